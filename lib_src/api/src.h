@@ -28,6 +28,131 @@ typedef enum dither_flag_t {
     ON = 1
 } dither_flag_t;
 
+/** Input ring buffer of the pull mode ASRC (asrc_pull_process())
+ *
+ *  The producer writes frames (one sample per channel of the instance, interleaved) at
+ *  write_index and then advances it, the ASRC reads them from read_index in blocks of the
+ *  number of input samples per ASRC call. Both indices count frames modulo 2 x n_frames, as
+ *  the block FIFO, so that any ring size wraps around correctly: the frame of an index is at
+ *  ASRC_IN_RING_POS(), ASRC_IN_RING_ADVANCE() advances an index and the ring holds
+ *  ASRC_IN_RING_FILL() frames.
+ */
+typedef struct asrc_in_ring_t
+{
+    int*         buff;         //!< Pointer to the ring samples (n_frames frames)
+    unsigned int n_frames;     //!< Ring size in frames, a multiple of the number of input samples per ASRC call
+    unsigned int write_index;  //!< Frames written by the producer, modulo 2 x n_frames
+    unsigned int read_index;   //!< Frames read by the ASRC, modulo 2 x n_frames
+} asrc_in_ring_t;
+
+//! Position in frames in the ring of the frame of index
+#define ASRC_IN_RING_POS(ring, index)         ((index) >= (ring)->n_frames ? (index) - (ring)->n_frames : (index))
+//! Index advanced by n frames (n at most n_frames)
+#define ASRC_IN_RING_ADVANCE(ring, index, n)  ((index) + (n) >= 2 * (ring)->n_frames ? (index) + (n) - 2 * (ring)->n_frames : (index) + (n))
+//! Number of frames held by the ring
+#define ASRC_IN_RING_FILL(ring)               ((ring)->write_index >= (ring)->read_index ? (ring)->write_index - (ring)->read_index : (ring)->write_index + 2 * (ring)->n_frames - (ring)->read_index)
+
+// Frame counters of the block FIFO: C11 atomics on hosts, volatile on xCORE (single issue and no
+// data cache, the FIFO functions add compiler barriers). XC and C++ only see the storage.
+#if defined(__XC__) || defined(__cplusplus) || defined(__xcore__)
+#define SRC_BLOCK_FIFO_COUNTER      volatile unsigned int
+#else
+#define SRC_BLOCK_FIFO_COUNTER      _Atomic unsigned int
+#endif
+
+//! Length in samples of the buffer of a block FIFO of n_frames frames with write windows of max_write frames
+#define SRC_BLOCK_FIFO_BUFF_LEN(n_frames, max_write, n_channels)    (((n_frames) + (max_write)) * (n_channels))
+
+/** Lock-free single producer, single consumer block FIFO (src_block_fifo_init())
+ *
+ *  The producer gets a contiguous write window of max_write frames (one sample per channel,
+ *  interleaved), for instance the output buffer of asrc_process(), and commits the frames it
+ *  wrote to it. The consumer reads the frames one at a time. Only the producer writes
+ *  write_index and only the consumer writes read_index, so the two sides can run in different
+ *  threads (or logical cores of the same tile) without a lock. Both indices count frames
+ *  modulo 2 x n_frames, the frame of an index being at position index % n_frames.
+ *
+ *  Overflows and underflows slip rather than reset the FIFO: a block committed when the FIFO
+ *  cannot hold it is dropped, and a read from an empty FIFO leaves the frame untouched (repeats
+ *  the last frame).
+ */
+typedef struct src_block_fifo_t
+{
+#ifdef __XC__
+    int* unsafe            buff;             //!< Pointer to the FIFO samples, SRC_BLOCK_FIFO_BUFF_LEN() samples
+#else
+    int*                   buff;             //!< Pointer to the FIFO samples, SRC_BLOCK_FIFO_BUFF_LEN() samples
+#endif
+    unsigned int           n_frames;         //!< FIFO size in frames
+    unsigned int           n_channels;       //!< Number of channels (samples per frame)
+    unsigned int           max_write;        //!< Size of the write window in frames
+    unsigned int           window_dropped;   //!< Set when the current write window will be dropped (producer)
+    unsigned int           n_overflows;      //!< Number of blocks dropped as the FIFO was full (producer)
+    unsigned int           n_underflows;     //!< Number of reads from an empty FIFO (consumer)
+    SRC_BLOCK_FIFO_COUNTER write_index;      //!< Frames written by the producer, modulo 2 x n_frames
+    SRC_BLOCK_FIFO_COUNTER read_index;       //!< Frames read by the consumer, modulo 2 x n_frames
+} src_block_fifo_t;
+
+/** Clock recovery loop estimating the Fs ratio of an ASRC (src_clock_recovery_init())
+ *
+ *  A second order loop (delay locked loop) steering the Fs ratio so that the level of the FIFO
+ *  between the ASRC output and the output clock domain settles at a target level. The phase
+ *  error is the FIFO level error. The frequency offset from the nominal Fs ratio is integrated
+ *  from it and, with a wider frequency locked loop, follows the clock ratio measured from the
+ *  timestamped sample counts. The fields are private to the src_clock_recovery functions.
+ */
+typedef struct src_clock_recovery_t
+{
+    unsigned int nominal_fs_ratio;   //!< Nominal Fs ratio, with fs_ratio_frac_bits fractional bits
+    unsigned int fs_ratio_frac_bits; //!< Fractional bits of the Fs ratios (SRC_FS_RATIO_FRAC_BITS or SRC_FS_RATIO_FRAC_BITS_WIDE)
+    unsigned int target_level;       //!< FIFO level the loop settles at, in frames
+    unsigned int bandwidth_mhz;      //!< Loop bandwidth in mHz
+    unsigned int ticks_per_second;   //!< Rate of the timestamps of the sample counts
+    int64_t      max_deviation;      //!< Largest offset from the nominal Fs ratio, relative in Q32 format
+    int64_t      freq;               //!< Frequency offset estimate, relative to the nominal Fs ratio in Q32 format
+    unsigned int seeded;             //!< Set once freq has been seeded from the sample counts
+    unsigned int fs_ratio;           //!< Last Fs ratio returned, with fs_ratio_frac_bits fractional bits
+} src_clock_recovery_t;
+
+/** Latency of a sample rate converter (ssrc_get_latency(), asrc_get_latency())
+ *
+ *  The group delay at DC of the filters chosen for the rate pair, from the time of an output
+ *  sample to the time of the input it represents, both streams starting together. Adding the
+ *  block buffering, one block of input samples collected before it is converted, gives the
+ *  total latency. All fields are in samples, unsigned Q16.16 format (1.0 = 65536).
+ */
+typedef struct src_latency_t
+{
+    unsigned int filters_in;   //!< Group delay of the filters in input samples
+    unsigned int filters_out;  //!< Group delay of the filters in output samples
+    unsigned int total_in;     //!< Group delay and block buffering in input samples
+    unsigned int total_out;    //!< Group delay and block buffering in output samples
+} src_latency_t;
+
+/** Fractional bits of the Fs ratios of the ASRC in Q4.28 format: 1.0 is 1 << 28.
+ *
+ *  The nominal Fs ratios (in / out) of asrc_init() and asrc_change_rate(), the Fs ratios given to
+ *  asrc_process() and those of the clock recovery loop are in this format. Fs ratios up to 16
+ *  (exclusive) fit in it.
+ */
+#define SRC_FS_RATIO_FRAC_BITS          28
+
+/** Fractional bits of the Fs ratios of the ASRC in Q8.24 format: 1.0 is 1 << 24.
+ *
+ *  Used in place of Q4.28 for the pairs of rates given in Hz (asrc_init_hz(),
+ *  asrc_change_rate_hz()) whose ratio, times 1.01, is 16 or above, up to 48 (384 to 8kHz).
+ *  asrc_get_fs_ratio_frac_bits() gives the format of an instance, to be passed on to
+ *  src_clock_recovery_init().
+ */
+#define SRC_FS_RATIO_FRAC_BITS_WIDE     24
+
+//! Alignment in bytes of the memory arena of ssrc_init_arena() and asrc_init_arena() (a cache line on hosts)
+#if defined(__xcore__) || defined(__XC__)
+#define SRC_ARENA_ALIGN     8
+#else
+#define SRC_ARENA_ALIGN     64
+#endif
+
 /** Initialises synchronous sample rate conversion instance.
  *  \param   sr_in                    Nominal sample rate code of input stream
  *  \param   sr_out                   Nominal sample rate code of output stream
@@ -40,6 +165,112 @@ void ssrc_init(const fs_code_t sr_in, const fs_code_t sr_out, ssrc_ctrl_t ssrc_c
                const unsigned n_channels_per_instance, const unsigned n_in_samples,
                const dither_flag_t dither_on_off);
 
+/** Initialises synchronous sample rate conversion instance for sample rates given in Hz.
+ *
+ *  The rates of the sample rate codes use the same filters as ssrc_init(), so the output is
+ *  identical. For other rates (with SRC_ARBITRARY_FS, the default on hosts), the filter stages are
+ *  planned for the pair of rates: an optional decimation by 2, 4, 8 or 16, a band limiting,
+ *  decimating or oversampling stage, and a polyphase filter for the remaining rational ratio.
+ *  The plan with the widest alias free pass band is used, which is at least 40% of the lowest of
+ *  the two rates.
+ *
+ *  Downsampling ratios up to 48 (384 to 8kHz) can be planned, with n_in_samples a multiple of
+ *  2 x D for the decimation by D, as for asrc_init_hz(). Upsampling ratios are planned up to 4,
+ *  and above 4 when the polyphase filter has an integer step (e.g. 8 to 48kHz); the upsampling
+ *  pairs from 8, 16 or 32kHz to the 44.1kHz family (and 22.05kHz), 8kHz to 192 or 384kHz, and
+ *  22.05 or 44.1kHz to 384kHz, 21 pairs of the rates from 8 to 384kHz, have no plan and are
+ *  converted by asrc_init_hz(). For them, and rates other than those of the codes without
+ *  SRC_ARBITRARY_FS, 0 is returned and the instance is not initialised: ssrc_rate_supported()
+ *  checks a pair of rates beforehand. The output buffer holds n_in_samples times out / in
+ *  samples per channel.
+ *
+ *  \param   fs_in                    Nominal sample rate of input stream (Hz)
+ *  \param   fs_out                   Nominal sample rate of output stream (Hz)
+ *  \param   ssrc_ctrl                Reference to array of SSRC control stuctures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of SSRC
+ *  \param   n_in_samples             Number of input samples per SSRC call
+ *  \param   dither_on_off            Dither to 24b on/off
+ *  \returns 1 if the instance is initialised, 0 if the pair of rates is not supported
+ */
+unsigned ssrc_init_hz(const unsigned fs_in, const unsigned fs_out, ssrc_ctrl_t ssrc_ctrl[],
+                      const unsigned n_channels_per_instance, const unsigned n_in_samples,
+                      const dither_flag_t dither_on_off);
+
+/** Checks whether synchronous sample rate conversion is supported for a pair of sample rates
+ *  given in Hz and a number of input samples per call, i.e. whether ssrc_init_hz() succeeds
+ *  for them.
+ *
+ *  \param   fs_in           Nominal sample rate of input stream (Hz)
+ *  \param   fs_out          Nominal sample rate of output stream (Hz)
+ *  \param   n_in_samples    Number of input samples per SSRC call
+ *  \returns 1 if the pair of rates is supported, 0 otherwise
+ */
+unsigned ssrc_rate_supported(const unsigned fs_in, const unsigned fs_out, const unsigned n_in_samples);
+
+/** Gets the memory needed by a synchronous sample rate conversion instance initialised with
+ *  ssrc_init_arena(): the control structures, states and stacks of the channels.
+ *
+ *  The stacks are sized for the filters of the rate pair and the block size (interleaved or
+ *  planar buffers), so for most rate pairs less memory is needed than with SSRC_STACK_LENGTH_MULT.
+ *
+ *  \param   sr_in                    Nominal sample rate code of input stream
+ *  \param   sr_out                   Nominal sample rate code of output stream
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of SSRC
+ *  \param   n_in_samples             Number of input samples per SSRC call
+ *  \returns The size of the arena in bytes
+ */
+unsigned ssrc_get_memory_size(const fs_code_t sr_in, const fs_code_t sr_out,
+                              const unsigned n_channels_per_instance, const unsigned n_in_samples);
+
+/** Gets the memory needed by a synchronous sample rate conversion instance initialised with
+ *  ssrc_init_arena_hz(), for sample rates given in Hz. As ssrc_get_memory_size() for the pairs
+ *  of rates with a sample rate code.
+ *
+ *  \param   fs_in                    Nominal sample rate of input stream (Hz)
+ *  \param   fs_out                   Nominal sample rate of output stream (Hz)
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of SSRC
+ *  \param   n_in_samples             Number of input samples per SSRC call
+ *  \returns The size of the arena in bytes, 0 if the pair of rates is not supported
+ */
+unsigned ssrc_get_memory_size_hz(const unsigned fs_in, const unsigned fs_out,
+                                 const unsigned n_channels_per_instance, const unsigned n_in_samples);
+
+/** Initialises synchronous sample rate conversion instance in a single memory arena.
+ *
+ *  The arena holds the array of SSRC control structures, at its start, followed by the state and
+ *  stack of each channel, each aligned to SRC_ARENA_ALIGN bytes. The instance is then used as
+ *  one initialised with ssrc_init(), with the arena as the array of control structures. A new
+ *  rate pair needs a new ssrc_init_arena() (with an arena of its memory size).
+ *
+ *  \param   sr_in                    Nominal sample rate code of input stream
+ *  \param   sr_out                   Nominal sample rate code of output stream
+ *  \param   ssrc_ctrl                Reference to the arena, of ssrc_get_memory_size() bytes
+ *                                    aligned to SRC_ARENA_ALIGN bytes
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of SSRC
+ *  \param   n_in_samples             Number of input samples per SSRC call
+ *  \param   dither_on_off            Dither to 24b on/off
+ */
+void ssrc_init_arena(const fs_code_t sr_in, const fs_code_t sr_out, ssrc_ctrl_t ssrc_ctrl[],
+                     const unsigned n_channels_per_instance, const unsigned n_in_samples,
+                     const dither_flag_t dither_on_off);
+
+/** Initialises synchronous sample rate conversion instance in a single memory arena for sample
+ *  rates given in Hz. The arena is laid out as by ssrc_init_arena() and the instance is then
+ *  used as one initialised with ssrc_init_hz().
+ *
+ *  \param   fs_in                    Nominal sample rate of input stream (Hz)
+ *  \param   fs_out                   Nominal sample rate of output stream (Hz)
+ *  \param   ssrc_ctrl                Reference to the arena, of ssrc_get_memory_size_hz() bytes
+ *                                    aligned to SRC_ARENA_ALIGN bytes
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of SSRC
+ *  \param   n_in_samples             Number of input samples per SSRC call
+ *  \param   dither_on_off            Dither to 24b on/off
+ *  \returns 1 if the instance is initialised, 0 if the pair of rates is not supported
+ */
+unsigned ssrc_init_arena_hz(const unsigned fs_in, const unsigned fs_out, ssrc_ctrl_t ssrc_ctrl[],
+                            const unsigned n_channels_per_instance, const unsigned n_in_samples,
+                            const dither_flag_t dither_on_off);
+
 /** Perform synchronous sample rate conversion processing on block of input samples using previously initialized settings.
  *
  *  \param   in_buff          Reference to input sample buffer array
@@ -49,6 +280,55 @@ void ssrc_init(const fs_code_t sr_in, const fs_code_t sr_out, ssrc_ctrl_t ssrc_c
  */
 unsigned ssrc_process(int in_buff[], int out_buff[], ssrc_ctrl_t ssrc_ctrl[]);
 
+/** Perform synchronous sample rate conversion processing on block of input samples in planar
+ *  (non-interleaved) buffers, one contiguous buffer per channel.
+ *
+ *  The filters read and write each channel with a unit step. The output samples are the same as
+ *  ssrc_process() with the channels interleaved, and the two may be used in turn on an instance.
+ *
+ *  \param   in_buff          Array of references to the input sample buffer of each channel
+ *  \param   out_buff         Array of references to the output sample buffer of each channel
+ *  \param   ssrc_ctrl        Reference to array of SSRC control stuctures
+ *  \returns The number of output samples produced by the SRC operation
+ */
+#ifdef __XC__
+unsigned ssrc_process_planar(int * unsafe in_buff[], int * unsafe out_buff[], ssrc_ctrl_t ssrc_ctrl[]);
+#else
+unsigned ssrc_process_planar(int *in_buff[], int *out_buff[], ssrc_ctrl_t ssrc_ctrl[]);
+#endif
+
+/** Gets the latency of an initialised synchronous sample rate conversion instance.
+ *
+ *  Exact for the filters of the rate pair, the output samples counted at the nominal rates.
+ *
+ *  \param   ssrc_ctrl        Reference to array of SSRC control stuctures
+ *  \param   latency          Reference to the latency, filled in
+ */
+#ifdef __XC__
+void ssrc_get_latency(ssrc_ctrl_t ssrc_ctrl[], src_latency_t * unsafe latency);
+#else
+void ssrc_get_latency(ssrc_ctrl_t ssrc_ctrl[], src_latency_t *latency);
+#endif
+
+#if FIR_FAST_CONV
+/** Switches an initialised synchronous sample rate conversion instance to fast convolution (FFT
+ *  overlap-save) filtering of its first two stages, for offline conversion of large blocks.
+ *
+ *  Fast convolution is only used for the filters with long enough polyphase branches, when
+ *  n_in_samples is at least FIR_FAST_CONV_MIN_IN_SAMPLES and when it is faster than the inner
+ *  loops selected for the host. The output is then within FIR_FAST_CONV_TOLERANCE LSBs of the
+ *  fixed point processing. Calling ssrc_init() switches back to fixed point processing.
+ *  Host builds only.
+ *
+ *  \param   ssrc_ctrl                Reference to array of SSRC control stuctures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of SSRC
+ *  \param   fast_conv_state          Reference to array of fast convolution states (one per channel)
+ *  \returns 1 if fast convolution is used, 0 otherwise
+ */
+unsigned ssrc_fast_conv_init(ssrc_ctrl_t ssrc_ctrl[], const unsigned n_channels_per_instance,
+                             ssrc_fast_conv_state_t fast_conv_state[]);
+#endif
+
 /** Initialises asynchronous sample rate conversion instance.
  *
  *  \param   sr_in           Nominal sample rate code of input stream
@@ -63,17 +343,522 @@ unsigned asrc_init(const fs_code_t sr_in, const fs_code_t sr_out,
                    asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
                    const unsigned n_in_samples, const dither_flag_t dither_on_off);
 
+/** Initialises asynchronous sample rate conversion instance for sample rates given in Hz.
+ *
+ *  The rates of the sample rate codes use the same filters as asrc_init(), so the output is
+ *  identical. For other rates (with SRC_ARBITRARY_FS, the default on hosts), the filter stages ahead of
+ *  the adaptive filter are planned for the pair of rates: a band limiting filter at the input
+ *  rate or at twice the input rate, or a decimation by 2, 4, 8 or 16 followed by a band limiting
+ *  filter. The plan with the widest alias free pass band is used, which is at least 40% of the
+ *  lowest of the two rates.
+ *
+ *  Any upsampling ratio and downsampling ratios up to 48 (384 to 8kHz) can be planned. The
+ *  decimation by D needs n_in_samples a multiple of 2 x D: 8 for ratios above about 6.5, 16
+ *  above about 13 and 32 above about 26. The Fs ratios are in Q4.28 format, or in Q8.24 format
+ *  when in / out times 1.01 is 16 or above (see asrc_get_fs_ratio_frac_bits()). For pairs of
+ *  rates without a plan for n_in_samples, and rates other than those of the codes without
+ *  SRC_ARBITRARY_FS, 0 is returned and the instance is not initialised: asrc_rate_supported()
+ *  checks a pair of rates beforehand.
+ *
+ *  \param   fs_in           Nominal sample rate of input stream (Hz)
+ *  \param   fs_out          Nominal sample rate of output stream (Hz)
+ *  \param   asrc_ctrl       Reference to array of ASRC control structures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \param   n_in_samples             Number of input samples per ASRC call
+ *  \param   dither_on_off            Dither to 24b on/off
+ *  \returns The nominal sample rate ratio of in to out, in Q4.28 or Q8.24 format, or 0 if the
+ *           pair of rates is not supported
+ */
+unsigned asrc_init_hz(const unsigned fs_in, const unsigned fs_out,
+                      asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
+                      const unsigned n_in_samples, const dither_flag_t dither_on_off);
+
+/** Gets the format of the Fs ratios of an initialised asynchronous sample rate conversion
+ *  instance: the Fs ratios returned by asrc_init_hz() and asrc_change_rate_hz() and given to
+ *  asrc_process() have this number of fractional bits.
+ *
+ *  It is SRC_FS_RATIO_FRAC_BITS (28, Q4.28 format) for all the rates of the codes, and
+ *  SRC_FS_RATIO_FRAC_BITS_WIDE (24, Q8.24 format) for pairs of rates given in Hz whose ratio,
+ *  times 1.01, is 16 or above.
+ *
+ *  \param   asrc_ctrl       Reference to array of ASRC control structures
+ *  \returns The number of fractional bits of the Fs ratios, SRC_FS_RATIO_FRAC_BITS or
+ *           SRC_FS_RATIO_FRAC_BITS_WIDE
+ */
+unsigned asrc_get_fs_ratio_frac_bits(asrc_ctrl_t asrc_ctrl[]);
+
+/** Checks whether asynchronous sample rate conversion is supported for a pair of sample rates
+ *  given in Hz and a number of input samples per call, i.e. whether asrc_init_hz() and
+ *  asrc_change_rate_hz() succeed for them.
+ *
+ *  \param   fs_in           Nominal sample rate of input stream (Hz)
+ *  \param   fs_out          Nominal sample rate of output stream (Hz)
+ *  \param   n_in_samples    Number of input samples per ASRC call
+ *  \returns 1 if the pair of rates is supported, 0 otherwise
+ */
+unsigned asrc_rate_supported(const unsigned fs_in, const unsigned fs_out, const unsigned n_in_samples);
+
+/** Gets the memory needed by an asynchronous sample rate conversion instance initialised with
+ *  asrc_init_arena(): the control structures, adaptive filter coefficients, states and stacks
+ *  of the channels.
+ *
+ *  The stacks are sized for the filters of the rate pair and the block size, so for most rate
+ *  pairs less memory is needed than with ASRC_STACK_LENGTH_MULT.
+ *
+ *  \param   sr_in                    Nominal sample rate code of input stream
+ *  \param   sr_out                   Nominal sample rate code of output stream
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \param   n_in_samples             Number of input samples per ASRC call
+ *  \returns The size of the arena in bytes
+ */
+unsigned asrc_get_memory_size(const fs_code_t sr_in, const fs_code_t sr_out,
+                              const unsigned n_channels_per_instance, const unsigned n_in_samples);
+
+/** Gets the memory needed by an asynchronous sample rate conversion instance initialised with
+ *  asrc_init_arena_hz(), for sample rates given in Hz. As asrc_get_memory_size() for the pairs
+ *  of rates with a sample rate code.
+ *
+ *  \param   fs_in                    Nominal sample rate of input stream (Hz)
+ *  \param   fs_out                   Nominal sample rate of output stream (Hz)
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \param   n_in_samples             Number of input samples per ASRC call
+ *  \returns The size of the arena in bytes, 0 if the pair of rates is not supported
+ */
+unsigned asrc_get_memory_size_hz(const unsigned fs_in, const unsigned fs_out,
+                                 const unsigned n_channels_per_instance, const unsigned n_in_samples);
+
+/** Initialises asynchronous sample rate conversion instance in a single memory arena.
+ *
+ *  The arena holds the array of ASRC control structures, at its start, followed by the adaptive
+ *  filter coefficients shared by the channels and the state and stack of each channel, each
+ *  aligned to SRC_ARENA_ALIGN bytes. The instance is then used as one initialised with
+ *  asrc_init(), with the arena as the array of control structures. The stacks are sized for the
+ *  rate pair: a new rate pair needs a new asrc_init_arena() (with an arena of its memory size)
+ *  rather than asrc_change_rate().
+ *
+ *  \param   sr_in                    Nominal sample rate code of input stream
+ *  \param   sr_out                   Nominal sample rate code of output stream
+ *  \param   asrc_ctrl                Reference to the arena, of asrc_get_memory_size() bytes
+ *                                    aligned to SRC_ARENA_ALIGN bytes
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \param   n_in_samples             Number of input samples per ASRC call
+ *  \param   dither_on_off            Dither to 24b on/off
+ *  \returns The nominal sample rate ratio of in to out in Q4.28 format
+ */
+unsigned asrc_init_arena(const fs_code_t sr_in, const fs_code_t sr_out, asrc_ctrl_t asrc_ctrl[],
+                         const unsigned n_channels_per_instance, const unsigned n_in_samples,
+                         const dither_flag_t dither_on_off);
+
+/** Initialises asynchronous sample rate conversion instance in a single memory arena for sample
+ *  rates given in Hz. The arena is laid out as by asrc_init_arena() and the instance is then
+ *  used as one initialised with asrc_init_hz().
+ *
+ *  \param   fs_in                    Nominal sample rate of input stream (Hz)
+ *  \param   fs_out                   Nominal sample rate of output stream (Hz)
+ *  \param   asrc_ctrl                Reference to the arena, of asrc_get_memory_size_hz() bytes
+ *                                    aligned to SRC_ARENA_ALIGN bytes
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \param   n_in_samples             Number of input samples per ASRC call
+ *  \param   dither_on_off            Dither to 24b on/off
+ *  \returns The nominal sample rate ratio of in to out, with asrc_get_fs_ratio_frac_bits()
+ *           fractional bits, or 0 if the pair of rates is not supported
+ */
+unsigned asrc_init_arena_hz(const unsigned fs_in, const unsigned fs_out, asrc_ctrl_t asrc_ctrl[],
+                            const unsigned n_channels_per_instance, const unsigned n_in_samples,
+                            const dither_flag_t dither_on_off);
+
+/** Switches an initialised asynchronous sample rate conversion instance to new nominal sample rates.
+ *
+ *  Unlike asrc_init(), the delay lines are not cleared: the first two filter stages are set up
+ *  for the new rates and refilled with as many of their newest samples as they hold, and the
+ *  adaptive filter stage, time and dither carry on, so output continues without a gap of
+ *  silence. The number of input samples per call and the dither setting are unchanged. With
+ *  asrc_pull_process(), the samples of the last input block not yet converted are dropped.
+ *
+ *  \param   sr_in           Nominal sample rate code of new input stream
+ *  \param   sr_out          Nominal sample rate code of new output stream
+ *  \param   asrc_ctrl       Reference to array of ASRC control structures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \returns The new nominal sample rate ratio of in to out in Q4.28 format
+ */
+unsigned asrc_change_rate(const fs_code_t sr_in, const fs_code_t sr_out,
+                          asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance);
+
+/** Switches an initialised asynchronous sample rate conversion instance to new nominal sample
+ *  rates given in Hz, as asrc_change_rate(), with the filter stages of asrc_init_hz().
+ *
+ *  If the new pair of rates is not supported for the number of input samples per call (see
+ *  asrc_rate_supported()), 0 is returned and the instance carries on at its current rates.
+ *
+ *  \param   fs_in           Nominal sample rate of new input stream (Hz)
+ *  \param   fs_out          Nominal sample rate of new output stream (Hz)
+ *  \param   asrc_ctrl       Reference to array of ASRC control structures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \returns The new nominal sample rate ratio of in to out, in Q4.28 or Q8.24 format
+ *           (asrc_get_fs_ratio_frac_bits() gives the format for the new rates), or 0 if the
+ *           pair of rates is not supported
+ */
+unsigned asrc_change_rate_hz(const unsigned fs_in, const unsigned fs_out,
+                             asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance);
+
+/** Sets the range of Fs ratios accepted by asrc_process() and asrc_pull_process() around the
+ *  nominal ratio, for varispeed playback or scrubbing without reinitialising the ASRC.
+ *
+ *  By default (after asrc_init()) Fs ratios beyond +/-1% of the nominal ratio are replaced by the
+ *  nominal ratio. This widens or narrows that range, up to ASRC_FS_RATIO_RANGE_MAX (+/-50%); 0
+ *  restores the default. The range is kept over asrc_change_rate(). The filters are designed for
+ *  the nominal rates, so the higher the output rate is pulled down by the Fs ratio, the more the
+ *  top of the pass band is folded back (when the output rate is the lower rate).
+ *
+ *  With a range of r ppm, asrc_process() produces up to
+ *  n_in_samples x fs_out / fs_in / (1 - r / 1000000) + 1 output samples per channel, which out_buff
+ *  must hold. The ratio times (1 + r / 1000000) must fit in the format of the Fs ratio (Q4.28, or
+ *  Q8.24 see asrc_get_fs_ratio_frac_bits()), otherwise the range is rejected.
+ *
+ *  \param   asrc_ctrl       Reference to array of ASRC control structures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \param   range_ppm       Maximal deviation of the Fs ratio from nominal, in parts per million
+ */
+void asrc_set_fs_ratio_range(asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
+                             const unsigned range_ppm);
+
 /** Perform asynchronous sample rate conversion processing on block of input samples using previously initialized settings.
  *
  *  \param   in_buff          Reference to input sample buffer array
  *  \param   out_buff         Reference to output sample buffer array
- *  \param   fs_ratio         Fixed point ratio of in/out sample rates in Q4.28 format
+ *  \param   fs_ratio         Fixed point ratio of in/out sample rates in Q4.28 format (Q8.24
+ *                            for the pairs of rates given in Hz with a ratio of 16 and above)
  *  \param   asrc_ctrl        Reference to array of ASRC control structures
  *  \returns The number of output samples produced by the SRC operation.
  */
 unsigned asrc_process(int in_buff[], int out_buff[], unsigned fs_ratio,
                       asrc_ctrl_t asrc_ctrl[]);
 
+/** Perform asynchronous sample rate conversion processing on block of input samples in planar
+ *  (non-interleaved) buffers, one contiguous buffer per channel.
+ *
+ *  The first and last filter stages read and write each channel with a unit step. The output
+ *  samples are the same as asrc_process() with the channels interleaved, and the two may be used
+ *  in turn on an instance.
+ *
+ *  \param   in_buff          Array of references to the input sample buffer of each channel
+ *  \param   out_buff         Array of references to the output sample buffer of each channel
+ *  \param   fs_ratio         Fixed point ratio of in/out sample rates in Q4.28 format (Q8.24
+ *                            for the pairs of rates given in Hz with a ratio of 16 and above)
+ *  \param   asrc_ctrl        Reference to array of ASRC control structures
+ *  \returns The number of output samples produced by the SRC operation.
+ */
+#ifdef __XC__
+unsigned asrc_process_planar(int * unsafe in_buff[], int * unsafe out_buff[], unsigned fs_ratio,
+                             asrc_ctrl_t asrc_ctrl[]);
+#else
+unsigned asrc_process_planar(int *in_buff[], int *out_buff[], unsigned fs_ratio,
+                             asrc_ctrl_t asrc_ctrl[]);
+#endif
+
+/** Perform asynchronous sample rate conversion processing producing a requested number of output
+ *  samples, pulling input samples from a ring buffer as needed (pull mode).
+ *
+ *  Blocks of the number of input samples given to asrc_init() are read from the ring whenever the
+ *  adaptive filter stage needs new samples, so the output is produced on demand (for instance
+ *  at the rate of a DAC) and only the input needs buffering. The output samples are the same as
+ *  with asrc_process() fed with the same input blocks. When the ring runs out of full input
+ *  blocks, fewer output samples are produced and conversion carries on from there on the next
+ *  call.
+ *
+ *  \param   in_ring          Reference to the input ring buffer
+ *  \param   out_buff         Reference to output sample buffer array (n_out_samples samples per channel)
+ *  \param   n_out_samples    Number of output samples requested
+ *  \param   fs_ratio         Fixed point ratio of in/out sample rates in Q4.28 format (Q8.24
+ *                            for the pairs of rates given in Hz with a ratio of 16 and above)
+ *  \param   asrc_ctrl        Reference to array of ASRC control structures
+ *  \returns The number of output samples produced, n_out_samples unless the input ran out.
+ */
+unsigned asrc_pull_process(asrc_in_ring_t *in_ring, int out_buff[], unsigned n_out_samples,
+                           unsigned fs_ratio, asrc_ctrl_t asrc_ctrl[]);
+
+/** Gets the latency of an initialised asynchronous sample rate conversion instance.
+ *
+ *  Computed for the filters of the current rates (asrc_init(), asrc_change_rate() or their _hz
+ *  variants) at the nominal Fs ratio, the output samples counted at the nominal rates. The
+ *  FIFO between the ASRC output and the output clock (see src_block_fifo_t) adds its level.
+ *
+ *  \param   asrc_ctrl        Reference to array of ASRC control structures
+ *  \param   latency          Reference to the latency, filled in
+ */
+#ifdef __XC__
+void asrc_get_latency(asrc_ctrl_t asrc_ctrl[], src_latency_t * unsafe latency);
+#else
+void asrc_get_latency(asrc_ctrl_t asrc_ctrl[], src_latency_t *latency);
+#endif
+
+#if ASRC_MT
+/** Multithreaded asynchronous sample rate converter (asrc_mt_process()), host builds only
+ *
+ *  The channels of one ASRC instance are split into contiguous groups, one per thread: the
+ *  calling thread converts the first group and a pool of worker threads, started by
+ *  asrc_mt_init(), the others.
+ */
+typedef struct asrc_mt_t
+{
+    asrc_ctrl_t* asrc_ctrl;    //!< Pointer to the ASRC control structures of all the channels
+    unsigned int n_channels;   //!< Number of channels of the instance
+    unsigned int n_threads;    //!< Number of threads converting, including the calling thread
+    void*        pool;         //!< Worker pool (internal)
+} asrc_mt_t;
+
+/** Starts the worker pool of a multithreaded asynchronous sample rate converter.
+ *
+ *  The ASRC instance is initialised as usual (asrc_init() or asrc_init_hz()) with all the channels,
+ *  before or after this call. Rates and the Fs ratio range can be changed between
+ *  asrc_mt_process() calls as for asrc_process().
+ *
+ *  \param   asrc_mt          Reference to the multithreaded ASRC structure
+ *  \param   asrc_ctrl        Reference to array of ASRC control structures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \param   n_threads        Number of threads, including the calling thread: at most
+ *                            ASRC_MT_MAX_THREADS and the number of channels
+ *  \param   pin_threads      Non zero to pin each worker thread to a CPU (Linux only), worker n
+ *                            on the n-th CPU the process may run on (wrapping around)
+ *  \returns The number of threads converting, fewer than requested when worker threads could not
+ *           be started
+ */
+unsigned asrc_mt_init(asrc_mt_t *asrc_mt, asrc_ctrl_t asrc_ctrl[],
+                      const unsigned n_channels_per_instance, unsigned n_threads,
+                      const unsigned pin_threads);
+
+/** Perform asynchronous sample rate conversion processing on a block of input samples, as
+ *  asrc_process(), with the channels converted in parallel by the threads of a multithreaded ASRC.
+ *
+ *  The worker threads run the first two filter stages and the adaptive filter stage of their
+ *  channels. The time steps and adaptive coefficients of the output samples, the same for all the
+ *  channels, are computed once per block. The output samples are the same as asrc_process().
+ *
+ *  \param   in_buff          Reference to input sample buffer array (channels interleaved)
+ *  \param   out_buff         Reference to output sample buffer array (channels interleaved)
+ *  \param   fs_ratio         Fixed point ratio of in/out sample rates in Q4.28 format (Q8.24
+ *                            for the pairs of rates given in Hz with a ratio of 16 and above)
+ *  \param   asrc_mt          Reference to the multithreaded ASRC structure
+ *  \returns The number of output samples produced by the SRC operation.
+ */
+unsigned asrc_mt_process(int in_buff[], int out_buff[], unsigned fs_ratio, asrc_mt_t *asrc_mt);
+
+/** Stops the worker threads of a multithreaded asynchronous sample rate converter.
+ *
+ *  \param   asrc_mt          Reference to the multithreaded ASRC structure
+ */
+void asrc_mt_release(asrc_mt_t *asrc_mt);
+#endif
+
+/** Initialises an empty block FIFO. To be called before the producer and the consumer start.
+ *
+ *  \param   fifo             Reference to the FIFO control structure
+ *  \param   buff             Reference to the FIFO sample buffer, of
+ *                            SRC_BLOCK_FIFO_BUFF_LEN(n_frames, max_write, n_channels) samples
+ *  \param   n_frames         FIFO size in frames, at least max_write
+ *  \param   n_channels       Number of channels (samples per frame)
+ *  \param   max_write        Size of the write window in frames: the largest number of frames
+ *                            committed at once (e.g. the maximum number of output samples of
+ *                            asrc_process())
+ */
+#ifdef __XC__
+void src_block_fifo_init(src_block_fifo_t * unsafe fifo, int * unsafe buff, unsigned n_frames,
+                         unsigned n_channels, unsigned max_write);
+#else
+void src_block_fifo_init(src_block_fifo_t *fifo, int buff[], unsigned n_frames,
+                         unsigned n_channels, unsigned max_write);
+#endif
+
+/** Returns the write window of a block FIFO (producer).
+ *
+ *  The window holds max_write contiguous frames. When the FIFO cannot hold max_write more
+ *  frames, the window is a scratch area and the next src_block_fifo_write_commit() drops the
+ *  frames written to it (counted in n_overflows).
+ *
+ *  \param   fifo             Reference to the FIFO control structure
+ *  \returns Pointer to the first sample of the write window
+ */
+#ifdef __XC__
+int * unsafe src_block_fifo_write_window(src_block_fifo_t * unsafe fifo);
+#else
+int *src_block_fifo_write_window(src_block_fifo_t *fifo);
+#endif
+
+/** Commits the frames written to the write window of a block FIFO (producer).
+ *
+ *  \param   fifo             Reference to the FIFO control structure
+ *  More than max_write frames cannot have fitted in the window: the commit is dropped and
+ *  counted in n_overflows, as for a full FIFO.
+ *
+ *  \param   n_frames         Number of frames written, at most max_write
+ */
+#ifdef __XC__
+void src_block_fifo_write_commit(src_block_fifo_t * unsafe fifo, unsigned n_frames);
+#else
+void src_block_fifo_write_commit(src_block_fifo_t *fifo, unsigned n_frames);
+#endif
+
+/** Reads one frame from a block FIFO (consumer).
+ *
+ *  \param   fifo             Reference to the FIFO control structure
+ *  \param   frame            Reference to the frame (n_channels samples), left untouched when
+ *                            the FIFO is empty (counted in n_underflows)
+ *  \returns 1 when a frame was read, 0 when the FIFO was empty
+ */
+#ifdef __XC__
+unsigned src_block_fifo_read(src_block_fifo_t * unsafe fifo, int * unsafe frame);
+#else
+unsigned src_block_fifo_read(src_block_fifo_t *fifo, int frame[]);
+#endif
+
+/** Returns the number of frames held by a block FIFO. Exact from either side, a snapshot for
+ *  anyone else.
+ *
+ *  \param   fifo             Reference to the FIFO control structure
+ *  \returns The number of frames written and not yet read
+ */
+#ifdef __XC__
+unsigned src_block_fifo_fill_level(src_block_fifo_t * unsafe fifo);
+#else
+unsigned src_block_fifo_fill_level(src_block_fifo_t *fifo);
+#endif
+
+/** Initialises a clock recovery loop (or restarts it after a sample rate change).
+ *
+ *  The loop bandwidth trades the settling of the FIFO level against the filtering of the FIFO
+ *  level, which moves by up to a block of ASRC output samples at a time. Clock drift is
+ *  tracked by the frequency locked loop, 8 times wider, so a few tens of mHz suit updates every
+ *  few tens of ms. The loop has a natural frequency of bandwidth_mhz and a damping factor of
+ *  0.707.
+ *
+ *  \param   clock_recovery     Reference to the clock recovery control structure
+ *  \param   nominal_fs_ratio   Nominal Fs ratio, as returned by asrc_init() or asrc_init_hz()
+ *  \param   fs_ratio_frac_bits Fractional bits of the Fs ratios of the ASRC:
+ *                              SRC_FS_RATIO_FRAC_BITS (Q4.28) for the rates of the codes, else
+ *                              as returned by asrc_get_fs_ratio_frac_bits()
+ *  \param   target_level       FIFO level (in frames) the loop settles at, typically half the
+ *                              FIFO size
+ *  \param   bandwidth_mhz      Loop bandwidth in mHz
+ *  \param   ticks_per_second   Rate of the timestamps given to src_clock_recovery_update()
+ *                              (e.g. XS1_TIMER_HZ)
+ *  \param   max_deviation_ppm  Largest offset of the Fs ratio from nominal, in ppm, at most
+ *                              ASRC_FS_RATIO_RANGE_MAX (10000 for the default range of
+ *                              asrc_process())
+ */
+void src_clock_recovery_init(src_clock_recovery_t *clock_recovery, unsigned nominal_fs_ratio,
+                             unsigned fs_ratio_frac_bits, unsigned target_level,
+                             unsigned bandwidth_mhz, unsigned ticks_per_second,
+                             unsigned max_deviation_ppm);
+
+/** Updates a clock recovery loop with the sample counts and FIFO level of the last period.
+ *
+ *  To be called periodically (every 10 to 100ms), the periods need not be regular.
+ *
+ *  \param   clock_recovery     Reference to the clock recovery control structure
+ *  \param   n_in_samples       Number of input samples counted over the period
+ *  \param   in_ticks           Duration of the input count, in ticks
+ *  \param   n_out_samples      Number of output samples counted over the period
+ *  \param   out_ticks          Duration of the output count, in ticks
+ *  \param   fifo_level         Level of the FIFO at the end of the period, in frames
+ *  \returns The Fs ratio to give to asrc_process(), in the format of the nominal Fs ratio
+ */
+unsigned src_clock_recovery_update(src_clock_recovery_t *clock_recovery,
+                                   unsigned n_in_samples, unsigned in_ticks,
+                                   unsigned n_out_samples, unsigned out_ticks,
+                                   unsigned fifo_level);
+
+#if FIR_FLOAT
+/** Initialises single precision floating point synchronous sample rate conversion instance.
+ *
+ *  Uses the same filters as ssrc_init(), with samples and coefficients in single precision
+ *  floating point (full scale is +/-1.0). There is no dither and no saturation: samples beyond
+ *  full scale are converted without clipping. Host builds only.
+ *
+ *  \param   sr_in                    Nominal sample rate code of input stream
+ *  \param   sr_out                   Nominal sample rate code of output stream
+ *  \param   ssrc_ctrl                Reference to array of float SSRC control stuctures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of SSRC
+ *  \param   n_in_samples             Number of input samples per SSRC call
+ */
+void ssrc_float_init(const fs_code_t sr_in, const fs_code_t sr_out, ssrc_float_ctrl_t ssrc_ctrl[],
+                     const unsigned n_channels_per_instance, const unsigned n_in_samples);
+
+/** Initialises single precision floating point synchronous sample rate conversion instance for
+ *  sample rates given in Hz.
+ *
+ *  Uses the same filters as ssrc_init_hz(), in single precision floating point as
+ *  ssrc_float_init(). Host builds only.
+ *
+ *  \param   fs_in                    Nominal sample rate of input stream (Hz)
+ *  \param   fs_out                   Nominal sample rate of output stream (Hz)
+ *  \param   ssrc_ctrl                Reference to array of float SSRC control stuctures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of SSRC
+ *  \param   n_in_samples             Number of input samples per SSRC call
+ *  \returns 1 if the instance is initialised, 0 if the pair of rates is not supported
+ *           (see ssrc_rate_supported())
+ */
+unsigned ssrc_float_init_hz(const unsigned fs_in, const unsigned fs_out, ssrc_float_ctrl_t ssrc_ctrl[],
+                            const unsigned n_channels_per_instance, const unsigned n_in_samples);
+
+/** Perform single precision floating point synchronous sample rate conversion processing on block
+ *  of input samples using previously initialized settings.
+ *
+ *  \param   in_buff          Reference to input sample buffer array
+ *  \param   out_buff         Reference to output sample buffer array
+ *  \param   ssrc_ctrl        Reference to array of float SSRC control stuctures
+ *  \returns The number of output samples produced by the SRC operation
+ */
+unsigned ssrc_float_process(float in_buff[], float out_buff[], ssrc_float_ctrl_t ssrc_ctrl[]);
+
+/** Initialises single precision floating point asynchronous sample rate conversion instance.
+ *
+ *  Uses the same filters and time stepping as asrc_init(), with samples and coefficients in
+ *  single precision floating point (full scale is +/-1.0). There is no dither and no
+ *  saturation. Host builds only.
+ *
+ *  \param   sr_in           Nominal sample rate code of input stream
+ *  \param   sr_out          Nominal sample rate code of output stream
+ *  \param   asrc_ctrl       Reference to array of float ASRC control structures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \param   n_in_samples             Number of input samples per ASRC call
+ *  \returns The nominal sample rate ratio of in to out in Q4.28 format
+ */
+unsigned asrc_float_init(const fs_code_t sr_in, const fs_code_t sr_out,
+                         asrc_float_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
+                         const unsigned n_in_samples);
+
+/** Initialises single precision floating point asynchronous sample rate conversion instance for
+ *  sample rates given in Hz.
+ *
+ *  Uses the same filters, time stepping and Fs ratio format as asrc_init_hz(), in single
+ *  precision floating point as asrc_float_init(). Host builds only.
+ *
+ *  \param   fs_in           Nominal sample rate of input stream (Hz)
+ *  \param   fs_out          Nominal sample rate of output stream (Hz)
+ *  \param   asrc_ctrl       Reference to array of float ASRC control structures
+ *  \param   n_channels_per_instance  Number of channels handled by this instance of ASRC
+ *  \param   n_in_samples             Number of input samples per ASRC call
+ *  \returns The nominal sample rate ratio of in to out, in Q4.28 or Q8.24 format, or 0 if the
+ *           pair of rates is not supported (see asrc_rate_supported())
+ */
+unsigned asrc_float_init_hz(const unsigned fs_in, const unsigned fs_out,
+                            asrc_float_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
+                            const unsigned n_in_samples);
+
+/** Perform single precision floating point asynchronous sample rate conversion processing on
+ *  block of input samples using previously initialized settings.
+ *
+ *  \param   in_buff          Reference to input sample buffer array
+ *  \param   out_buff         Reference to output sample buffer array
+ *  \param   fs_ratio         Fixed point ratio of in/out sample rates in Q4.28 format (Q8.24
+ *                            for the pairs of rates given in Hz with a ratio of 16 and above)
+ *  \param   asrc_ctrl        Reference to array of float ASRC control structures
+ *  \returns The number of output samples produced by the SRC operation.
+ */
+unsigned asrc_float_process(float in_buff[], float out_buff[], unsigned fs_ratio,
+                            asrc_float_ctrl_t asrc_ctrl[]);
+#endif
+
 // To avoid C type definitions when including this file from assembler
 #ifndef INCLUDE_FROM_ASM
 
@@ -96,8 +881,8 @@ typedef struct src_ds3_ctrl_t
     int*         delay_base;   //!< Pointer to delay line base
     unsigned int delay_len;    //!< Total length of delay line
     int*         delay_pos;    //!< Pointer to current position in delay line
-    int*         delay_wrap;   //!< Delay buffer wrap around address (for circular buffer simulation)
-    unsigned int delay_offset; //!< Delay line offset for second write (for circular buffer simulation)
+    int*         delay_wrap;   //!< Delay buffer wrap around address
+    unsigned int delay_offset; //!< Number of samples in delay line (offset for second write with circular buffer simulation)
     unsigned int inner_loops;  //!< Number of inner loop iterations
     unsigned int num_coeffs;   //!< Number of coefficients
     int*         coeffs;       //!< Pointer to coefficients
@@ -134,8 +919,8 @@ typedef struct src_os3_ctrl_t
     int*         delay_base;   //!< Pointer to delay line base
     unsigned int delay_len;    //!< Total length of delay line
     int*         delay_pos;    //!< Pointer to current position in delay line
-    int*         delay_wrap;   //!< Delay buffer wrap around address (for circular buffer simulation)
-    unsigned int delay_offset; //!< Delay line offset for second write (for circular buffer simulation)
+    int*         delay_wrap;   //!< Delay buffer wrap around address
+    unsigned int delay_offset; //!< Number of samples in delay line (offset for second write with circular buffer simulation)
     unsigned int inner_loops;  //!< Number of inner loop iterations
     unsigned int num_coeffs;   //!< Number of coefficients
     int*         coeffs;       //!< Pointer to coefficients
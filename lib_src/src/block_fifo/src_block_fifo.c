@@ -0,0 +1,200 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Lock-free single producer, single consumer block FIFO implementation file
+//
+// ===========================================================================
+// ===========================================================================
+
+
+// ===========================================================================
+//
+// Includes
+//
+// ===========================================================================
+#include <string.h>
+#if !defined(__xcore__)
+#include <stdatomic.h>
+#endif
+
+#include "src.h"
+
+
+// ===========================================================================
+//
+// Defines
+//
+// ===========================================================================
+
+// Counter accesses. The producer publishes the frames it wrote with a release store of write_index
+// and the consumer frees the frames it read with a release store of read_index, each side loading
+// the other's counter with acquire. Own counters are only written by their side, so are loaded
+// relaxed. xCORE tiles have no data cache and the counters are volatile: a compiler barrier is
+// enough to order the samples and the counters.
+#if defined(__xcore__)
+#define     SRC_BLOCK_FIFO_BARRIER()                    __asm__ __volatile__("" ::: "memory")
+#define     SRC_BLOCK_FIFO_LOAD_OWN(uiCounter)          (uiCounter)
+#define     SRC_BLOCK_FIFO_LOAD_ACQUIRE(uiCounter)      src_block_fifo_load_acquire(&(uiCounter))
+#define     SRC_BLOCK_FIFO_STORE_RELEASE(uiCounter, ui) src_block_fifo_store_release(&(uiCounter), (ui))
+
+static inline unsigned int src_block_fifo_load_acquire(volatile unsigned int *puiCounter)
+{
+    unsigned int ui = *puiCounter;
+
+    SRC_BLOCK_FIFO_BARRIER();
+    return ui;
+}
+
+static inline void src_block_fifo_store_release(volatile unsigned int *puiCounter, unsigned int ui)
+{
+    SRC_BLOCK_FIFO_BARRIER();
+    *puiCounter = ui;
+}
+#else
+#define     SRC_BLOCK_FIFO_LOAD_OWN(uiCounter)          atomic_load_explicit(&(uiCounter), memory_order_relaxed)
+#define     SRC_BLOCK_FIFO_LOAD_ACQUIRE(uiCounter)      atomic_load_explicit(&(uiCounter), memory_order_acquire)
+#define     SRC_BLOCK_FIFO_STORE_RELEASE(uiCounter, ui) atomic_store_explicit(&(uiCounter), (ui), memory_order_release)
+#endif
+
+// The indices count frames modulo twice the FIFO size, telling a full FIFO from an empty one for
+// any size (free running counters would need a power of 2 size to wrap)
+#define     SRC_BLOCK_FIFO_POS(fifo, uiIndex)           ((uiIndex) >= (fifo)->n_frames ? (uiIndex) - (fifo)->n_frames : (uiIndex))
+#define     SRC_BLOCK_FIFO_FILL(fifo, uiWrite, uiRead)  ((uiWrite) >= (uiRead) ? (uiWrite) - (uiRead) : (uiWrite) + 2 * (fifo)->n_frames - (uiRead))
+#define     SRC_BLOCK_FIFO_ADVANCE(fifo, uiIndex, n)    ((uiIndex) + (n) >= 2 * (fifo)->n_frames ? (uiIndex) + (n) - 2 * (fifo)->n_frames : (uiIndex) + (n))
+
+
+// ===========================================================================
+//
+// Functions implementations
+//
+// ===========================================================================
+
+// ==================================================================== //
+// Function:        src_block_fifo_init                                 //
+// Arguments:       src_block_fifo_t *fifo: Ctrl strct.                 //
+//                  int buff[]: FIFO samples                            //
+//                  unsigned n_frames: FIFO size in frames              //
+//                  unsigned n_channels: Samples per frame              //
+//                  unsigned max_write: Write window size in frames     //
+// Return values:   None                                                //
+// Description:     Inits an empty FIFO                                 //
+// ==================================================================== //
+void src_block_fifo_init(src_block_fifo_t *fifo, int buff[], unsigned n_frames,
+                         unsigned n_channels, unsigned max_write)
+{
+    fifo->buff              = buff;
+    fifo->n_frames          = n_frames;
+    fifo->n_channels        = n_channels;
+    fifo->max_write         = max_write;
+    fifo->window_dropped    = 0;
+    fifo->n_overflows       = 0;
+    fifo->n_underflows      = 0;
+    fifo->write_index       = 0;
+    fifo->read_index        = 0;
+
+    memset(buff, 0, SRC_BLOCK_FIFO_BUFF_LEN(n_frames, max_write, n_channels) * sizeof(int));
+}
+
+
+// ==================================================================== //
+// Function:        src_block_fifo_write_window                         //
+// Arguments:       src_block_fifo_t *fifo: Ctrl strct.                 //
+// Return values:   Pointer to the write window                         //
+// Description:     Producer side. The window starts at the write       //
+//                  position, the max_write frames past the end of the  //
+//                  FIFO keep it contiguous. Without room for max_write //
+//                  frames, the window past the end is used as scratch  //
+//                  and the commit drops its frames                     //
+// ==================================================================== //
+int *src_block_fifo_write_window(src_block_fifo_t *fifo)
+{
+    unsigned int    uiWrite = SRC_BLOCK_FIFO_LOAD_OWN(fifo->write_index);
+    unsigned int    uiRead = SRC_BLOCK_FIFO_LOAD_ACQUIRE(fifo->read_index);
+
+    if(fifo->n_frames - SRC_BLOCK_FIFO_FILL(fifo, uiWrite, uiRead) < fifo->max_write)
+    {
+        fifo->window_dropped = 1;
+        return fifo->buff + fifo->n_frames * fifo->n_channels;
+    }
+    fifo->window_dropped = 0;
+    return fifo->buff + SRC_BLOCK_FIFO_POS(fifo, uiWrite) * fifo->n_channels;
+}
+
+
+// ==================================================================== //
+// Function:        src_block_fifo_write_commit                         //
+// Arguments:       src_block_fifo_t *fifo: Ctrl strct.                 //
+//                  unsigned n_frames: Frames written to the window     //
+// Return values:   None                                                //
+// Description:     Producer side. Copies the frames written past the   //
+//                  end of the FIFO back to its start and publishes the //
+//                  frames to the consumer. Commits of more than        //
+//                  max_write frames are dropped as overflows           //
+// ==================================================================== //
+void src_block_fifo_write_commit(src_block_fifo_t *fifo, unsigned n_frames)
+{
+    unsigned int    uiWrite = SRC_BLOCK_FIFO_LOAD_OWN(fifo->write_index);
+    unsigned int    uiPos;
+
+    if(n_frames == 0)
+        return;
+    // The window only has room for max_write frames, whether in the FIFO or scratch
+    if(fifo->window_dropped || (n_frames > fifo->max_write))
+    {
+        fifo->n_overflows++;
+        return;
+    }
+
+    uiPos = SRC_BLOCK_FIFO_POS(fifo, uiWrite);
+    if(uiPos + n_frames > fifo->n_frames)
+        memcpy(fifo->buff, fifo->buff + fifo->n_frames * fifo->n_channels,
+               (uiPos + n_frames - fifo->n_frames) * fifo->n_channels * sizeof(int));
+
+    SRC_BLOCK_FIFO_STORE_RELEASE(fifo->write_index, SRC_BLOCK_FIFO_ADVANCE(fifo, uiWrite, n_frames));
+}
+
+
+// ==================================================================== //
+// Function:        src_block_fifo_read                                 //
+// Arguments:       src_block_fifo_t *fifo: Ctrl strct.                 //
+//                  int frame[]: Frame read                             //
+// Return values:   1 when a frame was read, 0 when the FIFO was empty  //
+// Description:     Consumer side. Reads one frame, leaving frame[] as  //
+//                  it was on underflow                                 //
+// ==================================================================== //
+unsigned src_block_fifo_read(src_block_fifo_t *fifo, int frame[])
+{
+    unsigned int    uiRead = SRC_BLOCK_FIFO_LOAD_OWN(fifo->read_index);
+    unsigned int    uiWrite = SRC_BLOCK_FIFO_LOAD_ACQUIRE(fifo->write_index);
+    int*            piFrame;
+    unsigned int    ui;
+
+    if(uiWrite == uiRead)
+    {
+        fifo->n_underflows++;
+        return 0;
+    }
+
+    piFrame = fifo->buff + SRC_BLOCK_FIFO_POS(fifo, uiRead) * fifo->n_channels;
+    for(ui = 0; ui < fifo->n_channels; ui++)
+        frame[ui] = piFrame[ui];
+
+    SRC_BLOCK_FIFO_STORE_RELEASE(fifo->read_index, SRC_BLOCK_FIFO_ADVANCE(fifo, uiRead, 1));
+    return 1;
+}
+
+
+// ==================================================================== //
+// Function:        src_block_fifo_fill_level                           //
+// Arguments:       src_block_fifo_t *fifo: Ctrl strct.                 //
+// Return values:   Number of frames in the FIFO                        //
+// Description:     Either side                                         //
+// ==================================================================== //
+unsigned src_block_fifo_fill_level(src_block_fifo_t *fifo)
+{
+    unsigned int    uiRead = SRC_BLOCK_FIFO_LOAD_ACQUIRE(fifo->read_index);
+    unsigned int    uiWrite = SRC_BLOCK_FIFO_LOAD_ACQUIRE(fifo->write_index);
+
+    return SRC_BLOCK_FIFO_FILL(fifo, uiWrite, uiRead);
+}
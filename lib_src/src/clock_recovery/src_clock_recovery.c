@@ -0,0 +1,164 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Clock recovery (Fs ratio estimation) loop implementation file
+//
+// ===========================================================================
+// ===========================================================================
+
+
+// ===========================================================================
+//
+// Includes
+//
+// ===========================================================================
+#include <stdint.h>
+
+#include "src.h"
+
+
+// ===========================================================================
+//
+// Defines
+//
+// ===========================================================================
+
+// The loop follows the second order DLL of F. Adriaensen ("Using a DLL to filter time"). Each
+// update, with e the FIFO level error relative to the number of output samples of the period
+// (the relative rate error that would cancel it over one period) and w = 2 pi B T the loop
+// bandwidth B normalised to the update period T:
+//      offset = freq + b e     (relative offset of the Fs ratio from nominal)
+//      freq  += c e + g (m - freq)
+// with b = sqrt(2) w and c = w^2, a natural frequency of B and a damping factor of 0.707. The
+// FIFO level moves by whole ASRC output blocks, so on its own it needs a bandwidth too wide to
+// keep the Fs ratio clean. The g term, a frequency locked loop with g = SRC_CLOCK_RECOVERY_FLL_GAIN
+// x w, pulls freq towards the clock ratio m measured from the timestamped sample counts, exact
+// but for the timestamp jitter, leaving the level error to the narrow DLL.
+// All relative quantities are in Q32 format (1.0 = 2^32)
+#define     SRC_CLOCK_RECOVERY_TWO_PI_Q28       1686629713      // 2 pi
+#define     SRC_CLOCK_RECOVERY_SQRT2_Q30        1518500250      // sqrt(2)
+#define     SRC_CLOCK_RECOVERY_FLL_GAIN         8               // Frequency locked loop bandwidth over the DLL bandwidth
+#define     SRC_CLOCK_RECOVERY_MAX_BT_Q32       (1LL << 27)     // B T at most 1/32, keeps the loop stable and the products in 64 bits
+#define     SRC_CLOCK_RECOVERY_MAX_ERROR_Q32    (1LL << 32)     // Level errors beyond a period of samples are clipped
+
+
+// ===========================================================================
+//
+// Functions implementations
+//
+// ===========================================================================
+
+// ==================================================================== //
+// Function:        src_clock_recovery_clip                             //
+// Arguments:       int64_t i64: Value                                  //
+//                  int64_t i64Max: Largest magnitude                   //
+// Return values:   Value clipped to +/-i64Max                          //
+// Description:     Clips a Q32 value                                   //
+// ==================================================================== //
+static inline int64_t src_clock_recovery_clip(int64_t i64, int64_t i64Max)
+{
+    if(i64 > i64Max)
+        return i64Max;
+    if(i64 < -i64Max)
+        return -i64Max;
+    return i64;
+}
+
+
+// ==================================================================== //
+// Function:        src_clock_recovery_init                             //
+// Arguments:       src_clock_recovery_t *clock_recovery: Ctrl strct.   //
+//                  unsigned nominal_fs_ratio: Nominal Fs ratio         //
+//                  unsigned fs_ratio_frac_bits: Fs ratio format        //
+//                  unsigned target_level: FIFO level to settle at      //
+//                  unsigned bandwidth_mhz: Loop bandwidth (mHz)        //
+//                  unsigned ticks_per_second: Timestamp rate           //
+//                  unsigned max_deviation_ppm: Fs ratio range (ppm)    //
+// Return values:   None                                                //
+// Description:     Inits the loop at the nominal Fs ratio, the first   //
+//                  update seeds the frequency offset                   //
+// ==================================================================== //
+void src_clock_recovery_init(src_clock_recovery_t *clock_recovery, unsigned nominal_fs_ratio,
+                             unsigned fs_ratio_frac_bits, unsigned target_level,
+                             unsigned bandwidth_mhz, unsigned ticks_per_second,
+                             unsigned max_deviation_ppm)
+{
+    if(max_deviation_ppm > ASRC_FS_RATIO_RANGE_MAX)
+        max_deviation_ppm = ASRC_FS_RATIO_RANGE_MAX;
+
+    clock_recovery->nominal_fs_ratio    = nominal_fs_ratio;
+    clock_recovery->fs_ratio_frac_bits  = fs_ratio_frac_bits;
+    clock_recovery->target_level        = target_level;
+    clock_recovery->bandwidth_mhz       = bandwidth_mhz;
+    clock_recovery->ticks_per_second    = ticks_per_second;
+    clock_recovery->max_deviation       = ((int64_t)max_deviation_ppm << 32) / 1000000;
+    clock_recovery->freq                = 0;
+    clock_recovery->seeded              = 0;
+    clock_recovery->fs_ratio            = nominal_fs_ratio;
+}
+
+
+// ==================================================================== //
+// Function:        src_clock_recovery_update                           //
+// Arguments:       src_clock_recovery_t *clock_recovery: Ctrl strct.   //
+//                  unsigned n_in_samples: Input samples of the period  //
+//                  unsigned in_ticks: Input count duration             //
+//                  unsigned n_out_samples: Output samples of the period//
+//                  unsigned out_ticks: Output count duration           //
+//                  unsigned fifo_level: FIFO level (frames)            //
+// Return values:   Fs ratio (format of the nominal Fs ratio)           //
+// Description:     Runs the loop for one period. Periods without       //
+//                  samples keep the last Fs ratio                      //
+// ==================================================================== //
+unsigned src_clock_recovery_update(src_clock_recovery_t *clock_recovery,
+                                   unsigned n_in_samples, unsigned in_ticks,
+                                   unsigned n_out_samples, unsigned out_ticks,
+                                   unsigned fifo_level)
+{
+    int64_t     i64Measured, i64Error, i64BT, i64W, i64B, i64C, i64Offset;
+
+    if((n_in_samples == 0) || (in_ticks == 0) || (n_out_samples == 0) || (out_ticks == 0) || (clock_recovery->ticks_per_second == 0))
+        return clock_recovery->fs_ratio;
+
+    // Clock ratio over the period from the timestamped sample counts, relative to nominal
+    {
+        uint64_t    u64Num = (uint64_t)n_in_samples * out_ticks;
+        uint64_t    u64Den = (uint64_t)in_ticks * n_out_samples;
+        uint64_t    u64Measured;
+
+        while(u64Num >= (1ULL << 35))
+        {
+            u64Num >>= 1;
+            u64Den >>= 1;
+        }
+        u64Measured = u64Den ? (u64Num << clock_recovery->fs_ratio_frac_bits) / u64Den : clock_recovery->nominal_fs_ratio;
+        i64Measured = src_clock_recovery_clip((int64_t)u64Measured - (int64_t)clock_recovery->nominal_fs_ratio,
+                                              ((int64_t)clock_recovery->nominal_fs_ratio * clock_recovery->max_deviation) >> 32);
+        i64Measured = i64Measured * (1LL << 32) / clock_recovery->nominal_fs_ratio;
+    }
+    if(!clock_recovery->seeded)
+    {
+        clock_recovery->freq = i64Measured;
+        clock_recovery->seeded = 1;
+    }
+
+    // Level error relative to the period: more samples than the target need a larger Fs ratio
+    i64Error = ((int64_t)fifo_level - (int64_t)clock_recovery->target_level) * (1LL << 32) / n_out_samples;
+    i64Error = src_clock_recovery_clip(i64Error, SRC_CLOCK_RECOVERY_MAX_ERROR_Q32);
+
+    // Loop coefficients for the period T (B T computed from T in Q16 format)
+    i64BT = (((((int64_t)out_ticks << 16) / clock_recovery->ticks_per_second) * clock_recovery->bandwidth_mhz) << 16) / 1000;
+    if(i64BT > SRC_CLOCK_RECOVERY_MAX_BT_Q32)
+        i64BT = SRC_CLOCK_RECOVERY_MAX_BT_Q32;
+    i64W = (i64BT * SRC_CLOCK_RECOVERY_TWO_PI_Q28) >> 28;
+    i64B = (i64W * SRC_CLOCK_RECOVERY_SQRT2_Q30) >> 30;
+    i64C = (i64W * i64W) >> 32;
+
+    // Loop filters, the frequency offset is held within the Fs ratio range (anti-windup)
+    i64Offset = src_clock_recovery_clip(clock_recovery->freq + ((i64B * i64Error) >> 32), clock_recovery->max_deviation);
+    clock_recovery->freq = src_clock_recovery_clip(clock_recovery->freq + ((i64C * i64Error) >> 32) + ((i64W * SRC_CLOCK_RECOVERY_FLL_GAIN * (i64Measured - clock_recovery->freq)) >> 32), clock_recovery->max_deviation);
+
+    clock_recovery->fs_ratio = (unsigned)((int64_t)clock_recovery->nominal_fs_ratio + (((int64_t)clock_recovery->nominal_fs_ratio * i64Offset) >> 32));
+    return clock_recovery->fs_ratio;
+}
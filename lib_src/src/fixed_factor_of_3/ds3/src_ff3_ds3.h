@@ -7,6 +7,7 @@ extern "C" {
 #endif
 
 #define SRC_FF3_DS3_N_COEFS 144 // Number of coefficients must be a multiple of 6
+#define SRC_FF3_DS3_DELAY_LEN FIR_DELAY_LEN(SRC_FF3_DS3_N_COEFS) // Length of delay line buffer (see src_mrhf_fir.h)
 
 /* Filters with "_b_" in their filenames have higher attenuation at
  * Nyquist (> 60dB compared with 20dB ) but with an earlier cutoff.
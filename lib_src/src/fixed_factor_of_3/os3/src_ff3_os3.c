@@ -15,12 +15,13 @@
 // ===========================================================================
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
 
 #include "src.h"
 #include "src_ff3_os3.h"
-#include "src_ff3_fir_inner_loop_asm.h"
+#include "src_kernels.h"
 
 // ===========================================================================
 //
@@ -54,9 +55,12 @@ src_ff3_return_code_t src_os3_init(src_os3_ctrl_t* src_os3_ctrl)
         return SRC_FF3_ERROR;
     }
 
+    // Select inner loop kernels (first call only)
+    src_kernels_init();
+
     // Setup from FIROS2 descriptor
-    src_os3_ctrl->delay_len         = (SRC_FF3_OS3_N_COEFS/SRC_FF3_OS3_N_PHASES)<<1;                        // Double length for circular buffer simulation. x3 over-sampler, so only 1/3rd of coefs length needed
-    src_os3_ctrl->delay_wrap        = src_os3_ctrl->delay_base + (SRC_FF3_OS3_N_COEFS/SRC_FF3_OS3_N_PHASES);
+    src_os3_ctrl->delay_len         = SRC_FF3_OS3_DELAY_LEN;                                                // x3 over-sampler, so only 1/3rd of coefs length needed
+    src_os3_ctrl->delay_wrap        = FIR_DELAY_WRAP(src_os3_ctrl->delay_base, (SRC_FF3_OS3_N_COEFS/SRC_FF3_OS3_N_PHASES), 1);
     src_os3_ctrl->delay_offset      = (SRC_FF3_OS3_N_COEFS/SRC_FF3_OS3_N_PHASES);
     src_os3_ctrl->inner_loops       = ((SRC_FF3_OS3_N_COEFS/SRC_FF3_OS3_N_PHASES)>>1) / SRC_FF3_N_LOOPS_PER_ASM;    // Right shift due to 2 x 32bits read for coefs per inner loop and x3 over-sampler, so only 1/3rd of coefs length needed
     src_os3_ctrl->num_coeffs        = SRC_FF3_OS3_N_COEFS;
@@ -73,7 +77,7 @@ src_ff3_return_code_t src_os3_init(src_os3_ctrl_t* src_os3_ctrl)
 src_ff3_return_code_t src_os3_sync(src_os3_ctrl_t* src_os3_ctrl)
 {
     // Set delay line index back to base
-    src_os3_ctrl->delay_pos = src_os3_ctrl->delay_base;
+    src_os3_ctrl->delay_pos = FIR_DELAY_START(src_os3_ctrl->delay_base, src_os3_ctrl->delay_offset);
 
     // Clear delay line
     for (unsigned int ui = 0; ui < src_os3_ctrl->delay_len; ui++) {
@@ -89,15 +93,10 @@ src_ff3_return_code_t src_os3_sync(src_os3_ctrl_t* src_os3_ctrl)
 src_ff3_return_code_t src_os3_input(src_os3_ctrl_t* src_os3_ctrl)
 {
     // Write new input sample from control structure to delay line
-    // at both positions for circular buffer simulation
-    *src_os3_ctrl->delay_pos                                     = src_os3_ctrl->in_data;
-    *(src_os3_ctrl->delay_pos + src_os3_ctrl->delay_offset)      = src_os3_ctrl->in_data;
-
-    // Step delay index with circular buffer simulation
-    src_os3_ctrl->delay_pos                += 1;
-    if (src_os3_ctrl->delay_pos >= src_os3_ctrl->delay_wrap) {
-        src_os3_ctrl->delay_pos = src_os3_ctrl->delay_base;
-    }
+    FIR_DELAY_WRITE(src_os3_ctrl->delay_pos, src_os3_ctrl->delay_offset, 0, src_os3_ctrl->in_data);
+
+    // Step delay index
+    FIR_DELAY_STEP(src_os3_ctrl->delay_base, src_os3_ctrl->delay_pos, src_os3_ctrl->delay_wrap, src_os3_ctrl->delay_offset, 1);
 
     return SRC_FF3_NO_ERROR;
 }
@@ -110,15 +109,11 @@ src_ff3_return_code_t                src_os3_proc(src_os3_ctrl_t* src_os3_ctrl)
     __int64_t     accumulator;
 
     // Clear accumulator and set data/coefs access pointers
-    data            = src_os3_ctrl->delay_pos;
+    data            = FIR_DELAY_DATA(src_os3_ctrl->delay_pos, src_os3_ctrl->delay_offset);
     coeffs          = src_os3_ctrl->coeffs + src_os3_ctrl->phase;
     accumulator     = 0;
 
-    if ((unsigned)data & 0b0100) {
-        src_ff3_fir_inner_loop_asm_odd(data, coeffs, &data0, src_os3_ctrl->inner_loops);
-    } else {
-        src_ff3_fir_inner_loop_asm(data, coeffs, &data0, src_os3_ctrl->inner_loops);
-    }
+    SRC_FF3_FIR_INNER_LOOP(data, coeffs, &data0, src_os3_ctrl->inner_loops);
 
     // Write output
     src_os3_ctrl->out_data = data0;
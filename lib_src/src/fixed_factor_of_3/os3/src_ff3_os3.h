@@ -8,6 +8,7 @@ extern "C" {
 
 #define SRC_FF3_OS3_N_COEFS 144 // Number of coefficients must be a multiple of 6
 #define SRC_FF3_OS3_N_PHASES 3  // Number of output phases (3 as OS3 over-sample by 3)
+#define SRC_FF3_OS3_DELAY_LEN FIR_DELAY_LEN(SRC_FF3_OS3_N_COEFS/SRC_FF3_OS3_N_PHASES) // Length of delay line buffer (see src_mrhf_fir.h)
 
 /* Filters with "_b_" in their filenames have higher attenuation at
  * 8kHz (> 60dB compared with 20dB ) but with an earlier cutoff.
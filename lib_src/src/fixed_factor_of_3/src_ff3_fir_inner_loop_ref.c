@@ -0,0 +1,40 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Portable C reference implementation of the fixed factor of 3 inner loop
+//
+// Bit-exact equivalent of src_ff3_fir_inner_loop_asm.S, used when
+// building for a target other than xCORE.
+//
+// ===========================================================================
+// ===========================================================================
+
+#if !defined(__xcore__)
+
+#include "src_kernels.h"
+
+// Each assembler loop iteration processes 2 x SRC_FF3_N_LOOPS_PER_ASM taps
+void src_ff3_fir_inner_loop_c(int *piData, int *piCoefs, int iData[], int count)
+{
+    long long       acc;
+    unsigned int    i, num_taps;
+
+    num_taps    = (unsigned int)count * (SRC_FF3_N_LOOPS_PER_ASM << 1);
+
+    acc         = 0;
+    for (i = 0; i < num_taps; i++) {
+        acc += (long long)piData[i] * (long long)piCoefs[i];
+    }
+
+    // Saturate to 2^62-1 / -2^62 and extract bits [62-31]
+    if (acc > (long long)0x3FFFFFFFFFFFFFFFLL) {
+        acc = (long long)0x3FFFFFFFFFFFFFFFLL;
+    }
+    if (acc < -(long long)0x4000000000000000LL) {
+        acc = -(long long)0x4000000000000000LL;
+    }
+    iData[0] = (int)(acc >> 31);
+}
+
+#endif // !__xcore__
@@ -0,0 +1,198 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Run-time inner loop kernel selection for non xCORE targets
+//
+// ===========================================================================
+// ===========================================================================
+
+#if !defined(__xcore__)
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "src_kernels.h"
+
+// Portable C kernels
+static const src_kernels_t src_kernels_c = {
+    SRC_KERNELS_ISA_C,
+    src_mrhf_fir_inner_loop_c,
+    src_mrhf_fir_os_inner_loop_c,
+    src_mrhf_adfir_inner_loop_c,
+    src_mrhf_spline_coeff_gen_inner_loop_c,
+    src_ff3_fir_inner_loop_c,
+    src_mrhf_fir_mc_inner_loop_c,
+    src_mrhf_fir_os_mc_inner_loop_c,
+    src_mrhf_fir_float_inner_loop_c,
+    src_mrhf_fir_os_float_inner_loop_c,
+    src_mrhf_fir_fixed_c,
+    src_mrhf_fir_os_fixed_c,
+    src_mrhf_adfir_fixed_c
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SRC_KERNELS_X86     1
+
+static const src_kernels_t src_kernels_sse41 = {
+    SRC_KERNELS_ISA_SSE41,
+    src_mrhf_fir_inner_loop_sse41,
+    src_mrhf_fir_os_inner_loop_sse41,
+    src_mrhf_adfir_inner_loop_sse41,
+    src_mrhf_spline_coeff_gen_inner_loop_sse41,
+    src_ff3_fir_inner_loop_sse41,
+    src_mrhf_fir_mc_inner_loop_sse41,
+    src_mrhf_fir_os_mc_inner_loop_sse41,
+    src_mrhf_fir_float_inner_loop_sse41,
+    src_mrhf_fir_os_float_inner_loop_sse41,
+    src_mrhf_fir_fixed_sse41,
+    src_mrhf_fir_os_fixed_sse41,
+    src_mrhf_adfir_fixed_sse41
+};
+
+static const src_kernels_t src_kernels_avx2 = {
+    SRC_KERNELS_ISA_AVX2,
+    src_mrhf_fir_inner_loop_avx2,
+    src_mrhf_fir_os_inner_loop_avx2,
+    src_mrhf_adfir_inner_loop_avx2,
+    src_mrhf_spline_coeff_gen_inner_loop_avx2,
+    src_ff3_fir_inner_loop_avx2,
+    src_mrhf_fir_mc_inner_loop_avx2,
+    src_mrhf_fir_os_mc_inner_loop_avx2,
+    src_mrhf_fir_float_inner_loop_avx2,
+    src_mrhf_fir_os_float_inner_loop_avx2,
+    src_mrhf_fir_fixed_avx2,
+    src_mrhf_fir_os_fixed_avx2,
+    src_mrhf_adfir_fixed_avx2
+};
+
+static const src_kernels_t src_kernels_avx512 = {
+    SRC_KERNELS_ISA_AVX512,
+    src_mrhf_fir_inner_loop_avx512,
+    src_mrhf_fir_os_inner_loop_avx512,
+    src_mrhf_adfir_inner_loop_avx512,
+    src_mrhf_spline_coeff_gen_inner_loop_avx512,
+    src_ff3_fir_inner_loop_avx512,
+    src_mrhf_fir_mc_inner_loop_avx512,
+    src_mrhf_fir_os_mc_inner_loop_avx512,
+    src_mrhf_fir_float_inner_loop_avx2,
+    src_mrhf_fir_os_float_inner_loop_avx2,
+    src_mrhf_fir_fixed_avx512,
+    src_mrhf_fir_os_fixed_avx512,
+    src_mrhf_adfir_fixed_avx512
+};
+#endif
+
+src_kernels_t src_kernels = {
+    SRC_KERNELS_ISA_C,
+    src_mrhf_fir_inner_loop_c,
+    src_mrhf_fir_os_inner_loop_c,
+    src_mrhf_adfir_inner_loop_c,
+    src_mrhf_spline_coeff_gen_inner_loop_c,
+    src_ff3_fir_inner_loop_c,
+    src_mrhf_fir_mc_inner_loop_c,
+    src_mrhf_fir_os_mc_inner_loop_c,
+    src_mrhf_fir_float_inner_loop_c,
+    src_mrhf_fir_os_float_inner_loop_c,
+    src_mrhf_fir_fixed_c,
+    src_mrhf_fir_os_fixed_c,
+    src_mrhf_adfir_fixed_c
+};
+
+// Set once the kernels have been selected, by src_kernels_select() or the first src_kernels_init()
+static atomic_int src_kernels_initialised = 0;
+static pthread_once_t src_kernels_once = PTHREAD_ONCE_INIT;
+
+int src_kernels_isa_supported(src_kernels_isa_t isa)
+{
+    switch (isa) {
+    case SRC_KERNELS_ISA_C:
+        return 1;
+#if SRC_KERNELS_X86
+    case SRC_KERNELS_ISA_SSE41:
+        return __builtin_cpu_supports("sse4.1");
+    case SRC_KERNELS_ISA_AVX2:
+        // The AVX2 single precision kernels also use FMA
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case SRC_KERNELS_ISA_AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return 0;
+    }
+}
+
+const src_kernels_t* src_kernels_get(src_kernels_isa_t isa)
+{
+    switch (isa) {
+    case SRC_KERNELS_ISA_C:
+        return &src_kernels_c;
+#if SRC_KERNELS_X86
+    case SRC_KERNELS_ISA_SSE41:
+        return &src_kernels_sse41;
+    case SRC_KERNELS_ISA_AVX2:
+        return &src_kernels_avx2;
+    case SRC_KERNELS_ISA_AVX512:
+        return &src_kernels_avx512;
+#endif
+    default:
+        return 0;
+    }
+}
+
+src_kernel_fir_t src_kernels_get_fixed(const src_kernel_fixed_t* fixed, src_kernel_fir_t generic, int count)
+{
+    for (; fixed->count; fixed++) {
+        if (fixed->count == count) {
+            return fixed->kernel;
+        }
+    }
+    return generic;
+}
+
+src_kernels_isa_t src_kernels_select(src_kernels_isa_t max_isa)
+{
+    int isa;
+
+    for (isa = max_isa; isa > SRC_KERNELS_ISA_C; isa--) {
+        if (src_kernels_get(isa) && src_kernels_isa_supported(isa)) {
+            break;
+        }
+    }
+    src_kernels = *src_kernels_get(isa);
+    atomic_store_explicit(&src_kernels_initialised, 1, memory_order_release);
+
+    return src_kernels.isa;
+}
+
+// Runs once for all the threads calling src_kernels_init(), which all return after it completes
+static void src_kernels_init_once(void)
+{
+    static const char* isa_names[] = {"c", "sse41", "avx2", "avx512"};
+    src_kernels_isa_t max_isa = SRC_KERNELS_ISA_AVX512;
+    const char* env;
+
+    if (atomic_load_explicit(&src_kernels_initialised, memory_order_acquire)) {
+        return;
+    }
+
+    env = getenv("LIB_SRC_KERNELS");
+    if (env) {
+        for (unsigned i = 0; i < sizeof(isa_names) / sizeof(isa_names[0]); i++) {
+            if (strcmp(env, isa_names[i]) == 0) {
+                max_isa = i;
+            }
+        }
+    }
+
+    src_kernels_select(max_isa);
+}
+
+void src_kernels_init(void)
+{
+    pthread_once(&src_kernels_once, src_kernels_init_once);
+}
+
+#endif // !__xcore__
@@ -0,0 +1,277 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+#ifndef _SRC_KERNELS_H_
+#define _SRC_KERNELS_H_
+
+// Inner loop kernel selection for all SRC components.
+//
+// On xCORE the inner loops are the hand written assembler functions, chosen
+// per call on data alignment. On other targets a table of kernel function
+// pointers is selected once (at asrc_init(), ssrc_init(), src_ds3_init() or
+// src_os3_init()) from the instruction sets supported by the running CPU.
+// The SRC_*_INNER_LOOP macros below hide the difference from the callers.
+//
+// Where the alignment of the data is known for a whole block (FIR delay lines
+// of even length step it by one word per input sample), callers can test it
+// once with SRC_KERNELS_DATA_ODD() and use the _EVEN/_ODD macros, which call
+// the assembler variant directly on xCORE.
+//
+// Elsewhere the tables also have FIR, OS2 FIR and ADFIR inner loops fully
+// unrolled for the tap counts of the SRC filters (src_kernels_fixed.h), which
+// FIR_init_from_desc() and ADFIR_init_from_desc() select with the
+// SRC_*_KERNEL macros for the FIR_proc and ADFIR_proc functions to call.
+//
+// The multichannel (_MC) inner loops filter n_channels delay lines with the
+// same coefficients, loading each coefficient once for a group of channels.
+// There is no assembler version of these, so xCORE uses the C kernels.
+
+#include "src_mrhf_fir_inner_loop_asm.h"
+#include "src_mrhf_fir_os_inner_loop_asm.h"
+#include "src_mrhf_adfir_inner_loop_asm.h"
+#include "src_mrhf_spline_coeff_gen_inner_loop_asm.h"
+#include "src_ff3_fir_inner_loop_asm.h"
+
+// Portable C multichannel kernels (src_mrhf_fir_mc_inner_loops.c), all targets.
+// ppiData[] holds one data pointer per channel. The FIR kernel writes channel c
+// result to iData[c], the OS kernel writes the two phases to iData[2c], iData[2c+1].
+void src_mrhf_fir_mc_inner_loop_c(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels);
+void src_mrhf_fir_os_mc_inner_loop_c(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels);
+
+#if defined(__xcore__)
+
+#define SRC_MRHF_FIR_INNER_LOOP(piData, piCoefs, iData, count) \
+    do { \
+        if ((unsigned)(piData) & 0b0100) src_mrhf_fir_inner_loop_asm_odd(piData, piCoefs, iData, count); \
+        else                             src_mrhf_fir_inner_loop_asm(piData, piCoefs, iData, count); \
+    } while (0)
+
+#define SRC_MRHF_FIR_OS_INNER_LOOP(piData, piCoefs, iData, count) \
+    do { \
+        if ((unsigned)(piData) & 0b0100) src_mrhf_fir_os_inner_loop_asm_odd(piData, piCoefs, iData, count); \
+        else                             src_mrhf_fir_os_inner_loop_asm(piData, piCoefs, iData, count); \
+    } while (0)
+
+#define SRC_MRHF_ADFIR_INNER_LOOP(piData, piCoefs, iData, count) \
+    do { \
+        if ((unsigned)(piData) & 0b0100) src_mrhf_adfir_inner_loop_asm_odd(piData, piCoefs, iData, count); \
+        else                             src_mrhf_adfir_inner_loop_asm(piData, piCoefs, iData, count); \
+    } while (0)
+
+#define SRC_MRHF_SPLINE_COEFF_GEN_INNER_LOOP(piPhase0, iH, piADCoefs, n_taps) \
+    src_mrhf_spline_coeff_gen_inner_loop_asm(piPhase0, iH, piADCoefs, n_taps)
+
+#define SRC_FF3_FIR_INNER_LOOP(piData, piCoefs, iData, count) \
+    do { \
+        if ((unsigned)(piData) & 0b0100) src_ff3_fir_inner_loop_asm_odd(piData, piCoefs, iData, count); \
+        else                             src_ff3_fir_inner_loop_asm(piData, piCoefs, iData, count); \
+    } while (0)
+
+// Inner loops for data known to be 64 bit aligned (_EVEN) or not (_ODD)
+#define SRC_KERNELS_DATA_ODD(piData)    ((unsigned)(piData) & 0b0100)
+
+#define SRC_MRHF_FIR_INNER_LOOP_EVEN(piData, piCoefs, iData, count)     src_mrhf_fir_inner_loop_asm(piData, piCoefs, iData, count)
+#define SRC_MRHF_FIR_INNER_LOOP_ODD(piData, piCoefs, iData, count)      src_mrhf_fir_inner_loop_asm_odd(piData, piCoefs, iData, count)
+#define SRC_MRHF_FIR_OS_INNER_LOOP_EVEN(piData, piCoefs, iData, count)  src_mrhf_fir_os_inner_loop_asm(piData, piCoefs, iData, count)
+#define SRC_MRHF_FIR_OS_INNER_LOOP_ODD(piData, piCoefs, iData, count)   src_mrhf_fir_os_inner_loop_asm_odd(piData, piCoefs, iData, count)
+#define SRC_MRHF_ADFIR_INNER_LOOP_EVEN(piData, piCoefs, iData, count)   src_mrhf_adfir_inner_loop_asm(piData, piCoefs, iData, count)
+#define SRC_MRHF_ADFIR_INNER_LOOP_ODD(piData, piCoefs, iData, count)    src_mrhf_adfir_inner_loop_asm_odd(piData, piCoefs, iData, count)
+
+#define SRC_MRHF_FIR_MC_INNER_LOOP(ppiData, piCoefs, iData, count, n_channels) \
+    src_mrhf_fir_mc_inner_loop_c(ppiData, piCoefs, iData, count, n_channels)
+
+#define SRC_MRHF_FIR_OS_MC_INNER_LOOP(ppiData, piCoefs, iData, count, n_channels) \
+    src_mrhf_fir_os_mc_inner_loop_c(ppiData, piCoefs, iData, count, n_channels)
+
+// Whether fast convolution FIRs are faster than the inner loops (no fast convolution on xCORE)
+#define SRC_KERNELS_FAST_CONV()         0
+
+#define src_kernels_init()
+
+#else // __xcore__
+
+/** Instruction set of a kernel table, in order of preference */
+typedef enum src_kernels_isa_t
+{
+    SRC_KERNELS_ISA_C      = 0, //!< Portable C
+    SRC_KERNELS_ISA_SSE41  = 1, //!< x86 SSE4.1
+    SRC_KERNELS_ISA_AVX2   = 2, //!< x86 AVX2
+    SRC_KERNELS_ISA_AVX512 = 3  //!< x86 AVX-512F
+} src_kernels_isa_t;
+
+/** FIR style inner loop (same arguments as the assembler functions) */
+typedef void (*src_kernel_fir_t)(int *piData, int *piCoefs, int iData[], int count);
+
+/** Multichannel FIR style inner loop */
+typedef void (*src_kernel_fir_mc_t)(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels);
+
+/** Spline coefficient generation inner loop */
+typedef void (*src_kernel_spline_t)(const int *piPhase0, int *iH, int* piADCoefs, const int n_taps);
+
+/** Single precision FIR style inner loop (float SRC, n_taps a multiple of 8) */
+typedef void (*src_kernel_fir_float_t)(const float *pfData, const float *pfCoefs, float fData[], int n_taps);
+
+/** Inner loop fully unrolled for one count (see src_kernels_fixed.h) */
+typedef struct src_kernel_fixed_t
+{
+    int                 count;          //!< Inner loop count of the kernel (its count argument is ignored)
+    src_kernel_fir_t    kernel;         //!< Kernel
+} src_kernel_fixed_t;
+
+/** Table of inner loop kernels */
+typedef struct src_kernels_t
+{
+    src_kernels_isa_t   isa;            //!< Instruction set used by this table
+    src_kernel_fir_t    mrhf_fir;       //!< src_mrhf_fir_inner_loop_asm equivalent
+    src_kernel_fir_t    mrhf_fir_os;    //!< src_mrhf_fir_os_inner_loop_asm equivalent
+    src_kernel_fir_t    mrhf_adfir;     //!< src_mrhf_adfir_inner_loop_asm equivalent
+    src_kernel_spline_t mrhf_spline;    //!< src_mrhf_spline_coeff_gen_inner_loop_asm equivalent
+    src_kernel_fir_t    ff3_fir;        //!< src_ff3_fir_inner_loop_asm equivalent
+    src_kernel_fir_mc_t mrhf_fir_mc;    //!< Multichannel mrhf_fir
+    src_kernel_fir_mc_t mrhf_fir_os_mc; //!< Multichannel mrhf_fir_os
+    src_kernel_fir_float_t mrhf_fir_float;    //!< Single precision mrhf_fir
+    src_kernel_fir_float_t mrhf_fir_os_float; //!< Single precision mrhf_fir_os (coefficients of each phase contiguous)
+    const src_kernel_fixed_t* mrhf_fir_fixed;    //!< mrhf_fir for fixed counts, terminated by count 0
+    const src_kernel_fixed_t* mrhf_fir_os_fixed; //!< mrhf_fir_os for fixed counts, terminated by count 0
+    const src_kernel_fixed_t* mrhf_adfir_fixed;  //!< mrhf_adfir for fixed counts, terminated by count 0
+} src_kernels_t;
+
+/** Active kernel table. Initialised to the portable C kernels */
+extern src_kernels_t src_kernels;
+
+/** Selects the best kernels for the running CPU. Only the first call has any
+ *  effect, and none after src_kernels_select(). Thread safe: concurrent calls
+ *  all return once the selection is complete. The environment variable LIB_SRC_KERNELS (c, sse41, avx2 or avx512)
+ *  can be used to limit the instruction set used.
+ */
+void src_kernels_init(void);
+
+/** Selects the best kernels for the running CPU not exceeding max_isa.
+ *
+ *  \param      max_isa     Highest instruction set to use
+ *  \returns    The instruction set selected
+ */
+src_kernels_isa_t src_kernels_select(src_kernels_isa_t max_isa);
+
+/** Returns the kernel of a list of fixed count kernels for count, or generic
+ *  if the list has none for count
+ */
+src_kernel_fir_t src_kernels_get_fixed(const src_kernel_fixed_t* fixed, src_kernel_fir_t generic, int count);
+
+/** Returns whether the running CPU supports the given instruction set */
+int src_kernels_isa_supported(src_kernels_isa_t isa);
+
+/** Returns the kernel table for a given instruction set, or 0 if the
+ *  instruction set is not available in this build
+ */
+const src_kernels_t* src_kernels_get(src_kernels_isa_t isa);
+
+// Portable C kernels
+void src_mrhf_fir_inner_loop_c(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_fir_os_inner_loop_c(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_fir_os_sym_inner_loop_c(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_adfir_inner_loop_c(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_spline_coeff_gen_inner_loop_c(const int *piPhase0, int *iH, int* piADCoefs, const int n_taps);
+void src_ff3_fir_inner_loop_c(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_fir_float_inner_loop_c(const float *pfData, const float *pfCoefs, float fData[], int n_taps);
+void src_mrhf_fir_os_float_inner_loop_c(const float *pfData, const float *pfCoefs, float fData[], int n_taps);
+extern const src_kernel_fixed_t src_mrhf_fir_fixed_c[];
+extern const src_kernel_fixed_t src_mrhf_fir_os_fixed_c[];
+extern const src_kernel_fixed_t src_mrhf_adfir_fixed_c[];
+
+#if defined(__x86_64__) || defined(__i386__)
+// x86 SIMD kernels (src_kernels_x86.c)
+void src_mrhf_fir_inner_loop_sse41(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_fir_os_inner_loop_sse41(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_adfir_inner_loop_sse41(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_spline_coeff_gen_inner_loop_sse41(const int *piPhase0, int *iH, int* piADCoefs, const int n_taps);
+void src_ff3_fir_inner_loop_sse41(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_fir_mc_inner_loop_sse41(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels);
+void src_mrhf_fir_os_mc_inner_loop_sse41(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels);
+void src_mrhf_fir_float_inner_loop_sse41(const float *pfData, const float *pfCoefs, float fData[], int n_taps);
+void src_mrhf_fir_os_float_inner_loop_sse41(const float *pfData, const float *pfCoefs, float fData[], int n_taps);
+extern const src_kernel_fixed_t src_mrhf_fir_fixed_sse41[];
+extern const src_kernel_fixed_t src_mrhf_fir_os_fixed_sse41[];
+extern const src_kernel_fixed_t src_mrhf_adfir_fixed_sse41[];
+
+void src_mrhf_fir_inner_loop_avx2(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_fir_os_inner_loop_avx2(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_adfir_inner_loop_avx2(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_spline_coeff_gen_inner_loop_avx2(const int *piPhase0, int *iH, int* piADCoefs, const int n_taps);
+void src_ff3_fir_inner_loop_avx2(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_fir_mc_inner_loop_avx2(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels);
+void src_mrhf_fir_os_mc_inner_loop_avx2(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels);
+void src_mrhf_fir_float_inner_loop_avx2(const float *pfData, const float *pfCoefs, float fData[], int n_taps);
+void src_mrhf_fir_os_float_inner_loop_avx2(const float *pfData, const float *pfCoefs, float fData[], int n_taps);
+extern const src_kernel_fixed_t src_mrhf_fir_fixed_avx2[];
+extern const src_kernel_fixed_t src_mrhf_fir_os_fixed_avx2[];
+extern const src_kernel_fixed_t src_mrhf_adfir_fixed_avx2[];
+
+void src_mrhf_fir_inner_loop_avx512(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_fir_os_inner_loop_avx512(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_adfir_inner_loop_avx512(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_spline_coeff_gen_inner_loop_avx512(const int *piPhase0, int *iH, int* piADCoefs, const int n_taps);
+void src_ff3_fir_inner_loop_avx512(int *piData, int *piCoefs, int iData[], int count);
+void src_mrhf_fir_mc_inner_loop_avx512(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels);
+void src_mrhf_fir_os_mc_inner_loop_avx512(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels);
+extern const src_kernel_fixed_t src_mrhf_fir_fixed_avx512[];
+extern const src_kernel_fixed_t src_mrhf_fir_os_fixed_avx512[];
+extern const src_kernel_fixed_t src_mrhf_adfir_fixed_avx512[];
+#endif
+
+#define SRC_MRHF_FIR_INNER_LOOP(piData, piCoefs, iData, count) \
+    src_kernels.mrhf_fir(piData, piCoefs, iData, count)
+
+#define SRC_MRHF_FIR_OS_INNER_LOOP(piData, piCoefs, iData, count) \
+    src_kernels.mrhf_fir_os(piData, piCoefs, iData, count)
+
+#define SRC_MRHF_ADFIR_INNER_LOOP(piData, piCoefs, iData, count) \
+    src_kernels.mrhf_adfir(piData, piCoefs, iData, count)
+
+#define SRC_MRHF_SPLINE_COEFF_GEN_INNER_LOOP(piPhase0, iH, piADCoefs, n_taps) \
+    src_kernels.mrhf_spline(piPhase0, iH, piADCoefs, n_taps)
+
+#define SRC_FF3_FIR_INNER_LOOP(piData, piCoefs, iData, count) \
+    src_kernels.ff3_fir(piData, piCoefs, iData, count)
+
+#define SRC_MRHF_FIR_MC_INNER_LOOP(ppiData, piCoefs, iData, count, n_channels) \
+    src_kernels.mrhf_fir_mc(ppiData, piCoefs, iData, count, n_channels)
+
+#define SRC_MRHF_FIR_OS_MC_INNER_LOOP(ppiData, piCoefs, iData, count, n_channels) \
+    src_kernels.mrhf_fir_os_mc(ppiData, piCoefs, iData, count, n_channels)
+
+// Kernels for the FIR, OS2 FIR and ADFIR inner loops with count iterations, fully unrolled for the
+// counts of the SRC filters (selected at init and kept in the FIR / ADFIR ctrl)
+#define SRC_MRHF_FIR_KERNEL(count) \
+    src_kernels_get_fixed(src_kernels.mrhf_fir_fixed, src_kernels.mrhf_fir, count)
+
+#define SRC_MRHF_FIR_OS_KERNEL(count) \
+    src_kernels_get_fixed(src_kernels.mrhf_fir_os_fixed, src_kernels.mrhf_fir_os, count)
+
+#define SRC_MRHF_ADFIR_KERNEL(count) \
+    src_kernels_get_fixed(src_kernels.mrhf_adfir_fixed, src_kernels.mrhf_adfir, count)
+
+#define SRC_MRHF_FIR_FLOAT_INNER_LOOP(pfData, pfCoefs, fData, n_taps) \
+    src_kernels.mrhf_fir_float(pfData, pfCoefs, fData, n_taps)
+
+#define SRC_MRHF_FIR_OS_FLOAT_INNER_LOOP(pfData, pfCoefs, fData, n_taps) \
+    src_kernels.mrhf_fir_os_float(pfData, pfCoefs, fData, n_taps)
+
+// Whether symmetric OS2 FIRs use the folded inner loop src_mrhf_fir_os_sym_inner_loop_c (faster than the
+// C kernels, up to 27% at 160 coefficients, but not than the SIMD ones)
+#define SRC_KERNELS_FOLD_SYMMETRIC()    (src_kernels.isa == SRC_KERNELS_ISA_C)
+
+// Whether fast convolution FIRs are faster than the inner loops (the AVX2 and AVX-512 ones are faster)
+#define SRC_KERNELS_FAST_CONV()         (src_kernels.isa < SRC_KERNELS_ISA_AVX2)
+
+// Alignment does not matter to the kernels, so the _ODD versions are never used
+#define SRC_KERNELS_DATA_ODD(piData)    0
+
+#define SRC_MRHF_FIR_INNER_LOOP_EVEN        SRC_MRHF_FIR_INNER_LOOP
+#define SRC_MRHF_FIR_INNER_LOOP_ODD         SRC_MRHF_FIR_INNER_LOOP
+#define SRC_MRHF_FIR_OS_INNER_LOOP_EVEN     SRC_MRHF_FIR_OS_INNER_LOOP
+#define SRC_MRHF_FIR_OS_INNER_LOOP_ODD      SRC_MRHF_FIR_OS_INNER_LOOP
+#define SRC_MRHF_ADFIR_INNER_LOOP_EVEN      SRC_MRHF_ADFIR_INNER_LOOP
+#define SRC_MRHF_ADFIR_INNER_LOOP_ODD       SRC_MRHF_ADFIR_INNER_LOOP
+
+#endif // __xcore__
+
+#endif // _SRC_KERNELS_H_
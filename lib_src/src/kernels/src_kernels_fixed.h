@@ -0,0 +1,63 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+#ifndef _SRC_KERNELS_FIXED_H_
+#define _SRC_KERNELS_FIXED_H_
+
+// Fully unrolled inner loop kernels for the tap counts of the SRC filters.
+//
+// The filter lengths are constants (src_mrhf_filter_defs.h), so next to the
+// generic FIR, OS2 FIR and ADFIR inner loops each kernel table has versions
+// of them for the inner loop counts actually used, with no loop counter or
+// pointer increments. FIR_init_from_desc() and ADFIR_init_from_desc() pick
+// them with src_kernels_get_fixed(); other counts use the generic kernels.
+//
+// The kernel sources generate them from the lists below:
+//     SRC_KERNELS_FIXED_FIR_COUNTS(KERNEL, mrhf_fir, avx2)
+// expands KERNEL(mrhf_fir, avx2, count, blocks) for each count, blocks being
+// the number of 16 tap (16 coefficient for the OS2 FIR) blocks, and
+//     SRC_KERNELS_FIXED_TABLE(mrhf_fir, avx2, SRC_KERNELS_FIXED_FIR_COUNTS);
+// defines the src_mrhf_fir_fixed_avx2[] list of the kernels so named
+// (src_mrhf_fir_inner_loop_avx2_<count>).
+//
+// Non xCORE targets only: the xCORE assembler inner loops already process 16
+// taps per iteration with double word loads, leaving 3 instructions of loop
+// overhead for 32 loads and multiply-accumulates, and full unrolling would
+// cost up to 10 times their code size in the tile memory.
+
+// FIR (count = taps / 2): BL9644, BL5016 and BL4816 160, BL, BL8848, BL4416 and BL3716 144, BLF,
+// BL19288 and BL17696 96, DS 32 taps
+#define SRC_KERNELS_FIXED_FIR_COUNTS(X, kernel, isa) \
+    X(kernel, isa, 80, 10) X(kernel, isa, 72, 9) X(kernel, isa, 48, 6) X(kernel, isa, 16, 2)
+
+// OS2 FIR (count = coefficients / 4): UP4844, UP5032 and UP4832 160, UP, UP4432 and UP3732 144, UPF
+// and UP192176 96, OS 32 coefficients
+#define SRC_KERNELS_FIXED_FIR_OS_COUNTS(X, kernel, isa) \
+    X(kernel, isa, 40, 10) X(kernel, isa, 36, 9) X(kernel, isa, 24, 6) X(kernel, isa, 8, 2)
+
+// ADFIR (count = taps per phase / 2): 16 taps
+#define SRC_KERNELS_FIXED_ADFIR_COUNTS(X, kernel, isa) \
+    X(kernel, isa, 8, 1)
+
+// Name of the fixed kernel for count
+#define SRC_KERNELS_FIXED_NAME(kernel, isa, count)     src_##kernel##_inner_loop_##isa##_##count
+
+#define SRC_KERNELS_FIXED_ENTRY(kernel, isa, count, blocks) \
+    {count, SRC_KERNELS_FIXED_NAME(kernel, isa, count)},
+
+// Defines the list of fixed kernels src_<kernel>_fixed_<isa>[]
+#define SRC_KERNELS_FIXED_TABLE(kernel, isa, COUNTS) \
+    const src_kernel_fixed_t src_##kernel##_fixed_##isa[] = { COUNTS(SRC_KERNELS_FIXED_ENTRY, kernel, isa) {0, 0} }
+
+// Repeats M(0) to M(blocks - 1)
+#define SRC_KERNELS_REPEAT_1(M)     M(0)
+#define SRC_KERNELS_REPEAT_2(M)     SRC_KERNELS_REPEAT_1(M) M(1)
+#define SRC_KERNELS_REPEAT_3(M)     SRC_KERNELS_REPEAT_2(M) M(2)
+#define SRC_KERNELS_REPEAT_4(M)     SRC_KERNELS_REPEAT_3(M) M(3)
+#define SRC_KERNELS_REPEAT_5(M)     SRC_KERNELS_REPEAT_4(M) M(4)
+#define SRC_KERNELS_REPEAT_6(M)     SRC_KERNELS_REPEAT_5(M) M(5)
+#define SRC_KERNELS_REPEAT_7(M)     SRC_KERNELS_REPEAT_6(M) M(6)
+#define SRC_KERNELS_REPEAT_8(M)     SRC_KERNELS_REPEAT_7(M) M(7)
+#define SRC_KERNELS_REPEAT_9(M)     SRC_KERNELS_REPEAT_8(M) M(8)
+#define SRC_KERNELS_REPEAT_10(M)    SRC_KERNELS_REPEAT_9(M) M(9)
+#define SRC_KERNELS_REPEAT(blocks, M)   SRC_KERNELS_REPEAT_##blocks(M)
+
+#endif // _SRC_KERNELS_FIXED_H_
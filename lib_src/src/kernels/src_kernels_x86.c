@@ -0,0 +1,740 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// x86 SIMD inner loop kernels (SSE4.1, AVX2 and AVX-512F)
+//
+// All kernels are bit-exact with the xCORE assembler: the 32x32->64 products
+// are summed in 64-bit lanes (integer addition is order independent) and
+// the results saturated/extracted exactly as lsats/lextract. Each function
+// is compiled for its instruction set with a target attribute, so the file
+// needs no special compiler flags. Selection is done in src_kernels.c.
+// The multichannel (_mc) kernels keep one accumulator per channel for groups
+// of four channels (eight with AVX-512), so each coefficient vector is loaded
+// once per group. Remaining channels use the single channel dot product.
+// The single precision (_float) kernels are the portable C loops of
+// src_mrhf_fir_float_inner_loop.h vectorised by the compiler, with FMA for
+// AVX2. They are not bit-exact between instruction sets. 8 lanes are enough
+// for the filter lengths used, so the AVX-512 table uses the AVX2 ones.
+// Each instruction set also has the FIR, OS2 FIR and ADFIR kernels fully
+// unrolled for the filter tap counts (src_kernels_fixed.h).
+//
+// ===========================================================================
+// ===========================================================================
+
+#if !defined(__xcore__) && (defined(__x86_64__) || defined(__i386__))
+
+#include <immintrin.h>
+
+#include "src_mrhf_int_arithmetic.h"
+#include "src_kernels.h"
+#include "src_mrhf_fir_float_inner_loop.h"
+#include "src_kernels_fixed.h"
+
+#define SSE41       __attribute__((target("sse4.1")))
+#define AVX2        __attribute__((target("avx2")))
+#define AVX2_FMA    __attribute__((target("avx2,fma")))
+#define AVX512      __attribute__((target("avx512f")))
+
+// Saturate to 2^62-1 / -2^62 and extract bits [62-31]
+static inline int sat_ext30(__int64 i64Acc)
+{
+    LSAT30(&i64Acc);
+    return (int)(i64Acc >> 31);
+}
+
+// Saturate to 2^61-1 / -2^61 and extract bits [61-30]
+static inline int sat_ext29(__int64 i64Acc)
+{
+    LSAT29(&i64Acc);
+    return (int)(i64Acc >> 30);
+}
+
+// Output of the fixed count FIR and ADFIR kernels (see src_kernels_fixed.h)
+#define FIXED_SAT_mrhf_fir      sat_ext30
+#define FIXED_SAT_mrhf_adfir    sat_ext29
+#define FIXED_SAT(kernel)       FIXED_SAT_##kernel
+
+// ===========================================================================
+//
+// SSE4.1
+//
+// ===========================================================================
+
+// 64-bit dot product of n taps (n a multiple of 4)
+static inline SSE41 __int64 dot_sse41(const int *piData, const int *piCoefs, unsigned n)
+{
+    __m128i vAcc0 = _mm_setzero_si128();
+    __m128i vAcc1 = _mm_setzero_si128();
+    __m128i vData, vCoefs;
+    __int64 pi64Acc[2];
+
+    for (; n >= 4; n -= 4) {
+        vData   = _mm_loadu_si128((const __m128i*)piData);
+        vCoefs  = _mm_loadu_si128((const __m128i*)piCoefs);
+        vAcc0   = _mm_add_epi64(vAcc0, _mm_mul_epi32(vData, vCoefs));
+        vAcc1   = _mm_add_epi64(vAcc1, _mm_mul_epi32(_mm_srli_epi64(vData, 32), _mm_srli_epi64(vCoefs, 32)));
+        piData  += 4;
+        piCoefs += 4;
+    }
+    _mm_storeu_si128((__m128i*)pi64Acc, _mm_add_epi64(vAcc0, vAcc1));
+    return pi64Acc[0] + pi64Acc[1];
+}
+
+SSE41 void src_mrhf_fir_inner_loop_sse41(int *piData, int *piCoefs, int iData[], int count)
+{
+    iData[0] = sat_ext30(dot_sse41(piData, piCoefs, ((unsigned)count >> 3) << 4));
+}
+
+SSE41 void src_mrhf_adfir_inner_loop_sse41(int *piData, int *piCoefs, int iData[], int count)
+{
+    iData[0] = sat_ext29(dot_sse41(piData, piCoefs, ((unsigned)count >> 3) << 4));
+}
+
+SSE41 void src_ff3_fir_inner_loop_sse41(int *piData, int *piCoefs, int iData[], int count)
+{
+    iData[0] = sat_ext30(dot_sse41(piData, piCoefs, (unsigned)count * (SRC_FF3_N_LOOPS_PER_ASM << 1)));
+}
+
+SSE41 void src_mrhf_fir_os_inner_loop_sse41(int *piData, int *piCoefs, int iData[], int count)
+{
+    __m128i vAcc0 = _mm_setzero_si128();
+    __m128i vAcc1 = _mm_setzero_si128();
+    __m128i vData, vCoefs;
+    __int64 pi64Acc0[2], pi64Acc1[2];
+    unsigned n;
+
+    // Each data sample multiplies an even (phase 0) and an odd (phase 1) coefficient
+    for (n = ((unsigned)count >> 2) << 3; n > 0; n -= 2) {
+        vData   = _mm_cvtepi32_epi64(_mm_loadl_epi64((const __m128i*)piData));
+        vCoefs  = _mm_loadu_si128((const __m128i*)piCoefs);
+        vAcc0   = _mm_add_epi64(vAcc0, _mm_mul_epi32(vData, vCoefs));
+        vAcc1   = _mm_add_epi64(vAcc1, _mm_mul_epi32(vData, _mm_srli_epi64(vCoefs, 32)));
+        piData  += 2;
+        piCoefs += 4;
+    }
+    _mm_storeu_si128((__m128i*)pi64Acc0, vAcc0);
+    _mm_storeu_si128((__m128i*)pi64Acc1, vAcc1);
+    iData[0] = sat_ext30(pi64Acc0[0] + pi64Acc0[1]);
+    iData[1] = sat_ext30(pi64Acc1[0] + pi64Acc1[1]);
+}
+
+SSE41 void src_mrhf_spline_coeff_gen_inner_loop_sse41(const int *piPhase0, int *iH, int* piADCoefs, const int n_taps)
+{
+    const int *piPhase1 = piPhase0 + n_taps;
+    const int *piPhase2 = piPhase1 + n_taps;
+    __m128i vH0 = _mm_set1_epi32(iH[2]);
+    __m128i vH1 = _mm_set1_epi32(iH[1]);
+    __m128i vH2 = _mm_set1_epi32(iH[0]);
+    __m128i vP0, vP1, vP2, vEven, vOdd;
+    int ui;
+
+    for (ui = 0; ui < n_taps; ui += 4) {
+        vP0     = _mm_loadu_si128((const __m128i*)(piPhase0 + ui));
+        vP1     = _mm_loadu_si128((const __m128i*)(piPhase1 + ui));
+        vP2     = _mm_loadu_si128((const __m128i*)(piPhase2 + ui));
+        vEven   = _mm_add_epi64(_mm_add_epi64(_mm_mul_epi32(vH0, vP0), _mm_mul_epi32(vH1, vP1)), _mm_mul_epi32(vH2, vP2));
+        vP0     = _mm_srli_epi64(vP0, 32);
+        vP1     = _mm_srli_epi64(vP1, 32);
+        vP2     = _mm_srli_epi64(vP2, 32);
+        vOdd    = _mm_add_epi64(_mm_add_epi64(_mm_mul_epi32(vH0, vP0), _mm_mul_epi32(vH1, vP1)), _mm_mul_epi32(vH2, vP2));
+        // Keep upper 32 bits of each 64-bit result
+        _mm_storeu_si128((__m128i*)(piADCoefs + ui), _mm_blend_epi16(_mm_srli_epi64(vEven, 32), vOdd, 0xCC));
+    }
+}
+
+// Four channel dot products of n taps (n a multiple of 4), one coefficient load per four channels
+static inline SSE41 void dot_mc4_sse41(int *ppiData[], const int *piCoefs, unsigned n, __int64 pi64Acc[4])
+{
+    __m128i vAcc[4], vCoefs0, vCoefs1, vData;
+    __int64 pi64Lane[2];
+    unsigned ui;
+    int g;
+
+    for (g = 0; g < 4; g++) vAcc[g] = _mm_setzero_si128();
+    for (ui = 0; ui < n; ui += 4) {
+        vCoefs0 = _mm_loadu_si128((const __m128i*)(piCoefs + ui));
+        vCoefs1 = _mm_srli_epi64(vCoefs0, 32);
+        for (g = 0; g < 4; g++) {
+            vData   = _mm_loadu_si128((const __m128i*)(ppiData[g] + ui));
+            vAcc[g] = _mm_add_epi64(vAcc[g], _mm_add_epi64(_mm_mul_epi32(vData, vCoefs0), _mm_mul_epi32(_mm_srli_epi64(vData, 32), vCoefs1)));
+        }
+    }
+    for (g = 0; g < 4; g++) {
+        _mm_storeu_si128((__m128i*)pi64Lane, vAcc[g]);
+        pi64Acc[g] = pi64Lane[0] + pi64Lane[1];
+    }
+}
+
+SSE41 void src_mrhf_fir_mc_inner_loop_sse41(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels)
+{
+    unsigned n = ((unsigned)count >> 3) << 4;
+    __int64 pi64Acc[4];
+    int ch, g;
+
+    for (ch = 0; ch + 4 <= n_channels; ch += 4) {
+        dot_mc4_sse41(ppiData + ch, piCoefs, n, pi64Acc);
+        for (g = 0; g < 4; g++) iData[ch + g] = sat_ext30(pi64Acc[g]);
+    }
+    for (; ch < n_channels; ch++) {
+        iData[ch] = sat_ext30(dot_sse41(ppiData[ch], piCoefs, n));
+    }
+}
+
+SSE41 void src_mrhf_fir_os_mc_inner_loop_sse41(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels)
+{
+    __m128i vAcc0[4], vAcc1[4], vCoefs0, vCoefs1, vData;
+    __int64 pi64Lane0[2], pi64Lane1[2];
+    unsigned n = ((unsigned)count >> 2) << 3;
+    unsigned ui;
+    int ch, g;
+
+    for (ch = 0; ch + 4 <= n_channels; ch += 4) {
+        for (g = 0; g < 4; g++) {
+            vAcc0[g] = _mm_setzero_si128();
+            vAcc1[g] = _mm_setzero_si128();
+        }
+        for (ui = 0; ui < n; ui += 2) {
+            vCoefs0 = _mm_loadu_si128((const __m128i*)(piCoefs + 2 * ui));
+            vCoefs1 = _mm_srli_epi64(vCoefs0, 32);
+            for (g = 0; g < 4; g++) {
+                vData    = _mm_cvtepi32_epi64(_mm_loadl_epi64((const __m128i*)(ppiData[ch + g] + ui)));
+                vAcc0[g] = _mm_add_epi64(vAcc0[g], _mm_mul_epi32(vData, vCoefs0));
+                vAcc1[g] = _mm_add_epi64(vAcc1[g], _mm_mul_epi32(vData, vCoefs1));
+            }
+        }
+        for (g = 0; g < 4; g++) {
+            _mm_storeu_si128((__m128i*)pi64Lane0, vAcc0[g]);
+            _mm_storeu_si128((__m128i*)pi64Lane1, vAcc1[g]);
+            iData[2 * (ch + g)]     = sat_ext30(pi64Lane0[0] + pi64Lane0[1]);
+            iData[2 * (ch + g) + 1] = sat_ext30(pi64Lane1[0] + pi64Lane1[1]);
+        }
+    }
+    for (; ch < n_channels; ch++) {
+        src_mrhf_fir_os_inner_loop_sse41(ppiData[ch], piCoefs, &iData[2 * ch], count);
+    }
+}
+
+SSE41 void src_mrhf_fir_float_inner_loop_sse41(const float *pfData, const float *pfCoefs, float fData[], int n_taps)
+{
+    fData[0] = src_mrhf_fir_float_dot(pfData, pfCoefs, n_taps);
+}
+
+SSE41 void src_mrhf_fir_os_float_inner_loop_sse41(const float *pfData, const float *pfCoefs, float fData[], int n_taps)
+{
+    fData[0] = src_mrhf_fir_float_dot(pfData, pfCoefs, n_taps);
+    fData[1] = src_mrhf_fir_float_dot(pfData, pfCoefs + n_taps, n_taps);
+}
+
+// Fully unrolled kernels for the filter tap counts (see src_kernels_fixed.h)
+
+// Four taps from tap ui
+#define FIXED_DOT_SSE41_4(ui) \
+    vData   = _mm_loadu_si128((const __m128i*)(piData + (ui))); \
+    vCoefs  = _mm_loadu_si128((const __m128i*)(piCoefs + (ui))); \
+    vAcc0   = _mm_add_epi64(vAcc0, _mm_mul_epi32(vData, vCoefs)); \
+    vAcc1   = _mm_add_epi64(vAcc1, _mm_mul_epi32(_mm_srli_epi64(vData, 32), _mm_srli_epi64(vCoefs, 32)));
+
+#define FIXED_DOT_SSE41_16(b) \
+    FIXED_DOT_SSE41_4(16 * (b)) FIXED_DOT_SSE41_4(16 * (b) + 4) FIXED_DOT_SSE41_4(16 * (b) + 8) FIXED_DOT_SSE41_4(16 * (b) + 12)
+
+// Two data samples (four coefficients) of the OS2 FIR from data sample ui
+#define FIXED_OS_SSE41_2(ui) \
+    vData   = _mm_cvtepi32_epi64(_mm_loadl_epi64((const __m128i*)(piData + (ui)))); \
+    vCoefs  = _mm_loadu_si128((const __m128i*)(piCoefs + 2 * (ui))); \
+    vAcc0   = _mm_add_epi64(vAcc0, _mm_mul_epi32(vData, vCoefs)); \
+    vAcc1   = _mm_add_epi64(vAcc1, _mm_mul_epi32(vData, _mm_srli_epi64(vCoefs, 32)));
+
+#define FIXED_OS_SSE41_16(b) \
+    FIXED_OS_SSE41_2(8 * (b)) FIXED_OS_SSE41_2(8 * (b) + 2) FIXED_OS_SSE41_2(8 * (b) + 4) FIXED_OS_SSE41_2(8 * (b) + 6)
+
+#define FIXED_FIR_KERNEL_SSE41(kernel, isa, N, B) \
+    static SSE41 void SRC_KERNELS_FIXED_NAME(kernel, isa, N)(int *piData, int *piCoefs, int iData[], int count) \
+    { \
+        (void)count; /* N taps */ \
+        __m128i vAcc0 = _mm_setzero_si128(); \
+        __m128i vAcc1 = _mm_setzero_si128(); \
+        __m128i vData, vCoefs; \
+        __int64 pi64Acc[2]; \
+        SRC_KERNELS_REPEAT(B, FIXED_DOT_SSE41_16) \
+        _mm_storeu_si128((__m128i*)pi64Acc, _mm_add_epi64(vAcc0, vAcc1)); \
+        iData[0] = FIXED_SAT(kernel)(pi64Acc[0] + pi64Acc[1]); \
+    }
+
+#define FIXED_FIR_OS_KERNEL_SSE41(kernel, isa, N, B) \
+    static SSE41 void SRC_KERNELS_FIXED_NAME(kernel, isa, N)(int *piData, int *piCoefs, int iData[], int count) \
+    { \
+        (void)count; /* N taps */ \
+        __m128i vAcc0 = _mm_setzero_si128(); \
+        __m128i vAcc1 = _mm_setzero_si128(); \
+        __m128i vData, vCoefs; \
+        __int64 pi64Acc0[2], pi64Acc1[2]; \
+        SRC_KERNELS_REPEAT(B, FIXED_OS_SSE41_16) \
+        _mm_storeu_si128((__m128i*)pi64Acc0, vAcc0); \
+        _mm_storeu_si128((__m128i*)pi64Acc1, vAcc1); \
+        iData[0] = sat_ext30(pi64Acc0[0] + pi64Acc0[1]); \
+        iData[1] = sat_ext30(pi64Acc1[0] + pi64Acc1[1]); \
+    }
+
+SRC_KERNELS_FIXED_FIR_COUNTS(FIXED_FIR_KERNEL_SSE41, mrhf_fir, sse41)
+SRC_KERNELS_FIXED_FIR_OS_COUNTS(FIXED_FIR_OS_KERNEL_SSE41, mrhf_fir_os, sse41)
+SRC_KERNELS_FIXED_ADFIR_COUNTS(FIXED_FIR_KERNEL_SSE41, mrhf_adfir, sse41)
+
+SRC_KERNELS_FIXED_TABLE(mrhf_fir, sse41, SRC_KERNELS_FIXED_FIR_COUNTS);
+SRC_KERNELS_FIXED_TABLE(mrhf_fir_os, sse41, SRC_KERNELS_FIXED_FIR_OS_COUNTS);
+SRC_KERNELS_FIXED_TABLE(mrhf_adfir, sse41, SRC_KERNELS_FIXED_ADFIR_COUNTS);
+
+// ===========================================================================
+//
+// AVX2
+//
+// ===========================================================================
+
+// 64-bit dot product of n taps (n a multiple of 8), four accumulators
+static inline AVX2 __int64 dot_avx2(const int *piData, const int *piCoefs, unsigned n)
+{
+    __m256i vAcc0 = _mm256_setzero_si256();
+    __m256i vAcc1 = _mm256_setzero_si256();
+    __m256i vAcc2 = _mm256_setzero_si256();
+    __m256i vAcc3 = _mm256_setzero_si256();
+    __m256i vData0, vData1, vCoefs0, vCoefs1;
+    __int64 pi64Acc[4];
+
+    for (; n >= 16; n -= 16) {
+        vData0  = _mm256_loadu_si256((const __m256i*)piData);
+        vCoefs0 = _mm256_loadu_si256((const __m256i*)piCoefs);
+        vData1  = _mm256_loadu_si256((const __m256i*)(piData + 8));
+        vCoefs1 = _mm256_loadu_si256((const __m256i*)(piCoefs + 8));
+
+        // Even taps use the low half of each 64-bit lane, odd taps the high half
+        vAcc0   = _mm256_add_epi64(vAcc0, _mm256_mul_epi32(vData0, vCoefs0));
+        vAcc1   = _mm256_add_epi64(vAcc1, _mm256_mul_epi32(_mm256_srli_epi64(vData0, 32), _mm256_srli_epi64(vCoefs0, 32)));
+        vAcc2   = _mm256_add_epi64(vAcc2, _mm256_mul_epi32(vData1, vCoefs1));
+        vAcc3   = _mm256_add_epi64(vAcc3, _mm256_mul_epi32(_mm256_srli_epi64(vData1, 32), _mm256_srli_epi64(vCoefs1, 32)));
+
+        piData  += 16;
+        piCoefs += 16;
+    }
+    if (n) {
+        vData0  = _mm256_loadu_si256((const __m256i*)piData);
+        vCoefs0 = _mm256_loadu_si256((const __m256i*)piCoefs);
+        vAcc0   = _mm256_add_epi64(vAcc0, _mm256_mul_epi32(vData0, vCoefs0));
+        vAcc1   = _mm256_add_epi64(vAcc1, _mm256_mul_epi32(_mm256_srli_epi64(vData0, 32), _mm256_srli_epi64(vCoefs0, 32)));
+    }
+
+    vAcc0 = _mm256_add_epi64(_mm256_add_epi64(vAcc0, vAcc1), _mm256_add_epi64(vAcc2, vAcc3));
+    _mm256_storeu_si256((__m256i*)pi64Acc, vAcc0);
+    return pi64Acc[0] + pi64Acc[1] + pi64Acc[2] + pi64Acc[3];
+}
+
+AVX2 void src_mrhf_fir_inner_loop_avx2(int *piData, int *piCoefs, int iData[], int count)
+{
+    iData[0] = sat_ext30(dot_avx2(piData, piCoefs, ((unsigned)count >> 3) << 4));
+}
+
+AVX2 void src_mrhf_adfir_inner_loop_avx2(int *piData, int *piCoefs, int iData[], int count)
+{
+    iData[0] = sat_ext29(dot_avx2(piData, piCoefs, ((unsigned)count >> 3) << 4));
+}
+
+AVX2 void src_ff3_fir_inner_loop_avx2(int *piData, int *piCoefs, int iData[], int count)
+{
+    iData[0] = sat_ext30(dot_avx2(piData, piCoefs, (unsigned)count * (SRC_FF3_N_LOOPS_PER_ASM << 1)));
+}
+
+AVX2 void src_mrhf_fir_os_inner_loop_avx2(int *piData, int *piCoefs, int iData[], int count)
+{
+    __m256i vAcc0 = _mm256_setzero_si256();
+    __m256i vAcc1 = _mm256_setzero_si256();
+    __m256i vData, vCoefs;
+    __int64 pi64Acc0[4], pi64Acc1[4];
+    unsigned n;
+
+    // Each data sample multiplies an even (phase 0) and an odd (phase 1) coefficient
+    for (n = ((unsigned)count >> 2) << 3; n > 0; n -= 4) {
+        vData   = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)piData));
+        vCoefs  = _mm256_loadu_si256((const __m256i*)piCoefs);
+        vAcc0   = _mm256_add_epi64(vAcc0, _mm256_mul_epi32(vData, vCoefs));
+        vAcc1   = _mm256_add_epi64(vAcc1, _mm256_mul_epi32(vData, _mm256_srli_epi64(vCoefs, 32)));
+        piData  += 4;
+        piCoefs += 8;
+    }
+    _mm256_storeu_si256((__m256i*)pi64Acc0, vAcc0);
+    _mm256_storeu_si256((__m256i*)pi64Acc1, vAcc1);
+    iData[0] = sat_ext30(pi64Acc0[0] + pi64Acc0[1] + pi64Acc0[2] + pi64Acc0[3]);
+    iData[1] = sat_ext30(pi64Acc1[0] + pi64Acc1[1] + pi64Acc1[2] + pi64Acc1[3]);
+}
+
+AVX2 void src_mrhf_spline_coeff_gen_inner_loop_avx2(const int *piPhase0, int *iH, int* piADCoefs, const int n_taps)
+{
+    const int *piPhase1 = piPhase0 + n_taps;
+    const int *piPhase2 = piPhase1 + n_taps;
+    __m256i vH0 = _mm256_set1_epi32(iH[2]);
+    __m256i vH1 = _mm256_set1_epi32(iH[1]);
+    __m256i vH2 = _mm256_set1_epi32(iH[0]);
+    __m256i vP0, vP1, vP2, vEven, vOdd;
+    int ui;
+
+    for (ui = 0; ui < n_taps; ui += 8) {
+        vP0     = _mm256_loadu_si256((const __m256i*)(piPhase0 + ui));
+        vP1     = _mm256_loadu_si256((const __m256i*)(piPhase1 + ui));
+        vP2     = _mm256_loadu_si256((const __m256i*)(piPhase2 + ui));
+        vEven   = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epi32(vH0, vP0), _mm256_mul_epi32(vH1, vP1)), _mm256_mul_epi32(vH2, vP2));
+        vP0     = _mm256_srli_epi64(vP0, 32);
+        vP1     = _mm256_srli_epi64(vP1, 32);
+        vP2     = _mm256_srli_epi64(vP2, 32);
+        vOdd    = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epi32(vH0, vP0), _mm256_mul_epi32(vH1, vP1)), _mm256_mul_epi32(vH2, vP2));
+        // Keep upper 32 bits of each 64-bit result
+        _mm256_storeu_si256((__m256i*)(piADCoefs + ui), _mm256_blend_epi32(_mm256_srli_epi64(vEven, 32), vOdd, 0xAA));
+    }
+}
+
+// Four channel dot products of n taps (n a multiple of 8), one coefficient load per four channels
+static inline AVX2 void dot_mc4_avx2(int *ppiData[], const int *piCoefs, unsigned n, __int64 pi64Acc[4])
+{
+    __m256i vAcc[4], vCoefs0, vCoefs1, vData;
+    __int64 pi64Lane[4];
+    unsigned ui;
+    int g;
+
+    for (g = 0; g < 4; g++) vAcc[g] = _mm256_setzero_si256();
+    for (ui = 0; ui < n; ui += 8) {
+        vCoefs0 = _mm256_loadu_si256((const __m256i*)(piCoefs + ui));
+        vCoefs1 = _mm256_srli_epi64(vCoefs0, 32);
+        for (g = 0; g < 4; g++) {
+            vData   = _mm256_loadu_si256((const __m256i*)(ppiData[g] + ui));
+            vAcc[g] = _mm256_add_epi64(vAcc[g], _mm256_add_epi64(_mm256_mul_epi32(vData, vCoefs0), _mm256_mul_epi32(_mm256_srli_epi64(vData, 32), vCoefs1)));
+        }
+    }
+    for (g = 0; g < 4; g++) {
+        _mm256_storeu_si256((__m256i*)pi64Lane, vAcc[g]);
+        pi64Acc[g] = pi64Lane[0] + pi64Lane[1] + pi64Lane[2] + pi64Lane[3];
+    }
+}
+
+AVX2 void src_mrhf_fir_mc_inner_loop_avx2(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels)
+{
+    unsigned n = ((unsigned)count >> 3) << 4;
+    __int64 pi64Acc[4];
+    int ch, g;
+
+    for (ch = 0; ch + 4 <= n_channels; ch += 4) {
+        dot_mc4_avx2(ppiData + ch, piCoefs, n, pi64Acc);
+        for (g = 0; g < 4; g++) iData[ch + g] = sat_ext30(pi64Acc[g]);
+    }
+    for (; ch < n_channels; ch++) {
+        iData[ch] = sat_ext30(dot_avx2(ppiData[ch], piCoefs, n));
+    }
+}
+
+AVX2 void src_mrhf_fir_os_mc_inner_loop_avx2(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels)
+{
+    __m256i vAcc0[4], vAcc1[4], vCoefs0, vCoefs1, vData;
+    __int64 pi64Lane0[4], pi64Lane1[4];
+    unsigned n = ((unsigned)count >> 2) << 3;
+    unsigned ui;
+    int ch, g;
+
+    for (ch = 0; ch + 4 <= n_channels; ch += 4) {
+        for (g = 0; g < 4; g++) {
+            vAcc0[g] = _mm256_setzero_si256();
+            vAcc1[g] = _mm256_setzero_si256();
+        }
+        for (ui = 0; ui < n; ui += 4) {
+            vCoefs0 = _mm256_loadu_si256((const __m256i*)(piCoefs + 2 * ui));
+            vCoefs1 = _mm256_srli_epi64(vCoefs0, 32);
+            for (g = 0; g < 4; g++) {
+                vData    = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(ppiData[ch + g] + ui)));
+                vAcc0[g] = _mm256_add_epi64(vAcc0[g], _mm256_mul_epi32(vData, vCoefs0));
+                vAcc1[g] = _mm256_add_epi64(vAcc1[g], _mm256_mul_epi32(vData, vCoefs1));
+            }
+        }
+        for (g = 0; g < 4; g++) {
+            _mm256_storeu_si256((__m256i*)pi64Lane0, vAcc0[g]);
+            _mm256_storeu_si256((__m256i*)pi64Lane1, vAcc1[g]);
+            iData[2 * (ch + g)]     = sat_ext30(pi64Lane0[0] + pi64Lane0[1] + pi64Lane0[2] + pi64Lane0[3]);
+            iData[2 * (ch + g) + 1] = sat_ext30(pi64Lane1[0] + pi64Lane1[1] + pi64Lane1[2] + pi64Lane1[3]);
+        }
+    }
+    for (; ch < n_channels; ch++) {
+        src_mrhf_fir_os_inner_loop_avx2(ppiData[ch], piCoefs, &iData[2 * ch], count);
+    }
+}
+
+AVX2_FMA void src_mrhf_fir_float_inner_loop_avx2(const float *pfData, const float *pfCoefs, float fData[], int n_taps)
+{
+    fData[0] = src_mrhf_fir_float_dot(pfData, pfCoefs, n_taps);
+}
+
+AVX2_FMA void src_mrhf_fir_os_float_inner_loop_avx2(const float *pfData, const float *pfCoefs, float fData[], int n_taps)
+{
+    fData[0] = src_mrhf_fir_float_dot(pfData, pfCoefs, n_taps);
+    fData[1] = src_mrhf_fir_float_dot(pfData, pfCoefs + n_taps, n_taps);
+}
+
+// Fully unrolled kernels for the filter tap counts (see src_kernels_fixed.h)
+
+// Block b of 16 taps
+#define FIXED_DOT_AVX2_16(b) \
+    vData0  = _mm256_loadu_si256((const __m256i*)(piData + 16 * (b))); \
+    vCoefs0 = _mm256_loadu_si256((const __m256i*)(piCoefs + 16 * (b))); \
+    vData1  = _mm256_loadu_si256((const __m256i*)(piData + 16 * (b) + 8)); \
+    vCoefs1 = _mm256_loadu_si256((const __m256i*)(piCoefs + 16 * (b) + 8)); \
+    vAcc0   = _mm256_add_epi64(vAcc0, _mm256_mul_epi32(vData0, vCoefs0)); \
+    vAcc1   = _mm256_add_epi64(vAcc1, _mm256_mul_epi32(_mm256_srli_epi64(vData0, 32), _mm256_srli_epi64(vCoefs0, 32))); \
+    vAcc2   = _mm256_add_epi64(vAcc2, _mm256_mul_epi32(vData1, vCoefs1)); \
+    vAcc3   = _mm256_add_epi64(vAcc3, _mm256_mul_epi32(_mm256_srli_epi64(vData1, 32), _mm256_srli_epi64(vCoefs1, 32)));
+
+// Four data samples (eight coefficients) of the OS2 FIR from data sample ui
+#define FIXED_OS_AVX2_4(ui) \
+    vData   = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(piData + (ui)))); \
+    vCoefs  = _mm256_loadu_si256((const __m256i*)(piCoefs + 2 * (ui))); \
+    vAcc0   = _mm256_add_epi64(vAcc0, _mm256_mul_epi32(vData, vCoefs)); \
+    vAcc1   = _mm256_add_epi64(vAcc1, _mm256_mul_epi32(vData, _mm256_srli_epi64(vCoefs, 32)));
+
+#define FIXED_OS_AVX2_16(b) \
+    FIXED_OS_AVX2_4(8 * (b)) FIXED_OS_AVX2_4(8 * (b) + 4)
+
+#define FIXED_FIR_KERNEL_AVX2(kernel, isa, N, B) \
+    static AVX2 void SRC_KERNELS_FIXED_NAME(kernel, isa, N)(int *piData, int *piCoefs, int iData[], int count) \
+    { \
+        (void)count; /* N taps */ \
+        __m256i vAcc0 = _mm256_setzero_si256(); \
+        __m256i vAcc1 = _mm256_setzero_si256(); \
+        __m256i vAcc2 = _mm256_setzero_si256(); \
+        __m256i vAcc3 = _mm256_setzero_si256(); \
+        __m256i vData0, vData1, vCoefs0, vCoefs1; \
+        __int64 pi64Acc[4]; \
+        SRC_KERNELS_REPEAT(B, FIXED_DOT_AVX2_16) \
+        vAcc0 = _mm256_add_epi64(_mm256_add_epi64(vAcc0, vAcc1), _mm256_add_epi64(vAcc2, vAcc3)); \
+        _mm256_storeu_si256((__m256i*)pi64Acc, vAcc0); \
+        iData[0] = FIXED_SAT(kernel)(pi64Acc[0] + pi64Acc[1] + pi64Acc[2] + pi64Acc[3]); \
+    }
+
+#define FIXED_FIR_OS_KERNEL_AVX2(kernel, isa, N, B) \
+    static AVX2 void SRC_KERNELS_FIXED_NAME(kernel, isa, N)(int *piData, int *piCoefs, int iData[], int count) \
+    { \
+        (void)count; /* N taps */ \
+        __m256i vAcc0 = _mm256_setzero_si256(); \
+        __m256i vAcc1 = _mm256_setzero_si256(); \
+        __m256i vData, vCoefs; \
+        __int64 pi64Acc0[4], pi64Acc1[4]; \
+        SRC_KERNELS_REPEAT(B, FIXED_OS_AVX2_16) \
+        _mm256_storeu_si256((__m256i*)pi64Acc0, vAcc0); \
+        _mm256_storeu_si256((__m256i*)pi64Acc1, vAcc1); \
+        iData[0] = sat_ext30(pi64Acc0[0] + pi64Acc0[1] + pi64Acc0[2] + pi64Acc0[3]); \
+        iData[1] = sat_ext30(pi64Acc1[0] + pi64Acc1[1] + pi64Acc1[2] + pi64Acc1[3]); \
+    }
+
+SRC_KERNELS_FIXED_FIR_COUNTS(FIXED_FIR_KERNEL_AVX2, mrhf_fir, avx2)
+SRC_KERNELS_FIXED_FIR_OS_COUNTS(FIXED_FIR_OS_KERNEL_AVX2, mrhf_fir_os, avx2)
+SRC_KERNELS_FIXED_ADFIR_COUNTS(FIXED_FIR_KERNEL_AVX2, mrhf_adfir, avx2)
+
+SRC_KERNELS_FIXED_TABLE(mrhf_fir, avx2, SRC_KERNELS_FIXED_FIR_COUNTS);
+SRC_KERNELS_FIXED_TABLE(mrhf_fir_os, avx2, SRC_KERNELS_FIXED_FIR_OS_COUNTS);
+SRC_KERNELS_FIXED_TABLE(mrhf_adfir, avx2, SRC_KERNELS_FIXED_ADFIR_COUNTS);
+
+// ===========================================================================
+//
+// AVX-512F
+//
+// ===========================================================================
+
+// 64-bit dot product of n taps (n a multiple of 8), two accumulators
+static inline AVX512 __int64 dot_avx512(const int *piData, const int *piCoefs, unsigned n)
+{
+    __m512i vAcc0 = _mm512_setzero_si512();
+    __m512i vAcc1 = _mm512_setzero_si512();
+    __m512i vData, vCoefs;
+    __mmask16 kMask;
+
+    for (; n >= 16; n -= 16) {
+        vData   = _mm512_loadu_si512((const void*)piData);
+        vCoefs  = _mm512_loadu_si512((const void*)piCoefs);
+        vAcc0   = _mm512_add_epi64(vAcc0, _mm512_mul_epi32(vData, vCoefs));
+        vAcc1   = _mm512_add_epi64(vAcc1, _mm512_mul_epi32(_mm512_srli_epi64(vData, 32), _mm512_srli_epi64(vCoefs, 32)));
+        piData  += 16;
+        piCoefs += 16;
+    }
+    if (n) {
+        kMask   = (__mmask16)((1u << n) - 1);
+        vData   = _mm512_maskz_loadu_epi32(kMask, (const void*)piData);
+        vCoefs  = _mm512_maskz_loadu_epi32(kMask, (const void*)piCoefs);
+        vAcc0   = _mm512_add_epi64(vAcc0, _mm512_mul_epi32(vData, vCoefs));
+        vAcc1   = _mm512_add_epi64(vAcc1, _mm512_mul_epi32(_mm512_srli_epi64(vData, 32), _mm512_srli_epi64(vCoefs, 32)));
+    }
+    return _mm512_reduce_add_epi64(_mm512_add_epi64(vAcc0, vAcc1));
+}
+
+AVX512 void src_mrhf_fir_inner_loop_avx512(int *piData, int *piCoefs, int iData[], int count)
+{
+    iData[0] = sat_ext30(dot_avx512(piData, piCoefs, ((unsigned)count >> 3) << 4));
+}
+
+AVX512 void src_mrhf_adfir_inner_loop_avx512(int *piData, int *piCoefs, int iData[], int count)
+{
+    iData[0] = sat_ext29(dot_avx512(piData, piCoefs, ((unsigned)count >> 3) << 4));
+}
+
+AVX512 void src_ff3_fir_inner_loop_avx512(int *piData, int *piCoefs, int iData[], int count)
+{
+    iData[0] = sat_ext30(dot_avx512(piData, piCoefs, (unsigned)count * (SRC_FF3_N_LOOPS_PER_ASM << 1)));
+}
+
+AVX512 void src_mrhf_fir_os_inner_loop_avx512(int *piData, int *piCoefs, int iData[], int count)
+{
+    __m512i vAcc0 = _mm512_setzero_si512();
+    __m512i vAcc1 = _mm512_setzero_si512();
+    __m512i vData, vCoefs;
+    unsigned n;
+
+    // Each data sample multiplies an even (phase 0) and an odd (phase 1) coefficient
+    for (n = ((unsigned)count >> 2) << 3; n > 0; n -= 8) {
+        vData   = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*)piData));
+        vCoefs  = _mm512_loadu_si512((const void*)piCoefs);
+        vAcc0   = _mm512_add_epi64(vAcc0, _mm512_mul_epi32(vData, vCoefs));
+        vAcc1   = _mm512_add_epi64(vAcc1, _mm512_mul_epi32(vData, _mm512_srli_epi64(vCoefs, 32)));
+        piData  += 8;
+        piCoefs += 16;
+    }
+    iData[0] = sat_ext30(_mm512_reduce_add_epi64(vAcc0));
+    iData[1] = sat_ext30(_mm512_reduce_add_epi64(vAcc1));
+}
+
+AVX512 void src_mrhf_spline_coeff_gen_inner_loop_avx512(const int *piPhase0, int *iH, int* piADCoefs, const int n_taps)
+{
+    const int *piPhase1 = piPhase0 + n_taps;
+    const int *piPhase2 = piPhase1 + n_taps;
+    __m512i vH0 = _mm512_set1_epi32(iH[2]);
+    __m512i vH1 = _mm512_set1_epi32(iH[1]);
+    __m512i vH2 = _mm512_set1_epi32(iH[0]);
+    __m512i vP0, vP1, vP2, vEven, vOdd;
+    int ui;
+
+    for (ui = 0; ui < n_taps; ui += 16) {
+        vP0     = _mm512_loadu_si512((const void*)(piPhase0 + ui));
+        vP1     = _mm512_loadu_si512((const void*)(piPhase1 + ui));
+        vP2     = _mm512_loadu_si512((const void*)(piPhase2 + ui));
+        vEven   = _mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epi32(vH0, vP0), _mm512_mul_epi32(vH1, vP1)), _mm512_mul_epi32(vH2, vP2));
+        vP0     = _mm512_srli_epi64(vP0, 32);
+        vP1     = _mm512_srli_epi64(vP1, 32);
+        vP2     = _mm512_srli_epi64(vP2, 32);
+        vOdd    = _mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epi32(vH0, vP0), _mm512_mul_epi32(vH1, vP1)), _mm512_mul_epi32(vH2, vP2));
+        // Keep upper 32 bits of each 64-bit result
+        _mm512_storeu_si512((void*)(piADCoefs + ui), _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(vEven, 32), vOdd));
+    }
+}
+
+// Eight channel dot products of n taps (n a multiple of 16), one coefficient load per eight channels
+static inline AVX512 void dot_mc8_avx512(int *ppiData[], const int *piCoefs, unsigned n, __int64 pi64Acc[8])
+{
+    __m512i vAcc[8], vCoefs0, vCoefs1, vData;
+    unsigned ui;
+    int g;
+
+    for (g = 0; g < 8; g++) vAcc[g] = _mm512_setzero_si512();
+    for (ui = 0; ui < n; ui += 16) {
+        vCoefs0 = _mm512_loadu_si512((const void*)(piCoefs + ui));
+        vCoefs1 = _mm512_srli_epi64(vCoefs0, 32);
+        for (g = 0; g < 8; g++) {
+            vData   = _mm512_loadu_si512((const void*)(ppiData[g] + ui));
+            vAcc[g] = _mm512_add_epi64(vAcc[g], _mm512_add_epi64(_mm512_mul_epi32(vData, vCoefs0), _mm512_mul_epi32(_mm512_srli_epi64(vData, 32), vCoefs1)));
+        }
+    }
+    for (g = 0; g < 8; g++) pi64Acc[g] = _mm512_reduce_add_epi64(vAcc[g]);
+}
+
+AVX512 void src_mrhf_fir_mc_inner_loop_avx512(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels)
+{
+    unsigned n = ((unsigned)count >> 3) << 4;
+    __int64 pi64Acc[8];
+    int ch, g;
+
+    for (ch = 0; ch + 8 <= n_channels; ch += 8) {
+        dot_mc8_avx512(ppiData + ch, piCoefs, n, pi64Acc);
+        for (g = 0; g < 8; g++) iData[ch + g] = sat_ext30(pi64Acc[g]);
+    }
+    for (; ch < n_channels; ch++) {
+        iData[ch] = sat_ext30(dot_avx512(ppiData[ch], piCoefs, n));
+    }
+}
+
+AVX512 void src_mrhf_fir_os_mc_inner_loop_avx512(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels)
+{
+    __m512i vAcc0[8], vAcc1[8], vCoefs0, vCoefs1, vData;
+    unsigned n = ((unsigned)count >> 2) << 3;
+    unsigned ui;
+    int ch, g;
+
+    for (ch = 0; ch + 8 <= n_channels; ch += 8) {
+        for (g = 0; g < 8; g++) {
+            vAcc0[g] = _mm512_setzero_si512();
+            vAcc1[g] = _mm512_setzero_si512();
+        }
+        for (ui = 0; ui < n; ui += 8) {
+            vCoefs0 = _mm512_loadu_si512((const void*)(piCoefs + 2 * ui));
+            vCoefs1 = _mm512_srli_epi64(vCoefs0, 32);
+            for (g = 0; g < 8; g++) {
+                vData    = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*)(ppiData[ch + g] + ui)));
+                vAcc0[g] = _mm512_add_epi64(vAcc0[g], _mm512_mul_epi32(vData, vCoefs0));
+                vAcc1[g] = _mm512_add_epi64(vAcc1[g], _mm512_mul_epi32(vData, vCoefs1));
+            }
+        }
+        for (g = 0; g < 8; g++) {
+            iData[2 * (ch + g)]     = sat_ext30(_mm512_reduce_add_epi64(vAcc0[g]));
+            iData[2 * (ch + g) + 1] = sat_ext30(_mm512_reduce_add_epi64(vAcc1[g]));
+        }
+    }
+    for (; ch < n_channels; ch++) {
+        src_mrhf_fir_os_inner_loop_avx512(ppiData[ch], piCoefs, &iData[2 * ch], count);
+    }
+}
+
+// Fully unrolled kernels for the filter tap counts (see src_kernels_fixed.h)
+
+// Block b of 16 taps
+#define FIXED_DOT_AVX512_16(b) \
+    vData   = _mm512_loadu_si512((const void*)(piData + 16 * (b))); \
+    vCoefs  = _mm512_loadu_si512((const void*)(piCoefs + 16 * (b))); \
+    vAcc0   = _mm512_add_epi64(vAcc0, _mm512_mul_epi32(vData, vCoefs)); \
+    vAcc1   = _mm512_add_epi64(vAcc1, _mm512_mul_epi32(_mm512_srli_epi64(vData, 32), _mm512_srli_epi64(vCoefs, 32)));
+
+// Block b of 16 coefficients (eight data samples) of the OS2 FIR
+#define FIXED_OS_AVX512_16(b) \
+    vData   = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*)(piData + 8 * (b)))); \
+    vCoefs  = _mm512_loadu_si512((const void*)(piCoefs + 16 * (b))); \
+    vAcc0   = _mm512_add_epi64(vAcc0, _mm512_mul_epi32(vData, vCoefs)); \
+    vAcc1   = _mm512_add_epi64(vAcc1, _mm512_mul_epi32(vData, _mm512_srli_epi64(vCoefs, 32)));
+
+#define FIXED_FIR_KERNEL_AVX512(kernel, isa, N, B) \
+    static AVX512 void SRC_KERNELS_FIXED_NAME(kernel, isa, N)(int *piData, int *piCoefs, int iData[], int count) \
+    { \
+        (void)count; /* N taps */ \
+        __m512i vAcc0 = _mm512_setzero_si512(); \
+        __m512i vAcc1 = _mm512_setzero_si512(); \
+        __m512i vData, vCoefs; \
+        SRC_KERNELS_REPEAT(B, FIXED_DOT_AVX512_16) \
+        iData[0] = FIXED_SAT(kernel)(_mm512_reduce_add_epi64(_mm512_add_epi64(vAcc0, vAcc1))); \
+    }
+
+#define FIXED_FIR_OS_KERNEL_AVX512(kernel, isa, N, B) \
+    static AVX512 void SRC_KERNELS_FIXED_NAME(kernel, isa, N)(int *piData, int *piCoefs, int iData[], int count) \
+    { \
+        (void)count; /* N taps */ \
+        __m512i vAcc0 = _mm512_setzero_si512(); \
+        __m512i vAcc1 = _mm512_setzero_si512(); \
+        __m512i vData, vCoefs; \
+        SRC_KERNELS_REPEAT(B, FIXED_OS_AVX512_16) \
+        iData[0] = sat_ext30(_mm512_reduce_add_epi64(vAcc0)); \
+        iData[1] = sat_ext30(_mm512_reduce_add_epi64(vAcc1)); \
+    }
+
+SRC_KERNELS_FIXED_FIR_COUNTS(FIXED_FIR_KERNEL_AVX512, mrhf_fir, avx512)
+SRC_KERNELS_FIXED_FIR_OS_COUNTS(FIXED_FIR_OS_KERNEL_AVX512, mrhf_fir_os, avx512)
+SRC_KERNELS_FIXED_ADFIR_COUNTS(FIXED_FIR_KERNEL_AVX512, mrhf_adfir, avx512)
+
+SRC_KERNELS_FIXED_TABLE(mrhf_fir, avx512, SRC_KERNELS_FIXED_FIR_COUNTS);
+SRC_KERNELS_FIXED_TABLE(mrhf_fir_os, avx512, SRC_KERNELS_FIXED_FIR_OS_COUNTS);
+SRC_KERNELS_FIXED_TABLE(mrhf_adfir, avx512, SRC_KERNELS_FIXED_ADFIR_COUNTS);
+
+#endif // !__xcore__ && x86
@@ -18,13 +18,19 @@
 // ===========================================================================
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
+#if !defined(__xcore__)
+#include <pthread.h>
+#endif
 
 // Integer arithmetic include
 #include "src_mrhf_int_arithmetic.h"
 // ASRC include
 #include "src.h"
+// Inner loop kernels
+#include "src_kernels.h"
 
 // ===========================================================================
 //
@@ -91,10 +97,19 @@
 
 #define        ASRC_ADFIR_INITIAL_PHASE                32
 
+// Stage planner (SRC_ARBITRARY_FS)
+#define        ASRC_PLAN_BANDS_UNIT                    10000                    // Band edges unit (ASRCFirBands_t), per coefficients rate
+#define        ASRC_PLAN_MIN_PASS_BAND                    4000                    // Minimum pass band, in ASRC_PLAN_BANDS_UNIT of the lowest of Fsin and Fsout
+#define        ASRC_PLAN_N_PRE                            5                        // Number of pre-stages (none, DS, DS4, DS8, DS16)
+
 // Time ratio shift values
 #define        ASRC_FS_RATIO_UNIT_BIT                    28
+#define        ASRC_FS_RATIO_WIDE_UNIT_BIT                24                        // Fs ratios of 16 and above (8.24 format, SRC_ARBITRARY_FS)
 #define        ASRC_FS_RATIO_PHASE_N_BITS                7
 #define        ASRC_FS_RATIO_BASE_SHIFT                (ASRC_FS_RATIO_UNIT_BIT - ASRC_FS_RATIO_PHASE_N_BITS)
+#define        ASRC_FS_RATIO_SHIFT_M4                    (ASRC_FS_RATIO_BASE_SHIFT + 4)
+#define        ASRC_FS_RATIO_SHIFT_M3                    (ASRC_FS_RATIO_BASE_SHIFT + 3)
+#define        ASRC_FS_RATIO_SHIFT_M2                    (ASRC_FS_RATIO_BASE_SHIFT + 2)
 #define        ASRC_FS_RATIO_SHIFT_M1                    (ASRC_FS_RATIO_BASE_SHIFT + 1)
 #define        ASRC_FS_RATIO_SHIFT_0                    (ASRC_FS_RATIO_BASE_SHIFT)
 #define        ASRC_FS_RATIO_SHIFT_P1                    (ASRC_FS_RATIO_BASE_SHIFT - 1)
@@ -115,6 +130,11 @@
 //
 // ===========================================================================
 
+const unsigned int        uiASRCFsHz[ASRC_N_FS] =                            // Sampling rates of the FS codes (Hz)
+{
+    44100,        48000,        88200,        96000,        176400,        192000
+};
+
 ASRCFiltersIDs_t        sASRCFiltersIDs[ASRC_N_FS][ASRC_N_FS] =                // Filter configuration table [Fsin][Fsout]
 {
     {    // Fsin = 44.1kHz
@@ -232,6 +252,63 @@ ASRCFsRatioConfigs_t        sFsRatioConfigs[ASRC_N_FS][ASRC_N_FS] =
     }
 };
 
+#if SRC_ARBITRARY_FS
+// Measured band edges of the ASRC FIR filters (ordered by ID), for the stage planner (see ASRC_plan)
+// Those of FILTER_DEFS_ASRC_FIR_DS4_ID and above come from src_mrhf_fir_coefs_generator.py
+static const ASRCFirBands_t    sASRCFirBands[FILTER_DEFS_ASRC_N_FIR_ID] =
+{
+    // Pass    Stop
+    {2276,    2700},        // FILTER_DEFS_ASRC_FIR_BL_ID
+    {2086,    2477},        // FILTER_DEFS_ASRC_FIR_BL9644_ID
+    {2481,    2933},        // FILTER_DEFS_ASRC_FIR_BL8848_ID
+    {2058,    2686},        // FITLER_DEFS_ASRC_FIR_BLF_ID
+    {1833,    2461},        // FITLER_DEFS_ASRC_FIR_BL19288_ID
+    {2284,    2924},        // FILTER_DEFS_ASRC_FIR_BL17696_ID
+    {2276,    2700},        // FILTER_DEFS_ASRC_FIR_UP_ID
+    {2086,    2477},        // FILTER_DEFS_ASRC_FIR_UP4844_ID
+    {2058,    2686},        // FILTER_DEFS_ASRC_FIR_UPF_ID
+    {1833,    2461},        // FILTER_DEFS_ASRC_FIR_UP192176_ID
+    {1453,    3325},        // FILTER_DEFS_ASRC_FIR_DS_ID
+    {0,        0},            // FILTER_DEFS_ASRC_FIR_NONE_ID
+    {714,    1697},        // FILTER_DEFS_ASRC_FIR_DS4_ID
+    {1352,    1742},        // FILTER_DEFS_ASRC_FIR_BL5016_ID
+    {1462,    1852},        // FILTER_DEFS_ASRC_FIR_BL4816_ID
+    {1587,    2021},        // FILTER_DEFS_ASRC_FIR_BL4416_ID
+    {1739,    2173},        // FILTER_DEFS_ASRC_FIR_BL3716_ID
+    {1352,    1742},        // FILTER_DEFS_ASRC_FIR_UP5032_ID
+    {1462,    1852},        // FILTER_DEFS_ASRC_FIR_UP4832_ID
+    {1587,    2021},        // FILTER_DEFS_ASRC_FIR_UP4432_ID
+    {1739,    2173},        // FILTER_DEFS_ASRC_FIR_UP3732_ID
+    {372,    860},        // FILTER_DEFS_ASRC_FIR_DS8_ID
+    {136,    490}        // FILTER_DEFS_ASRC_FIR_DS16_ID
+};
+
+// Pre-stages the planner can put ahead of a SYNC band limiting filter, and their decimation factors
+static const unsigned int    uiASRCPlanPreFID[ASRC_PLAN_N_PRE]        = {FILTER_DEFS_ASRC_FIR_NONE_ID,    FILTER_DEFS_ASRC_FIR_DS_ID,        FILTER_DEFS_ASRC_FIR_DS4_ID,    FILTER_DEFS_ASRC_FIR_DS8_ID,    FILTER_DEFS_ASRC_FIR_DS16_ID};
+static const unsigned int    uiASRCPlanPreDecim[ASRC_PLAN_N_PRE]        = {1,                                2,                                4,                                8,                                16};
+static const int            iASRCPlanPreShift[ASRC_PLAN_N_PRE]        = {ASRC_FS_RATIO_SHIFT_0,            ASRC_FS_RATIO_SHIFT_M1,            ASRC_FS_RATIO_SHIFT_M2,            ASRC_FS_RATIO_SHIFT_M3,            ASRC_FS_RATIO_SHIFT_M4};
+#endif
+
+#if ASRC_ADFIR_DENSE_PHASES
+// Dense ADFIR phase table: phase i holds the F3 coefficients for time i / ASRC_ADFIR_DENSE_PHASE_MULT
+// (in ADFIR phases), i.e. the spline coefficients generation output for that time. The extra last
+// phase is time FILTER_DEFS_ADFIR_N_PHASES, for the linear interpolation of the last phases
+// Note this is a workaround to force the compiler to align the array to 64b boundary (required by inner loop assembler that uses load/store double)
+static struct
+{
+    long long                   padding_to_64b;                                                                 // Force 64b alignment
+    int                         iCoefs[ASRC_ADFIR_DENSE_PHASES + 1][FILTER_DEFS_ADFIR_PHASE_N_TAPS];            // Dense phases
+#if defined(__xcore__)
+    volatile int                iReady;                                                                         // Table prepared
+#endif
+} sADFirDense;
+#if !defined(__xcore__)
+// Host threads may initialise ASRC instances concurrently: the table is prepared by the first one,
+// the others wait for it
+static pthread_once_t           sADFirDenseOnce = PTHREAD_ONCE_INIT;
+#endif
+#endif
+
 
 // ===========================================================================
 //
@@ -248,81 +325,321 @@ ASRCFsRatioConfigs_t        sFsRatioConfigs[ASRC_N_FS][ASRC_N_FS] =
 // ===========================================================================
 
 
+#if ASRC_ADFIR_DENSE_PHASES
+// ==================================================================== //
+// Function:        ASRC_prepare_dense_coefs                            //
+// Arguments:        None                                                //
+// Return values:    None                                                //
+// Description:        Computes the dense ADFIR phase table                //
+// ==================================================================== //
+static void                        ASRC_prepare_dense_coefs(void)
+{
+    static const int            iZeroPhase[FILTER_DEFS_ADFIR_PHASE_N_TAPS] = {0};
+    int                            iPhase;
+    int                            iTimeInt;
+    int                            iAlpha;
+    int                            iH[3]; //iH0, iH1, iH2;
+    long long                    i64Acc0;
+    const int*                    piPhase0;
+    const int*                    piPhase1;
+    const int*                    piPhase2;
+    unsigned int                ui;
+
+    for(iPhase = 0; iPhase <= ASRC_ADFIR_DENSE_PHASES; iPhase++)
+    {
+        // Same spline factors as ASRC_proc_F3_time for the time of this phase
+        iTimeInt    = iPhase / ASRC_ADFIR_DENSE_PHASE_MULT;
+        iAlpha        = (int)((((unsigned long long)(iPhase % ASRC_ADFIR_DENSE_PHASE_MULT) << 32) / ASRC_ADFIR_DENSE_PHASE_MULT) >> 1);
+        i64Acc0        = (long long)iAlpha * (long long)iAlpha;
+
+        iH[0]        = (int)(i64Acc0>>32);
+        iH[2]        = 0x40000000;                        // Load H2 with 0.5;
+        iH[1]        = iH[2] - iH[0];                    // H1 = 0.5 - 0.5 * alpha * alpha;
+        iH[1]        = iH[1] - iH[0];                    // H1 = 0.5 - alpha * alpha
+        iH[1]        = iH[1] + iAlpha;                    // H1 = 0.5 + alpha - alpha * alpha;
+        iH[2]        = iH[2] - iAlpha;                    // H2 = 0.5 - alpha
+        iH[2]        = iH[2] + iH[0];                    // H2 = 0.5 - alpha + 0.5 * alpha * alpha
+
+        // Last phase (time FILTER_DEFS_ADFIR_N_PHASES) has alpha = 0 so H0 = 0: its third phase is not used
+        piPhase0    = iADFirCoefs[iTimeInt];
+        piPhase1    = iADFirCoefs[iTimeInt + 1];
+        piPhase2    = (iTimeInt + 2 < FILTER_DEFS_ADFIR_N_PHASES + 2) ? iADFirCoefs[iTimeInt + 2] : iZeroPhase;
+
+        // As the spline coefficients generation inner loop
+        for(ui = 0; ui < FILTER_DEFS_ADFIR_PHASE_N_TAPS; ui++)
+        {
+            i64Acc0     = (long long)iH[2] * (long long)piPhase0[ui];
+            i64Acc0    += (long long)iH[1] * (long long)piPhase1[ui];
+            i64Acc0    += (long long)iH[0] * (long long)piPhase2[ui];
+            sADFirDense.iCoefs[iPhase][ui]    = (int)(i64Acc0 >> 32);
+        }
+    }
+}
+#endif
+
 // ==================================================================== //
 // Function:        ASRC_prepare_coefs                                    //
-// Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+// Arguments:        None                                                //
 // Return values:    ASRC_NO_ERROR on success                            //
 //                    ASRC_ERROR on failure                                //
-// Description:        Prepares the ASRC coefficients from the prototype    //
-//                    Needs to be called only once                        //
+// Description:        Prepares the dense ADFIR phase table if enabled        //
+//                    (ASRC_ADFIR_DENSE_PHASES, first call only). The        //
+//                    ASRC coefficients (iADFirCoefs) are prepared from    //
+//                    the prototype at build time                            //
+//                    (src_mrhf_adfir_coefs_generator.py)                    //
 // ==================================================================== //
 ASRCReturnCodes_t                ASRC_prepare_coefs(void)
 {
-    unsigned int        ui, uj;
-    int*                piPrototypeCoefs = iADFirPrototypeCoefs + FILTER_DEFS_ADFIR_PROTOTYPE_N_TAPS - FILTER_DEFS_ADFIR_N_PHASES;
+#if ASRC_ADFIR_DENSE_PHASES
+#if defined(__xcore__)
+    // The logical cores of a tile share the memory without caches: cores initialising concurrently
+    // write the same values, and iReady is only set once the table is complete
+    if(!sADFirDense.iReady)
+    {
+        ASRC_prepare_dense_coefs();
+        __asm__ __volatile__("" ::: "memory");
+        sADFirDense.iReady    = 1;
+    }
+#else
+    pthread_once(&sADFirDenseOnce, ASRC_prepare_dense_coefs);
+#endif
+#endif
+
+    return ASRC_NO_ERROR;
+}
+
+#if ASRC_ADFIR_DENSE_PHASES
+// ==================================================================== //
+// Function:        ASRC_F3_dense_coefs                                    //
+// Arguments:        int iTimeInt: Integer part of time                    //
+//                    unsigned int uiTimeFract: Fractional part of time    //
+//                    int *piADCoefs: AD coefficients buffer                //
+// Return values:    Pointer to the F3 coefficients for time: the dense    //
+//                    table phase (nearest) or piADCoefs (linear)            //
+// Description:        F3 coefficients from the dense ADFIR phase table    //
+// ==================================================================== //
+const int*                        ASRC_F3_dense_coefs(int iTimeInt, unsigned int uiTimeFract, int* piADCoefs)
+{
+#if ASRC_ADFIR_DENSE_LINEAR
+    unsigned long long            u64Pos;
+    unsigned int                uiWeight;
+    const int*                    piPhase0;
+    const int*                    piPhase1;
+    unsigned int                ui;
+
+    // Dense phase before time and distance to it (0.32)
+    u64Pos        = (unsigned long long)uiTimeFract * ASRC_ADFIR_DENSE_PHASE_MULT;
+    piPhase0    = sADFirDense.iCoefs[iTimeInt * ASRC_ADFIR_DENSE_PHASE_MULT + (int)(u64Pos >> 32)];
+    piPhase1    = piPhase0 + FILTER_DEFS_ADFIR_PHASE_N_TAPS;
+    uiWeight    = (unsigned int)u64Pos;
+
+    for(ui = 0; ui < FILTER_DEFS_ADFIR_PHASE_N_TAPS; ui++)
+        piADCoefs[ui]    = piPhase0[ui] + (int)(((long long)(piPhase1[ui] - piPhase0[ui]) * uiWeight) >> 32);
+
+    return piADCoefs;
+#else
+    // Nearest dense phase (rounding up to the extra last phase at most), used as is
+    (void)piADCoefs;
+    return sADFirDense.iCoefs[iTimeInt * ASRC_ADFIR_DENSE_PHASE_MULT +
+        (int)(((unsigned long long)uiTimeFract * ASRC_ADFIR_DENSE_PHASE_MULT + 0x80000000ULL) >> 32)];
+#endif
+}
+#endif
+
+// ==================================================================== //
+// Function:        ASRC_fs_code                                        //
+// Arguments:        unsigned int uiFs: Sampling rate (Hz)                //
+// Return values:    Sampling rate code of uiFs, ASRC_FS_NONE if it has    //
+//                    no code                                                //
+// Description:        Finds the sampling rate code of a rate in Hz        //
+// ==================================================================== //
+static ASRCFs_t                    ASRC_fs_code(unsigned int uiFs)
+{
+    int                            iFs;
 
-    // First fill in the phases which start normally
-    for(ui = 0; ui < FILTER_DEFS_ADFIR_N_PHASES; ui++)
+    for(iFs = ASRC_FS_MIN; iFs <= ASRC_FS_MAX; iFs++)
+        if(uiASRCFsHz[iFs] == uiFs)
+            return (ASRCFs_t)iFs;
+    return ASRC_FS_NONE;
+}
+
+
+// ==================================================================== //
+// Function:        ASRC_plan                                            //
+// Arguments:        unsigned int uiInFs: Fsin (Hz)                        //
+//                    unsigned int uiOutFs: Fsout (Hz)                    //
+//                    unsigned int uiNInSamples: Number of input samples    //
+//                    ASRCFiltersIDs_t *psFiltersID: F1 and F2 IDs        //
+//                    ASRCFsRatioConfigs_t *psFsRatioConfig: Fs ratios    //
+//                    unsigned int *puiFsRatioFracBits: Fractional bits    //
+//                    of the Fs ratios (28 or 24)                            //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR if there is no plan for Fsin and Fsout    //
+// Description:        Chooses filters F1 and F2 and the Fs ratio            //
+//                    configuration for Fsin and Fsout                    //
+// ==================================================================== //
+static ASRCReturnCodes_t        ASRC_plan(unsigned int uiInFs, unsigned int uiOutFs, unsigned int uiNInSamples, ASRCFiltersIDs_t* psFiltersID, ASRCFsRatioConfigs_t* psFsRatioConfig, unsigned int* puiFsRatioFracBits)
+{
+    ASRCFs_t                        eInFs, eOutFs;
+#if SRC_ARBITRARY_FS
+    unsigned long long            u64Nominal;
+    unsigned int                uiFracBits;
+    unsigned long long            u64B, u64S, u64BestB;
+    unsigned int                uiPre, uiFID, uiD, uiM, uiCost, uiBestD, uiBestCost;
+    int                            iBestPre, iBestFID;
+    const FIRDescriptor_t*        psFIRDescriptor;
+#endif
+
+    // Pairs of FS codes rates use the tables
+    eInFs    = ASRC_fs_code(uiInFs);
+    eOutFs    = ASRC_fs_code(uiOutFs);
+    if((eInFs != ASRC_FS_NONE) && (eOutFs != ASRC_FS_NONE))
+    {
+        *psFiltersID        = sASRCFiltersIDs[eInFs][eOutFs];
+        *psFsRatioConfig    = sFsRatioConfigs[eInFs][eOutFs];
+        *puiFsRatioFracBits    = ASRC_FS_RATIO_UNIT_BIT;
+        return ASRC_NO_ERROR;
+    }
+
+#if SRC_ARBITRARY_FS
+    if((uiInFs == 0) || (uiOutFs == 0))
+        return ASRC_ERROR;
+
+    // The maximal Fs ratio must fit in 4.28 format, or in 8.24 format for Fs ratios of 16 and above
+    uiFracBits        = ASRC_FS_RATIO_UNIT_BIT;
+    u64Nominal        = ((unsigned long long)uiInFs << uiFracBits) / uiOutFs;
+    if((double)u64Nominal * ASRC_FS_RATIO_MAX_FACTOR >= 4294967296.0)
     {
-        // Copy phase information
-        for(uj = 0; uj < FILTER_DEFS_ADFIR_PHASE_N_TAPS - 1; uj++)
-            iADFirCoefs[ui][uj] = *(piPrototypeCoefs + ui - uj * FILTER_DEFS_ADFIR_N_PHASES);
-        // Zero fill last coefficient
-        iADFirCoefs[ui][FILTER_DEFS_ADFIR_PHASE_N_TAPS - 1]    = 0;
+        uiFracBits    = ASRC_FS_RATIO_WIDE_UNIT_BIT;
+        u64Nominal    = ((unsigned long long)uiInFs << uiFracBits) / uiOutFs;
+        if((double)u64Nominal * ASRC_FS_RATIO_MAX_FACTOR >= 4294967296.0)
+            return ASRC_ERROR;
     }
 
-    // Then fill in the two phases which start delayed
-    for(ui = 0; ui < 2; ui++)
+    // Search a band limiting filter X, at Fsync = Fsin (SYNC) or 2 x Fsin (OS2), or a pre-stage decimating
+    // by D (DS, DS4, DS8, DS16) followed by a SYNC X at Fsync = Fsin / D. With B its pass band edge (and that of the
+    // pre-stage) and S its stop band edge, in Hz:
+    //  - S <= Fsout - B, so what F3 folds back from above Fsout / 2 stays out of the pass band
+    //  - a pre-stage aliases above Fsync - its stop band edge, which must be above S
+    //  - B >= ASRC_PLAN_MIN_PASS_BAND of the lowest of Fsin and Fsout
+    // and keep the widest pass band, then the fewest taps per input sample. Below, all frequencies are in
+    // Hz x ASRC_PLAN_BANDS_UNIT x D (exact integers)
+    iBestPre        = -1;
+    iBestFID        = -1;
+    u64BestB        = 0;
+    uiBestD            = 1;
+    uiBestCost        = 0;
+    for(uiPre = 0; uiPre < ASRC_PLAN_N_PRE; uiPre++)
+    {
+        uiD            = uiASRCPlanPreDecim[uiPre];
+        // X needs an even number of input samples
+        if((uiNInSamples % (uiD << 1)) != 0)
+            continue;
+        for(uiFID = 0; uiFID < FILTER_DEFS_ASRC_N_FIR_ID; uiFID++)
+        {
+            psFIRDescriptor        = &sASRCFirDescriptor[uiFID];
+            if(uiFID == FILTER_DEFS_ASRC_FIR_NONE_ID)
+                continue;
+            if(psFIRDescriptor->eType == FIR_TYPE_OS2)
+            {
+                if(uiD != 1)
+                    continue;
+                uiM        = 2;
+            }
+            else if(psFIRDescriptor->eType == FIR_TYPE_SYNC)
+                uiM        = 1;
+            else
+                continue;
+
+            u64B        = (unsigned long long)sASRCFirBands[uiFID].uiPass * uiInFs * uiM;
+            u64S        = (unsigned long long)sASRCFirBands[uiFID].uiStop * uiInFs * uiM;
+            uiCost        = psFIRDescriptor->uiNCoefs;
+            if(uiD != 1)
+            {
+                if(u64B > (unsigned long long)sASRCFirBands[uiASRCPlanPreFID[uiPre]].uiPass * uiInFs * uiD)
+                    u64B    = (unsigned long long)sASRCFirBands[uiASRCPlanPreFID[uiPre]].uiPass * uiInFs * uiD;
+                if((unsigned long long)ASRC_PLAN_BANDS_UNIT * uiInFs < (unsigned long long)sASRCFirBands[uiASRCPlanPreFID[uiPre]].uiStop * uiInFs * uiD + u64S)
+                    continue;
+                uiCost    += sASRCFirDescriptor[uiASRCPlanPreFID[uiPre]].uiNCoefs;
+            }
+            if(u64S + u64B > (unsigned long long)ASRC_PLAN_BANDS_UNIT * uiOutFs * uiD)
+                continue;
+            if(u64B < (unsigned long long)ASRC_PLAN_MIN_PASS_BAND * ((uiInFs < uiOutFs) ? uiInFs : uiOutFs) * uiD)
+                continue;
+
+            // Pass bands B / D and costs uiCost / D compared across D
+            if( (iBestFID < 0) ||
+                (u64B * uiBestD > u64BestB * uiD) ||
+                ((u64B * uiBestD == u64BestB * uiD) && (uiCost * uiBestD < uiBestCost * uiD)) )
+            {
+                iBestPre    = (int)uiPre;
+                iBestFID    = (int)uiFID;
+                u64BestB    = u64B;
+                uiBestD        = uiD;
+                uiBestCost    = uiCost;
+            }
+        }
+    }
+    if(iBestFID < 0)
+        return ASRC_ERROR;
+
+    // F1 is the pre-stage if any, X otherwise
+    if(iBestPre != 0)
+    {
+        psFiltersID->uiFID[ASRC_F1_INDEX]    = uiASRCPlanPreFID[iBestPre];
+        psFiltersID->uiFID[ASRC_F2_INDEX]    = (unsigned int)iBestFID;
+        psFsRatioConfig->iFsRatioShift        = iASRCPlanPreShift[iBestPre];
+    }
+    else
     {
-        // Zero fill first coefficient
-        iADFirCoefs[FILTER_DEFS_ADFIR_N_PHASES + ui][0]    = 0;
-        // Copy phase informaiton
-        for(uj = 0; uj < FILTER_DEFS_ADFIR_PHASE_N_TAPS - 1; uj++)
-            iADFirCoefs[FILTER_DEFS_ADFIR_N_PHASES + ui][uj + 1] = *(piPrototypeCoefs + ui - uj * FILTER_DEFS_ADFIR_N_PHASES);
+        psFiltersID->uiFID[ASRC_F1_INDEX]    = (unsigned int)iBestFID;
+        psFiltersID->uiFID[ASRC_F2_INDEX]    = FILTER_DEFS_ASRC_FIR_NONE_ID;
+        psFsRatioConfig->iFsRatioShift        = (sASRCFirDescriptor[iBestFID].eType == FIR_TYPE_OS2) ? ASRC_FS_RATIO_SHIFT_P1 : ASRC_FS_RATIO_SHIFT_0;
     }
+    // The time step is the same number of phases in either format
+    psFsRatioConfig->iFsRatioShift        -= (int)(ASRC_FS_RATIO_UNIT_BIT - uiFracBits);
+    *puiFsRatioFracBits                    = uiFracBits;
+    psFsRatioConfig->uiNominalFsRatio    = (unsigned int)u64Nominal;
+    psFsRatioConfig->uiMinFsRatio        = (unsigned int)(u64Nominal * ASRC_FS_RATIO_MIN_FACTOR);
+    psFsRatioConfig->uiMaxFsRatio        = (unsigned int)(u64Nominal * ASRC_FS_RATIO_MAX_FACTOR);
 
     return ASRC_NO_ERROR;
+#else
+    (void)uiNInSamples;
+    return ASRC_ERROR;
+#endif
 }
 
+
 // ==================================================================== //
-// Function:        ASRC_init                                            //
+// Function:        ASRC_init_F1_F2                                        //
 // Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
 // Return values:    ASRC_NO_ERROR on success                            //
 //                    ASRC_ERROR on failure                                //
-// Description:        Inits the ASRC passed as argument                    //
+// Description:        Sets the nominal Fs ratio and sets up filters F1 and    //
+//                    F2 for Fsin and Fsout (their delay lines are left    //
+//                    to ASRC_sync or ASRC_change_rate)                    //
 // ==================================================================== //
-ASRCReturnCodes_t                ASRC_init(asrc_ctrl_t* pasrc_ctrl)
+static ASRCReturnCodes_t        ASRC_init_F1_F2(asrc_ctrl_t* pasrc_ctrl)
 {
-    ASRCFiltersIDs_t*            psFiltersID;
+    ASRCFiltersIDs_t            sFiltersID;
+    ASRCFiltersIDs_t*            psFiltersID        = &sFiltersID;
     FIRDescriptor_t*            psFIRDescriptor;
-    ADFIRDescriptor_t*            psADFIRDescriptor;
-
 
-    // Check if state is allocated
-    if(pasrc_ctrl->psState == 0)
-        return ASRC_ERROR;
 
-    // Check if stack is allocated
-    if(pasrc_ctrl->piStack == 0)
+    // Choose filters and Fs ratio configuration (fails if Fsin and Fsout are not supported)
+    if(ASRC_plan(pasrc_ctrl->uiInFs, pasrc_ctrl->uiOutFs, pasrc_ctrl->uiNInSamples, psFiltersID, &pasrc_ctrl->sFsRatioConfig, &pasrc_ctrl->uiFsRatioFracBits) != ASRC_NO_ERROR)
         return ASRC_ERROR;
+    pasrc_ctrl->eInFs        = ASRC_fs_code(pasrc_ctrl->uiInFs);
+    pasrc_ctrl->eOutFs        = ASRC_fs_code(pasrc_ctrl->uiOutFs);
 
-    // Check if valid Fsin and Fsout have been provided
-    if( (pasrc_ctrl->eInFs < ASRC_FS_MIN) || (pasrc_ctrl->eInFs > ASRC_FS_MAX))
-        return ASRC_ERROR;
-    if( (pasrc_ctrl->eOutFs < ASRC_FS_MIN) || (pasrc_ctrl->eOutFs > ASRC_FS_MAX))
-        return ASRC_ERROR;
+    // Apply the Fs ratio range, if set (it is kept over rate changes)
+    if(pasrc_ctrl->uiFsRatioRange != 0)
+        if(ASRC_set_fs_ratio_range(pasrc_ctrl) != ASRC_NO_ERROR)
+            return ASRC_ERROR;
 
     // Set nominal fs ratio
-    pasrc_ctrl->uiFsRatio    = sFsRatioConfigs[pasrc_ctrl->eInFs][pasrc_ctrl->eOutFs].uiNominalFsRatio;
-
-    // Check that number of input samples is allocated and is a multiple of 4
-    if(pasrc_ctrl->uiNInSamples == 0)
-        return ASRC_ERROR;
-    if((pasrc_ctrl->uiNInSamples & 0x3) != 0x0)
-        return ASRC_ERROR;
-
-    // Load filters ID and number of samples
-    psFiltersID        = &sASRCFiltersIDs[pasrc_ctrl->eInFs][pasrc_ctrl->eOutFs];
+    pasrc_ctrl->uiFsRatio    = pasrc_ctrl->sFsRatioConfig.uiNominalFsRatio;
 
 
     // Configure filters F1 and F2 from filters ID and number of samples
@@ -332,17 +649,23 @@ ASRCReturnCodes_t                ASRC_init(asrc_ctrl_t* pasrc_ctrl)
     psFIRDescriptor                            = &sASRCFirDescriptor[psFiltersID->uiFID[ASRC_F1_INDEX]];
     // Set number of input samples and input samples step
     pasrc_ctrl->sFIRF1Ctrl.uiNInSamples        = pasrc_ctrl->uiNInSamples;
-    pasrc_ctrl->sFIRF1Ctrl.uiInStep            = pasrc_ctrl->uiNchannels;
+    pasrc_ctrl->sFIRF1Ctrl.uiInStep            = pasrc_ctrl->uiStep;
     // Set delay line base pointer
-    if( psFiltersID->uiFID[ASRC_F1_INDEX] == FILTER_DEFS_ASRC_FIR_DS_ID )
+    if( (psFiltersID->uiFID[ASRC_F1_INDEX] == FILTER_DEFS_ASRC_FIR_DS_ID)
+#if SRC_ARBITRARY_FS
+        || (psFiltersID->uiFID[ASRC_F1_INDEX] == FILTER_DEFS_ASRC_FIR_DS4_ID)
+        || (psFiltersID->uiFID[ASRC_F1_INDEX] == FILTER_DEFS_ASRC_FIR_DS8_ID)
+        || (psFiltersID->uiFID[ASRC_F1_INDEX] == FILTER_DEFS_ASRC_FIR_DS16_ID)
+#endif
+        )
         pasrc_ctrl->sFIRF1Ctrl.piDelayB            = pasrc_ctrl->psState->iDelayFIRShort;
     else
         pasrc_ctrl->sFIRF1Ctrl.piDelayB            = pasrc_ctrl->psState->iDelayFIRLong;
     // Set output buffer step
     pasrc_ctrl->sFIRF1Ctrl.uiOutStep        = 1;//ASRC_N_CHANNELS; //TODO confirm this
 
-    // Call init for FIR F1
-    if(FIR_init_from_desc(&pasrc_ctrl->sFIRF1Ctrl, psFIRDescriptor) != FIR_NO_ERROR)
+    // Call set up for FIR F1
+    if(FIR_set_desc(&pasrc_ctrl->sFIRF1Ctrl, psFIRDescriptor) != FIR_NO_ERROR)
         return ASRC_ERROR;
 
     // Update synchronous number of samples
@@ -361,8 +684,8 @@ ASRCReturnCodes_t                ASRC_init(asrc_ctrl_t* pasrc_ctrl)
     // Set output buffer step
     pasrc_ctrl->sFIRF2Ctrl.uiOutStep        = 1;//ASRC_N_CHANNELS; //TODO confirm this. Looks like 1 = channel per instance
 
-    // Call init for FIR F2
-    if(FIR_init_from_desc(&pasrc_ctrl->sFIRF2Ctrl, psFIRDescriptor) != FIR_NO_ERROR)
+    // Call set up for FIR F2
+    if(FIR_set_desc(&pasrc_ctrl->sFIRF2Ctrl, psFIRDescriptor) != FIR_NO_ERROR)
         return ASRC_ERROR;
 
     // Update synchronous number of samples
@@ -378,6 +701,49 @@ ASRCReturnCodes_t                ASRC_init(asrc_ctrl_t* pasrc_ctrl)
     pasrc_ctrl->sFIRF1Ctrl.piOut            = pasrc_ctrl->piStack;
     pasrc_ctrl->sFIRF2Ctrl.piOut            = pasrc_ctrl->piStack;
 
+    return ASRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ASRC_init                                            //
+// Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR on failure                                //
+// Description:        Inits the ASRC passed as argument                    //
+// ==================================================================== //
+ASRCReturnCodes_t                ASRC_init(asrc_ctrl_t* pasrc_ctrl)
+{
+    ADFIRDescriptor_t*            psADFIRDescriptor;
+
+
+    // Check if state is allocated
+    if(pasrc_ctrl->psState == 0)
+        return ASRC_ERROR;
+
+    // Check if stack is allocated
+    if(pasrc_ctrl->piStack == 0)
+        return ASRC_ERROR;
+
+    // Check that number of input samples is allocated and is a multiple of 4
+    if(pasrc_ctrl->uiNInSamples == 0)
+        return ASRC_ERROR;
+    if((pasrc_ctrl->uiNInSamples & 0x3) != 0x0)
+        return ASRC_ERROR;
+
+    // Select inner loop kernels (first call only)
+    src_kernels_init();
+
+    // Prepare dense ADFIR phase table if enabled (first call only)
+    if(ASRC_prepare_coefs() != ASRC_NO_ERROR)
+        return ASRC_ERROR;
+
+    // Input and output buffers are interleaved (see ASRC_set_step)
+    pasrc_ctrl->uiStep                        = pasrc_ctrl->uiNchannels;
+
+    // Configure filters F1 and F2 and nominal Fs ratio from Fsin and Fsout
+    if(ASRC_init_F1_F2(pasrc_ctrl) != ASRC_NO_ERROR)
+        return ASRC_ERROR;
 
 
     // Filter F3
@@ -423,6 +789,9 @@ ASRCReturnCodes_t                ASRC_sync(asrc_ctrl_t* pasrc_ctrl)
     pasrc_ctrl->iTimeInt        = FILTER_DEFS_ADFIR_N_PHASES + ASRC_ADFIR_INITIAL_PHASE;
     pasrc_ctrl->uiTimeFract        = 0;
 
+    // No synchronous samples left on stack for F3
+    pasrc_ctrl->uiNSyncSamplesUsed    = pasrc_ctrl->uiNSyncSamples;
+
     // Reset random seeds to initial values
     pasrc_ctrl->psState->uiRndSeed    = pasrc_ctrl->uiRndSeedInit;
 
@@ -434,6 +803,208 @@ ASRCReturnCodes_t                ASRC_sync(asrc_ctrl_t* pasrc_ctrl)
 }
 
 
+// ==================================================================== //
+// Function:        ASRC_change_rate                                    //
+// Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR on failure                                //
+// Description:        Switches an initialised ASRC to new Fsin and Fsout    //
+//                    (uiInFs, uiOutFs) without clearing its delay lines    //
+// ==================================================================== //
+ASRCReturnCodes_t                ASRC_change_rate(asrc_ctrl_t* pasrc_ctrl)
+{
+    // F1 and F2 histories, in place in their delay lines (F1 may move between the short and long delay lines, which F2 also uses)
+    const int*                    piHistoryF1;
+    const int*                    piHistoryF2;
+    unsigned int                uiHistoryF1L;
+    unsigned int                uiHistoryF2L;
+
+    // Check if state is allocated
+    if(pasrc_ctrl->psState == 0)
+        return ASRC_ERROR;
+
+    // Check if stack is allocated
+    if(pasrc_ctrl->piStack == 0)
+        return ASRC_ERROR;
+
+    // Locate the newest samples of F1 and F2
+    if(FIR_get_history(&pasrc_ctrl->sFIRF1Ctrl, &piHistoryF1, &uiHistoryF1L) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+    if(FIR_get_history(&pasrc_ctrl->sFIRF2Ctrl, &piHistoryF2, &uiHistoryF2L) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+
+    // Configure filters F1 and F2 and nominal Fs ratio from new Fsin and Fsout (delay lines untouched)
+    if(ASRC_init_F1_F2(pasrc_ctrl) != ASRC_NO_ERROR)
+        return ASRC_ERROR;
+    // Synchronous samples on stack not yet used by F3 (pull mode) were produced at the old rates: drop them
+    pasrc_ctrl->uiNSyncSamplesUsed    = pasrc_ctrl->uiNSyncSamples;
+
+    // Sync their delay lines with as much of the history as they hold. F1 first: when it moves to the
+    // short delay line, its history is in the long one, which F2 then clears. When it moves to the long
+    // one, F2 is disabled and its history is dropped
+    if(FIR_sync_history(&pasrc_ctrl->sFIRF1Ctrl, piHistoryF1, uiHistoryF1L) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+    if(FIR_sync_history(&pasrc_ctrl->sFIRF2Ctrl, piHistoryF2, uiHistoryF2L) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+
+    // F3 delay line, time and random seed carry on: only update time step for the new nominal Fs ratio
+    if(ASRC_update_fs_ratio(pasrc_ctrl) != ASRC_NO_ERROR)
+        return ASRC_ERROR;
+
+    return ASRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ASRC_set_fs_ratio_range                                //
+// Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR on failure                                //
+// Description:        Sets the min and max Fs ratios from the nominal Fs    //
+//                    ratio and the Fs ratio range (uiFsRatioRange)        //
+// ==================================================================== //
+ASRCReturnCodes_t                ASRC_set_fs_ratio_range(asrc_ctrl_t* pasrc_ctrl)
+{
+    unsigned long long            u64Nominal        = pasrc_ctrl->sFsRatioConfig.uiNominalFsRatio;
+    unsigned long long            u64Deviation;
+
+    if(pasrc_ctrl->uiFsRatioRange > ASRC_FS_RATIO_RANGE_MAX)
+        return ASRC_ERROR;
+
+    // No range: +/-1%, as in the Fs ratio configuration tables
+    if(pasrc_ctrl->uiFsRatioRange == 0)
+    {
+        pasrc_ctrl->sFsRatioConfig.uiMinFsRatio        = (unsigned int)(u64Nominal * ASRC_FS_RATIO_MIN_FACTOR);
+        pasrc_ctrl->sFsRatioConfig.uiMaxFsRatio        = (unsigned int)(u64Nominal * ASRC_FS_RATIO_MAX_FACTOR);
+        return ASRC_NO_ERROR;
+    }
+
+    // The max Fs ratio must fit in its format. The time step shift only depends on the synchronous
+    // rate, and the integer part of time is large enough for any time step, so they are unchanged
+    u64Deviation    = (u64Nominal * pasrc_ctrl->uiFsRatioRange) / 1000000;
+    if(u64Nominal + u64Deviation > 0xFFFFFFFF)
+        return ASRC_ERROR;
+    pasrc_ctrl->sFsRatioConfig.uiMinFsRatio        = (unsigned int)(u64Nominal - u64Deviation);
+    pasrc_ctrl->sFsRatioConfig.uiMaxFsRatio        = (unsigned int)(u64Nominal + u64Deviation);
+
+    return ASRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ASRC_set_step                                        //
+// Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+//                    unsigned int uiStep: Step between the samples of    //
+//                    the channel in the input and output buffers            //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR on failure                                //
+// Description:        Sets the input and output buffers layout of an        //
+//                    initialised ASRC: interleaved (uiNchannels) or        //
+//                    planar (1)                                            //
+// ==================================================================== //
+ASRCReturnCodes_t                ASRC_set_step(asrc_ctrl_t* pasrc_ctrl, unsigned int uiStep)
+{
+    if(uiStep == 0)
+        return ASRC_ERROR;
+
+    // F1 reads the input buffer, F3 writes the output buffer (F1 and F2 outputs are on stack)
+    pasrc_ctrl->uiStep                        = uiStep;
+    pasrc_ctrl->sFIRF1Ctrl.uiInStep            = uiStep;
+
+    return ASRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ASRC_get_stack_length                                //
+// Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+//                    unsigned int *puiStackLength: Stack length            //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR on failure                                //
+// Description:        Gets the length of the stack used by an ASRC for    //
+//                    uiInFs, uiOutFs and uiNInSamples, before it is        //
+//                    initialised                                            //
+// ==================================================================== //
+ASRCReturnCodes_t                ASRC_get_stack_length(asrc_ctrl_t* pasrc_ctrl, unsigned int* puiStackLength)
+{
+    ASRCFiltersIDs_t            sFiltersID;
+    ASRCFsRatioConfigs_t        sFsRatioConfig;
+    unsigned int                uiFsRatioFracBits;
+    unsigned int                uiNF1OutSamples, uiNF2OutSamples;
+
+
+    // Same filters as ASRC_init_F1_F2
+    if(ASRC_plan(pasrc_ctrl->uiInFs, pasrc_ctrl->uiOutFs, pasrc_ctrl->uiNInSamples, &sFiltersID, &sFsRatioConfig, &uiFsRatioFracBits) != ASRC_NO_ERROR)
+        return ASRC_ERROR;
+
+    // F1 and F2 write the synchronous samples of the channel to the stack (in place, step 1)
+    if(FIR_get_n_out_samples(&sASRCFirDescriptor[sFiltersID.uiFID[ASRC_F1_INDEX]], pasrc_ctrl->uiNInSamples, &uiNF1OutSamples) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+    if(FIR_get_n_out_samples(&sASRCFirDescriptor[sFiltersID.uiFID[ASRC_F2_INDEX]], uiNF1OutSamples, &uiNF2OutSamples) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+
+    *puiStackLength        = (uiNF2OutSamples > uiNF1OutSamples) ? uiNF2OutSamples : uiNF1OutSamples;
+
+    return ASRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ASRC_get_delay                                        //
+// Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+//                    long long *pi64Delay: Group delay (Q32 format)        //
+//                    unsigned long long *pu64OutRatio: Fsout / Fsin    //
+//                    (Q32 format)                                        //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR on failure                                //
+// Description:        Gets the group delay at DC of the filters F1, F2    //
+//                    and F3 in input samples, at the nominal Fs ratio    //
+// ==================================================================== //
+ASRCReturnCodes_t                ASRC_get_delay(asrc_ctrl_t* pasrc_ctrl, long long* pi64Delay, unsigned long long* pu64OutRatio)
+{
+    long long                    i64Delay;
+    unsigned int                uiNInSamples    = pasrc_ctrl->uiNInSamples;
+    double                        dSum            = 0.0;
+    double                        dMoment            = 0.0;
+    int                            iPhase;
+    unsigned int                ui;
+
+
+    if(pasrc_ctrl->sFsRatioConfig.uiNominalFsRatio == 0)
+        return ASRC_ERROR;
+
+    // F1 (always enabled) and F2, each delay in its own input samples scaled to the ASRC input samples
+    if(FIR_get_delay(&pasrc_ctrl->sFIRF1Ctrl, &i64Delay) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+    *pi64Delay        = i64Delay;
+    if(FIR_get_delay(&pasrc_ctrl->sFIRF2Ctrl, &i64Delay) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+    if(pasrc_ctrl->sFIRF2Ctrl.eEnable == FIR_ON)
+        *pi64Delay    += i64Delay * uiNInSamples / pasrc_ctrl->sFIRF2Ctrl.uiNInSamples;
+
+    // F3 at time iTimeInt (fractional part zero) outputs iTimeInt / FILTER_DEFS_ADFIR_N_PHASES synchronous
+    // samples after the newest, with half each of phases iTimeInt and iTimeInt + 1 (spline factors H2 and H1)
+    for(iPhase = 0; iPhase < FILTER_DEFS_ADFIR_N_PHASES; iPhase++)
+        for(ui = 0; ui < FILTER_DEFS_ADFIR_PHASE_N_TAPS; ui++)
+        {
+            dSum        += (double)iADFirCoefs[iPhase][ui] + iADFirCoefs[iPhase + 1][ui];
+            dMoment        += ((double)iADFirCoefs[iPhase][ui] + iADFirCoefs[iPhase + 1][ui]) *
+                            ((FILTER_DEFS_ADFIR_PHASE_N_TAPS - 1 - ui) + (double)iPhase / FILTER_DEFS_ADFIR_N_PHASES);
+        }
+    if(dSum == 0.0)
+        return ASRC_ERROR;
+
+    // The first output sample is at ASRC_ADFIR_INITIAL_PHASE after the first synchronous sample
+    i64Delay        = (long long)((dMoment / dSum - (double)ASRC_ADFIR_INITIAL_PHASE / FILTER_DEFS_ADFIR_N_PHASES) * 4294967296.0);
+    *pi64Delay        += i64Delay * uiNInSamples / pasrc_ctrl->uiNSyncSamples;
+
+    // Nominal Fs ratio is Fsin / Fsout with uiFsRatioFracBits fractional bits
+    *pu64OutRatio    = (1ULL << (32 + pasrc_ctrl->uiFsRatioFracBits)) / pasrc_ctrl->sFsRatioConfig.uiNominalFsRatio;
+
+    return ASRC_NO_ERROR;
+}
+
+
 // ==================================================================== //
 // Function:        ASRC_proc_F1_F2                                        //
 // Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
@@ -479,13 +1050,13 @@ ASRCReturnCodes_t                ASRC_update_fs_ratio(asrc_ctrl_t* pasrc_ctrl)
     unsigned int    uiFsRatio        = pasrc_ctrl->uiFsRatio;
 
     // Check for bounds of new Fs ratio
-    if( (uiFsRatio < sFsRatioConfigs[pasrc_ctrl->eInFs][pasrc_ctrl->eOutFs].uiMinFsRatio) ||
-        (uiFsRatio > sFsRatioConfigs[pasrc_ctrl->eInFs][pasrc_ctrl->eOutFs].uiMaxFsRatio) )
+    if( (uiFsRatio < pasrc_ctrl->sFsRatioConfig.uiMinFsRatio) ||
+        (uiFsRatio > pasrc_ctrl->sFsRatioConfig.uiMaxFsRatio) )
         return ASRC_ERROR;
 
     // Apply shift to time ratio to build integer and fractional parts of time step
-    pasrc_ctrl->iTimeStepInt     = uiFsRatio >> (sFsRatioConfigs[pasrc_ctrl->eInFs][pasrc_ctrl->eOutFs].iFsRatioShift);
-    pasrc_ctrl->uiTimeStepFract  = uiFsRatio << (32 - sFsRatioConfigs[pasrc_ctrl->eInFs][pasrc_ctrl->eOutFs].iFsRatioShift);
+    pasrc_ctrl->iTimeStepInt     = uiFsRatio >> (pasrc_ctrl->sFsRatioConfig.iFsRatioShift);
+    pasrc_ctrl->uiTimeStepFract  = uiFsRatio << (32 - pasrc_ctrl->sFsRatioConfig.iFsRatioShift);
 
     return ASRC_NO_ERROR;
 }
@@ -522,13 +1093,12 @@ ASRCReturnCodes_t                ASRC_proc_F3_in_spl(asrc_ctrl_t* pasrc_ctrl, in
 ASRCReturnCodes_t                ASRC_proc_F3_time(asrc_ctrl_t* pasrc_ctrl)
 {
     unsigned int    uiTemp;
+#if !ASRC_ADFIR_DENSE_PHASES
     int                iAlpha;
     int                iH[3]; //iH0, iH1, iH2;
-    int                iZero;
     __int64_t            i64Acc0;
-    int*            piPhase0;
-    int*            piPhase1;
-    int*            piPhase2;
+#endif
+    const int*        piPhase0;
     int*            piADCoefs;
 
     // Check if the next output time instant is in the current time slot
@@ -545,9 +1115,13 @@ ASRCReturnCodes_t                ASRC_proc_F3_time(asrc_ctrl_t* pasrc_ctrl)
     // Loop load approximation: 5.625 instructions per sample + 15 instructions overhead => 5.625 * 16 + 15 = 90 + 15 = 105 Instructions
     // Total: 125 instructions
 
-    // Set register to zero
-    iZero        = 0;
-
+#if ASRC_ADFIR_DENSE_PHASES
+    // Coefficients from the dense phase table (copied to the AD coefficients shared with the other channels)
+    piADCoefs        = pasrc_ctrl->piADCoefs;
+    piPhase0        = ASRC_F3_dense_coefs(pasrc_ctrl->iTimeInt, pasrc_ctrl->uiTimeFract, piADCoefs);
+    if(piPhase0 != piADCoefs)
+        memcpy(piADCoefs, piPhase0, FILTER_DEFS_ADFIR_PHASE_N_TAPS * sizeof(int));
+#else
     // Compute adative coefficients spline factors
     // The fractional part of time gives alpha
     iAlpha        = pasrc_ctrl->uiTimeFract>>1;        // Now alpha can be seen as a signed number
@@ -563,11 +1137,10 @@ ASRCReturnCodes_t                ASRC_proc_F3_time(asrc_ctrl_t* pasrc_ctrl)
 
     // The integer part of time gives the phase
     piPhase0        = iADFirCoefs[pasrc_ctrl->iTimeInt];
-    piPhase1        = piPhase0 + FILTER_DEFS_ADFIR_PHASE_N_TAPS;
-    piPhase2        = piPhase1 + FILTER_DEFS_ADFIR_PHASE_N_TAPS;
     piADCoefs        = pasrc_ctrl->piADCoefs;        // Given limited number of registers, this should be DP
 
-    src_mrhf_spline_coeff_gen_inner_loop_asm(piPhase0, iH, piADCoefs, FILTER_DEFS_ADFIR_PHASE_N_TAPS);
+    SRC_MRHF_SPLINE_COEFF_GEN_INNER_LOOP(piPhase0, iH, piADCoefs, FILTER_DEFS_ADFIR_PHASE_N_TAPS);
+#endif
 
     // Step time for next output sample
     // --------------------------------
@@ -622,8 +1195,10 @@ ASRCReturnCodes_t                ASRC_proc_dither(asrc_ctrl_t* pasrc_ctrl)
     int*            piData;
     unsigned int    uiR;
     int                iDither;
-    __int64_t            i64Acc;
+    __int64            i64Acc;
     unsigned int    ui;
+    unsigned int    uiStep;
+    unsigned int    uiEnd;
 
 
     // Apply dither if required
@@ -633,9 +1208,12 @@ ASRCReturnCodes_t                ASRC_proc_dither(asrc_ctrl_t* pasrc_ctrl)
         piData    = pasrc_ctrl->piOut;
         // Get random seed
         uiR        = pasrc_ctrl->psState->uiRndSeed;
+        // Get step and end of the samples (locals: the stores to piData could alias the ctrl fields)
+        uiStep    = pasrc_ctrl->uiStep;
+        uiEnd    = pasrc_ctrl->uiNASRCOutSamples * uiStep;
 
         // Loop through samples
-        for(ui = 0; ui < pasrc_ctrl->uiNASRCOutSamples * pasrc_ctrl->uiNchannels; ui += pasrc_ctrl->uiNchannels)
+        for(ui = 0; ui < uiEnd; ui += uiStep)
         {
             // Compute dither sample (TPDF)
             iDither        = ASRC_DITHER_BIAS;
@@ -648,12 +1226,8 @@ ASRCReturnCodes_t                ASRC_proc_dither(asrc_ctrl_t* pasrc_ctrl)
             uiR            = (unsigned int)(ASRC_R_CONS + uiR);
             iDither        += ((uiR>>ASRC_RPDF_BITS_SHIFT) & ASRC_RPDF_MASK);
 
-                        //unsigned iACCl = 0;
-                        //int iACCh = iDither;
-                        //pi_Data[ui] = dither_maths_asm(piData[ui],iACCh, iACCl);
-
             // Use MACC instruction to saturate and dither + signal
-            i64Acc        = ((__int64_t)iDither <<32);    // On XMOS this is not necessary, just load dither in the top word of the ACC register
+            i64Acc        = ((__int64)iDither <<32);    // On XMOS this is not necessary, just load dither in the top word of the ACC register
             MACC(&i64Acc, piData[ui], 0x7FFFFFFF);
             LSAT30(&i64Acc);
             // Extract 32bits result
@@ -670,3 +1244,183 @@ ASRCReturnCodes_t                ASRC_proc_dither(asrc_ctrl_t* pasrc_ctrl)
 
     return ASRC_NO_ERROR;
 }
+
+
+#if FIR_FLOAT
+// ==================================================================== //
+// Function:        ASRC_float_init                                        //
+// Arguments:        asrc_float_ctrl_t *pasrc_ctrl: Ctrl strct.            //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR on failure                                //
+// Description:        Inits the float ASRC passed as argument                //
+//                    (same filters and wiring as ASRC_init)                //
+// ==================================================================== //
+ASRCReturnCodes_t                ASRC_float_init(asrc_float_ctrl_t* pasrc_ctrl)
+{
+    ASRCFiltersIDs_t            sFiltersID;
+    ASRCFiltersIDs_t*            psFiltersID        = &sFiltersID;
+    FIRDescriptor_t*            psFIRDescriptor;
+
+
+    // Check if state is allocated
+    if(pasrc_ctrl->psState == 0)
+        return ASRC_ERROR;
+
+    // Check if stack is allocated
+    if(pasrc_ctrl->pfStack == 0)
+        return ASRC_ERROR;
+
+    // Check that number of input samples is allocated and is a multiple of 4
+    if(pasrc_ctrl->uiNInSamples == 0)
+        return ASRC_ERROR;
+    if((pasrc_ctrl->uiNInSamples & 0x3) != 0x0)
+        return ASRC_ERROR;
+
+    // Choose filters and Fs ratio configuration (fails if Fsin and Fsout are not supported)
+    if(ASRC_plan(pasrc_ctrl->uiInFs, pasrc_ctrl->uiOutFs, pasrc_ctrl->uiNInSamples, psFiltersID, &pasrc_ctrl->sFsRatioConfig, &pasrc_ctrl->uiFsRatioFracBits) != ASRC_NO_ERROR)
+        return ASRC_ERROR;
+
+    // Set nominal fs ratio
+    pasrc_ctrl->uiFsRatio    = pasrc_ctrl->sFsRatioConfig.uiNominalFsRatio;
+
+    // Select inner loop kernels (first call only)
+    src_kernels_init();
+
+    // Filter F1
+    // ---------
+    psFIRDescriptor                            = &sASRCFirDescriptor[psFiltersID->uiFID[ASRC_F1_INDEX]];
+    pasrc_ctrl->sFIRF1Ctrl.uiNInSamples        = pasrc_ctrl->uiNInSamples;
+    pasrc_ctrl->sFIRF1Ctrl.uiInStep            = pasrc_ctrl->uiNchannels;
+    if( (psFiltersID->uiFID[ASRC_F1_INDEX] == FILTER_DEFS_ASRC_FIR_DS_ID)
+#if SRC_ARBITRARY_FS
+        || (psFiltersID->uiFID[ASRC_F1_INDEX] == FILTER_DEFS_ASRC_FIR_DS4_ID)
+        || (psFiltersID->uiFID[ASRC_F1_INDEX] == FILTER_DEFS_ASRC_FIR_DS8_ID)
+        || (psFiltersID->uiFID[ASRC_F1_INDEX] == FILTER_DEFS_ASRC_FIR_DS16_ID)
+#endif
+        )
+        pasrc_ctrl->sFIRF1Ctrl.pfDelayB            = pasrc_ctrl->psState->fDelayFIRShort;
+    else
+        pasrc_ctrl->sFIRF1Ctrl.pfDelayB            = pasrc_ctrl->psState->fDelayFIRLong;
+    pasrc_ctrl->sFIRF1Ctrl.uiOutStep        = 1;
+
+    if(FIR_float_init_from_desc(&pasrc_ctrl->sFIRF1Ctrl, psFIRDescriptor) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+
+    if( psFiltersID->uiFID[ASRC_F1_INDEX] != FILTER_DEFS_ASRC_FIR_NONE_ID )
+        pasrc_ctrl->uiNSyncSamples                = pasrc_ctrl->sFIRF1Ctrl.uiNOutSamples;
+
+    // Filter F2
+    // ---------
+    psFIRDescriptor                            = &sASRCFirDescriptor[psFiltersID->uiFID[ASRC_F2_INDEX]];
+    pasrc_ctrl->sFIRF2Ctrl.uiNInSamples        = pasrc_ctrl->sFIRF1Ctrl.uiNOutSamples;
+    pasrc_ctrl->sFIRF2Ctrl.uiInStep            = pasrc_ctrl->sFIRF1Ctrl.uiOutStep;
+    pasrc_ctrl->sFIRF2Ctrl.pfDelayB            = pasrc_ctrl->psState->fDelayFIRLong;
+    pasrc_ctrl->sFIRF2Ctrl.uiOutStep        = 1;
+
+    if(FIR_float_init_from_desc(&pasrc_ctrl->sFIRF2Ctrl, psFIRDescriptor) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+
+    if( psFiltersID->uiFID[ASRC_F2_INDEX] != FILTER_DEFS_ASRC_FIR_NONE_ID )
+        pasrc_ctrl->uiNSyncSamples                = pasrc_ctrl->sFIRF2Ctrl.uiNOutSamples;
+
+    // Setup fixed input/output buffers for F1 and F2 (see ASRC_init)
+    // --------------------------------------------------------------
+    pasrc_ctrl->sFIRF2Ctrl.pfIn                = pasrc_ctrl->pfStack;
+    pasrc_ctrl->sFIRF1Ctrl.pfOut            = pasrc_ctrl->pfStack;
+    pasrc_ctrl->sFIRF2Ctrl.pfOut            = pasrc_ctrl->pfStack;
+
+    // Filter F3
+    // ---------
+    pasrc_ctrl->sADFIRF3Ctrl.pfDelayB        = pasrc_ctrl->psState->fDelayADFIR;
+    pasrc_ctrl->sADFIRF3Ctrl.pfADCoefs        = pasrc_ctrl->psState->fADCoefs;
+
+    if(ADFIR_float_init_from_desc(&pasrc_ctrl->sADFIRF3Ctrl, &sADFirDescriptor) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+
+    // Call sync function
+    if(ASRC_float_sync(pasrc_ctrl) != ASRC_NO_ERROR)
+        return ASRC_ERROR;
+
+    return ASRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ASRC_float_sync                                        //
+// Arguments:        asrc_float_ctrl_t *pasrc_ctrl: Ctrl strct.            //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR on failure                                //
+// Description:        Syncs the float ASRC passed as argument                //
+// ==================================================================== //
+ASRCReturnCodes_t                ASRC_float_sync(asrc_float_ctrl_t* pasrc_ctrl)
+{
+    // Sync the FIR and ADFIR
+    if(FIR_float_sync(&pasrc_ctrl->sFIRF1Ctrl) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+    if(FIR_float_sync(&pasrc_ctrl->sFIRF2Ctrl) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+    if(ADFIR_float_sync(&pasrc_ctrl->sADFIRF3Ctrl) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+
+    // Reset time
+    pasrc_ctrl->iTimeInt        = FILTER_DEFS_ADFIR_N_PHASES + ASRC_ADFIR_INITIAL_PHASE;
+    pasrc_ctrl->uiTimeFract        = 0;
+
+    // Update time step based on Fs ratio
+    if(ASRC_float_update_fs_ratio(pasrc_ctrl) != ASRC_NO_ERROR)
+        return ASRC_ERROR;
+
+    return ASRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ASRC_float_update_fs_ratio                            //
+// Arguments:        asrc_float_ctrl_t *pasrc_ctrl: Ctrl strct.            //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR on failure                                //
+// Description:        Updates the float ASRC with the new Fs ratio        //
+// ==================================================================== //
+ASRCReturnCodes_t                ASRC_float_update_fs_ratio(asrc_float_ctrl_t* pasrc_ctrl)
+{
+    unsigned int    uiFsRatio        = pasrc_ctrl->uiFsRatio;
+
+    // Check for bounds of new Fs ratio
+    if( (uiFsRatio < pasrc_ctrl->sFsRatioConfig.uiMinFsRatio) ||
+        (uiFsRatio > pasrc_ctrl->sFsRatioConfig.uiMaxFsRatio) )
+        return ASRC_ERROR;
+
+    // Apply shift to time ratio to build integer and fractional parts of time step
+    pasrc_ctrl->iTimeStepInt     = uiFsRatio >> (pasrc_ctrl->sFsRatioConfig.iFsRatioShift);
+    pasrc_ctrl->uiTimeStepFract  = uiFsRatio << (32 - pasrc_ctrl->sFsRatioConfig.iFsRatioShift);
+
+    return ASRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ASRC_float_proc_F1_F2                                //
+// Arguments:        asrc_float_ctrl_t *pasrc_ctrl: Ctrl strct.            //
+// Return values:    ASRC_NO_ERROR on success                            //
+//                    ASRC_ERROR on failure                                //
+// Description:        Processes float F1 and F2 for a channel                //
+// ==================================================================== //
+ASRCReturnCodes_t                ASRC_float_proc_F1_F2(asrc_float_ctrl_t* pasrc_ctrl)
+{
+    // Setup variable input / output buffers
+    pasrc_ctrl->sFIRF1Ctrl.pfIn            = pasrc_ctrl->pfIn;
+
+    // F1 is always enabled, so call F1
+    if(pasrc_ctrl->sFIRF1Ctrl.pvProc(&pasrc_ctrl->sFIRF1Ctrl) != FIR_NO_ERROR)
+        return ASRC_ERROR;
+
+    // Check if F2 is enabled
+    if(pasrc_ctrl->sFIRF2Ctrl.eEnable == FIR_ON)
+    {
+        if(pasrc_ctrl->sFIRF2Ctrl.pvProc(&pasrc_ctrl->sFIRF2Ctrl) != FIR_NO_ERROR)
+            return ASRC_ERROR;
+    }
+
+    return ASRC_NO_ERROR;
+}
+#endif // FIR_FLOAT
@@ -19,6 +19,7 @@
     //
     // ===========================================================================
     #include "src_mrhf_fir.h"
+    #include "src_mrhf_fir_float.h"
     #include "src_mrhf_filter_defs.h"
     #include "src.h"
     #include "src_mrhf_spline_coeff_gen_inner_loop_asm.h"
@@ -36,6 +37,39 @@
     #define        ASRC_ADFIR_COEFS_LENGTH                FILTER_DEFS_ADFIR_PHASE_N_TAPS        // Length of AD FIR coefficients buffer
     #define     ASRC_NOMINAL_FS_SCALE           (268435456)      //Nominal Fs Ratio scale value in 4.28 format
 
+    // Dense ADFIR phase table
+    // -----------------------
+    // With ASRC_ADFIR_DENSE_PHASES set to a multiple of FILTER_DEFS_ADFIR_N_PHASES (e.g. 1024 or 4096),
+    // the F3 coefficients are precomputed by the spline interpolation for that many phases on the first
+    // ASRC_init() call, and for each output sample they are read from this table in place of the spline
+    // coefficients generation: linearly interpolated between the two nearest phases with
+    // ASRC_ADFIR_DENSE_LINEAR set to 1 (2 in place of 3 multiplies per tap), or the nearest phase as is
+    // with ASRC_ADFIR_DENSE_LINEAR set to 0 (no computation). The table takes
+    // (ASRC_ADFIR_DENSE_PHASES + 1) x 64 bytes. 0 (default) keeps the spline coefficients generation.
+    #ifndef ASRC_ADFIR_DENSE_PHASES
+    #define        ASRC_ADFIR_DENSE_PHASES                0
+    #endif
+    #ifndef ASRC_ADFIR_DENSE_LINEAR
+    #define        ASRC_ADFIR_DENSE_LINEAR                1
+    #endif
+    #if (ASRC_ADFIR_DENSE_PHASES % FILTER_DEFS_ADFIR_N_PHASES) != 0
+    #error "ASRC_ADFIR_DENSE_PHASES must be a multiple of FILTER_DEFS_ADFIR_N_PHASES"
+    #endif
+    #define        ASRC_ADFIR_DENSE_PHASE_MULT            (ASRC_ADFIR_DENSE_PHASES / FILTER_DEFS_ADFIR_N_PHASES)    // Dense phases per ADFIR phase
+
+    // Multithreaded ASRC
+    // ------------------
+    // asrc_mt_process splits the channels of one ASRC instance across a pool of POSIX threads. Host
+    // builds only (on xCORE, channels are split across ASRC_N_INSTANCES logical cores).
+    #ifndef ASRC_MT
+    #if defined(__xcore__)
+    #define        ASRC_MT                                0
+    #else
+    #define        ASRC_MT                                1
+    #endif
+    #endif
+    #define        ASRC_MT_MAX_THREADS                    64                                    // Maximal number of threads of a pool (including the calling thread)
+
 
     // Parameter values
     // ----------------
@@ -82,11 +116,15 @@
             ASRC_FS_96                                = 3,                                // Fs = 96kHz code
             ASRC_FS_176                                = 4,                                // Fs = 176.4kHz code
             ASRC_FS_192                                = 5,                                // Fs = 192kHz code
+            ASRC_FS_NONE                                = 6,                                // Fs without a code (rates given in Hz)
         } ASRCFs_t;
         #define        ASRC_N_FS                        (ASRC_FS_192 + 1)
         #define        ASRC_FS_MIN                        ASRC_FS_44
         #define        ASRC_FS_MAX                        ASRC_FS_192
 
+        // Sampling rates of the codes above (Hz)
+        extern const unsigned int        uiASRCFsHz[ASRC_N_FS];
+
 
         // ASRC Filters IDs structure
         // --------------------------
@@ -109,77 +147,110 @@
             int                    iFsRatioShift;
         } ASRCFsRatioConfigs_t;
 
+        // Maximal Fs ratio range (ppm of the nominal Fs ratio, see ASRC_set_fs_ratio_range)
+        #define        ASRC_FS_RATIO_RANGE_MAX            500000
+
+#if SRC_ARBITRARY_FS
+        // ASRC FIR band edges (for the stage planner)
+        // -------------------------------------------
+        typedef struct _ASRCFirBands
+        {
+            unsigned int        uiPass;                                                    // Pass band edge (-0.01dB), in 1/10000 of the coefficients rate
+            unsigned int        uiStop;                                                    // Stop band edge (-100dB), in 1/10000 of the coefficients rate
+        } ASRCFirBands_t;
+#endif
+
         // ASRC State structure
         // --------------------
         typedef struct _ASRCState
         {
             long long                               pad_to_64b_alignment;               //Force compiler to 64b align
             unsigned int                            uiRndSeed;                                                // Dither random seeds current values
-            int                                        iDelayFIRLong[2 * FILTER_DEFS_FIR_MAX_TAPS_LONG];        // Doubled length for circular buffer simulation
-            int                                        iDelayFIRShort[2 * FILTER_DEFS_FIR_MAX_TAPS_SHORT];        // Doubled length for circular buffer simulation
-            int                                        iDelayADFIR[2 * FILTER_DEFS_ADFIR_PHASE_N_TAPS];        // Doubled length for circular buffer simulation
+            int                                        iDelayFIRLong[FIR_DELAY_LEN(FILTER_DEFS_FIR_MAX_TAPS_LONG)];        // Delay line (see FIR_DELAY_LEN)
+            int                                        iDelayFIRShort[FIR_DELAY_LEN(FILTER_DEFS_ASRC_FIR_MAX_TAPS_SHORT)];    // Delay line (see FIR_DELAY_LEN)
+            int                                        iDelayADFIR[FIR_DELAY_LEN(FILTER_DEFS_ADFIR_PHASE_N_TAPS)];        // Delay line (see FIR_DELAY_LEN)
         } asrc_state_t;
 
 
         // ASRC Control structure
         // ----------------------
+        // The fields used per output sample by F3 come first, next to each other. They take 120 bytes
+        // on 64 bit hosts (sADFIRF3Ctrl alone is 64), so the structure is not aligned to a cache line
         typedef struct _ASRCCtrl
         {
 #ifdef __XC__
+            // Used per output sample by F3, for each channel
             long long                               pad_to_64b_alignment;               //Force compiler to 64b align
-            unsigned int                            uiNchannels;                        // Number of channels in this instance
-            int* unsafe                                piIn;                                // Input buffer pointer (PCM, 32bits, 2 channels time domain interleaved data)
-            unsigned int                            uiNInSamples;                        // Number of input samples to process in one call to the processing function
-            unsigned int                            uiNSyncSamples;                        // Number of synchronous samples produced in one call to the processing function
-            ASRCFs_t                                eInFs;                                // Input sampling rate code
             int* unsafe                                piOut;                                // Output buffer poin ter (PCM, 32bits, 2 channels time domain interleaved data)
-            unsigned int                            uiNASRCOutSamples;                    // Number of output samples produced during last call to the asynchronous processing function
-            ASRCFs_t                                eOutFs;                                // Output sampling rate code
-
-            FIRCtrl_t                                sFIRF1Ctrl;                            // F1 FIR controller
-            FIRCtrl_t                                sFIRF2Ctrl;                            // F2 FIR controller
+            int* unsafe                                piStack;                            // Pointer to stack buffer
             ADFIRCtrl_t                                sADFIRF3Ctrl;                        // F3 ADFIR controller
 
-            unsigned int                            uiFsRatio;                            // Fs ratio: Fsin / Fsout
-
+            // Used per output sample by F3 for the first channel, per block for the others
+            unsigned int                            uiStep;                                // Step between the samples of a channel in the input and output buffers (uiNchannels interleaved, 1 planar)
             int                                        iTimeInt;                            // Integer part of time
             unsigned int                            uiTimeFract;                        // Fractional part of time
             int                                        iTimeStepInt;                        // Integer part of time step
             unsigned int                            uiTimeStepFract;                    // Fractional part of time step
-
+            unsigned int                            uiNSyncSamples;                        // Number of synchronous samples produced in one call to the processing function
+            unsigned int                            uiNSyncSamplesUsed;                    // Number of these synchronous samples already pushed into the F3 delay line
+            unsigned int                            uiNASRCOutSamples;                    // Number of output samples produced during last call to the asynchronous processing function
+            unsigned int                            uiNchannels;                        // Number of channels in this instance
             unsigned int                            uiDitherOnOff;                        // Dither on/off flag
-            unsigned int                            uiRndSeedInit;                        // Dither random seed initial value
 
+            // Used per block
+            int* unsafe                                piIn;                                // Input buffer pointer (PCM, 32bits, 2 channels time domain interleaved data)
+            unsigned int                            uiNInSamples;                        // Number of input samples to process in one call to the processing function
+            unsigned int                            uiFsRatio;                            // Fs ratio: Fsin / Fsout
+            FIRCtrl_t                                sFIRF1Ctrl;                            // F1 FIR controller
+            FIRCtrl_t                                sFIRF2Ctrl;                            // F2 FIR controller
             asrc_state_t* unsafe                        psState;                            // Pointer to state structure
-            int* unsafe                                piStack;                            // Pointer to stack buffer
+
+            // Configuration, used at initialisation and on Fs ratio updates
+            ASRCFsRatioConfigs_t                    sFsRatioConfig;                        // Nominal, min and max Fs ratios and time step shift for Fsin and Fsout
+            unsigned int                            uiFsRatioRange;                        // Fs ratio range: maximal deviation from nominal (ppm), 0 for +/-1%
+            unsigned int                            uiInFs;                                // Input sampling rate (Hz)
+            unsigned int                            uiOutFs;                            // Output sampling rate (Hz)
+            ASRCFs_t                                eInFs;                                // Input sampling rate code (ASRC_FS_NONE for rates without a code)
+            ASRCFs_t                                eOutFs;                                // Output sampling rate code (ASRC_FS_NONE for rates without a code)
+            unsigned int                            uiFsRatioFracBits;                    // Fractional bits of the Fs ratios: 28 (4.28 format), 24 (8.24) for Fs ratios of 16 and above
+            unsigned int                            uiRndSeedInit;                        // Dither random seed initial value
             int* unsafe                                piADCoefs;                            // Pointer to AD coefficients
 #else
+            // Used per output sample by F3, for each channel
             long long                               pad_to_64b_alignment;               //Force compiler to 64b align
-            unsigned int                            uiNchannels;                        // Number of channels in this instance
-            int*                                    piIn;                                // Input buffer pointer (PCM, 32bits, 2 channels time domain interleaved data)
-            unsigned int                            uiNInSamples;                        // Number of input samples to process in one call to the processing function
-            unsigned int                            uiNSyncSamples;                        // Number of synchronous samples produced in one call to the processing function
-            ASRCFs_t                                eInFs;                                // Input sampling rate code
             int*                                    piOut;                                // Output buffer poin ter (PCM, 32bits, 2 channels time domain interleaved data)
-            unsigned int                            uiNASRCOutSamples;                    // Number of output samples produced during last call to the asynchronous processing function
-            ASRCFs_t                                eOutFs;                                // Output sampling rate code
-
-            FIRCtrl_t                                sFIRF1Ctrl;                            // F1 FIR controller
-            FIRCtrl_t                                sFIRF2Ctrl;                            // F2 FIR controller
+            int*                                    piStack;                            // Pointer to stack buffer
             ADFIRCtrl_t                                sADFIRF3Ctrl;                        // F3 ADFIR controller
 
-            unsigned int                            uiFsRatio;                            // Fs ratio: Fsin / Fsout
-
+            // Used per output sample by F3 for the first channel, per block for the others
+            unsigned int                            uiStep;                                // Step between the samples of a channel in the input and output buffers (uiNchannels interleaved, 1 planar)
             int                                        iTimeInt;                            // Integer part of time
             unsigned int                            uiTimeFract;                        // Fractional part of time
             int                                        iTimeStepInt;                        // Integer part of time step
             unsigned int                            uiTimeStepFract;                    // Fractional part of time step
-
+            unsigned int                            uiNSyncSamples;                        // Number of synchronous samples produced in one call to the processing function
+            unsigned int                            uiNSyncSamplesUsed;                    // Number of these synchronous samples already pushed into the F3 delay line
+            unsigned int                            uiNASRCOutSamples;                    // Number of output samples produced during last call to the asynchronous processing function
+            unsigned int                            uiNchannels;                        // Number of channels in this instance
             unsigned int                            uiDitherOnOff;                        // Dither on/off flag
-            unsigned int                            uiRndSeedInit;                        // Dither random seed initial value
 
+            // Used per block
+            int*                                    piIn;                                // Input buffer pointer (PCM, 32bits, 2 channels time domain interleaved data)
+            unsigned int                            uiNInSamples;                        // Number of input samples to process in one call to the processing function
+            unsigned int                            uiFsRatio;                            // Fs ratio: Fsin / Fsout
+            FIRCtrl_t                                sFIRF1Ctrl;                            // F1 FIR controller
+            FIRCtrl_t                                sFIRF2Ctrl;                            // F2 FIR controller
             asrc_state_t*                            psState;                            // Pointer to state structure
-            int*                                    piStack;                            // Pointer to stack buffer
+
+            // Configuration, used at initialisation and on Fs ratio updates
+            ASRCFsRatioConfigs_t                    sFsRatioConfig;                        // Nominal, min and max Fs ratios and time step shift for Fsin and Fsout
+            unsigned int                            uiFsRatioRange;                        // Fs ratio range: maximal deviation from nominal (ppm), 0 for +/-1%
+            unsigned int                            uiInFs;                                // Input sampling rate (Hz)
+            unsigned int                            uiOutFs;                            // Output sampling rate (Hz)
+            ASRCFs_t                                eInFs;                                // Input sampling rate code (ASRC_FS_NONE for rates without a code)
+            ASRCFs_t                                eOutFs;                                // Output sampling rate code (ASRC_FS_NONE for rates without a code)
+            unsigned int                            uiFsRatioFracBits;                    // Fractional bits of the Fs ratios: 28 (4.28 format), 24 (8.24) for Fs ratios of 16 and above
+            unsigned int                            uiRndSeedInit;                        // Dither random seed initial value
             int*                                    piADCoefs;                            // Pointer to AD coefficients
 #endif
         } asrc_ctrl_t;
@@ -198,6 +269,50 @@
 
 
 
+#if FIR_FLOAT
+        // ASRC float State structure
+        // --------------------------
+        typedef struct _ASRCFloatState
+        {
+            float                                    fDelayFIRLong[FIR_DELAY_LEN(FILTER_DEFS_FIR_MAX_TAPS_LONG)];        // Delay line (see FIR_DELAY_LEN)
+            float                                    fDelayFIRShort[FIR_DELAY_LEN(FILTER_DEFS_ASRC_FIR_MAX_TAPS_SHORT)];    // Delay line (see FIR_DELAY_LEN)
+            float                                    fDelayADFIR[FIR_DELAY_LEN(FILTER_DEFS_ADFIR_PHASE_N_TAPS)];        // Delay line (see FIR_DELAY_LEN)
+            float                                    fADCoefs[ASRC_ADFIR_COEFS_LENGTH];                                    // Adaptive FIR coefficients (those of the first channel are used by all channels)
+        } asrc_float_state_t;
+
+
+        // ASRC float Control structure
+        // ----------------------------
+        typedef struct _ASRCFloatCtrl
+        {
+            unsigned int                            uiNchannels;                        // Number of channels in this instance
+            float*                                    pfIn;                                // Input buffer pointer (full scale +/-1.0, channels time domain interleaved data)
+            unsigned int                            uiNInSamples;                        // Number of input samples to process in one call to the processing function
+            unsigned int                            uiNSyncSamples;                        // Number of synchronous samples produced in one call to the processing function
+            unsigned int                            uiInFs;                                // Input sampling rate (Hz)
+            float*                                    pfOut;                                // Output buffer pointer (full scale +/-1.0, channels time domain interleaved data)
+            unsigned int                            uiNASRCOutSamples;                    // Number of output samples produced during last call to the asynchronous processing function
+            unsigned int                            uiOutFs;                            // Output sampling rate (Hz)
+
+            FIRFloatCtrl_t                            sFIRF1Ctrl;                            // F1 FIR controller
+            FIRFloatCtrl_t                            sFIRF2Ctrl;                            // F2 FIR controller
+            ADFIRFloatCtrl_t                        sADFIRF3Ctrl;                        // F3 ADFIR controller
+
+            unsigned int                            uiFsRatio;                            // Fs ratio: Fsin / Fsout
+            ASRCFsRatioConfigs_t                    sFsRatioConfig;                        // Nominal, min and max Fs ratios and time step shift for Fsin and Fsout
+            unsigned int                            uiFsRatioFracBits;                    // Fractional bits of the Fs ratios: 28 (4.28 format), 24 (8.24) for Fs ratios of 16 and above
+
+            int                                        iTimeInt;                            // Integer part of time
+            unsigned int                            uiTimeFract;                        // Fractional part of time
+            int                                        iTimeStepInt;                        // Integer part of time step
+            unsigned int                            uiTimeStepFract;                    // Fractional part of time step
+
+            asrc_float_state_t*                        psState;                            // Pointer to state structure
+            float*                                    pfStack;                            // Pointer to stack buffer
+        } asrc_float_ctrl_t;
+#endif
+
+
         // ===========================================================================
         //
         // Function prototypes
@@ -206,14 +321,29 @@
 
         // ==================================================================== //
         // Function:        ASRC_prepare_coefs                                  //
-        // Arguments:       asrc_ctrl_t  *pasrc_ctrl: Ctrl strct.                //
+        // Arguments:       None                                                //
         // Return values:   ASRC_NO_ERROR on success                            //
         //                  ASRC_ERROR on failure                               //
-        // Description:     Prepares the ASRC coefficients from the prototype   //
-        //                  Needs to be called only once                        //
+        // Description:     Prepares the dense ADFIR phase table if enabled     //
+        //                  (ASRC_ADFIR_DENSE_PHASES, first call only, called   //
+        //                  by ASRC_init). The ASRC coefficients (iADFirCoefs)  //
+        //                  are prepared from the prototype at build time       //
         // ==================================================================== //
         ASRCReturnCodes_t               ASRC_prepare_coefs(void);
 
+#if ASRC_ADFIR_DENSE_PHASES
+        // ==================================================================== //
+        // Function:        ASRC_F3_dense_coefs                                 //
+        // Arguments:       int iTimeInt: Integer part of time                  //
+        //                  unsigned int uiTimeFract: Fractional part of time   //
+        //                  int *piADCoefs: AD coefficients buffer              //
+        // Return values:   Pointer to the F3 coefficients for time: the dense  //
+        //                  table phase (nearest) or piADCoefs (linear)         //
+        // Description:     F3 coefficients from the dense ADFIR phase table    //
+        // ==================================================================== //
+        const int*                      ASRC_F3_dense_coefs(int iTimeInt, unsigned int uiTimeFract, int* piADCoefs);
+#endif
+
         // ==================================================================== //
         // Function:        ASRC_init                                            //
         // Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
@@ -232,6 +362,64 @@
         // ==================================================================== //
         ASRCReturnCodes_t                ASRC_sync(asrc_ctrl_t* pasrc_ctrl);
 
+        // ==================================================================== //
+        // Function:        ASRC_change_rate                                    //
+        // Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+        // Return values:    ASRC_NO_ERROR on success                            //
+        //                    ASRC_ERROR on failure                                //
+        // Description:        Switches an initialised ASRC to new Fsin and Fsout    //
+        //                    (uiInFs, uiOutFs) without clearing its delay lines    //
+        // ==================================================================== //
+        ASRCReturnCodes_t                ASRC_change_rate(asrc_ctrl_t* pasrc_ctrl);
+
+        // ==================================================================== //
+        // Function:        ASRC_set_fs_ratio_range                                //
+        // Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+        // Return values:    ASRC_NO_ERROR on success                            //
+        //                    ASRC_ERROR on failure                                //
+        // Description:        Sets the min and max Fs ratios from the nominal Fs    //
+        //                    ratio and the Fs ratio range (uiFsRatioRange)        //
+        // ==================================================================== //
+        ASRCReturnCodes_t                ASRC_set_fs_ratio_range(asrc_ctrl_t* pasrc_ctrl);
+
+        // ==================================================================== //
+        // Function:        ASRC_set_step                                        //
+        // Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+        //                    unsigned int uiStep: Step between the samples of    //
+        //                    the channel in the input and output buffers            //
+        // Return values:    ASRC_NO_ERROR on success                            //
+        //                    ASRC_ERROR on failure                                //
+        // Description:        Sets the input and output buffers layout of an        //
+        //                    initialised ASRC: interleaved (uiNchannels) or        //
+        //                    planar (1)                                            //
+        // ==================================================================== //
+        ASRCReturnCodes_t                ASRC_set_step(asrc_ctrl_t* pasrc_ctrl, unsigned int uiStep);
+
+        // ==================================================================== //
+        // Function:        ASRC_get_stack_length                                //
+        // Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+        //                    unsigned int *puiStackLength: Stack length            //
+        // Return values:    ASRC_NO_ERROR on success                            //
+        //                    ASRC_ERROR on failure                                //
+        // Description:        Gets the length of the stack used by an ASRC for    //
+        //                    uiInFs, uiOutFs and uiNInSamples, before it is        //
+        //                    initialised                                            //
+        // ==================================================================== //
+        ASRCReturnCodes_t                ASRC_get_stack_length(asrc_ctrl_t* pasrc_ctrl, unsigned int* puiStackLength);
+
+        // ==================================================================== //
+        // Function:        ASRC_get_delay                                        //
+        // Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
+        //                    long long *pi64Delay: Group delay (Q32 format)        //
+        //                    unsigned long long *pu64OutRatio: Fsout / Fsin    //
+        //                    (Q32 format)                                        //
+        // Return values:    ASRC_NO_ERROR on success                            //
+        //                    ASRC_ERROR on failure                                //
+        // Description:        Gets the group delay at DC of the filters F1, F2    //
+        //                    and F3 in input samples, at the nominal Fs ratio    //
+        // ==================================================================== //
+        ASRCReturnCodes_t                ASRC_get_delay(asrc_ctrl_t* pasrc_ctrl, long long* pi64Delay, unsigned long long* pu64OutRatio);
+
         // ==================================================================== //
         // Function:        ASRC_proc_F1_F2                                        //
         // Arguments:        asrc_ctrl_t     *pasrc_ctrl: Ctrl strct.                //
@@ -288,6 +476,44 @@
         // ==================================================================== //
         ASRCReturnCodes_t                ASRC_proc_dither(asrc_ctrl_t* pasrc_ctrl);
 
+#if FIR_FLOAT
+        // ==================================================================== //
+        // Function:        ASRC_float_init                                        //
+        // Arguments:        asrc_float_ctrl_t *pasrc_ctrl: Ctrl strct.            //
+        // Return values:    ASRC_NO_ERROR on success                            //
+        //                    ASRC_ERROR on failure                                //
+        // Description:        Inits the float ASRC passed as argument            //
+        // ==================================================================== //
+        ASRCReturnCodes_t                ASRC_float_init(asrc_float_ctrl_t* pasrc_ctrl);
+
+        // ==================================================================== //
+        // Function:        ASRC_float_sync                                        //
+        // Arguments:        asrc_float_ctrl_t *pasrc_ctrl: Ctrl strct.            //
+        // Return values:    ASRC_NO_ERROR on success                            //
+        //                    ASRC_ERROR on failure                                //
+        // Description:        Syncs the float ASRC passed as argument                //
+        // ==================================================================== //
+        ASRCReturnCodes_t                ASRC_float_sync(asrc_float_ctrl_t* pasrc_ctrl);
+
+        // ==================================================================== //
+        // Function:        ASRC_float_update_fs_ratio                            //
+        // Arguments:        asrc_float_ctrl_t *pasrc_ctrl: Ctrl strct.            //
+        // Return values:    ASRC_NO_ERROR on success                            //
+        //                    ASRC_ERROR on failure                                //
+        // Description:        Updates the float ASRC with the new Fs ratio        //
+        // ==================================================================== //
+        ASRCReturnCodes_t                ASRC_float_update_fs_ratio(asrc_float_ctrl_t* pasrc_ctrl);
+
+        // ==================================================================== //
+        // Function:        ASRC_float_proc_F1_F2                                //
+        // Arguments:        asrc_float_ctrl_t *pasrc_ctrl: Ctrl strct.            //
+        // Return values:    ASRC_NO_ERROR on success                            //
+        //                    ASRC_ERROR on failure                                //
+        // Description:        Processes float F1 and F2 for a channel                //
+        // ==================================================================== //
+        ASRCReturnCodes_t                ASRC_float_proc_F1_F2(asrc_float_ctrl_t* pasrc_ctrl);
+#endif
+
     #endif // nINCLUDE_FROM_ASM
 
 #endif // _SRC_MRHF_ASRC_H_
@@ -1,50 +1,124 @@
 // Copyright (c) 2016, XMOS Ltd, All rights reserved
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE             // pthread_setaffinity_np, to pin the asrc_mt_process worker threads
+#endif
 // General includes
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
+#include <limits.h>
+#if defined(__xcore__)
 #include <timer.h>
 #include "debug_print.h"
+#else
+#define debug_printf            printf
+#endif
 
 // ASRC includes
 #include "src.h"
+#include "src_kernels.h"
 
-extern ASRCFsRatioConfigs_t     sFsRatioConfigs[ASRC_N_FS][ASRC_N_FS];
+#if ASRC_MT
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#endif
 
 #define DO_FS_BOUNDS_CHECK      1   //This is important to prevent pointers going out of bounds when invalid fs_ratios are sent
 
+// Number of output samples whose F3 time instants and adaptive coefficients are computed in one go by
+// asrc_process, before running the F3 MACs of all channels over them
+#define ASRC_F3_BATCH_N_OUT     16
+
+//The following is replicated/inlined code from ASRC_proc_F3_in_spl in ASRC.c and ADFIR_proc_in_spl in FIR.c
+//Pushes synchronous sample uiSync (F1/F2 output on stack) into the F3 delay line of channel uj
+#define ASRC_F3_PUSH(uj, uiSync) \
+    do { \
+        FIR_DELAY_WRITE(asrc_ctrl[uj].sADFIRF3Ctrl.piDelayI, asrc_ctrl[uj].sADFIRF3Ctrl.uiDelayO, 0, asrc_ctrl[uj].piStack[uiSync]); \
+        FIR_DELAY_STEP(asrc_ctrl[uj].sADFIRF3Ctrl.piDelayB, asrc_ctrl[uj].sADFIRF3Ctrl.piDelayI, asrc_ctrl[uj].sADFIRF3Ctrl.piDelayW, asrc_ctrl[uj].sADFIRF3Ctrl.uiDelayO, 1); \
+    } while(0)
+
+//The following is replicated/inlined code from ADFIR_F3_proc_macc in ASRC.c and ADFIR_proc_macc in FIR.c
+//Applies filter F3 for channel uj with INNER_LOOP (chosen for the delay line data alignment) and the
+//adaptive coefficients piCoefs, writing output sample uiOut
+#define ASRC_F3_PROC_MACC(uj, INNER_LOOP, piCoefs, uiOut) \
+    INNER_LOOP(FIR_DELAY_DATA(asrc_ctrl[uj].sADFIRF3Ctrl.piDelayI, asrc_ctrl[uj].sADFIRF3Ctrl.uiDelayO), \
+        (int *)(piCoefs), asrc_ctrl[uj].piOut + uiOutStep * (uiOut), asrc_ctrl[uj].sADFIRF3Ctrl.uiNLoops)
+
+// Inner loops of filter F3: on xCORE the assembler variant for the data alignment, elsewhere
+// the kernel selected for the number of taps by ADFIR_init_from_desc (pvInnerLoop)
+#if defined(__xcore__)
+#define ASRC_F3_INNER_LOOP_EVEN(uj)     SRC_MRHF_ADFIR_INNER_LOOP_EVEN
+#define ASRC_F3_INNER_LOOP_ODD(uj)      SRC_MRHF_ADFIR_INNER_LOOP_ODD
+#else
+#define ASRC_F3_INNER_LOOP_EVEN(uj)     asrc_ctrl[uj].sADFIRF3Ctrl.pvInnerLoop
+#define ASRC_F3_INNER_LOOP_ODD(uj)      asrc_ctrl[uj].sADFIRF3Ctrl.pvInnerLoop
+#endif
+
 static void asrc_error(int code)
 {
     debug_printf("ASRC_proc Error code %d\n", code);
+#if defined(__xcore__)
     delay_milliseconds(1); //Allow xscope to display message before quit
+#endif
     _Exit(code);
 }
 
 
+// Sampling rate of FS code fs (0, which is not supported, for an invalid code)
+static unsigned asrc_fs_hz(const fs_code_t fs)
+{
+    if (((int)fs < ASRC_FS_MIN) || ((int)fs > ASRC_FS_MAX)) return 0;
+    return uiASRCFsHz[fs];
+}
+
 unsigned asrc_init(const fs_code_t sr_in, const fs_code_t sr_out, asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
         const unsigned n_in_samples, const dither_flag_t dither_on_off)
+{
+    unsigned fs_ratio = asrc_init_hz(asrc_fs_hz(sr_in), asrc_fs_hz(sr_out), asrc_ctrl, n_channels_per_instance, n_in_samples, dither_on_off);
+
+    if (fs_ratio == 0) asrc_error(11);
+    return fs_ratio;
+}
+
+unsigned asrc_rate_supported(const unsigned fs_in, const unsigned fs_out, const unsigned n_in_samples)
+{
+    asrc_ctrl_t asrc_ctrl;
+    unsigned stack_length;
+
+    // ASRC_init needs a multiple of 4 input samples, and the filters of ASRC_init_F1_F2 are planned as for the stack length
+    if ((n_in_samples == 0) || (n_in_samples & 0x3)) return 0;
+    asrc_ctrl.uiInFs                        = fs_in;
+    asrc_ctrl.uiOutFs                       = fs_out;
+    asrc_ctrl.uiNInSamples                  = n_in_samples;
+
+    return (ASRC_get_stack_length(&asrc_ctrl, &stack_length) == ASRC_NO_ERROR);
+}
+
+unsigned asrc_init_hz(const unsigned fs_in, const unsigned fs_out, asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
+        const unsigned n_in_samples, const dither_flag_t dither_on_off)
 {
     unsigned ui;
 
     ASRCReturnCodes_t ret_code;
 
-    ret_code = ASRC_prepare_coefs();
-    if (ret_code != ASRC_NO_ERROR) asrc_error(10);
-
     //Check to see if n_channels_per_instance, n_in_samples are reasonable
     if ((n_in_samples & 0x1) || (n_in_samples < 4)) asrc_error(100);
     if (n_channels_per_instance < 1) asrc_error(101);
 
+    //Pairs of rates without a plan are left to the caller
+    if (!asrc_rate_supported(fs_in, fs_out, n_in_samples)) return 0;
 
     for(ui = 0; ui < n_channels_per_instance; ui++)
     {
         // Set number of channels per instance
         asrc_ctrl[ui].uiNchannels               = n_channels_per_instance;
 
-        // Set input/output sampling rate codes
-        asrc_ctrl[ui].eInFs                     = (int)sr_in;
-        asrc_ctrl[ui].eOutFs                    = (int)sr_out;
+        // Set input/output sampling rates
+        asrc_ctrl[ui].uiInFs                    = fs_in;
+        asrc_ctrl[ui].uiOutFs                   = fs_out;
 
         // Set number of samples
         asrc_ctrl[ui].uiNInSamples              = n_in_samples;
@@ -53,6 +127,9 @@ unsigned asrc_init(const fs_code_t sr_in, const fs_code_t sr_out, asrc_ctrl_t as
         asrc_ctrl[ui].uiDitherOnOff             = dither_on_off;
         asrc_ctrl[ui].uiRndSeedInit             = 12345 * ui;   //Some randomish numbers. Value not critical
 
+        // Default Fs ratio range (+/-1%)
+        asrc_ctrl[ui].uiFsRatioRange            = 0;
+
         // Init ASRC instances
         ret_code = ASRC_init(&asrc_ctrl[ui]);
         if (ret_code != ASRC_NO_ERROR) asrc_error(11);
@@ -69,104 +146,275 @@ unsigned asrc_init(const fs_code_t sr_in, const fs_code_t sr_out, asrc_ctrl_t as
     return (asrc_ctrl[0].uiFsRatio);
 }
 
-unsigned asrc_process(int *in_buff, int *out_buff, unsigned fs_ratio, asrc_ctrl_t asrc_ctrl[]){
+unsigned asrc_get_fs_ratio_frac_bits(asrc_ctrl_t asrc_ctrl[])
+{
+    return asrc_ctrl[0].uiFsRatioFracBits;
+}
 
-    int ui, uj; //General counters
-    int             uiSplCntr;  //Spline counter
+// Rounds an arena block size up to keep the next block SRC_ARENA_ALIGN bytes aligned
+static unsigned asrc_arena_round(unsigned size)
+{
+    return (size + SRC_ARENA_ALIGN - 1) & ~(SRC_ARENA_ALIGN - 1);
+}
 
-    // Get the number of channels per instance from first channel
-    const unsigned n_channels_per_instance = asrc_ctrl[0].uiNchannels;
+// Stack length of each channel of an instance
+static unsigned asrc_stack_length(const unsigned fs_in, const unsigned fs_out, const unsigned n_in_samples)
+{
+    asrc_ctrl_t asrc_ctrl;
+    unsigned stack_length;
+
+    asrc_ctrl.uiInFs                        = fs_in;
+    asrc_ctrl.uiOutFs                       = fs_out;
+    asrc_ctrl.uiNInSamples                  = n_in_samples;
+    if (ASRC_get_stack_length(&asrc_ctrl, &stack_length) != ASRC_NO_ERROR) asrc_error(18);
+
+    return stack_length;
+}
+
+unsigned asrc_get_memory_size(const fs_code_t sr_in, const fs_code_t sr_out, const unsigned n_channels_per_instance,
+        const unsigned n_in_samples)
+{
+    unsigned size = asrc_get_memory_size_hz(asrc_fs_hz(sr_in), asrc_fs_hz(sr_out), n_channels_per_instance, n_in_samples);
+
+    if (size == 0) asrc_error(18);
+    return size;
+}
+
+unsigned asrc_get_memory_size_hz(const unsigned fs_in, const unsigned fs_out, const unsigned n_channels_per_instance,
+        const unsigned n_in_samples)
+{
+    unsigned stack_length;
+
+    //Check to see if n_channels_per_instance, n_in_samples are reasonable
+    if ((n_in_samples & 0x1) || (n_in_samples < 4)) asrc_error(100);
+    if (n_channels_per_instance < 1) asrc_error(101);
+
+    //Pairs of rates without a plan are left to the caller
+    if (!asrc_rate_supported(fs_in, fs_out, n_in_samples)) return 0;
+
+    stack_length = asrc_stack_length(fs_in, fs_out, n_in_samples);
+
+    return asrc_arena_round(n_channels_per_instance * sizeof(asrc_ctrl_t)) + asrc_arena_round(sizeof(asrc_adfir_coefs_t)) +
+           n_channels_per_instance * (asrc_arena_round(sizeof(asrc_state_t)) + asrc_arena_round(stack_length * sizeof(int)));
+}
+
+unsigned asrc_init_arena(const fs_code_t sr_in, const fs_code_t sr_out, asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
+        const unsigned n_in_samples, const dither_flag_t dither_on_off)
+{
+    unsigned fs_ratio = asrc_init_arena_hz(asrc_fs_hz(sr_in), asrc_fs_hz(sr_out), asrc_ctrl, n_channels_per_instance, n_in_samples, dither_on_off);
+
+    if (fs_ratio == 0) asrc_error(11);
+    return fs_ratio;
+}
+
+unsigned asrc_init_arena_hz(const unsigned fs_in, const unsigned fs_out, asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
+        const unsigned n_in_samples, const dither_flag_t dither_on_off)
+{
+    char *arena = (char *)asrc_ctrl;
+    asrc_adfir_coefs_t *adfir_coefs;
+    unsigned stack_length;
+    unsigned ui;
+
+    //Check to see if n_channels_per_instance, n_in_samples and the arena are reasonable
+    if ((n_in_samples & 0x1) || (n_in_samples < 4)) asrc_error(100);
+    if (n_channels_per_instance < 1) asrc_error(101);
+    if ((size_t)arena & (SRC_ARENA_ALIGN - 1)) asrc_error(103);
+
+    //Pairs of rates without a plan are left to the caller
+    if (!asrc_rate_supported(fs_in, fs_out, n_in_samples)) return 0;
 
+    stack_length = asrc_stack_length(fs_in, fs_out, n_in_samples);
 
+    // Control structures first, then the adaptive filter coefficients and the state and stack of each channel
+    arena += asrc_arena_round(n_channels_per_instance * sizeof(asrc_ctrl_t));
+    adfir_coefs = (asrc_adfir_coefs_t *)arena;
+    arena += asrc_arena_round(sizeof(asrc_adfir_coefs_t));
     for(ui = 0; ui < n_channels_per_instance; ui++)
     {
-    // Update Fs Ratio
-        asrc_ctrl[ui].uiFsRatio     = fs_ratio;
+        asrc_ctrl[ui].psState                   = (asrc_state_t *)arena;
+        arena += asrc_arena_round(sizeof(asrc_state_t));
+        asrc_ctrl[ui].piStack                   = (int *)arena;
+        arena += asrc_arena_round(stack_length * sizeof(int));
+        asrc_ctrl[ui].piADCoefs                 = adfir_coefs->iASRCADFIRCoefs;
+    }
 
-#if DO_FS_BOUNDS_CHECK
-        // Check for bounds of new Fs ratio
-        if( (fs_ratio < sFsRatioConfigs[asrc_ctrl[ui].eInFs][asrc_ctrl[ui].eOutFs].uiMinFsRatio) ||
-            (fs_ratio > sFsRatioConfigs[asrc_ctrl[ui].eInFs][asrc_ctrl[ui].eOutFs].uiMaxFsRatio) )
-        {
-            //debug_printf("Passed = %x, Nominal = 0x%x\n", fs_ratio, sFsRatioConfigs[asrc_ctrl[ui].eInFs][asrc_ctrl[ui].eOutFs].uiNominalFsRatio);
-            fs_ratio = sFsRatioConfigs[asrc_ctrl[ui].eInFs][asrc_ctrl[ui].eOutFs].uiNominalFsRatio; //Important to prevent buffer overflow if fs_ratio requests too many samples.
-            //debug_printf("!");
-        }
-#endif
-        // Apply shift to time ratio to build integer and fractional parts of time step
-        asrc_ctrl[ui].iTimeStepInt     = fs_ratio >> (sFsRatioConfigs[asrc_ctrl[ui].eInFs][asrc_ctrl[ui].eOutFs].iFsRatioShift);
-        asrc_ctrl[ui].uiTimeStepFract  = fs_ratio << (32 - sFsRatioConfigs[asrc_ctrl[ui].eInFs][asrc_ctrl[ui].eOutFs].iFsRatioShift);
+    return asrc_init_hz(fs_in, fs_out, asrc_ctrl, n_channels_per_instance, n_in_samples, dither_on_off);
+}
 
+unsigned asrc_change_rate(const fs_code_t sr_in, const fs_code_t sr_out, asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance)
+{
+    unsigned fs_ratio = asrc_change_rate_hz(asrc_fs_hz(sr_in), asrc_fs_hz(sr_out), asrc_ctrl, n_channels_per_instance);
 
+    if (fs_ratio == 0) asrc_error(13);
+    return fs_ratio;
+}
 
+unsigned asrc_change_rate_hz(const unsigned fs_in, const unsigned fs_out, asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance)
+{
+    unsigned ui;
 
-        // Set input and output data pointers
-        asrc_ctrl[ui].piIn          = in_buff + ui;
-        asrc_ctrl[ui].piOut         = out_buff + ui;
+    ASRCReturnCodes_t ret_code;
+
+    if (n_channels_per_instance < 1) asrc_error(101);
 
+    //Pairs of rates without a plan are left to the caller, the instance carries on at its current rates
+    if (!asrc_rate_supported(fs_in, fs_out, asrc_ctrl[0].uiNInSamples)) return 0;
 
-    // Process synchronous part (F1 + F2)
-    // ==================================
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        // Set new input/output sampling rates
+        asrc_ctrl[ui].uiInFs                    = fs_in;
+        asrc_ctrl[ui].uiOutFs                   = fs_out;
 
-        // Note: this is block based similar to SSRC, output will be on stack
-        // and there will be asrc_ctrl[chan_start].uiNSyncSamples samples per channel produced
-        if(ASRC_proc_F1_F2(&asrc_ctrl[ui]) != ASRC_NO_ERROR)
-        {
-            asrc_error(12);
-        }
+        // Switch filters and Fs ratio, keeping delay lines and time
+        ret_code = ASRC_change_rate(&asrc_ctrl[ui]);
+        if (ret_code != ASRC_NO_ERROR) asrc_error(13);
+    }
 
+    return (asrc_ctrl[0].uiFsRatio);
+}
 
+void asrc_set_fs_ratio_range(asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance, const unsigned range_ppm)
+{
+    unsigned ui;
 
-    // Run the asynchronous part (F3)
-    // ==============================
-    // Clear number of output samples (note that this sample counter would actually not be needed if all was sample by sampe)
+    if (n_channels_per_instance < 1) asrc_error(101);
 
-        asrc_ctrl[ui].uiNASRCOutSamples = 0;
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        // Set min and max Fs ratios around the nominal Fs ratio
+        asrc_ctrl[ui].uiFsRatioRange            = range_ppm;
+        if (ASRC_set_fs_ratio_range(&asrc_ctrl[ui]) != ASRC_NO_ERROR) asrc_error(14);
     }
+}
+
+void asrc_get_latency(asrc_ctrl_t asrc_ctrl[], src_latency_t *latency)
+{
+    long long delay;                // Q32 input samples
+    unsigned long long out_ratio;   // Q32 output samples per input sample
+    long long block = (long long)asrc_ctrl[0].uiNInSamples << 32;
 
-    uiSplCntr = 0; // This is actually only used because of the bizarre mix of block and sample based processing
+    // All channels of the instance have the same filters and nominal Fs ratio
+    if (ASRC_get_delay(&asrc_ctrl[0], &delay, &out_ratio) != ASRC_NO_ERROR) asrc_error(16);
 
-    // Driven by samples produced during the synchronous phase
-    for(ui = 0; ui < asrc_ctrl[0].uiNSyncSamples; ui++)
+    // Rounded to Q16.16 (the Q32 products do not fit in 64 bits)
+    latency->filters_in     = (unsigned)((delay + (1 << 15)) >> 16);
+    latency->filters_out    = (unsigned)((double)delay * out_ratio / 281474976710656.0 + 0.5);
+    latency->total_in       = (unsigned)((delay + block + (1 << 15)) >> 16);
+    latency->total_out      = (unsigned)((double)(delay + block) * out_ratio / 281474976710656.0 + 0.5);
+}
+
+// Updates the Fs ratio and time step of channels iChStart to iChEnd - 1. They share the Fs ratio
+// configuration, so the time step is computed once from the first channel
+static void asrc_update_fs_ratio(asrc_ctrl_t asrc_ctrl[], int iChStart, int iChEnd, unsigned fs_ratio)
+{
+    int ui;
+    int             iTimeStepInt;
+    unsigned int    uiTimeStepFract;
+    const ASRCFsRatioConfigs_t *psFsRatioConfig = &asrc_ctrl[iChStart].sFsRatioConfig;
+    const unsigned  uiFsRatio = fs_ratio;
+
+#if DO_FS_BOUNDS_CHECK
+    // Check for bounds of new Fs ratio
+    if( (fs_ratio < psFsRatioConfig->uiMinFsRatio) ||
+        (fs_ratio > psFsRatioConfig->uiMaxFsRatio) )
     {
-        // Push new samples into F3 delay line (input from stack) for each new "synchronous" sample (i.e. output of F1, respectively F2)
-        for(uj = 0; uj < n_channels_per_instance; uj++)
+        //debug_printf("Passed = %x, Nominal = 0x%x\n", fs_ratio, psFsRatioConfig->uiNominalFsRatio);
+        fs_ratio = psFsRatioConfig->uiNominalFsRatio; //Important to prevent buffer overflow if fs_ratio requests too many samples.
+        //debug_printf("!");
+    }
+#endif
+    // Apply shift to time ratio to build integer and fractional parts of time step
+    iTimeStepInt        = fs_ratio >> (psFsRatioConfig->iFsRatioShift);
+    uiTimeStepFract     = fs_ratio << (32 - psFsRatioConfig->iFsRatioShift);
+
+    for(ui = iChStart; ui < iChEnd; ui++)
+    {
+        asrc_ctrl[ui].uiFsRatio         = uiFsRatio;
+        asrc_ctrl[ui].iTimeStepInt      = iTimeStepInt;
+        asrc_ctrl[ui].uiTimeStepFract   = uiTimeStepFract;
+    }
+}
+
+// Sets the step between the samples of a channel in the input and output buffers of channels iChStart to iChEnd - 1
+static void asrc_set_step(asrc_ctrl_t asrc_ctrl[], int iChStart, int iChEnd, unsigned uiStep)
+{
+    int ui;
+
+    for(ui = iChStart; ui < iChEnd; ui++)
+    {
+        if(asrc_ctrl[ui].uiStep == uiStep)
+            continue;
+        if(ASRC_set_step(&asrc_ctrl[ui], uiStep) != ASRC_NO_ERROR)
         {
+            asrc_error(17);
+        }
+    }
+}
 
-            //The following is replicated/inlined code from ASRC_proc_F3_in_spl in ASRC.c
-            asrc_ctrl[uj].sADFIRF3Ctrl.iIn        = asrc_ctrl[uj].piStack[ui];
+// Processes the dither part of channels iChStart to iChEnd - 1 over the uiNASRCOutSamples output samples from piOut
+static void asrc_proc_dither(asrc_ctrl_t asrc_ctrl[], int iChStart, int iChEnd)
+{
+    int ui;
+
+    // Nothing to do without dither (set for the whole instance at init)
+    if(asrc_ctrl[iChStart].uiDitherOnOff != ASRC_DITHER_ON)
+        return;
 
-            //The following is replicated/inlined code from ADFIR_proc_in_spl in FIR.c
-            // Double write to simulate circular buffer
-            *asrc_ctrl[uj].sADFIRF3Ctrl.piDelayI                                  = asrc_ctrl[uj].sADFIRF3Ctrl.iIn;
-            *(asrc_ctrl[uj].sADFIRF3Ctrl.piDelayI + asrc_ctrl[uj].sADFIRF3Ctrl.uiDelayO)        = asrc_ctrl[uj].sADFIRF3Ctrl.iIn;
-            // Step delay (with circular simulation)
-            asrc_ctrl[uj].sADFIRF3Ctrl.piDelayI++;
-            if(asrc_ctrl[uj].sADFIRF3Ctrl.piDelayI >= asrc_ctrl[uj].sADFIRF3Ctrl.piDelayW)
-                asrc_ctrl[uj].sADFIRF3Ctrl.piDelayI               =asrc_ctrl[uj].sADFIRF3Ctrl.piDelayB;
+    // We are back to block based processing. This is where the number of ASRC output samples is required again
+    // (would not be used if sample by sample based (on output samples))
+    for(ui = iChStart; ui < iChEnd; ui++)
+    {
+        // Note: this is block based similar to SSRC
+        if(ASRC_proc_dither(&asrc_ctrl[ui]) != ASRC_NO_ERROR)
+        {
+            asrc_error(4);
+        }
+    }
+}
 
-            // Decrease next output time (this is an integer value, so no influence on fractional part)
-            asrc_ctrl[uj].iTimeInt    -= FILTER_DEFS_ADFIR_N_PHASES;
+// Steps the time of the first channel (pasrc_ctrl) through the synchronous samples from *puiSyncIn,
+// for up to uiNOutMax output samples, recording for each output sample the number of synchronous
+// samples it follows (uiF3SyncIn) and its adaptive coefficients (piF3Coefs, computed in iF3Coefs),
+// which are shared by all channels. Stops early when it runs out of synchronous samples and returns
+// the number of output samples stepped through
+static inline unsigned asrc_F3_times(asrc_ctrl_t *pasrc_ctrl, unsigned uiNOutMax, unsigned *puiSyncIn,
+                                     unsigned uiF3SyncIn[], const int* piF3Coefs[],
+                                     int (*iF3Coefs)[FILTER_DEFS_ADFIR_PHASE_N_TAPS])
+{
+    unsigned        uiSyncIn = *puiSyncIn;
+    unsigned        uiNOut = 0;
 
+    while(uiNOut < uiNOutMax)
+    {
+        unsigned int    uiTemp;
 
+        // Check if a new output sample needs to be produced before the next synchronous sample
+        if(pasrc_ctrl->iTimeInt >= FILTER_DEFS_ADFIR_N_PHASES)
+        {
+            if(uiSyncIn == pasrc_ctrl->uiNSyncSamples)
+                break;
+            // Decrease next output time for the next synchronous sample (this is an integer value, so no influence on fractional part)
+            pasrc_ctrl->iTimeInt    -= FILTER_DEFS_ADFIR_N_PHASES;
+            uiSyncIn++;
+            continue;
         }
-        // Run macc loop for F3
-        // Check if a new output sample needs to be produced
-        // Note that this will also update the adaptive filter coefficients
-        // These must be computed for one channel only and reused in the macc loop of other channels
-        while(asrc_ctrl[0].iTimeInt < FILTER_DEFS_ADFIR_N_PHASES)
+        uiF3SyncIn[uiNOut]      = uiSyncIn;
+
+#if ASRC_ADFIR_DENSE_PHASES
+        // Adaptive coefficients from the dense phase table: the table phase itself when nearest, no copy
+        piF3Coefs[uiNOut]       = ASRC_F3_dense_coefs(pasrc_ctrl->iTimeInt, pasrc_ctrl->uiTimeFract, iF3Coefs[uiNOut]);
+#else
         {
-            unsigned int    uiTemp;
             int             iAlpha;
 
             int             iH[3]; //iH0, iH1, iH2;
             long long       i64Acc0;
-            int*            piPhase0;
-            int*            piADCoefs;
+            const int*      piPhase0;
 
             // Compute adative coefficients spline factors
             // The fractional part of time gives alpha
-            iAlpha      = asrc_ctrl[0].uiTimeFract>>1;      // Now alpha can be seen as a signed number
+            iAlpha      = pasrc_ctrl->uiTimeFract>>1;      // Now alpha can be seen as a signed number
             i64Acc0 = (long long)iAlpha * (long long)iAlpha;
 
             iH[0]           = (int)(i64Acc0>>32);
@@ -178,72 +426,687 @@ unsigned asrc_process(int *in_buff, int *out_buff, unsigned fs_ratio, asrc_ctrl_
             iH[2]           = iH[2] + iH[0];                        // H2 = 0.5 - alpha + 0.5 * alpha * alpha
 
             // The integer part of time gives the phase
-            piPhase0        = iADFirCoefs[asrc_ctrl[0].iTimeInt];
+            piPhase0        = iADFirCoefs[pasrc_ctrl->iTimeInt];
             // These are calculated by the asm funcion  piPhase1        = piPhase0 + FILTER_DEFS_ADFIR_PHASE_N_TAPS;
             //                                          piPhase2        = piPhase1 + FILTER_DEFS_ADFIR_PHASE_N_TAPS;
-            piADCoefs       = asrc_ctrl[0].piADCoefs;       // Given limited number of registers, this could be DP
 
             // Apply spline coefficients to filter coefficients
-            src_mrhf_spline_coeff_gen_inner_loop_asm(piPhase0, iH, piADCoefs, FILTER_DEFS_ADFIR_PHASE_N_TAPS);
+            SRC_MRHF_SPLINE_COEFF_GEN_INNER_LOOP(piPhase0, iH, iF3Coefs[uiNOut], FILTER_DEFS_ADFIR_PHASE_N_TAPS);
+            piF3Coefs[uiNOut]       = iF3Coefs[uiNOut];
+        }
+#endif
 
+        // Step time for next output sample
+        // --------------------------------
+        // Step to next output time (add integer and fractional parts)
+        pasrc_ctrl->iTimeInt        += pasrc_ctrl->iTimeStepInt;
+        // For fractional part, this can be optimized using the add with carry instruction of XS2
+        uiTemp      = pasrc_ctrl->uiTimeFract;
+        pasrc_ctrl->uiTimeFract     += pasrc_ctrl->uiTimeStepFract;
+        if(pasrc_ctrl->uiTimeFract < uiTemp)
+            pasrc_ctrl->iTimeInt++;
 
-            // Step time for next output sample
-            // --------------------------------
-            // Step to next output time (add integer and fractional parts)
-            asrc_ctrl[0].iTimeInt       += asrc_ctrl[0].iTimeStepInt;
-            // For fractional part, this can be optimized using the add with carry instruction of XS2
-            uiTemp      = asrc_ctrl[0].uiTimeFract;
-            asrc_ctrl[0].uiTimeFract        += asrc_ctrl[0].uiTimeStepFract;
-            if(asrc_ctrl[0].uiTimeFract < uiTemp)
-                asrc_ctrl[0].iTimeInt++;
+        uiNOut++;
+    }
 
+    *puiSyncIn = uiSyncIn;
+    return uiNOut;
+}
 
-            // Not really needed, just for the beauty of it...
-            //asrc_ctrl[0+1].iTimeInt     = asrc_ctrl[0].iTimeInt;
-            //asrc_ctrl[0+1].uiTimeFract  = asrc_ctrl[0].uiTimeFract;
+// Pushes the synchronous samples into the F3 delay lines and applies F3 for channels iChStart to
+// iChEnd - 1, for the uiNOut output samples stepped through by asrc_F3_times, written from output
+// sample uiOut. Then pushes the synchronous samples stepped through after the last output sample,
+// up to uiSyncIn. *puiSyncPushed counts the synchronous samples pushed into the F3 delay lines
+static inline void asrc_F3_macs(asrc_ctrl_t asrc_ctrl[], int iChStart, int iChEnd, unsigned uiNOut,
+                                const unsigned uiF3SyncIn[], const int* const piF3Coefs[],
+                                unsigned uiOut, unsigned uiSyncIn, unsigned *puiSyncPushed)
+{
+    int uj; //Channel counter
+    unsigned uk; //Output sample counter
+    unsigned        uiDataOdd;  //F3 delay line data alignment
+    unsigned        uiSyncPushed = *puiSyncPushed;
 
-            // Apply filter F3 with just computed adaptive coefficients
-            for(uj = 0; uj < n_channels_per_instance; uj++)    {
+    // Get the step between the output samples of a channel (interleaved or planar) from first channel
+    const unsigned uiOutStep = asrc_ctrl[iChStart].uiStep;
+
+    for(uk = 0; uk < uiNOut; uk++)
+    {
+        // Push new samples into F3 delay lines up to this output sample
+        for(; uiSyncPushed < uiF3SyncIn[uk]; uiSyncPushed++)
+        {
+            for(uj = iChStart; uj < iChEnd; uj++)
+                ASRC_F3_PUSH(uj, uiSyncPushed);
+        }
+
+        // The F3 delay lines of all channels are at the same position (and their state structures are
+        // 64 bits aligned), so the data alignment is the same for all channels: check it once here
+        uiDataOdd = SRC_KERNELS_DATA_ODD(FIR_DELAY_DATA(asrc_ctrl[iChStart].sADFIRF3Ctrl.piDelayI, asrc_ctrl[iChStart].sADFIRF3Ctrl.uiDelayO));
+
+        // Apply filter F3 with the adaptive coefficients of this output sample
+        if(!uiDataOdd)
+        {
+            for(uj = iChStart; uj < iChEnd; uj++)
+                ASRC_F3_PROC_MACC(uj, ASRC_F3_INNER_LOOP_EVEN(uj), piF3Coefs[uk], uiOut + uk);
+        }
+        else
+        {
+            for(uj = iChStart; uj < iChEnd; uj++)
+                ASRC_F3_PROC_MACC(uj, ASRC_F3_INNER_LOOP_ODD(uj), piF3Coefs[uk], uiOut + uk);
+        }
+    }
+
+    // Push the synchronous samples stepped through after the last output sample
+    for(; uiSyncPushed < uiSyncIn; uiSyncPushed++)
+    {
+        for(uj = iChStart; uj < iChEnd; uj++)
+            ASRC_F3_PUSH(uj, uiSyncPushed);
+    }
 
-                //The following is replicated/inlined code from ADFIR_F3_proc_macc in ASRC.c
-                asrc_ctrl[uj].sADFIRF3Ctrl.piOut      = (asrc_ctrl[uj].piOut + n_channels_per_instance * uiSplCntr);
+    *puiSyncPushed = uiSyncPushed;
+}
 
-                //The following is replicated/inlined code from ADFIR_proc_macc in FIR.c
-                int*            piData;
-                int*            piCoefs;
-                int             iData;
-                // Clear accumulator and set access pointers
-                piData                  = asrc_ctrl[uj].sADFIRF3Ctrl.piDelayI;
-                piCoefs                 = asrc_ctrl[uj].sADFIRF3Ctrl.piADCoefs;
+// Runs the asynchronous part (F3) of all channels from the synchronous samples on stack, writing
+// up to uiNOutMax output samples from piOut. Returns the number of output samples produced
+static unsigned asrc_proc_F3(asrc_ctrl_t asrc_ctrl[], unsigned uiNOutMax)
+{
+    unsigned uj; //General counter
+    unsigned        uiSplCntr;  //Spline counter
 
-                // Do FIR
-                if ((unsigned)piData & 0b0100) src_mrhf_adfir_inner_loop_asm_odd(piData, piCoefs, &iData, asrc_ctrl[uj].sADFIRF3Ctrl.uiNLoops);
-                else                               src_mrhf_adfir_inner_loop_asm(piData, piCoefs, &iData, asrc_ctrl[uj].sADFIRF3Ctrl.uiNLoops);
+    // F3 batch (see below)
+    unsigned        uiSyncIn, uiSyncPushed, uiNBatch;
+    unsigned        uiF3SyncIn[ASRC_F3_BATCH_N_OUT];                                    // Synchronous samples before each output sample
+    const int*      piF3Coefs[ASRC_F3_BATCH_N_OUT];                                     // Adaptive coefficients of each output sample
+    long long       i64F3Coefs[ASRC_F3_BATCH_N_OUT * FILTER_DEFS_ADFIR_PHASE_N_TAPS / 2]; // Computed adaptive coefficients (64 bits aligned for the inner loops)
+    int             (*iF3Coefs)[FILTER_DEFS_ADFIR_PHASE_N_TAPS] = (int (*)[FILTER_DEFS_ADFIR_PHASE_N_TAPS])i64F3Coefs;
 
-                // Write output
-                *(asrc_ctrl[uj].sADFIRF3Ctrl.piOut)       = iData;
-                asrc_ctrl[uj].uiNASRCOutSamples++;
-            }
-            uiSplCntr++; // This is actually only used because of the bizarre mix of block and sample based processing
+    // Get the number of channels per instance from first channel
+    const unsigned n_channels_per_instance = asrc_ctrl[0].uiNchannels;
+
+    // F3 runs in two passes over batches of up to ASRC_F3_BATCH_N_OUT output samples. The first one
+    // (asrc_F3_times) steps the time of the first channel through the synchronous samples, recording
+    // for each output sample the number of synchronous samples it follows and computing its adaptive
+    // coefficients (shared by all channels). The second one (asrc_F3_macs) then pushes the
+    // synchronous samples into the F3 delay lines and applies F3 to all channels for each output
+    // sample of the batch. Channels are kept interleaved there: running one channel at a time over
+    // the batch puts the MAC loads right behind the delay line writes of the same channel, which
+    // measured slower on the host
+    // It stops after uiNOutMax output samples or when it runs out of synchronous samples, carrying on
+    // from there on the next call (uiNSyncSamplesUsed)
+    uiSplCntr       = 0;                                // Output samples produced
+    uiSyncIn        = asrc_ctrl[0].uiNSyncSamplesUsed;  // Synchronous samples stepped through by the first pass
+    uiSyncPushed    = uiSyncIn;                         // Synchronous samples pushed into the F3 delay lines
+    do
+    {
+        uiNBatch = asrc_F3_times(&asrc_ctrl[0], (uiNOutMax - uiSplCntr < ASRC_F3_BATCH_N_OUT) ? uiNOutMax - uiSplCntr : ASRC_F3_BATCH_N_OUT,
+                                 &uiSyncIn, uiF3SyncIn, piF3Coefs, iF3Coefs);
+        asrc_F3_macs(asrc_ctrl, 0, n_channels_per_instance, uiNBatch, uiF3SyncIn, piF3Coefs, uiSplCntr, uiSyncIn, &uiSyncPushed);
+        uiSplCntr       += uiNBatch;
+    } while((uiNBatch == ASRC_F3_BATCH_N_OUT) && (uiSplCntr < uiNOutMax));
+
+    // All channels produced the same output samples, at the time of the first channel
+    for(uj = 0; uj < n_channels_per_instance; uj++)
+    {
+        asrc_ctrl[uj].uiNASRCOutSamples     = uiSplCntr;
+        asrc_ctrl[uj].uiNSyncSamplesUsed    = uiSyncIn;
+        asrc_ctrl[uj].iTimeInt              = asrc_ctrl[0].iTimeInt;
+        asrc_ctrl[uj].uiTimeFract           = asrc_ctrl[0].uiTimeFract;
+    }
+
+    return uiSplCntr;
+}
+
+// Processes all channels, from the input and output pointers already set
+static unsigned asrc_process_channels(unsigned fs_ratio, asrc_ctrl_t asrc_ctrl[])
+{
+    unsigned ui; //General counters
+
+    // Get the number of channels per instance from first channel
+    const unsigned n_channels_per_instance = asrc_ctrl[0].uiNchannels;
+
+
+    // Update Fs ratio and time step
+    asrc_update_fs_ratio(asrc_ctrl, 0, n_channels_per_instance, fs_ratio);
+
+
+    // Process synchronous part (F1 + F2)
+    // ==================================
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        // Note: this is block based similar to SSRC, output will be on stack
+        // and there will be asrc_ctrl[chan_start].uiNSyncSamples samples per channel produced
+        if(ASRC_proc_F1_F2(&asrc_ctrl[ui]) != ASRC_NO_ERROR)
+        {
+            asrc_error(12);
         }
+        asrc_ctrl[ui].uiNSyncSamplesUsed    = 0;
     }
 
 
-#if (ASRC_DITHER_SETTING != ASRC_DITHER_OFF)    //Removed for speed optimisation
+    // Run the asynchronous part (F3)
+    // ==============================
+    // All the synchronous samples produced are used
+    asrc_proc_F3(asrc_ctrl, UINT_MAX);
+
+
     // Process dither part
     // ===================
-    // We are back to block based processing. This is where the number of ASRC output samples is required again
-    // (would not be used if sample by sample based (on output samples))
+    asrc_proc_dither(asrc_ctrl, 0, asrc_ctrl[0].uiNchannels);
+
+    unsigned n_samps_out = asrc_ctrl[0].uiNASRCOutSamples;
+    return n_samps_out;
+}
+
+unsigned asrc_process(int *in_buff, int *out_buff, unsigned fs_ratio, asrc_ctrl_t asrc_ctrl[]){
+
+    unsigned ui; //General counters
+
+    // Get the number of channels per instance from first channel
+    const unsigned n_channels_per_instance = asrc_ctrl[0].uiNchannels;
+
+    // Interleaved channels: set input and output data pointers
+    asrc_set_step(asrc_ctrl, 0, n_channels_per_instance, n_channels_per_instance);
     for(ui = 0; ui < n_channels_per_instance; ui++)
     {
-        // Note: this is block based similar to SSRC
-        if(ASRC_proc_dither(&asrc_ctrl[ui]) != ASRC_NO_ERROR)
+        asrc_ctrl[ui].piIn          = in_buff + ui;
+        asrc_ctrl[ui].piOut         = out_buff + ui;
+    }
+
+    return asrc_process_channels(fs_ratio, asrc_ctrl);
+}
+
+unsigned asrc_process_planar(int *in_buff[], int *out_buff[], unsigned fs_ratio, asrc_ctrl_t asrc_ctrl[]){
+
+    unsigned ui; //General counters
+
+    // Get the number of channels per instance from first channel
+    const unsigned n_channels_per_instance = asrc_ctrl[0].uiNchannels;
+
+    // One contiguous buffer per channel: set input and output data pointers
+    asrc_set_step(asrc_ctrl, 0, n_channels_per_instance, 1);
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        asrc_ctrl[ui].piIn          = in_buff[ui];
+        asrc_ctrl[ui].piOut         = out_buff[ui];
+    }
+
+    return asrc_process_channels(fs_ratio, asrc_ctrl);
+}
+
+unsigned asrc_pull_process(asrc_in_ring_t *in_ring, int *out_buff, unsigned n_out_samples, unsigned fs_ratio, asrc_ctrl_t asrc_ctrl[]){
+
+    unsigned ui; //General counters
+    unsigned        uiNOut;     //Output samples produced
+
+    // Get the number of channels per instance from first channel
+    const unsigned n_channels_per_instance = asrc_ctrl[0].uiNchannels;
+
+    // Input blocks must not wrap around the end of the ring
+    if ((in_ring->n_frames == 0) || (in_ring->n_frames % asrc_ctrl[0].uiNInSamples)) asrc_error(102);
+    if ((in_ring->read_index >= 2 * in_ring->n_frames) || (in_ring->write_index >= 2 * in_ring->n_frames)) asrc_error(104);
+
+    // Interleaved channels
+    asrc_set_step(asrc_ctrl, 0, n_channels_per_instance, n_channels_per_instance);
+
+    // Update Fs ratio and time step
+    asrc_update_fs_ratio(asrc_ctrl, 0, n_channels_per_instance, fs_ratio);
+
+    uiNOut = 0;
+    while(uiNOut < n_out_samples)
+    {
+        // Process synchronous part (F1 + F2) of the next input block once F3 has used all the synchronous samples
+        if(asrc_ctrl[0].uiNSyncSamplesUsed == asrc_ctrl[0].uiNSyncSamples)
         {
-            asrc_error(4);
+            // Stop short when the ring does not hold a full input block
+            if(ASRC_IN_RING_FILL(in_ring) < asrc_ctrl[0].uiNInSamples)
+                break;
+
+            for(ui = 0; ui < n_channels_per_instance; ui++)
+            {
+                asrc_ctrl[ui].piIn          = in_ring->buff + ASRC_IN_RING_POS(in_ring, in_ring->read_index) * n_channels_per_instance + ui;
+                if(ASRC_proc_F1_F2(&asrc_ctrl[ui]) != ASRC_NO_ERROR)
+                {
+                    asrc_error(12);
+                }
+                asrc_ctrl[ui].uiNSyncSamplesUsed    = 0;
+            }
+            in_ring->read_index     = ASRC_IN_RING_ADVANCE(in_ring, in_ring->read_index, asrc_ctrl[0].uiNInSamples);
+        }
+
+        // Run the asynchronous part (F3) up to the requested number of output samples
+        for(ui = 0; ui < n_channels_per_instance; ui++)
+        {
+            asrc_ctrl[ui].piOut         = out_buff + uiNOut * n_channels_per_instance + ui;
+        }
+        uiNOut += asrc_proc_F3(asrc_ctrl, n_out_samples - uiNOut);
+    }
+
+    // Process dither part over all the output samples
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        asrc_ctrl[ui].piOut             = out_buff + ui;
+        asrc_ctrl[ui].uiNASRCOutSamples = uiNOut;
+    }
+    asrc_proc_dither(asrc_ctrl, 0, asrc_ctrl[0].uiNchannels);
+
+    return uiNOut;
+}
+
+#if ASRC_MT
+// Multithreaded ASRC (asrc_mt_process)
+// ====================================
+// The channels are split into contiguous groups, group 0 converted by the calling thread and the
+// others by the worker threads. For each block, the threads run F1 and F2 on their channels, the
+// calling thread computing the F3 time instants and adaptive coefficients of the first
+// ASRC_MT_F3_N_OUT output samples (a round) right after F1 and F2 of channel 0. Then all threads
+// run the F3 MACs of their channels over the round, the calling thread computing the next round
+// if there are more output samples. Three barriers per block of up to ASRC_MT_F3_N_OUT output samples
+
+// Output samples of a round (one round per block for blocks of up to this many output samples)
+#define ASRC_MT_F3_N_OUT        256
+
+// Channel groups start on multiples of this many channels (a 64 bytes cache line of output samples)
+// when there are enough channels, so that threads do not write to the same cache lines
+#define ASRC_MT_GROUP_ALIGN     16
+
+// Barrier waits spin this many times before sleeping on the pool condition variable
+#define ASRC_MT_SPIN_N          4096
+
+typedef struct _ASRCMtPool ASRCMtPool_t;
+
+// Worker thread of the pool
+typedef struct _ASRCMtWorker
+{
+    ASRCMtPool_t*   psPool;
+    unsigned int    uiGroup;                                    // Channel group converted
+    pthread_t       sThread;
+} ASRCMtWorker_t;
+
+struct _ASRCMtPool
+{
+    asrc_ctrl_t*    pasrc_ctrl;                                 // ASRC control structures of all the channels
+    unsigned int    uiNChannels;
+    unsigned int    uiNThreads;                                 // Threads, including the calling thread
+    ASRCMtWorker_t  sWorkers[ASRC_MT_MAX_THREADS];              // Worker threads (from 1)
+
+    // Barrier: the last thread in bumps the generation the others wait for
+    atomic_uint     uiBarrierCount;
+    atomic_uint     uiBarrierGen;
+    pthread_mutex_t sMutex;
+    pthread_cond_t  sCond;
+
+    // Block being converted
+    int*            piIn;
+    int*            piOut;
+    unsigned int    uiFsRatio;
+    int             iQuit;                                      // Set to stop the workers
+
+    // F3 round, computed by the calling thread from the time of channel 0
+    unsigned int    uiNOut;                                     // Output samples of the round
+    unsigned int    uiSyncIn;                                   // Synchronous samples stepped through
+    int             iTimeInt;                                   // Time after the round
+    unsigned int    uiTimeFract;
+    unsigned int    uiF3SyncIn[ASRC_MT_F3_N_OUT];               // Synchronous samples before each output sample
+    const int*      piF3Coefs[ASRC_MT_F3_N_OUT];                // Adaptive coefficients of each output sample
+    long long       i64F3Coefs[ASRC_MT_F3_N_OUT * FILTER_DEFS_ADFIR_PHASE_N_TAPS / 2]; // Computed adaptive coefficients (64 bits aligned for the inner loops)
+};
+
+// Waits for all the threads of the pool
+static void asrc_mt_barrier(ASRCMtPool_t *psPool)
+{
+    unsigned int    uiGen = atomic_load_explicit(&psPool->uiBarrierGen, memory_order_acquire);
+    unsigned int    uiSpin;
+
+    if(atomic_fetch_add_explicit(&psPool->uiBarrierCount, 1, memory_order_acq_rel) == psPool->uiNThreads - 1)
+    {
+        // Last thread in: release the others
+        atomic_store_explicit(&psPool->uiBarrierCount, 0, memory_order_relaxed);
+        pthread_mutex_lock(&psPool->sMutex);
+        atomic_fetch_add_explicit(&psPool->uiBarrierGen, 1, memory_order_release);
+        pthread_cond_broadcast(&psPool->sCond);
+        pthread_mutex_unlock(&psPool->sMutex);
+        return;
+    }
+
+    // Blocks follow each other closely when streaming: spin first, then sleep
+    for(uiSpin = 0; uiSpin < ASRC_MT_SPIN_N; uiSpin++)
+    {
+        if(atomic_load_explicit(&psPool->uiBarrierGen, memory_order_acquire) != uiGen)
+            return;
+    }
+    pthread_mutex_lock(&psPool->sMutex);
+    while(atomic_load_explicit(&psPool->uiBarrierGen, memory_order_acquire) == uiGen)
+        pthread_cond_wait(&psPool->sCond, &psPool->sMutex);
+    pthread_mutex_unlock(&psPool->sMutex);
+}
+
+// First channel of channel group uiGroup (the number of channels for uiGroup = uiNThreads)
+static int asrc_mt_group_start(ASRCMtPool_t *psPool, unsigned uiGroup)
+{
+    unsigned int    uiStart = uiGroup * psPool->uiNChannels / psPool->uiNThreads;
+
+    // Rounded to the nearest multiple of ASRC_MT_GROUP_ALIGN when groups hold at least as many channels
+    if(psPool->uiNChannels >= ASRC_MT_GROUP_ALIGN * psPool->uiNThreads)
+    {
+        uiStart = (uiStart + ASRC_MT_GROUP_ALIGN / 2) / ASRC_MT_GROUP_ALIGN * ASRC_MT_GROUP_ALIGN;
+        if(uiStart > psPool->uiNChannels)
+            uiStart = psPool->uiNChannels;
+    }
+    return uiStart;
+}
+
+// Computes the next F3 round from the time of channel 0 (calling thread)
+static void asrc_mt_F3_times(ASRCMtPool_t *psPool)
+{
+    asrc_ctrl_t*    pasrc_ctrl = &psPool->pasrc_ctrl[0];
+
+    psPool->uiNOut          = asrc_F3_times(pasrc_ctrl, ASRC_MT_F3_N_OUT, &psPool->uiSyncIn, psPool->uiF3SyncIn, psPool->piF3Coefs,
+                                            (int (*)[FILTER_DEFS_ADFIR_PHASE_N_TAPS])psPool->i64F3Coefs);
+    psPool->iTimeInt        = pasrc_ctrl->iTimeInt;
+    psPool->uiTimeFract     = pasrc_ctrl->uiTimeFract;
+}
+
+// Converts channel group uiGroup of the current block, along with the other threads of the pool
+static void asrc_mt_run(ASRCMtPool_t *psPool, unsigned uiGroup)
+{
+    int ui; //General counter
+    asrc_ctrl_t*    asrc_ctrl = psPool->pasrc_ctrl;
+    const int       iChStart = asrc_mt_group_start(psPool, uiGroup);
+    const int       iChEnd = asrc_mt_group_start(psPool, uiGroup + 1);
+    unsigned        uiSplCntr, uiSyncPushed, uiNOut;
+
+    // Process synchronous part (F1 + F2)
+    // ==================================
+    asrc_set_step(asrc_ctrl, iChStart, iChEnd, psPool->uiNChannels);   // Interleaved channels
+    asrc_update_fs_ratio(asrc_ctrl, iChStart, iChEnd, psPool->uiFsRatio);
+    for(ui = iChStart; ui < iChEnd; ui++)
+    {
+        asrc_ctrl[ui].piIn          = psPool->piIn + ui;
+        asrc_ctrl[ui].piOut         = psPool->piOut + ui;
+        if(ASRC_proc_F1_F2(&asrc_ctrl[ui]) != ASRC_NO_ERROR)
+        {
+            asrc_error(12);
         }
+        asrc_ctrl[ui].uiNSyncSamplesUsed    = 0;
+
+        // First F3 round, while the other threads carry on with F1 and F2
+        if(ui == 0)
+        {
+            psPool->uiSyncIn    = 0;
+            asrc_mt_F3_times(psPool);
+        }
+    }
+
+    // Run the asynchronous part (F3), a round at a time
+    // =================================================
+    uiSplCntr       = 0;
+    uiSyncPushed    = 0;
+    for(;;)
+    {
+        asrc_mt_barrier(psPool);    // Round computed
+        uiNOut = psPool->uiNOut;
+        asrc_F3_macs(asrc_ctrl, iChStart, iChEnd, uiNOut, psPool->uiF3SyncIn, psPool->piF3Coefs, uiSplCntr, psPool->uiSyncIn, &uiSyncPushed);
+        uiSplCntr += uiNOut;
+        if(uiNOut < ASRC_MT_F3_N_OUT)
+            break;
+        asrc_mt_barrier(psPool);    // Round used by all the threads
+        if(uiGroup == 0)
+            asrc_mt_F3_times(psPool);
     }
+
+    for(ui = iChStart; ui < iChEnd; ui++)
+    {
+        asrc_ctrl[ui].uiNASRCOutSamples     = uiSplCntr;
+        asrc_ctrl[ui].uiNSyncSamplesUsed    = psPool->uiSyncIn;
+        asrc_ctrl[ui].iTimeInt              = psPool->iTimeInt;
+        asrc_ctrl[ui].uiTimeFract           = psPool->uiTimeFract;
+    }
+
+    // Process dither part
+    // ===================
+    asrc_proc_dither(asrc_ctrl, iChStart, iChEnd);
+}
+
+static void *asrc_mt_worker(void *pvWorker)
+{
+    ASRCMtWorker_t* psWorker = (ASRCMtWorker_t *)pvWorker;
+    ASRCMtPool_t*   psPool = psWorker->psPool;
+
+    // Wait for asrc_mt_init to have started all the workers (uiNThreads final)
+    pthread_mutex_lock(&psPool->sMutex);
+    pthread_mutex_unlock(&psPool->sMutex);
+
+    for(;;)
+    {
+        asrc_mt_barrier(psPool);    // Block start
+        if(psPool->iQuit)
+            return NULL;
+        asrc_mt_run(psPool, psWorker->uiGroup);
+        asrc_mt_barrier(psPool);    // Block done
+    }
+}
+
+unsigned asrc_mt_init(asrc_mt_t *asrc_mt, asrc_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance, unsigned n_threads,
+                      const unsigned pin_threads)
+{
+    ASRCMtPool_t*   psPool;
+    unsigned        ui;
+#if defined(__linux__)
+    cpu_set_t       sCpus;
+    int             iNCpus = 0;
 #endif
 
-    unsigned n_samps_out = asrc_ctrl[0].uiNASRCOutSamples;
-    return n_samps_out;
+    if (n_channels_per_instance < 1) asrc_error(101);
+    if (n_threads > n_channels_per_instance) n_threads = n_channels_per_instance;
+    if (n_threads > ASRC_MT_MAX_THREADS) n_threads = ASRC_MT_MAX_THREADS;
+    if (n_threads < 1) n_threads = 1;
+
+    psPool = (ASRCMtPool_t *)calloc(1, sizeof(ASRCMtPool_t));
+    if (psPool == NULL) asrc_error(15);
+    psPool->pasrc_ctrl      = asrc_ctrl;
+    psPool->uiNChannels     = n_channels_per_instance;
+    atomic_init(&psPool->uiBarrierCount, 0);
+    atomic_init(&psPool->uiBarrierGen, 0);
+    pthread_mutex_init(&psPool->sMutex, NULL);
+    pthread_cond_init(&psPool->sCond, NULL);
+
+#if defined(__linux__)
+    if (pin_threads && (sched_getaffinity(0, sizeof(sCpus), &sCpus) == 0)) iNCpus = CPU_COUNT(&sCpus);
+#else
+    (void)pin_threads;
+#endif
+
+    // Start the workers, held back until the number of threads is final
+    pthread_mutex_lock(&psPool->sMutex);
+    for(ui = 1; ui < n_threads; ui++)
+    {
+        ASRCMtWorker_t* psWorker = &psPool->sWorkers[ui];
+
+        psWorker->psPool    = psPool;
+        psWorker->uiGroup   = ui;
+        if (pthread_create(&psWorker->sThread, NULL, asrc_mt_worker, psWorker) != 0) break;
+#if defined(__linux__)
+        // Worker ui on the ui-th CPU the process may run on (best effort)
+        if (iNCpus > 0)
+        {
+            int     iCpu, iN = ui % iNCpus;
+            cpu_set_t   sCpu;
+
+            for(iCpu = 0; !CPU_ISSET(iCpu, &sCpus) || iN--; iCpu++);
+            CPU_ZERO(&sCpu);
+            CPU_SET(iCpu, &sCpu);
+            pthread_setaffinity_np(psWorker->sThread, sizeof(sCpu), &sCpu);
+        }
+#endif
+    }
+    psPool->uiNThreads      = ui;
+    pthread_mutex_unlock(&psPool->sMutex);
+
+    asrc_mt->asrc_ctrl      = asrc_ctrl;
+    asrc_mt->n_channels     = n_channels_per_instance;
+    asrc_mt->n_threads      = psPool->uiNThreads;
+    asrc_mt->pool           = psPool;
+    return asrc_mt->n_threads;
+}
+
+unsigned asrc_mt_process(int *in_buff, int *out_buff, unsigned fs_ratio, asrc_mt_t *asrc_mt){
+
+    ASRCMtPool_t*   psPool = (ASRCMtPool_t *)asrc_mt->pool;
+
+    psPool->piIn        = in_buff;
+    psPool->piOut       = out_buff;
+    psPool->uiFsRatio   = fs_ratio;
+
+    asrc_mt_barrier(psPool);    // Block start
+    asrc_mt_run(psPool, 0);
+    asrc_mt_barrier(psPool);    // Block done
+
+    return asrc_mt->asrc_ctrl[0].uiNASRCOutSamples;
+}
+
+void asrc_mt_release(asrc_mt_t *asrc_mt)
+{
+    ASRCMtPool_t*   psPool = (ASRCMtPool_t *)asrc_mt->pool;
+    unsigned        ui;
+
+    psPool->iQuit = 1;
+    asrc_mt_barrier(psPool);
+    for(ui = 1; ui < psPool->uiNThreads; ui++)
+        pthread_join(psPool->sWorkers[ui].sThread, NULL);
+    pthread_mutex_destroy(&psPool->sMutex);
+    pthread_cond_destroy(&psPool->sCond);
+    free(psPool);
+    asrc_mt->pool = NULL;
+}
+#endif
+
+#if FIR_FLOAT
+unsigned asrc_float_init(const fs_code_t sr_in, const fs_code_t sr_out, asrc_float_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
+        const unsigned n_in_samples)
+{
+    unsigned fs_ratio = asrc_float_init_hz(asrc_fs_hz(sr_in), asrc_fs_hz(sr_out), asrc_ctrl, n_channels_per_instance, n_in_samples);
+
+    if (fs_ratio == 0) asrc_error(11);
+    return fs_ratio;
 }
+
+unsigned asrc_float_init_hz(const unsigned fs_in, const unsigned fs_out, asrc_float_ctrl_t asrc_ctrl[], const unsigned n_channels_per_instance,
+        const unsigned n_in_samples)
+{
+    unsigned ui;
+
+    ASRCReturnCodes_t ret_code;
+
+    //Check to see if n_channels_per_instance, n_in_samples are reasonable
+    if ((n_in_samples & 0x1) || (n_in_samples < 4)) asrc_error(100);
+    if (n_channels_per_instance < 1) asrc_error(101);
+
+    //Pairs of rates without a plan are left to the caller (same filters as asrc_init_hz)
+    if (!asrc_rate_supported(fs_in, fs_out, n_in_samples)) return 0;
+
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        asrc_ctrl[ui].uiNchannels               = n_channels_per_instance;
+        asrc_ctrl[ui].uiInFs                    = fs_in;
+        asrc_ctrl[ui].uiOutFs                   = fs_out;
+        asrc_ctrl[ui].uiNInSamples              = n_in_samples;
+
+        // Init float ASRC instances
+        ret_code = ASRC_float_init(&asrc_ctrl[ui]);
+        if (ret_code != ASRC_NO_ERROR) asrc_error(11);
+    }
+
+    return (asrc_ctrl[0].uiFsRatio);
+}
+
+unsigned asrc_float_process(float *in_buff, float *out_buff, unsigned fs_ratio, asrc_float_ctrl_t asrc_ctrl[]){
+
+    unsigned ui, uj; //General counters
+    int             uiSplCntr;  //Spline counter
+
+    // Get the number of channels per instance from first channel
+    const unsigned n_channels_per_instance = asrc_ctrl[0].uiNchannels;
+
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        // Update Fs Ratio
+        asrc_ctrl[ui].uiFsRatio     = fs_ratio;
+
+#if DO_FS_BOUNDS_CHECK
+        // Check for bounds of new Fs ratio
+        if( (fs_ratio < asrc_ctrl[ui].sFsRatioConfig.uiMinFsRatio) ||
+            (fs_ratio > asrc_ctrl[ui].sFsRatioConfig.uiMaxFsRatio) )
+        {
+            fs_ratio = asrc_ctrl[ui].sFsRatioConfig.uiNominalFsRatio; //Important to prevent buffer overflow if fs_ratio requests too many samples.
+        }
+#endif
+        // Apply shift to time ratio to build integer and fractional parts of time step
+        asrc_ctrl[ui].iTimeStepInt     = fs_ratio >> (asrc_ctrl[ui].sFsRatioConfig.iFsRatioShift);
+        asrc_ctrl[ui].uiTimeStepFract  = fs_ratio << (32 - asrc_ctrl[ui].sFsRatioConfig.iFsRatioShift);
+
+        // Set input and output data pointers
+        asrc_ctrl[ui].pfIn          = in_buff + ui;
+        asrc_ctrl[ui].pfOut         = out_buff + ui;
+
+        // Process synchronous part (F1 + F2)
+        if(ASRC_float_proc_F1_F2(&asrc_ctrl[ui]) != ASRC_NO_ERROR)
+        {
+            asrc_error(12);
+        }
+
+        asrc_ctrl[ui].uiNASRCOutSamples = 0;
+    }
+
+    uiSplCntr = 0;
+
+    // Run the asynchronous part (F3), driven by samples produced during the synchronous phase
+    for(ui = 0; ui < asrc_ctrl[0].uiNSyncSamples; ui++)
+    {
+        // Push new samples into F3 delay line
+        for(uj = 0; uj < n_channels_per_instance; uj++)
+        {
+            asrc_ctrl[uj].sADFIRF3Ctrl.fIn        = asrc_ctrl[uj].pfStack[ui];
+            ADFIR_float_proc_in_spl(&asrc_ctrl[uj].sADFIRF3Ctrl);
+        }
+
+        // Decrease next output time (this is an integer value, so no influence on fractional part)
+        // Only the first channel steps through time, as for the fixed point F3
+        asrc_ctrl[0].iTimeInt    -= FILTER_DEFS_ADFIR_N_PHASES;
+
+        // Produce output samples until the next output time is beyond the current input sample
+        // The adaptive coefficients are computed for the first channel only and reused by the other channels
+        while(asrc_ctrl[0].iTimeInt < FILTER_DEFS_ADFIR_N_PHASES)
+        {
+            unsigned int    uiTemp;
+            float*          pfADCoefs = asrc_ctrl[0].sADFIRF3Ctrl.pfADCoefs;
+
+            // Integer part of time gives the phase, fractional part gives alpha
+            ADFIR_float_proc_spline(&asrc_ctrl[0].sADFIRF3Ctrl, asrc_ctrl[0].iTimeInt, (float)asrc_ctrl[0].uiTimeFract * (1.0f / 4294967296.0f));
+
+            // Step time for next output sample
+            asrc_ctrl[0].iTimeInt       += asrc_ctrl[0].iTimeStepInt;
+            uiTemp      = asrc_ctrl[0].uiTimeFract;
+            asrc_ctrl[0].uiTimeFract        += asrc_ctrl[0].uiTimeStepFract;
+            if(asrc_ctrl[0].uiTimeFract < uiTemp)
+                asrc_ctrl[0].iTimeInt++;
+
+            // Apply filter F3 with just computed adaptive coefficients
+            for(uj = 0; uj < n_channels_per_instance; uj++)
+            {
+                SRC_MRHF_FIR_FLOAT_INNER_LOOP(FIR_DELAY_DATA(asrc_ctrl[uj].sADFIRF3Ctrl.pfDelayI, asrc_ctrl[uj].sADFIRF3Ctrl.uiDelayO),
+                    pfADCoefs, asrc_ctrl[uj].pfOut + n_channels_per_instance * uiSplCntr, asrc_ctrl[uj].sADFIRF3Ctrl.uiNTaps);
+                asrc_ctrl[uj].uiNASRCOutSamples++;
+            }
+            uiSplCntr++;
+        }
+    }
+
+    // All channels are at the time of the first channel
+    for(uj = 1; uj < n_channels_per_instance; uj++)
+    {
+        asrc_ctrl[uj].iTimeInt      = asrc_ctrl[0].iTimeInt;
+        asrc_ctrl[uj].uiTimeFract   = asrc_ctrl[0].uiTimeFract;
+    }
+
+    return asrc_ctrl[0].uiNASRCOutSamples;
+}
+#endif
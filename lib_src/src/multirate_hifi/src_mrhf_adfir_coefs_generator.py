@@ -0,0 +1,53 @@
+#!/usr/bin/env python
+# Copyright (c) 2016, XMOS Ltd, All rights reserved
+#
+# Generates FilterData/ADFirPhases.dat, the ADFIR filter phases used by the
+# ASRC (iADFirCoefs), from the ADFIR prototype FilterData/ADFir.dat.
+#
+# The prototype has N_PHASES x (PHASE_N_TAPS - 1) taps. Phase i (i < N_PHASES)
+# holds prototype taps i, i + N_PHASES, ... in reverse order followed by a
+# zero. The two extra phases N_PHASES and N_PHASES + 1 hold phases 0 and 1
+# delayed by one tap, so the spline interpolation of the last phases can
+# read three consecutive phases.
+import os.path
+
+N_PHASES = 128
+PROTOTYPE_N_TAPS = 1920
+PHASE_N_TAPS = PROTOTYPE_N_TAPS // N_PHASES + 1
+
+HEADER = """\
+/* This file is generated using src_mrhf_adfir_coefs_generator.py
+ *
+ * Do not modify it directly, changes may be overwritten!
+ */
+"""
+
+
+def read_prototype(path):
+    with open(path) as f:
+        coefs = [int(v) for v in f.read().replace(",", " ").split()]
+    assert len(coefs) == PROTOTYPE_N_TAPS
+    return coefs
+
+
+def make_phases(prototype):
+    base = PROTOTYPE_N_TAPS - N_PHASES
+    phases = []
+    for i in range(N_PHASES):
+        phases.append([prototype[base + i - j * N_PHASES] for j in range(PHASE_N_TAPS - 1)] + [0])
+    for i in range(2):
+        phases.append([0] + [prototype[base + i - j * N_PHASES] for j in range(PHASE_N_TAPS - 1)])
+    return phases
+
+
+def write_phases(path, phases):
+    with open(path, "w") as f:
+        f.write(HEADER)
+        for phase in phases:
+            f.write("    {" + ", ".join("%d" % c for c in phase) + "},\n")
+
+
+if __name__ == "__main__":
+    filter_data = os.path.join(os.path.dirname(os.path.realpath(__file__)), "FilterData")
+    phases = make_phases(read_prototype(os.path.join(filter_data, "ADFir.dat")))
+    write_phases(os.path.join(filter_data, "ADFirPhases.dat"), phases)
@@ -0,0 +1,7 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+#ifndef _SRC_MRHF_DITHER_MATHS_ASM_H_
+#define _SRC_MRHF_DITHER_MATHS_ASM_H_
+
+int dither_maths_asm(int iData, int iAccH, unsigned uiAccL);
+
+#endif // _SRC_MRHF_DITHER_MATHS_ASM_H_
@@ -31,6 +31,14 @@
 
 
 
+// Last member of the FIR descriptors, the first half of the symmetric OS2 coefficients
+#if FIR_FOLD_SYMMETRIC
+#define        FILTER_DEFS_FIR_HALF(piCoefsHalf)    , piCoefsHalf
+#else
+#define        FILTER_DEFS_FIR_HALF(piCoefsHalf)
+#endif
+
+
 // ===========================================================================
 //
 // Variables
@@ -40,34 +48,62 @@
 // SSRC FIR filters descriptors (ordered by ID)
 FIRDescriptor_t            sSSRCFirDescriptor[FILTER_DEFS_SSRC_N_FIR_ID] =
 {
-    {FIR_TYPE_DS2,                            FILTER_DEFS_FIR_BL_N_TAPS,            iFirBLCoefs},            // FILTER_DEFS_FIR_BL_ID
-    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL9644_N_TAPS,        iFirBL9644Coefs},        // FILTER_DEFS_FIR_BL9644_ID
-    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL8848_N_TAPS,        iFirBL8848},            // FILTER_DEFS_FIR_BL8848_ID
-    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL19288_N_TAPS,        iFirBL19288Coefs},        // FILTER_DEFS_FIR_BL19288_ID
-    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL17696_N_TAPS,        iFirBL17696},            // FILTER_DEFS_FIR_BL17696_ID
-    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP_N_TAPS,            iFirUPCoefs},            // FILTER_DEFS_FIR_UP_ID
-    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP4844_N_TAPS,        iFirUP4844Coefs},        // FILTER_DEFS_FIR_UP4844_ID
-    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UPF_N_TAPS,            iFirUPFCoefs},            // FILTER_DEFS_FIR_UPF_ID
-    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP192176_N_TAPS,    iFirUP192176Coefs},        // FILTER_DEFS_FIR_UP192176_ID
-    {FIR_TYPE_DS2,                            FILTER_DEFS_FIR_DS_N_TAPS,            iFirDSCoefs},            // FILTER_DEFS_FIR_DS_ID
-    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_OS_N_TAPS,            iFirOSCoefs},            // FILTER_DEFS_FIR_OS_ID
-    {FIR_TYPE_SYNC,                            0,                                    0}                        // FILTER_DEFS_FIR_NONE_ID
+    {FIR_TYPE_DS2,                            FILTER_DEFS_FIR_BL_N_TAPS,            iFirBLCoefs FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_FIR_BL_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL9644_N_TAPS,        iFirBL9644Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_FIR_BL9644_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL8848_N_TAPS,        iFirBL8848 FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_FIR_BL8848_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL19288_N_TAPS,        iFirBL19288Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_FIR_BL19288_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL17696_N_TAPS,        iFirBL17696 FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_FIR_BL17696_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP_N_TAPS,            iFirUPCoefs FILTER_DEFS_FIR_HALF(iFirUPHalfCoefs)},            // FILTER_DEFS_FIR_UP_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP4844_N_TAPS,        iFirUP4844Coefs FILTER_DEFS_FIR_HALF(iFirUP4844HalfCoefs)},        // FILTER_DEFS_FIR_UP4844_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UPF_N_TAPS,            iFirUPFCoefs FILTER_DEFS_FIR_HALF(iFirUPFHalfCoefs)},            // FILTER_DEFS_FIR_UPF_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP192176_N_TAPS,    iFirUP192176Coefs FILTER_DEFS_FIR_HALF(iFirUP192176HalfCoefs)},        // FILTER_DEFS_FIR_UP192176_ID
+    {FIR_TYPE_DS2,                            FILTER_DEFS_FIR_DS_N_TAPS,            iFirDSCoefs FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_FIR_DS_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_OS_N_TAPS,            iFirOSCoefs FILTER_DEFS_FIR_HALF(iFirOSHalfCoefs)},            // FILTER_DEFS_FIR_OS_ID
+    {FIR_TYPE_SYNC,                            0,                                    0 FILTER_DEFS_FIR_HALF(0)}                        // FILTER_DEFS_FIR_NONE_ID
+#if SRC_ARBITRARY_FS
+    ,
+    {FIR_TYPE_DS4,                            FILTER_DEFS_FIR_DS4_N_TAPS,            iFirDS4Coefs FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_SSRC_FIR_DS4_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL5016_N_TAPS,        iFirBL5016Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_SSRC_FIR_BL5016_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL4816_N_TAPS,        iFirBL4816Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_SSRC_FIR_BL4816_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL4416_N_TAPS,        iFirBL4416Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_SSRC_FIR_BL4416_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL3716_N_TAPS,        iFirBL3716Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_SSRC_FIR_BL3716_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP5032_N_TAPS,        iFirUP5032Coefs FILTER_DEFS_FIR_HALF(iFirUP5032HalfCoefs)},        // FILTER_DEFS_SSRC_FIR_UP5032_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP4832_N_TAPS,        iFirUP4832Coefs FILTER_DEFS_FIR_HALF(iFirUP4832HalfCoefs)},        // FILTER_DEFS_SSRC_FIR_UP4832_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP4432_N_TAPS,        iFirUP4432Coefs FILTER_DEFS_FIR_HALF(iFirUP4432HalfCoefs)},        // FILTER_DEFS_SSRC_FIR_UP4432_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP3732_N_TAPS,        iFirUP3732Coefs FILTER_DEFS_FIR_HALF(iFirUP3732HalfCoefs)},        // FILTER_DEFS_SSRC_FIR_UP3732_ID
+    {FIR_TYPE_DS8,                            FILTER_DEFS_FIR_DS8_N_TAPS,            iFirDS8Coefs FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_SSRC_FIR_DS8_ID
+    {FIR_TYPE_DS16,                            FILTER_DEFS_FIR_DS16_N_TAPS,        iFirDS16Coefs FILTER_DEFS_FIR_HALF(0)}            // FILTER_DEFS_SSRC_FIR_DS16_ID
+#endif
 };
 // ASRC  FIR filters descriptors (ordered by ID)
 FIRDescriptor_t            sASRCFirDescriptor[FILTER_DEFS_ASRC_N_FIR_ID] =
 {
-    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL_N_TAPS,            iFirBLCoefs},            // FILTER_DEFS_FIR_BL_ID
-    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL9644_N_TAPS,        iFirBL9644Coefs},        // FILTER_DEFS_FIR_BL9644_ID
-    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL8848_N_TAPS,        iFirBL8848},            // FILTER_DEFS_FIR_BL8848_ID
-    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BLF_N_TAPS,            iFirBLFCoefs},            // FILTER_DEFS_FIR_BLF_ID
-    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL19288_N_TAPS,        iFirBL19288Coefs},        // FILTER_DEFS_FIR_BL19288_ID
-    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL17696_N_TAPS,        iFirBL17696},            // FILTER_DEFS_FIR_BL17696_ID
-    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP_N_TAPS,            iFirUPCoefs},            // FILTER_DEFS_FIR_UP_ID
-    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP4844_N_TAPS,        iFirUP4844Coefs},        // FILTER_DEFS_FIR_UP4844_ID
-    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UPF_N_TAPS,            iFirUPFCoefs},            // FILTER_DEFS_FIR_UPF_ID
-    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP192176_N_TAPS,    iFirUP192176Coefs},        // FILTER_DEFS_FIR_UP192176_ID
-    {FIR_TYPE_DS2,                            FILTER_DEFS_FIR_DS_N_TAPS,            iFirDSCoefs},            // FILTER_DEFS_FIR_DS_ID
-    {FIR_TYPE_SYNC,                            0,                                    0}                        // FILTER_DEFS_FIR_NONE_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL_N_TAPS,            iFirBLCoefs FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_FIR_BL_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL9644_N_TAPS,        iFirBL9644Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_FIR_BL9644_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL8848_N_TAPS,        iFirBL8848 FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_FIR_BL8848_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BLF_N_TAPS,            iFirBLFCoefs FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_FIR_BLF_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL19288_N_TAPS,        iFirBL19288Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_FIR_BL19288_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL17696_N_TAPS,        iFirBL17696 FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_FIR_BL17696_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP_N_TAPS,            iFirUPCoefs FILTER_DEFS_FIR_HALF(iFirUPHalfCoefs)},            // FILTER_DEFS_FIR_UP_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP4844_N_TAPS,        iFirUP4844Coefs FILTER_DEFS_FIR_HALF(iFirUP4844HalfCoefs)},        // FILTER_DEFS_FIR_UP4844_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UPF_N_TAPS,            iFirUPFCoefs FILTER_DEFS_FIR_HALF(iFirUPFHalfCoefs)},            // FILTER_DEFS_FIR_UPF_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP192176_N_TAPS,    iFirUP192176Coefs FILTER_DEFS_FIR_HALF(iFirUP192176HalfCoefs)},        // FILTER_DEFS_FIR_UP192176_ID
+    {FIR_TYPE_DS2,                            FILTER_DEFS_FIR_DS_N_TAPS,            iFirDSCoefs FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_FIR_DS_ID
+    {FIR_TYPE_SYNC,                            0,                                    0 FILTER_DEFS_FIR_HALF(0)}                        // FILTER_DEFS_FIR_NONE_ID
+#if SRC_ARBITRARY_FS
+    ,
+    {FIR_TYPE_DS4,                            FILTER_DEFS_FIR_DS4_N_TAPS,            iFirDS4Coefs FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_ASRC_FIR_DS4_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL5016_N_TAPS,        iFirBL5016Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_ASRC_FIR_BL5016_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL4816_N_TAPS,        iFirBL4816Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_ASRC_FIR_BL4816_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL4416_N_TAPS,        iFirBL4416Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_ASRC_FIR_BL4416_ID
+    {FIR_TYPE_SYNC,                            FILTER_DEFS_FIR_BL3716_N_TAPS,        iFirBL3716Coefs FILTER_DEFS_FIR_HALF(0)},        // FILTER_DEFS_ASRC_FIR_BL3716_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP5032_N_TAPS,        iFirUP5032Coefs FILTER_DEFS_FIR_HALF(iFirUP5032HalfCoefs)},        // FILTER_DEFS_ASRC_FIR_UP5032_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP4832_N_TAPS,        iFirUP4832Coefs FILTER_DEFS_FIR_HALF(iFirUP4832HalfCoefs)},        // FILTER_DEFS_ASRC_FIR_UP4832_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP4432_N_TAPS,        iFirUP4432Coefs FILTER_DEFS_FIR_HALF(iFirUP4432HalfCoefs)},        // FILTER_DEFS_ASRC_FIR_UP4432_ID
+    {FIR_TYPE_OS2,                            FILTER_DEFS_FIR_UP3732_N_TAPS,        iFirUP3732Coefs FILTER_DEFS_FIR_HALF(iFirUP3732HalfCoefs)},        // FILTER_DEFS_ASRC_FIR_UP3732_ID
+    {FIR_TYPE_DS8,                            FILTER_DEFS_FIR_DS8_N_TAPS,            iFirDS8Coefs FILTER_DEFS_FIR_HALF(0)},            // FILTER_DEFS_ASRC_FIR_DS8_ID
+    {FIR_TYPE_DS16,                            FILTER_DEFS_FIR_DS16_N_TAPS,        iFirDS16Coefs FILTER_DEFS_FIR_HALF(0)}            // FILTER_DEFS_ASRC_FIR_DS16_ID
+#endif
 };
 
 // FIR filters coefficients
@@ -107,6 +143,72 @@ int                    iFirDSCoefs[FILTER_DEFS_FIR_DS_N_TAPS]     = {
 int                    iFirOSCoefs[FILTER_DEFS_FIR_OS_N_TAPS]     = {
     #include FILTER_DEFS_FIR_OS_FILE
 };
+#if SRC_ARBITRARY_FS
+int                    iFirDS4Coefs[FILTER_DEFS_FIR_DS4_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_DS4_FILE
+};
+int                    iFirBL5016Coefs[FILTER_DEFS_FIR_BL5016_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_BL5016_FILE
+};
+int                    iFirBL4816Coefs[FILTER_DEFS_FIR_BL4816_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_BL4816_FILE
+};
+int                    iFirBL4416Coefs[FILTER_DEFS_FIR_BL4416_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_BL4416_FILE
+};
+int                    iFirBL3716Coefs[FILTER_DEFS_FIR_BL3716_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_BL3716_FILE
+};
+int                    iFirUP5032Coefs[FILTER_DEFS_FIR_UP5032_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_UP5032_FILE
+};
+int                    iFirUP4832Coefs[FILTER_DEFS_FIR_UP4832_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_UP4832_FILE
+};
+int                    iFirUP4432Coefs[FILTER_DEFS_FIR_UP4432_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_UP4432_FILE
+};
+int                    iFirUP3732Coefs[FILTER_DEFS_FIR_UP3732_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_UP3732_FILE
+};
+int                    iFirDS8Coefs[FILTER_DEFS_FIR_DS8_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_DS8_FILE
+};
+int                    iFirDS16Coefs[FILTER_DEFS_FIR_DS16_N_TAPS]     = {
+    #include FILTER_DEFS_FIR_DS16_FILE
+};
+#endif
+#if FIR_FOLD_SYMMETRIC
+int                    iFirUPHalfCoefs[FILTER_DEFS_FIR_UP_N_TAPS / 2]     = {
+    #include FILTER_DEFS_FIR_UP_HALF_FILE
+};
+int                    iFirUP4844HalfCoefs[FILTER_DEFS_FIR_UP4844_N_TAPS / 2]     = {
+    #include FILTER_DEFS_FIR_UP4844_HALF_FILE
+};
+int                    iFirUPFHalfCoefs[FILTER_DEFS_FIR_UPF_N_TAPS / 2]     = {
+    #include FILTER_DEFS_FIR_UPF_HALF_FILE
+};
+int                    iFirUP192176HalfCoefs[FILTER_DEFS_FIR_UP192176_N_TAPS / 2]     = {
+    #include FILTER_DEFS_FIR_UP192176_HALF_FILE
+};
+int                    iFirOSHalfCoefs[FILTER_DEFS_FIR_OS_N_TAPS / 2]     = {
+    #include FILTER_DEFS_FIR_OS_HALF_FILE
+};
+#if SRC_ARBITRARY_FS
+int                    iFirUP5032HalfCoefs[FILTER_DEFS_FIR_UP5032_N_TAPS / 2]     = {
+    #include FILTER_DEFS_FIR_UP5032_HALF_FILE
+};
+int                    iFirUP4832HalfCoefs[FILTER_DEFS_FIR_UP4832_N_TAPS / 2]     = {
+    #include FILTER_DEFS_FIR_UP4832_HALF_FILE
+};
+int                    iFirUP4432HalfCoefs[FILTER_DEFS_FIR_UP4432_N_TAPS / 2]     = {
+    #include FILTER_DEFS_FIR_UP4432_HALF_FILE
+};
+int                    iFirUP3732HalfCoefs[FILTER_DEFS_FIR_UP3732_N_TAPS / 2]     = {
+    #include FILTER_DEFS_FIR_UP3732_HALF_FILE
+};
+#endif
+#endif
 
 
 
@@ -116,11 +218,10 @@ ADFIRDescriptor_t        sADFirDescriptor =
     FILTER_DEFS_ADFIR_PHASE_N_TAPS,        FILTER_DEFS_ADFIR_N_PHASES + 2,        (int *)iADFirCoefs
 };
 
-// ADFIR filter coefficients
-int                    iADFirPrototypeCoefs[FILTER_DEFS_ADFIR_PROTOTYPE_N_TAPS]  = {
-    #include FILTER_DEFS_ADFIR_PROTOTYPE_FILE
+// ADFIR filter coefficients, prepared from the prototype (FILTER_DEFS_ADFIR_PROTOTYPE_FILE) at build time
+const int            iADFirCoefs[FILTER_DEFS_ADFIR_N_PHASES + 2][FILTER_DEFS_ADFIR_PHASE_N_TAPS]  = {
+    #include FILTER_DEFS_ADFIR_PHASES_FILE
 };
-int                    iADFirCoefs[FILTER_DEFS_ADFIR_N_PHASES + 2][FILTER_DEFS_ADFIR_PHASE_N_TAPS];
 
 // PPFIR filters descriptors (ordered by ID)
 PPFIRDescriptor_t        sPPFirDescriptor[FILTER_DEFS_N_PPFIR_ID] =
@@ -46,9 +46,56 @@
     #define        FILTER_DEFS_ASRC_FIR_DS_ID                10            // ID of DS FIR filter
     #define        FILTER_DEFS_ASRC_FIR_NONE_ID                11            // ID of disabled FIR filter
 
+    // Sample rates beyond the six FS codes (asrc_init_hz and ssrc_init_hz, see src_mrhf_asrc.c and
+    // src_mrhf_ssrc.c): extra FIR filters for the ASRC and SSRC stage planners. Off by default on xCORE to
+    // save the memory of their coefficients (about 6kB) when only the rates of the FS codes are used: set
+    // to 1 (e.g. -DSRC_ARBITRARY_FS=1 in the module_build_info of the application) for other rates.
+    #ifndef SRC_ARBITRARY_FS
+    #if defined(__xcore__)
+    #define        SRC_ARBITRARY_FS                0
+    #else
+    #define        SRC_ARBITRARY_FS                1
+    #endif
+    #endif
 
+    #if SRC_ARBITRARY_FS
+    #define        FILTER_DEFS_ASRC_FIR_DS4_ID                12            // ID of DS4 FIR filter
+    #define        FILTER_DEFS_ASRC_FIR_BL5016_ID            13            // ID of BL5016 FIR filter
+    #define        FILTER_DEFS_ASRC_FIR_BL4816_ID            14            // ID of BL4816 FIR filter
+    #define        FILTER_DEFS_ASRC_FIR_BL4416_ID            15            // ID of BL4416 FIR filter
+    #define        FILTER_DEFS_ASRC_FIR_BL3716_ID            16            // ID of BL3716 FIR filter
+    #define        FILTER_DEFS_ASRC_FIR_UP5032_ID            17            // ID of UP5032 FIR filter
+    #define        FILTER_DEFS_ASRC_FIR_UP4832_ID            18            // ID of UP4832 FIR filter
+    #define        FILTER_DEFS_ASRC_FIR_UP4432_ID            19            // ID of UP4432 FIR filter
+    #define        FILTER_DEFS_ASRC_FIR_UP3732_ID            20            // ID of UP3732 FIR filter
+    #define        FILTER_DEFS_ASRC_FIR_DS8_ID                21            // ID of DS8 FIR filter
+    #define        FILTER_DEFS_ASRC_FIR_DS16_ID                22            // ID of DS16 FIR filter
+
+    // SSRC FIR filters IDs (same filters as the ASRC ones above)
+    #define        FILTER_DEFS_SSRC_FIR_DS4_ID                12            // ID of DS4 FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_BL5016_ID            13            // ID of BL5016 FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_BL4816_ID            14            // ID of BL4816 FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_BL4416_ID            15            // ID of BL4416 FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_BL3716_ID            16            // ID of BL3716 FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_UP5032_ID            17            // ID of UP5032 FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_UP4832_ID            18            // ID of UP4832 FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_UP4432_ID            19            // ID of UP4432 FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_UP3732_ID            20            // ID of UP3732 FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_DS8_ID                21            // ID of DS8 FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_DS16_ID                22            // ID of DS16 FIR filter
+    #endif
+
+
+    #if SRC_ARBITRARY_FS
+    #define        FILTER_DEFS_SSRC_N_FIR_ID                  (FILTER_DEFS_SSRC_FIR_DS16_ID + 1)        // Number of FIR IDs (NONE is not the last one)
+    #else
     #define        FILTER_DEFS_SSRC_N_FIR_ID                  (FILTER_DEFS_SSRC_FIR_NONE_ID + 1)        // Number of FIR IDs corresponding to real FIRs
+    #endif
+    #if SRC_ARBITRARY_FS
+    #define        FILTER_DEFS_ASRC_N_FIR_ID                  (FILTER_DEFS_ASRC_FIR_DS16_ID + 1)        // Number of FIR IDs (NONE is not the last one)
+    #else
         #define        FILTER_DEFS_ASRC_N_FIR_ID                  (FILTER_DEFS_ASRC_FIR_NONE_ID + 1)        // Number of FIR IDs corresponding to real FIRs
+    #endif
 
     // FIR filter number of taps
     #define        FILTER_DEFS_FIR_BL_N_TAPS            144            // Number of taps of BL FIR filter
@@ -63,9 +110,29 @@
     #define        FILTER_DEFS_FIR_UP192176_N_TAPS        96            // Number of taps of UP192176 filter
     #define        FILTER_DEFS_FIR_DS_N_TAPS            32            // Number of taps of DS filter
         #define        FILTER_DEFS_FIR_OS_N_TAPS            32            // Number of taps of OS filter
+    #if SRC_ARBITRARY_FS
+    #define        FILTER_DEFS_FIR_DS4_N_TAPS            64            // Number of taps of DS4 filter
+    #define        FILTER_DEFS_FIR_BL5016_N_TAPS        160            // Number of taps of BL5016 filter
+    #define        FILTER_DEFS_FIR_BL4816_N_TAPS        160            // Number of taps of BL4816 filter
+    #define        FILTER_DEFS_FIR_BL4416_N_TAPS        144            // Number of taps of BL4416 filter
+    #define        FILTER_DEFS_FIR_BL3716_N_TAPS        144            // Number of taps of BL3716 filter
+    #define        FILTER_DEFS_FIR_UP5032_N_TAPS        160            // Number of taps of UP5032 filter
+    #define        FILTER_DEFS_FIR_UP4832_N_TAPS        160            // Number of taps of UP4832 filter
+    #define        FILTER_DEFS_FIR_UP4432_N_TAPS        144            // Number of taps of UP4432 filter
+    #define        FILTER_DEFS_FIR_UP3732_N_TAPS        144            // Number of taps of UP3732 filter
+    #define        FILTER_DEFS_FIR_DS8_N_TAPS            128            // Number of taps of DS8 filter
+    #define        FILTER_DEFS_FIR_DS16_N_TAPS            176            // Number of taps of DS16 filter
+    #endif
 
     #define        FILTER_DEFS_FIR_MAX_TAPS_LONG        FILTER_DEFS_FIR_BL9644_N_TAPS        // Maximum number of taps for long FIR filter
     #define        FILTER_DEFS_FIR_MAX_TAPS_SHORT        FILTER_DEFS_FIR_DS_N_TAPS            // Maximum number of taps for short FIR filter
+    #if SRC_ARBITRARY_FS
+    #define        FILTER_DEFS_ASRC_FIR_MAX_TAPS_SHORT    FILTER_DEFS_FIR_DS16_N_TAPS            // Maximum number of taps for ASRC short FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_MAX_TAPS_SHORT    FILTER_DEFS_FIR_DS16_N_TAPS            // Maximum number of taps for SSRC short FIR filter
+    #else
+    #define        FILTER_DEFS_ASRC_FIR_MAX_TAPS_SHORT    FILTER_DEFS_FIR_MAX_TAPS_SHORT        // Maximum number of taps for ASRC short FIR filter
+    #define        FILTER_DEFS_SSRC_FIR_MAX_TAPS_SHORT    FILTER_DEFS_FIR_MAX_TAPS_SHORT        // Maximum number of taps for SSRC short FIR filter
+    #endif
 
     // FIR filter coefficients files
     #define        FILTER_DEFS_FIR_BL_FILE                "FilterData/BL.dat"            // Coefficients file for BL FIR filter
@@ -80,6 +147,36 @@
     #define        FILTER_DEFS_FIR_UP192176_FILE        "FilterData/UP192176.dat"    // Coefficients file for UP192176 filter
     #define        FILTER_DEFS_FIR_DS_FILE                "FilterData/DS.dat"            // Coefficients file for DS filter
         #define        FILTER_DEFS_FIR_OS_FILE                "FilterData/OS.dat"            // Coefficients file for OS filter
+    #if SRC_ARBITRARY_FS
+    // Generated by src_mrhf_fir_coefs_generator.py
+    #define        FILTER_DEFS_FIR_DS4_FILE            "FilterData/DS4.dat"        // Coefficients file for DS4 filter
+    #define        FILTER_DEFS_FIR_BL5016_FILE            "FilterData/BL5016.dat"        // Coefficients file for BL5016 filter
+    #define        FILTER_DEFS_FIR_BL4816_FILE            "FilterData/BL4816.dat"        // Coefficients file for BL4816 filter
+    #define        FILTER_DEFS_FIR_BL4416_FILE            "FilterData/BL4416.dat"        // Coefficients file for BL4416 filter
+    #define        FILTER_DEFS_FIR_BL3716_FILE            "FilterData/BL3716.dat"        // Coefficients file for BL3716 filter
+    #define        FILTER_DEFS_FIR_UP5032_FILE            "FilterData/UP5032.dat"        // Coefficients file for UP5032 filter
+    #define        FILTER_DEFS_FIR_UP4832_FILE            "FilterData/UP4832.dat"        // Coefficients file for UP4832 filter
+    #define        FILTER_DEFS_FIR_UP4432_FILE            "FilterData/UP4432.dat"        // Coefficients file for UP4432 filter
+    #define        FILTER_DEFS_FIR_UP3732_FILE            "FilterData/UP3732.dat"        // Coefficients file for UP3732 filter
+    #define        FILTER_DEFS_FIR_DS8_FILE            "FilterData/DS8.dat"        // Coefficients file for DS8 filter
+    #define        FILTER_DEFS_FIR_DS16_FILE            "FilterData/DS16.dat"        // Coefficients file for DS16 filter
+    #endif
+
+    // First half of the symmetric OS2 FIR filter coefficients, for the folded inner loop (FIR_FOLD_SYMMETRIC,
+    // see src_mrhf_fir.h). Generated by src_mrhf_fir_half_coefs_generator.py
+    #if FIR_FOLD_SYMMETRIC
+    #define        FILTER_DEFS_FIR_UP_HALF_FILE        "FilterData/UPHalf.dat"        // First half of UP filter coefficients
+    #define        FILTER_DEFS_FIR_UP4844_HALF_FILE    "FilterData/UP4844Half.dat"    // First half of UP4844 filter coefficients
+    #define        FILTER_DEFS_FIR_UPF_HALF_FILE        "FilterData/UPFHalf.dat"    // First half of UPF filter coefficients
+    #define        FILTER_DEFS_FIR_UP192176_HALF_FILE    "FilterData/UP192176Half.dat"    // First half of UP192176 filter coefficients
+    #define        FILTER_DEFS_FIR_OS_HALF_FILE        "FilterData/OSHalf.dat"        // First half of OS filter coefficients
+    #if SRC_ARBITRARY_FS
+    #define        FILTER_DEFS_FIR_UP5032_HALF_FILE    "FilterData/UP5032Half.dat"    // First half of UP5032 filter coefficients
+    #define        FILTER_DEFS_FIR_UP4832_HALF_FILE    "FilterData/UP4832Half.dat"    // First half of UP4832 filter coefficients
+    #define        FILTER_DEFS_FIR_UP4432_HALF_FILE    "FilterData/UP4432Half.dat"    // First half of UP4432 filter coefficients
+    #define        FILTER_DEFS_FIR_UP3732_HALF_FILE    "FilterData/UP3732Half.dat"    // First half of UP3732 filter coefficients
+    #endif
+    #endif
 
     // ADFIR filter number of taps and phases
     #define        FILTER_DEFS_ADFIR_PROTOTYPE_N_TAPS    1920                                                                        // Number of taps of ADFIR filter prototype
@@ -90,6 +187,7 @@
 
     // ADFIR filter coefficients files
     #define        FILTER_DEFS_ADFIR_PROTOTYPE_FILE    "FilterData/ADFir.dat"        // Coefficients file for the ADFIR filter (prototype)
+    #define        FILTER_DEFS_ADFIR_PHASES_FILE        "FilterData/ADFirPhases.dat"    // ADFIR filter phases prepared from the prototype (src_mrhf_adfir_coefs_generator.py)
 
     // PPFIR filters IDs
     #define        FILTER_DEFS_PPFIR_HS294_ID            0            // ID of HS294 PPFIR filter
@@ -141,12 +239,37 @@
     extern        int                                    iFirUP192176Coefs[FILTER_DEFS_FIR_UP192176_N_TAPS];
     extern        int                                    iFirDSCoefs[FILTER_DEFS_FIR_DS_N_TAPS];
     extern        int                                    iFirOSCoefs[FILTER_DEFS_FIR_OS_N_TAPS];
+#if SRC_ARBITRARY_FS
+    extern        int                                    iFirDS4Coefs[FILTER_DEFS_FIR_DS4_N_TAPS];
+    extern        int                                    iFirBL5016Coefs[FILTER_DEFS_FIR_BL5016_N_TAPS];
+    extern        int                                    iFirBL4816Coefs[FILTER_DEFS_FIR_BL4816_N_TAPS];
+    extern        int                                    iFirBL4416Coefs[FILTER_DEFS_FIR_BL4416_N_TAPS];
+    extern        int                                    iFirBL3716Coefs[FILTER_DEFS_FIR_BL3716_N_TAPS];
+    extern        int                                    iFirUP5032Coefs[FILTER_DEFS_FIR_UP5032_N_TAPS];
+    extern        int                                    iFirUP4832Coefs[FILTER_DEFS_FIR_UP4832_N_TAPS];
+    extern        int                                    iFirUP4432Coefs[FILTER_DEFS_FIR_UP4432_N_TAPS];
+    extern        int                                    iFirUP3732Coefs[FILTER_DEFS_FIR_UP3732_N_TAPS];
+    extern        int                                    iFirDS8Coefs[FILTER_DEFS_FIR_DS8_N_TAPS];
+    extern        int                                    iFirDS16Coefs[FILTER_DEFS_FIR_DS16_N_TAPS];
+#endif
+#if FIR_FOLD_SYMMETRIC
+    extern        int                                    iFirUPHalfCoefs[FILTER_DEFS_FIR_UP_N_TAPS / 2];
+    extern        int                                    iFirUP4844HalfCoefs[FILTER_DEFS_FIR_UP4844_N_TAPS / 2];
+    extern        int                                    iFirUPFHalfCoefs[FILTER_DEFS_FIR_UPF_N_TAPS / 2];
+    extern        int                                    iFirUP192176HalfCoefs[FILTER_DEFS_FIR_UP192176_N_TAPS / 2];
+    extern        int                                    iFirOSHalfCoefs[FILTER_DEFS_FIR_OS_N_TAPS / 2];
+#if SRC_ARBITRARY_FS
+    extern        int                                    iFirUP5032HalfCoefs[FILTER_DEFS_FIR_UP5032_N_TAPS / 2];
+    extern        int                                    iFirUP4832HalfCoefs[FILTER_DEFS_FIR_UP4832_N_TAPS / 2];
+    extern        int                                    iFirUP4432HalfCoefs[FILTER_DEFS_FIR_UP4432_N_TAPS / 2];
+    extern        int                                    iFirUP3732HalfCoefs[FILTER_DEFS_FIR_UP3732_N_TAPS / 2];
+#endif
+#endif
 
     // ADFIR filter descriptor
     extern        ADFIRDescriptor_t                    sADFirDescriptor;
-    // ADFIR filters coefficients
-    extern        int                                    iADFirPrototypeCoefs[FILTER_DEFS_ADFIR_PROTOTYPE_N_TAPS];
-    extern        int                                    iADFirCoefs[FILTER_DEFS_ADFIR_N_PHASES + 2][FILTER_DEFS_ADFIR_PHASE_N_TAPS];
+    // ADFIR filters coefficients (read only, shared by all ASRC instances)
+    extern        const int                            iADFirCoefs[FILTER_DEFS_ADFIR_N_PHASES + 2][FILTER_DEFS_ADFIR_PHASE_N_TAPS];
 
     // PPFIR filters descriptors (ordered by ID)
     extern        PPFIRDescriptor_t                    sPPFirDescriptor[FILTER_DEFS_N_PPFIR_ID];
@@ -16,14 +16,12 @@
 // ===========================================================================
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
 
-// Optimised assembler inner loop functions
-#include "src_mrhf_fir_os_inner_loop_asm.h"
-#include "src_mrhf_fir_inner_loop_asm.h"
-#include "src_mrhf_adfir_inner_loop_asm.h"
-#include "src_mrhf_spline_coeff_gen_inner_loop_asm.h"
+// Optimised inner loop functions (assembler on xCORE)
+#include "src_kernels.h"
 
 // FIR includes
 #include "src_mrhf_fir.h"
@@ -56,6 +54,9 @@
 //
 // ===========================================================================
 
+static FIRReturnCodes_t         FIR_proc_os2_mc(FIRCtrl_t* psFIRCtrl[], unsigned int uiNChannels);
+static FIRReturnCodes_t         FIR_proc_sync_mc(FIRCtrl_t* psFIRCtrl[], unsigned int uiNChannels);
+static FIRReturnCodes_t         FIR_proc_ds2_mc(FIRCtrl_t* psFIRCtrl[], unsigned int uiNChannels);
 
 
 // ===========================================================================
@@ -74,6 +75,30 @@
 // ==================================================================== //
 FIRReturnCodes_t                FIR_init_from_desc(FIRCtrl_t* psFIRCtrl, FIRDescriptor_t* psFIRDescriptor)
 {
+    // Set up the FIR
+    if(FIR_set_desc(psFIRCtrl, psFIRDescriptor) != FIR_NO_ERROR)
+        return FIR_ERROR;
+
+    // Sync the FIR
+    if(FIR_sync(psFIRCtrl) != FIR_NO_ERROR)
+        return FIR_ERROR;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_set_desc                                        //
+// Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+//                    FIRDescriptor_t *psFIRDescriptor: Desc. strct.        //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Sets up the FIR from the Descriptor, leaving its    //
+//                    delay line untouched until it is synced                //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_set_desc(FIRCtrl_t* psFIRCtrl, FIRDescriptor_t* psFIRDescriptor)
+{
+    unsigned int        uiDecim;
 
     // Check if FIR is disabled (this is given by the number of coefficients being zero)
     if( psFIRDescriptor->uiNCoefs == 0)
@@ -86,6 +111,10 @@ FIRReturnCodes_t                FIR_init_from_desc(FIRCtrl_t* psFIRCtrl, FIRDesc
         psFIRCtrl->piDelayW            = 0;
         psFIRCtrl->uiDelayO            = 0;
         psFIRCtrl->uiNLoops            = 0;
+#if !defined(__xcore__)
+        psFIRCtrl->pvInnerLoop        = 0;
+        psFIRCtrl->piLoopCoefs        = 0;
+#endif
         psFIRCtrl->uiNCoefs            = 0;
         psFIRCtrl->piCoefs            = 0;
 
@@ -119,12 +148,24 @@ FIRReturnCodes_t                FIR_init_from_desc(FIRCtrl_t* psFIRCtrl, FIRDesc
             psFIRCtrl->eEnable            = FIR_ON;
             psFIRCtrl->uiNOutSamples    = (psFIRCtrl->uiNInSamples)<<1;                        // Os2 FIR doubles the number of samples
             psFIRCtrl->pvProc            = (FIRReturnCodes_t (*)(int *)) FIR_proc_os2;
-            psFIRCtrl->uiDelayL            = psFIRDescriptor->uiNCoefs;                        // Double length for circular buffer simulation, but only half length due to OS2
-            psFIRCtrl->piDelayW            = psFIRCtrl->piDelayB + (psFIRDescriptor->uiNCoefs>>1);
+            psFIRCtrl->uiDelayL            = FIR_DELAY_LEN(psFIRDescriptor->uiNCoefs>>1);        // Only half length due to OS2
+            psFIRCtrl->piDelayW            = FIR_DELAY_WRAP(psFIRCtrl->piDelayB, psFIRDescriptor->uiNCoefs>>1, 1);
             psFIRCtrl->uiDelayO            = psFIRDescriptor->uiNCoefs>>1;
             psFIRCtrl->uiNLoops            = psFIRDescriptor->uiNCoefs>>2;                        // Due to 2 x 32bits read for data and 4 x 32bits for coefs per inner loop
             psFIRCtrl->uiNCoefs            = psFIRDescriptor->uiNCoefs;
             psFIRCtrl->piCoefs            = psFIRDescriptor->piCoefs;
+#if !defined(__xcore__)
+            psFIRCtrl->pvInnerLoop        = SRC_MRHF_FIR_OS_KERNEL(psFIRCtrl->uiNLoops);        // Fully unrolled for the filter lengths
+            psFIRCtrl->piLoopCoefs        = psFIRDescriptor->piCoefs;
+#if FIR_FOLD_SYMMETRIC
+            if((psFIRDescriptor->piCoefsHalf != 0) && SRC_KERNELS_FOLD_SYMMETRIC())
+            {
+                // Folded inner loop reading the first half of the symmetric coefficients
+                psFIRCtrl->pvInnerLoop    = src_mrhf_fir_os_sym_inner_loop_c;
+                psFIRCtrl->piLoopCoefs    = psFIRDescriptor->piCoefsHalf;
+            }
+#endif
+#endif
         break;
 
         // Asynchronous type
@@ -135,10 +176,14 @@ FIRReturnCodes_t                FIR_init_from_desc(FIRCtrl_t* psFIRCtrl, FIRDesc
             psFIRCtrl->eEnable            = FIR_ON;
             psFIRCtrl->uiNOutSamples    = psFIRCtrl->uiNInSamples;                            // Sync FIR does not change number of samples
             psFIRCtrl->pvProc            = (FIRReturnCodes_t (*)(int *)) FIR_proc_sync;
-            psFIRCtrl->uiDelayL            = psFIRDescriptor->uiNCoefs<<1;                        // Double length for circular buffer simulation
-            psFIRCtrl->piDelayW            = psFIRCtrl->piDelayB + psFIRDescriptor->uiNCoefs;
+            psFIRCtrl->uiDelayL            = FIR_DELAY_LEN(psFIRDescriptor->uiNCoefs);
+            psFIRCtrl->piDelayW            = FIR_DELAY_WRAP(psFIRCtrl->piDelayB, psFIRDescriptor->uiNCoefs, 1);
             psFIRCtrl->uiDelayO            = psFIRDescriptor->uiNCoefs;
             psFIRCtrl->uiNLoops            = psFIRDescriptor->uiNCoefs>>1;                        // Due to 2 x 32bits read for data and coefs per inner loop
+#if !defined(__xcore__)
+            psFIRCtrl->pvInnerLoop        = SRC_MRHF_FIR_KERNEL(psFIRCtrl->uiNLoops);            // Fully unrolled for the filter lengths
+            psFIRCtrl->piLoopCoefs        = psFIRDescriptor->piCoefs;
+#endif
             psFIRCtrl->uiNCoefs            = psFIRDescriptor->uiNCoefs;
             psFIRCtrl->piCoefs            = psFIRDescriptor->piCoefs;
         break;
@@ -150,10 +195,42 @@ FIRReturnCodes_t                FIR_init_from_desc(FIRCtrl_t* psFIRCtrl, FIRDesc
             psFIRCtrl->eEnable            = FIR_ON;
             psFIRCtrl->uiNOutSamples    = psFIRCtrl->uiNInSamples>>1;                        // Ds2 FIR divides the number of samples by two
             psFIRCtrl->pvProc            = (FIRReturnCodes_t (*)(int *)) FIR_proc_ds2;
-            psFIRCtrl->uiDelayL            = psFIRDescriptor->uiNCoefs<<1;                        // Double length for circular buffer simulation
-            psFIRCtrl->piDelayW            = psFIRCtrl->piDelayB + psFIRDescriptor->uiNCoefs;
+            psFIRCtrl->uiDelayL            = FIR_DELAY_LEN(psFIRDescriptor->uiNCoefs);
+            psFIRCtrl->piDelayW            = FIR_DELAY_WRAP(psFIRCtrl->piDelayB, psFIRDescriptor->uiNCoefs, 2);
+            psFIRCtrl->uiDelayO            = psFIRDescriptor->uiNCoefs;
+            psFIRCtrl->uiNLoops            = psFIRDescriptor->uiNCoefs>>1;                        // Due to 2 x 32bits read for data and coefs per inner loop
+#if !defined(__xcore__)
+            psFIRCtrl->pvInnerLoop        = SRC_MRHF_FIR_KERNEL(psFIRCtrl->uiNLoops);            // Fully unrolled for the filter lengths
+            psFIRCtrl->piLoopCoefs        = psFIRDescriptor->piCoefs;
+#endif
+            psFIRCtrl->uiNCoefs            = psFIRDescriptor->uiNCoefs;
+            psFIRCtrl->piCoefs            = psFIRDescriptor->piCoefs;
+        break;
+
+        // Down-sample by 4, 8 or 16 type
+        case FIR_TYPE_DS4:
+        case FIR_TYPE_DS8:
+        case FIR_TYPE_DS16:
+            uiDecim                        = FIR_DSN_DECIM(psFIRDescriptor->eType);
+            if( (psFIRDescriptor->uiNCoefs & (uiDecim - 1)) != 0x0)                            // Check that number of coefficients is a multiple of the decimation
+                return FIR_ERROR;
+            if( (psFIRCtrl->uiNInSamples & (uiDecim - 1)) != 0x0)                            // Check that number of samples is a multiple of the decimation
+                return FIR_ERROR;
+#if SRC_LINEAR_DELAY_LINES
+            if( uiDecim > SRC_LINEAR_DELAY_BLOCK )                                            // Linear delay lines take up to SRC_LINEAR_DELAY_BLOCK samples per step
+                return FIR_ERROR;
+#endif
+            psFIRCtrl->eEnable            = FIR_ON;
+            psFIRCtrl->uiNOutSamples    = psFIRCtrl->uiNInSamples / uiDecim;                // DsN FIR divides the number of samples by the decimation
+            psFIRCtrl->pvProc            = (FIRReturnCodes_t (*)(int *)) FIR_proc_dsn;
+            psFIRCtrl->uiDelayL            = FIR_DELAY_LEN(psFIRDescriptor->uiNCoefs);
+            psFIRCtrl->piDelayW            = FIR_DELAY_WRAP(psFIRCtrl->piDelayB, psFIRDescriptor->uiNCoefs, uiDecim);
             psFIRCtrl->uiDelayO            = psFIRDescriptor->uiNCoefs;
             psFIRCtrl->uiNLoops            = psFIRDescriptor->uiNCoefs>>1;                        // Due to 2 x 32bits read for data and coefs per inner loop
+#if !defined(__xcore__)
+            psFIRCtrl->pvInnerLoop        = SRC_MRHF_FIR_KERNEL(psFIRCtrl->uiNLoops);            // Fully unrolled for the filter lengths
+            psFIRCtrl->piLoopCoefs        = psFIRDescriptor->piCoefs;
+#endif
             psFIRCtrl->uiNCoefs            = psFIRDescriptor->uiNCoefs;
             psFIRCtrl->piCoefs            = psFIRDescriptor->piCoefs;
         break;
@@ -163,9 +240,54 @@ FIRReturnCodes_t                FIR_init_from_desc(FIRCtrl_t* psFIRCtrl, FIRDesc
             return FIR_ERROR;
     }
 
-    // Sync the FIR
-    if(FIR_sync(psFIRCtrl) != FIR_NO_ERROR)
-        return FIR_ERROR;
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_get_n_out_samples                                //
+// Arguments:        FIRDescriptor_t *psFIRDescriptor: Desc. strct.        //
+//                    unsigned int uiNInSamples: Number of input samples    //
+//                    unsigned int *puiNOutSamples: Number of output        //
+//                    samples (0 if the FIR is disabled)                    //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Gets the number of output samples of a FIR from the    //
+//                    Descriptor, as FIR_init_from_desc                    //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_get_n_out_samples(FIRDescriptor_t* psFIRDescriptor, unsigned int uiNInSamples, unsigned int* puiNOutSamples)
+{
+    // FIR disabled
+    if( psFIRDescriptor->uiNCoefs == 0)
+    {
+        *puiNOutSamples        = 0;
+        return FIR_NO_ERROR;
+    }
+
+    switch(psFIRDescriptor->eType)
+    {
+        case FIR_TYPE_OS2:
+            *puiNOutSamples    = uiNInSamples<<1;
+        break;
+
+        case FIR_TYPE_SYNC:
+            *puiNOutSamples    = uiNInSamples;
+        break;
+
+        case FIR_TYPE_DS2:
+            *puiNOutSamples    = uiNInSamples>>1;
+        break;
+
+        case FIR_TYPE_DS4:
+        case FIR_TYPE_DS8:
+        case FIR_TYPE_DS16:
+            *puiNOutSamples    = uiNInSamples / FIR_DSN_DECIM(psFIRDescriptor->eType);
+        break;
+
+        // Unrecognized type
+        default:
+            return FIR_ERROR;
+    }
 
     return FIR_NO_ERROR;
 }
@@ -185,7 +307,7 @@ FIRReturnCodes_t                FIR_sync(FIRCtrl_t* psFIRCtrl)
     if(psFIRCtrl->eEnable == FIR_ON)
     {
         // Set delay line index back to base
-        psFIRCtrl->piDelayI    = psFIRCtrl->piDelayB;
+        psFIRCtrl->piDelayI    = FIR_DELAY_START(psFIRCtrl->piDelayB, psFIRCtrl->uiDelayO);
 
         // Clear delay line
         for(ui = 0; ui < psFIRCtrl->uiDelayL; ui++)
@@ -196,6 +318,202 @@ FIRReturnCodes_t                FIR_sync(FIRCtrl_t* psFIRCtrl)
 }
 
 
+// ==================================================================== //
+// Function:        FIR_get_history                                        //
+// Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+//                    const int **ppiHistory: History (oldest first)        //
+//                    unsigned int *puiHistoryL: Number of samples        //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Gets the delay line samples, oldest first, in place    //
+//                    (valid until the delay line is next written)        //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_get_history(FIRCtrl_t* psFIRCtrl, const int** ppiHistory, unsigned int* puiHistoryL)
+{
+    // Disabled FIR has no history
+    *ppiHistory        = 0;
+    *puiHistoryL    = 0;
+    if(psFIRCtrl->eEnable != FIR_ON)
+        return FIR_NO_ERROR;
+
+    // Delay line data holds the last uiDelayO samples, oldest first
+    *ppiHistory        = FIR_DELAY_DATA(psFIRCtrl->piDelayI, psFIRCtrl->uiDelayO);
+    *puiHistoryL    = psFIRCtrl->uiDelayO;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_sync_history                                    //
+// Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+//                    const int *piHistory: History (oldest first)        //
+//                    unsigned int uiHistoryL: Number of history samples    //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Syncs the FIR with the newest history samples (from    //
+//                    FIR_get_history) in its delay line, the older ones    //
+//                    cleared. The history may lie in the delay line        //
+//                    buffer itself                                        //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_sync_history(FIRCtrl_t* psFIRCtrl, const int* piHistory, unsigned int uiHistoryL)
+{
+    unsigned int        ui;
+
+    if(psFIRCtrl->eEnable != FIR_ON)
+        return FIR_NO_ERROR;
+
+    // Keep only the newest samples if the delay line got shorter (the older ones are cleared otherwise)
+    if(uiHistoryL > psFIRCtrl->uiDelayO)
+    {
+        piHistory    += uiHistoryL - psFIRCtrl->uiDelayO;
+        uiHistoryL    = psFIRCtrl->uiDelayO;
+    }
+
+    // Delay line index back to base: its data starts at the base in both delay line layouts. Move the
+    // history to the newest end of the data first, as it may overlap the cleared part
+    psFIRCtrl->piDelayI    = FIR_DELAY_START(psFIRCtrl->piDelayB, psFIRCtrl->uiDelayO);
+    memmove(psFIRCtrl->piDelayB + psFIRCtrl->uiDelayO - uiHistoryL, piHistory, uiHistoryL * sizeof(int));
+    for(ui = 0; ui < psFIRCtrl->uiDelayO - uiHistoryL; ui++)
+        psFIRCtrl->piDelayB[ui]    = FIR_STATE_INIT;
+#if !SRC_LINEAR_DELAY_LINES
+    // Second copy of the circular buffer
+    memcpy(psFIRCtrl->piDelayB + psFIRCtrl->uiDelayO, psFIRCtrl->piDelayB, psFIRCtrl->uiDelayO * sizeof(int));
+#endif
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_get_delay                                        //
+// Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+//                    long long *pi64Delay: Group delay (Q32 format)        //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Gets the group delay at DC of the FIR in input        //
+//                    samples (0 when disabled): output sample n, at time    //
+//                    n x uiNInSamples / uiNOutSamples, is the input at    //
+//                    that time less the delay                            //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_get_delay(FIRCtrl_t* psFIRCtrl, long long* pi64Delay)
+{
+    double                dSum        = 0.0;
+    double                dMoment        = 0.0;
+    double                dDelay;
+    unsigned int        ui;
+
+    *pi64Delay        = 0;
+    if(psFIRCtrl->eEnable != FIR_ON)
+        return FIR_NO_ERROR;
+
+    // Delay lines are oldest first, so coefficient ui weights the input uiNCoefs - 1 - ui samples before the newest
+    for(ui = 0; ui < psFIRCtrl->uiNCoefs; ui++)
+    {
+        dSum        += psFIRCtrl->piCoefs[ui];
+        dMoment        += (double)psFIRCtrl->piCoefs[ui] * (psFIRCtrl->uiNCoefs - 1 - ui);
+    }
+    if(dSum == 0.0)
+        return FIR_ERROR;
+    dDelay            = dMoment / dSum;
+
+    if(psFIRCtrl->uiNOutSamples > psFIRCtrl->uiNInSamples)
+        // OS2 interleaves its two phases, each coefficient step is half an input sample
+        dDelay        = dDelay / 2;
+    else
+        // DS2 to DS16 output at the time of the oldest input sample of each group
+        dDelay        -= (double)(psFIRCtrl->uiNInSamples / psFIRCtrl->uiNOutSamples - 1);
+
+    *pi64Delay        = (long long)(dDelay * 4294967296.0);
+
+    return FIR_NO_ERROR;
+}
+
+
+// Per input sample steps of the FIR_proc functions below.
+// FIR delay lines have an even length so the delay line data pointer alternates between 64 bits
+// aligned and not from one input sample to the next. The FIR_proc functions therefore process input
+// samples in pairs and check the alignment once per block, so each inner loop call can use the
+// variant for its alignment directly (on xCORE) instead of checking it for every output sample.
+
+// Inner loops of the FIR_proc functions: on xCORE the assembler variant for the data alignment,
+// elsewhere the kernel selected for the number of taps by FIR_init_from_desc (pvInnerLoop)
+#if defined(__xcore__)
+#define FIR_INNER_LOOP_EVEN             SRC_MRHF_FIR_INNER_LOOP_EVEN
+#define FIR_INNER_LOOP_ODD              SRC_MRHF_FIR_INNER_LOOP_ODD
+#define FIR_OS_INNER_LOOP_EVEN          SRC_MRHF_FIR_OS_INNER_LOOP_EVEN
+#define FIR_OS_INNER_LOOP_ODD           SRC_MRHF_FIR_OS_INNER_LOOP_ODD
+#else
+#define FIR_INNER_LOOP_EVEN             pvInnerLoop
+#define FIR_INNER_LOOP_ODD              pvInnerLoop
+#define FIR_OS_INNER_LOOP_EVEN          pvInnerLoop
+#define FIR_OS_INNER_LOOP_ODD           pvInnerLoop
+#endif
+
+// Coefficients read by the inner loops of the FIR_proc functions
+#if defined(__xcore__)
+#define FIR_LOOP_COEFS(psFIRCtrl)       ((psFIRCtrl)->piCoefs)
+#else
+#define FIR_LOOP_COEFS(psFIRCtrl)       ((psFIRCtrl)->piLoopCoefs)
+#endif
+
+// Gets new data sample to delay line and processes the two OS2 phases with INNER_LOOP
+#define FIR_OS2_PROC_SPL(INNER_LOOP) \
+    do { \
+        iData[0]                = *piIn; \
+        piIn                    += uiInStep; \
+        FIR_DELAY_WRITE(piDelayI, uiDelayO, 0, iData[0]); \
+        FIR_DELAY_STEP(piDelayB, piDelayI, piDelayW, uiDelayO, 1); \
+        INNER_LOOP(FIR_DELAY_DATA(piDelayI, uiDelayO), piCoefsB, iData, uiNLoops); \
+        /* Write output with step. NOTE OUTPUT WRITE ORDER: First iData[1], then iData[0] */ \
+        *piOut                  = iData[1]; \
+        piOut                   += uiOutStep; \
+        *piOut                  = iData[0]; \
+        piOut                   += uiOutStep; \
+    } while(0)
+
+// Gets new data sample to delay line and processes one output sample with INNER_LOOP
+#define FIR_SYNC_PROC_SPL(INNER_LOOP) \
+    do { \
+        iData0                  = *piIn; \
+        piIn                    += uiInStep; \
+        FIR_DELAY_WRITE(piDelayI, uiDelayO, 0, iData0); \
+        FIR_DELAY_STEP(piDelayB, piDelayI, piDelayW, uiDelayO, 1); \
+        INNER_LOOP(FIR_DELAY_DATA(piDelayI, uiDelayO), piCoefsB, &iData0, uiNLoops); \
+        *piOut                  = iData0; \
+        piOut                   += uiOutStep; \
+    } while(0)
+
+// Gets two new data samples to delay line and processes one output sample with INNER_LOOP
+#define FIR_DS2_PROC_SPL(INNER_LOOP) \
+    do { \
+        iData0                  = *piIn; \
+        piIn                    += uiInStep; \
+        iData1                  = *piIn; \
+        piIn                    += uiInStep; \
+        FIR_DELAY_WRITE(piDelayI, uiDelayO, 0, iData0); \
+        FIR_DELAY_WRITE(piDelayI, uiDelayO, 1, iData1); \
+        FIR_DELAY_STEP(piDelayB, piDelayI, piDelayW, uiDelayO, 2); \
+        INNER_LOOP(FIR_DELAY_DATA(piDelayI, uiDelayO), piCoefsB, &iData0, uiNLoops); \
+        *piOut                  = iData0; \
+        piOut                   += uiOutStep; \
+    } while(0)
+
+// Gets uiDecim new data samples to delay line and processes one output sample with INNER_LOOP
+#define FIR_DSN_PROC_SPL(INNER_LOOP) \
+    do { \
+        for(uk = 0; uk < uiDecim; uk++) \
+        { \
+            FIR_DELAY_WRITE(piDelayI, uiDelayO, uk, *piIn); \
+            piIn                += uiInStep; \
+        } \
+        FIR_DELAY_STEP(piDelayB, piDelayI, piDelayW, uiDelayO, uiDecim); \
+        INNER_LOOP(FIR_DELAY_DATA(piDelayI, uiDelayO), piCoefsB, &iData0, uiNLoops); \
+        *piOut                  = iData0; \
+        piOut                   += uiOutStep; \
+    } while(0)
+
+
 // ==================================================================== //
 // Function:        FIR_proc_os2                                        //
 // Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
@@ -213,73 +531,32 @@ FIRReturnCodes_t                FIR_proc_os2(FIRCtrl_t* psFIRCtrl)
     int*            piDelayI    = psFIRCtrl->piDelayI;
     int*            piDelayW    = psFIRCtrl->piDelayW;
     unsigned int    uiDelayO    = psFIRCtrl->uiDelayO;
-    int*            piCoefsB    = psFIRCtrl->piCoefs;
+    int*            piCoefsB    = FIR_LOOP_COEFS(psFIRCtrl);
     unsigned int    uiNLoops    = psFIRCtrl->uiNLoops;
-    int*            piData;
-    int*            piCoefs;
+#if !defined(__xcore__)
+    void            (*pvInnerLoop)(int *, int *, int [], int) = psFIRCtrl->pvInnerLoop;
+#endif
     int                iData[2];
     unsigned        ui;
 
-    for(ui = 0; ui < psFIRCtrl->uiNInSamples; ui+=2) //Note step by 2 as inner loop unrolled twice
+    // Check alignment of data for first input sample of each pair
+    if(!SRC_KERNELS_DATA_ODD(FIR_DELAY_DATA(piDelayI + 1, uiDelayO)))
     {
-        // Get new data sample to delay line (double write for circular buffer simulation) with step
-        iData[0]                    = *piIn;
-        piIn                    += uiInStep;
-        // Double write to simulate circular buffer
-        *piDelayI               = iData[0];
-        *(piDelayI + uiDelayO)  = iData[0];
-
-        // Step delay (with circular simulation)
-        piDelayI++;
-        if(piDelayI >= piDelayW)
-            piDelayI                = piDelayB;
-
-        // Set access pointers
-        piData                  = piDelayI;
-        piCoefs                 = piCoefsB;
-
-        //printf("piData = %p, piCoefs = %p\n", piData, piCoefs);
-        if ((unsigned)piData & 0b0100)
-            src_mrhf_fir_os_inner_loop_asm_odd(piData, piCoefs, iData, uiNLoops);
-        else
-            src_mrhf_fir_os_inner_loop_asm(piData, piCoefs, iData, uiNLoops);
-
-        // Write output with step
-        // NOTE OUTPUT WRITE ORDER: First iData[1], then iData[0]
-        *piOut                  = iData[1];
-        piOut                   += uiOutStep;
-        *piOut                  = iData[0];
-        piOut                   += uiOutStep;
-
-        // Get new data sample to delay line (double write for circular buffer simulation) with step
-        iData[0]                    = *piIn;
-        piIn                    += uiInStep;
-        // Double write to simulate circular buffer
-        *piDelayI               = iData[0];
-        *(piDelayI + uiDelayO)  = iData[0];
-
-        // Step delay (with circular simulation)
-        piDelayI++;
-        if(piDelayI >= piDelayW)
-            piDelayI                = piDelayB;
-
-        // Set access pointers
-        piData                  = piDelayI;
-        piCoefs                 = piCoefsB;
-
-        //printf("piData = %p, piCoefs = %p\n", piData, piCoefs);
-        if ((unsigned)piData & 0b0100)
-            src_mrhf_fir_os_inner_loop_asm_odd(piData, piCoefs, iData, uiNLoops);
-        else
-            src_mrhf_fir_os_inner_loop_asm(piData, piCoefs, iData, uiNLoops);
-
-        // Write output with step
-        // NOTE OUTPUT WRITE ORDER: First iData[1], then iData[0]
-        *piOut                  = iData[1];
-        piOut                   += uiOutStep;
-        *piOut                  = iData[0];
-        piOut                   += uiOutStep;
+        for(ui = 0; ui < psFIRCtrl->uiNInSamples; ui+=2) //Note step by 2 as inner loop unrolled twice
+        {
+            FIR_OS2_PROC_SPL(FIR_OS_INNER_LOOP_EVEN);
+            FIR_OS2_PROC_SPL(FIR_OS_INNER_LOOP_ODD);
+        }
     }
+    else
+    {
+        for(ui = 0; ui < psFIRCtrl->uiNInSamples; ui+=2) //Note step by 2 as inner loop unrolled twice
+        {
+            FIR_OS2_PROC_SPL(FIR_OS_INNER_LOOP_ODD);
+            FIR_OS2_PROC_SPL(FIR_OS_INNER_LOOP_EVEN);
+        }
+    }
+
     // Write delay line index back for next round
     psFIRCtrl->piDelayI        = piDelayI;
 
@@ -304,36 +581,31 @@ FIRReturnCodes_t                FIR_proc_sync(FIRCtrl_t* psFIRCtrl)
     int*            piDelayI    = psFIRCtrl->piDelayI;
     int*            piDelayW    = psFIRCtrl->piDelayW;
     unsigned int    uiDelayO    = psFIRCtrl->uiDelayO;
-    int*            piCoefsB    = psFIRCtrl->piCoefs;
+    int*            piCoefsB    = FIR_LOOP_COEFS(psFIRCtrl);
     unsigned int    uiNLoops    = psFIRCtrl->uiNLoops;
-    int*            piData;
-    int*            piCoefs;
+#if !defined(__xcore__)
+    void            (*pvInnerLoop)(int *, int *, int [], int) = psFIRCtrl->pvInnerLoop;
+#endif
     int                iData0;
     unsigned        ui;
 
-    for(ui = 0; ui < psFIRCtrl->uiNInSamples; ui++)
+    // Check alignment of data for first input sample of each pair
+    // (number of input samples is a multiple of 2, checked at init)
+    if(!SRC_KERNELS_DATA_ODD(FIR_DELAY_DATA(piDelayI + 1, uiDelayO)))
     {
-        // Get new data sample to delay line (double write for circular buffer simulation) with step
-        iData0                    = *piIn;
-        piIn                    += uiInStep;
-        // Double write to simulate circular buffer
-        *piDelayI                = iData0;
-        *(piDelayI + uiDelayO)    = iData0;
-        // Step delay (with circular simulation)
-        piDelayI++;
-        if(piDelayI >= piDelayW)
-            piDelayI                = piDelayB;
-
-        // Clear accumulator and set access pointers
-        piData                    = piDelayI;
-        piCoefs                    = piCoefsB;
-
-        if ((unsigned)piData & 0b0100) src_mrhf_fir_inner_loop_asm_odd(piData, piCoefs, &iData0, uiNLoops);
-        else src_mrhf_fir_inner_loop_asm(piData, piCoefs, &iData0, uiNLoops);
-
-        // Write output with step
-        *piOut                    = iData0;
-        piOut                    += uiOutStep;
+        for(ui = 0; ui < psFIRCtrl->uiNInSamples; ui+=2)
+        {
+            FIR_SYNC_PROC_SPL(FIR_INNER_LOOP_EVEN);
+            FIR_SYNC_PROC_SPL(FIR_INNER_LOOP_ODD);
+        }
+    }
+    else
+    {
+        for(ui = 0; ui < psFIRCtrl->uiNInSamples; ui+=2)
+        {
+            FIR_SYNC_PROC_SPL(FIR_INNER_LOOP_ODD);
+            FIR_SYNC_PROC_SPL(FIR_INNER_LOOP_EVEN);
+        }
     }
 
     // Write delay line index back for next round
@@ -360,38 +632,69 @@ FIRReturnCodes_t                FIR_proc_ds2(FIRCtrl_t* psFIRCtrl)
     int*            piDelayI    = psFIRCtrl->piDelayI;
     int*            piDelayW    = psFIRCtrl->piDelayW;
     unsigned int    uiDelayO    = psFIRCtrl->uiDelayO;
-    int*            piCoefsB    = psFIRCtrl->piCoefs;
+    int*            piCoefsB    = FIR_LOOP_COEFS(psFIRCtrl);
     unsigned int    uiNLoops    = psFIRCtrl->uiNLoops;
-    int*            piData;
-    int*            piCoefs;
+#if !defined(__xcore__)
+    void            (*pvInnerLoop)(int *, int *, int [], int) = psFIRCtrl->pvInnerLoop;
+#endif
     int                iData0, iData1;
     unsigned        ui;
 
-    for(ui = 0; ui < psFIRCtrl->uiNInSamples>>1; ui++)
+    // Two input samples per output sample, so the data alignment is the same for all output samples
+    if(!SRC_KERNELS_DATA_ODD(FIR_DELAY_DATA(piDelayI + 2, uiDelayO)))
     {
-        // Get two new data samples to delay line (double write for circular buffer simulation), with input buffer step
-        iData0                    = *piIn;
-        piIn                    += uiInStep;
-        iData1                    = *piIn;
-        piIn                    += uiInStep;
-        // Double write to simulate circular buffer with DUAL store instruction
-        *piDelayI                = iData0;
-        *(piDelayI + 1)            = iData1;
-        *(piDelayI + uiDelayO)    = iData0;
-        *(piDelayI + uiDelayO + 1)    = iData1;
-        // Step delay with circular simulation
-        piDelayI                += 2;
-        if(piDelayI >= piDelayW)
-            piDelayI                = piDelayB;
-
-        // Clear accumulator and set access pointers
-        piData                    = piDelayI;
-        piCoefs                    = piCoefsB;
-        if ((unsigned)piData & 0b0100) src_mrhf_fir_inner_loop_asm_odd(piData, piCoefs, &iData0, uiNLoops);
-        else src_mrhf_fir_inner_loop_asm(piData, piCoefs, &iData0, uiNLoops);
-        // Write output with step
-        *piOut                    = iData0;
-        piOut                    += uiOutStep;
+        for(ui = 0; ui < psFIRCtrl->uiNInSamples>>1; ui++)
+            FIR_DS2_PROC_SPL(FIR_INNER_LOOP_EVEN);
+    }
+    else
+    {
+        for(ui = 0; ui < psFIRCtrl->uiNInSamples>>1; ui++)
+            FIR_DS2_PROC_SPL(FIR_INNER_LOOP_ODD);
+    }
+
+    // Write delay line index back for next round
+    psFIRCtrl->piDelayI        = piDelayI;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_proc_dsn                                        //
+// Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the FIR in down-sample by 4, 8 or 16 mode    //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_proc_dsn(FIRCtrl_t* psFIRCtrl)
+{
+    int*            piIn        = psFIRCtrl->piIn;
+    unsigned int    uiInStep    = psFIRCtrl->uiInStep;
+    int*            piOut        = psFIRCtrl->piOut;
+    unsigned int    uiOutStep    = psFIRCtrl->uiOutStep;
+    int*            piDelayB    = psFIRCtrl->piDelayB;
+    int*            piDelayI    = psFIRCtrl->piDelayI;
+    int*            piDelayW    = psFIRCtrl->piDelayW;
+    unsigned int    uiDelayO    = psFIRCtrl->uiDelayO;
+    int*            piCoefsB    = FIR_LOOP_COEFS(psFIRCtrl);
+    unsigned int    uiNLoops    = psFIRCtrl->uiNLoops;
+#if !defined(__xcore__)
+    void            (*pvInnerLoop)(int *, int *, int [], int) = psFIRCtrl->pvInnerLoop;
+#endif
+    unsigned int    uiDecim        = psFIRCtrl->uiNInSamples / psFIRCtrl->uiNOutSamples;
+    int                iData0;
+    unsigned        ui, uk;
+
+    // An even number of input samples per output sample, so the data alignment is the same for all output samples
+    if(!SRC_KERNELS_DATA_ODD(FIR_DELAY_DATA(piDelayI + uiDecim, uiDelayO)))
+    {
+        for(ui = 0; ui < psFIRCtrl->uiNOutSamples; ui++)
+            FIR_DSN_PROC_SPL(FIR_INNER_LOOP_EVEN);
+    }
+    else
+    {
+        for(ui = 0; ui < psFIRCtrl->uiNOutSamples; ui++)
+            FIR_DSN_PROC_SPL(FIR_INNER_LOOP_ODD);
     }
 
     // Write delay line index back for next round
@@ -401,6 +704,195 @@ FIRReturnCodes_t                FIR_proc_ds2(FIRCtrl_t* psFIRCtrl)
 }
 
 
+// Multichannel versions of the FIR_proc functions. All channels share the coefficients, number of
+// samples, steps and delay line length of channel 0, and each channel delay line is stepped with
+// its own base and wrap address.
+
+// Loads the per channel pointers from the Ctrl strct.
+#define FIR_MC_LOAD_CTRL() \
+    do { \
+        for(uj = 0; uj < uiNChannels; uj++) \
+        { \
+            piIn[uj]                = psFIRCtrl[uj]->piIn; \
+            piOut[uj]               = psFIRCtrl[uj]->piOut; \
+            piDelayI[uj]            = psFIRCtrl[uj]->piDelayI; \
+        } \
+    } while(0)
+
+// Writes the delay line index of each channel back for next round
+#define FIR_MC_STORE_CTRL() \
+    do { \
+        for(uj = 0; uj < uiNChannels; uj++) \
+            psFIRCtrl[uj]->piDelayI = piDelayI[uj]; \
+    } while(0)
+
+// Gets uiNSpl new data samples of each channel to its delay line and sets the channel data pointers
+#define FIR_MC_GET_SPL(uiNSpl) \
+    do { \
+        for(uj = 0; uj < uiNChannels; uj++) \
+        { \
+            for(uk = 0; uk < (uiNSpl); uk++) \
+            { \
+                FIR_DELAY_WRITE(piDelayI[uj], uiDelayO, uk, *piIn[uj]); \
+                piIn[uj]            += uiInStep; \
+            } \
+            FIR_DELAY_STEP(psFIRCtrl[uj]->piDelayB, piDelayI[uj], psFIRCtrl[uj]->piDelayW, uiDelayO, (uiNSpl)); \
+            piData[uj]              = FIR_DELAY_DATA(piDelayI[uj], uiDelayO); \
+        } \
+    } while(0)
+
+// Local variables of the multichannel FIR_proc functions
+#define FIR_MC_LOCALS \
+    unsigned int    uiInStep    = psFIRCtrl[0]->uiInStep; \
+    unsigned int    uiOutStep   = psFIRCtrl[0]->uiOutStep; \
+    unsigned int    uiDelayO    = psFIRCtrl[0]->uiDelayO; \
+    int*            piCoefsB    = psFIRCtrl[0]->piCoefs; \
+    unsigned int    uiNLoops    = psFIRCtrl[0]->uiNLoops; \
+    int*            piIn[FIR_MC_MAX_CHANNELS]; \
+    int*            piOut[FIR_MC_MAX_CHANNELS]; \
+    int*            piDelayI[FIR_MC_MAX_CHANNELS]; \
+    int*            piData[FIR_MC_MAX_CHANNELS]; \
+    unsigned        ui, uj, uk
+
+
+// ==================================================================== //
+// Function:        FIR_proc_mc                                            //
+// Arguments:        FIRCtrl_t     *psFIRCtrl[]: Ctrl strct. per channel    //
+//                    unsigned int uiNChannels: number of channels        //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes uiNChannels FIRs (up to                    //
+//                    FIR_MC_MAX_CHANNELS) in their pvProc mode            //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_proc_mc(FIRCtrl_t* psFIRCtrl[], unsigned int uiNChannels)
+{
+    FIRReturnCodes_t    (*pvProc)(int *);
+    unsigned            uj;
+
+    if((uiNChannels == 0) || (uiNChannels > FIR_MC_MAX_CHANNELS))
+        return FIR_ERROR;
+
+    pvProc = psFIRCtrl[0]->pvProc;
+    if(pvProc == (FIRReturnCodes_t (*)(int *)) FIR_proc_os2)
+        return FIR_proc_os2_mc(psFIRCtrl, uiNChannels);
+    if(pvProc == (FIRReturnCodes_t (*)(int *)) FIR_proc_sync)
+        return FIR_proc_sync_mc(psFIRCtrl, uiNChannels);
+    if(pvProc == (FIRReturnCodes_t (*)(int *)) FIR_proc_ds2)
+        return FIR_proc_ds2_mc(psFIRCtrl, uiNChannels);
+
+    // No multichannel version (down-sample by 4, 8 or 16), so process each channel on its own
+    for(uj = 0; uj < uiNChannels; uj++)
+    {
+        if(psFIRCtrl[uj]->pvProc((int *)psFIRCtrl[uj]) != FIR_NO_ERROR)
+            return FIR_ERROR;
+    }
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_proc_os2_mc                                        //
+// Arguments:        FIRCtrl_t     *psFIRCtrl[]: Ctrl strct. per channel    //
+//                    unsigned int uiNChannels: number of channels        //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the FIRs in over-sample by 2 mode            //
+// ==================================================================== //
+static FIRReturnCodes_t         FIR_proc_os2_mc(FIRCtrl_t* psFIRCtrl[], unsigned int uiNChannels)
+{
+    FIR_MC_LOCALS;
+    int                iData[2 * FIR_MC_MAX_CHANNELS];
+
+    FIR_MC_LOAD_CTRL();
+
+    for(ui = 0; ui < psFIRCtrl[0]->uiNInSamples; ui++)
+    {
+        FIR_MC_GET_SPL(1);
+        SRC_MRHF_FIR_OS_MC_INNER_LOOP(piData, piCoefsB, iData, uiNLoops, uiNChannels);
+
+        // Write output with step. NOTE OUTPUT WRITE ORDER: First iData[1], then iData[0]
+        for(uj = 0; uj < uiNChannels; uj++)
+        {
+            *piOut[uj]              = iData[2 * uj + 1];
+            piOut[uj]               += uiOutStep;
+            *piOut[uj]              = iData[2 * uj];
+            piOut[uj]               += uiOutStep;
+        }
+    }
+
+    FIR_MC_STORE_CTRL();
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_proc_sync_mc                                    //
+// Arguments:        FIRCtrl_t     *psFIRCtrl[]: Ctrl strct. per channel    //
+//                    unsigned int uiNChannels: number of channels        //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the FIRs in asynchronous mode                //
+// ==================================================================== //
+static FIRReturnCodes_t         FIR_proc_sync_mc(FIRCtrl_t* psFIRCtrl[], unsigned int uiNChannels)
+{
+    FIR_MC_LOCALS;
+    int                iData[FIR_MC_MAX_CHANNELS];
+
+    FIR_MC_LOAD_CTRL();
+
+    for(ui = 0; ui < psFIRCtrl[0]->uiNInSamples; ui++)
+    {
+        FIR_MC_GET_SPL(1);
+        SRC_MRHF_FIR_MC_INNER_LOOP(piData, piCoefsB, iData, uiNLoops, uiNChannels);
+
+        for(uj = 0; uj < uiNChannels; uj++)
+        {
+            *piOut[uj]              = iData[uj];
+            piOut[uj]               += uiOutStep;
+        }
+    }
+
+    FIR_MC_STORE_CTRL();
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_proc_ds2_mc                                        //
+// Arguments:        FIRCtrl_t     *psFIRCtrl[]: Ctrl strct. per channel    //
+//                    unsigned int uiNChannels: number of channels        //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the FIRs in down-sample by 2 mode            //
+// ==================================================================== //
+static FIRReturnCodes_t         FIR_proc_ds2_mc(FIRCtrl_t* psFIRCtrl[], unsigned int uiNChannels)
+{
+    FIR_MC_LOCALS;
+    int                iData[FIR_MC_MAX_CHANNELS];
+
+    FIR_MC_LOAD_CTRL();
+
+    for(ui = 0; ui < psFIRCtrl[0]->uiNInSamples>>1; ui++)
+    {
+        FIR_MC_GET_SPL(2);
+        SRC_MRHF_FIR_MC_INNER_LOOP(piData, piCoefsB, iData, uiNLoops, uiNChannels);
+
+        for(uj = 0; uj < uiNChannels; uj++)
+        {
+            *piOut[uj]              = iData[uj];
+            piOut[uj]               += uiOutStep;
+        }
+    }
+
+    FIR_MC_STORE_CTRL();
+
+    return FIR_NO_ERROR;
+}
+
+
 // ==================================================================== //
 // Function:        ADFIR_init_from_desc                                //
 // Arguments:        ADFIRCtrl_t     *psADFIRCtrl: Ctrl strct.            //
@@ -429,10 +921,13 @@ FIRReturnCodes_t                ADFIR_init_from_desc(ADFIRCtrl_t* psADFIRCtrl, A
 
     uiPhaseLength                    = psADFIRDescriptor->uiNCoefsPerPhase;
     // Setup ADFIR
-    psADFIRCtrl->uiDelayL            = uiPhaseLength<<1;                    // Double length for circular buffer simulation
-    psADFIRCtrl->piDelayW            = psADFIRCtrl->piDelayB + uiPhaseLength;
+    psADFIRCtrl->uiDelayL            = FIR_DELAY_LEN(uiPhaseLength);
+    psADFIRCtrl->piDelayW            = FIR_DELAY_WRAP(psADFIRCtrl->piDelayB, uiPhaseLength, 1);
     psADFIRCtrl->uiDelayO            = uiPhaseLength;
     psADFIRCtrl->uiNLoops            = uiPhaseLength>>1;                    // Due to 2 x 32bits read for data and coefs per inner loop
+#if !defined(__xcore__)
+    psADFIRCtrl->pvInnerLoop        = SRC_MRHF_ADFIR_KERNEL(psADFIRCtrl->uiNLoops);        // Fully unrolled for the filter length
+#endif
 
     // Sync the ADFIR
     if(ADFIR_sync(psADFIRCtrl) != FIR_NO_ERROR)
@@ -453,7 +948,7 @@ FIRReturnCodes_t                ADFIR_sync(ADFIRCtrl_t* psADFIRCtrl)
     unsigned int        ui;
 
     // Set delay line index back to base
-    psADFIRCtrl->piDelayI    = psADFIRCtrl->piDelayB;
+    psADFIRCtrl->piDelayI    = FIR_DELAY_START(psADFIRCtrl->piDelayB, psADFIRCtrl->uiDelayO);
 
     // Clear delay line
     for(ui = 0; ui < psADFIRCtrl->uiDelayL; ui++)
@@ -471,13 +966,8 @@ FIRReturnCodes_t                ADFIR_sync(ADFIRCtrl_t* psADFIRCtrl)
 // ==================================================================== //
 FIRReturnCodes_t                ADFIR_proc_in_spl(ADFIRCtrl_t* psADFIRCtrl)
 {
-    // Double write to simulate circular buffer
-    *psADFIRCtrl->piDelayI                                    = psADFIRCtrl->iIn;
-    *(psADFIRCtrl->piDelayI + psADFIRCtrl->uiDelayO)        = psADFIRCtrl->iIn;
-    // Step delay (with circular simulation)
-    psADFIRCtrl->piDelayI++;
-    if(psADFIRCtrl->piDelayI >= psADFIRCtrl->piDelayW)
-        psADFIRCtrl->piDelayI                = psADFIRCtrl->piDelayB;
+    FIR_DELAY_WRITE(psADFIRCtrl->piDelayI, psADFIRCtrl->uiDelayO, 0, psADFIRCtrl->iIn);
+    FIR_DELAY_STEP(psADFIRCtrl->piDelayB, psADFIRCtrl->piDelayI, psADFIRCtrl->piDelayW, psADFIRCtrl->uiDelayO, 1);
 
     return FIR_NO_ERROR;
 }
@@ -500,10 +990,13 @@ FIRReturnCodes_t                ADFIR_proc_macc(ADFIRCtrl_t* psADFIRCtrl)
     //*(psADFIRCtrl->piOut)    = *psADFIRCtrl->piDelayI;
 
     // Clear accumulator and set access pointers
-    piData                    = psADFIRCtrl->piDelayI;
+    piData                    = FIR_DELAY_DATA(psADFIRCtrl->piDelayI, psADFIRCtrl->uiDelayO);
     piCoefs                    = psADFIRCtrl->piADCoefs;
-    if ((unsigned)piData & 0b0100) src_mrhf_adfir_inner_loop_asm_odd(piData, piCoefs, &iData, psADFIRCtrl->uiNLoops);
-    else                               src_mrhf_adfir_inner_loop_asm(piData, piCoefs, &iData, psADFIRCtrl->uiNLoops);
+#if defined(__xcore__)
+    SRC_MRHF_ADFIR_INNER_LOOP(piData, piCoefs, &iData, psADFIRCtrl->uiNLoops);
+#else
+    psADFIRCtrl->pvInnerLoop(piData, piCoefs, &iData, psADFIRCtrl->uiNLoops);
+#endif
 
     // Write output
     *(psADFIRCtrl->piOut)        = iData;
@@ -572,8 +1065,8 @@ FIRReturnCodes_t                PPFIR_init_from_desc(PPFIRCtrl_t* psPPFIRCtrl, P
 
     // Setup PPFIR
     psPPFIRCtrl->eEnable            = FIR_ON;
-    psPPFIRCtrl->uiDelayL            = uiPhaseLength<<1;                                    // Double length for circular buffer simulation
-    psPPFIRCtrl->piDelayW            = psPPFIRCtrl->piDelayB + uiPhaseLength;
+    psPPFIRCtrl->uiDelayL            = FIR_DELAY_LEN(uiPhaseLength);
+    psPPFIRCtrl->piDelayW            = FIR_DELAY_WRAP(psPPFIRCtrl->piDelayB, uiPhaseLength, 1);
     psPPFIRCtrl->uiDelayO            = uiPhaseLength;
     psPPFIRCtrl->uiNLoops            = uiPhaseLength>>1;                                    // Due to 2 x 32bits read for data and coefs per inner loop
     psPPFIRCtrl->uiNCoefs            = psPPFIRDescriptor->uiNCoefs;
@@ -603,7 +1096,7 @@ FIRReturnCodes_t                PPFIR_sync(PPFIRCtrl_t* psPPFIRCtrl)
     if(psPPFIRCtrl->eEnable == FIR_ON)
     {
         // Set delay line index back to base
-        psPPFIRCtrl->piDelayI    = psPPFIRCtrl->piDelayB;
+        psPPFIRCtrl->piDelayI    = FIR_DELAY_START(psPPFIRCtrl->piDelayB, psPPFIRCtrl->uiDelayO);
 
         // Clear delay line
         for(ui = 0; ui < psPPFIRCtrl->uiDelayL; ui++)
@@ -621,6 +1114,44 @@ FIRReturnCodes_t                PPFIR_sync(PPFIRCtrl_t* psPPFIRCtrl)
 }
 
 
+// ==================================================================== //
+// Function:        PPFIR_get_delay                                        //
+// Arguments:        PPFIRCtrl_t     *psPPFIRCtrl: Ctrl strct.            //
+//                    long long *pi64Delay: Group delay (Q32 format)        //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Gets the group delay at DC of the PPFIR in input    //
+//                    samples (0 when disabled): output sample n, at time    //
+//                    n x uiPhaseStep / uiNPhases, is the input at that    //
+//                    time less the delay                                    //
+// ==================================================================== //
+FIRReturnCodes_t                PPFIR_get_delay(PPFIRCtrl_t* psPPFIRCtrl, long long* pi64Delay)
+{
+    unsigned int        uiPhaseLength;
+    double                dSum        = 0.0;
+    double                dMoment        = 0.0;
+    unsigned int        ui;
+
+    *pi64Delay        = 0;
+    if(psPPFIRCtrl->eEnable != FIR_ON)
+        return FIR_NO_ERROR;
+
+    // Phase p (coefficients p x uiPhaseLength on) outputs p / uiNPhases input samples after the newest
+    uiPhaseLength    = psPPFIRCtrl->uiNCoefs / psPPFIRCtrl->uiNPhases;
+    for(ui = 0; ui < psPPFIRCtrl->uiNCoefs; ui++)
+    {
+        dSum        += psPPFIRCtrl->piCoefs[ui];
+        dMoment        += (double)psPPFIRCtrl->piCoefs[ui] * ((uiPhaseLength - 1 - (ui % uiPhaseLength)) + (double)(ui / uiPhaseLength) / psPPFIRCtrl->uiNPhases);
+    }
+    if(dSum == 0.0)
+        return FIR_ERROR;
+
+    *pi64Delay        = (long long)(dMoment / dSum * 4294967296.0);
+
+    return FIR_NO_ERROR;
+}
+
+
 // ==================================================================== //
 // Function:        PPFIR_proc                                            //
 // Arguments:        PPFIRCtrl_t     *psPPFIRCtrl: Ctrl strct.            //
@@ -652,16 +1183,11 @@ FIRReturnCodes_t                PPFIR_proc(PPFIRCtrl_t* psPPFIRCtrl)
 
     for(ui = 0; ui < psPPFIRCtrl->uiNInSamples; ui++)
     {
-        // Get new data sample to delay line (double write for circular buffer simulation) with step
+        // Get new data sample to delay line with step
         iData[0]                    = *piIn;
         piIn                    += uiInStep;
-        // Double write to simulate circular buffer
-        *piDelayI                = iData[0];
-        *(piDelayI + uiDelayO)    = iData[0];
-        // Step delay (with circular simulation)
-        piDelayI++;
-        if(piDelayI >= piDelayW)
-            piDelayI                = piDelayB;
+        FIR_DELAY_WRITE(piDelayI, uiDelayO, 0, iData[0]);
+        FIR_DELAY_STEP(piDelayB, piDelayI, piDelayW, uiDelayO, 1);
 
         // Do while the current phase coefficient pointer points to phase coefficients
         // This is equivalent to know if the output sample is between the current and next input sample
@@ -669,11 +1195,10 @@ FIRReturnCodes_t                PPFIR_proc(PPFIRCtrl_t* psPPFIRCtrl)
         while(uiCoefsPhase < uiNCoefs)
         {
             // Clear accumulator and set access pointers
-            piData                    = piDelayI;
+            piData                    = FIR_DELAY_DATA(piDelayI, uiDelayO);
             piCoefs                    = piCoefsB + uiCoefsPhase;
 
-            if ((unsigned)piData & 0b0100) src_mrhf_fir_inner_loop_asm_odd(piData, piCoefs, iData, uiNLoops);
-            else src_mrhf_fir_inner_loop_asm(piData, piCoefs, iData, uiNLoops);
+            SRC_MRHF_FIR_INNER_LOOP(piData, piCoefs, iData, uiNLoops);
 
 
             // Write output with step
@@ -701,3 +1226,85 @@ FIRReturnCodes_t                PPFIR_proc(PPFIRCtrl_t* psPPFIRCtrl)
     return FIR_NO_ERROR;
 }
 
+
+// ==================================================================== //
+// Function:        PPFIR_proc_mc                                        //
+// Arguments:        PPFIRCtrl_t     *psPPFIRCtrl[]: Ctrl strct. per chan.    //
+//                    unsigned int uiNChannels: number of channels        //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes uiNChannels PPFIR polyphase filters        //
+//                    (up to FIR_MC_MAX_CHANNELS)                            //
+// ==================================================================== //
+FIRReturnCodes_t                PPFIR_proc_mc(PPFIRCtrl_t* psPPFIRCtrl[], unsigned int uiNChannels)
+{
+    unsigned int    uiInStep            = psPPFIRCtrl[0]->uiInStep;
+    unsigned int    uiOutStep            = psPPFIRCtrl[0]->uiOutStep;
+    unsigned int    uiDelayO            = psPPFIRCtrl[0]->uiDelayO;
+    int*            piCoefsB            = psPPFIRCtrl[0]->piCoefs;
+    unsigned int    uiNLoops            = psPPFIRCtrl[0]->uiNLoops;
+    unsigned int    uiNCoefs            = psPPFIRCtrl[0]->uiNCoefs;
+    unsigned int    uiCoefsPhase        = psPPFIRCtrl[0]->uiCoefsPhase;
+    unsigned int    uiCoefsPhaseStep    = psPPFIRCtrl[0]->uiCoefsPhaseStep;
+    int*            piIn[FIR_MC_MAX_CHANNELS];
+    int*            piOut[FIR_MC_MAX_CHANNELS];
+    int*            piDelayI[FIR_MC_MAX_CHANNELS];
+    int*            piData[FIR_MC_MAX_CHANNELS];
+    int                iData[FIR_MC_MAX_CHANNELS];
+    unsigned int    uiNOutSamples        = 0;
+    unsigned        ui, uj;
+
+    if((uiNChannels == 0) || (uiNChannels > FIR_MC_MAX_CHANNELS))
+        return FIR_ERROR;
+
+    for(uj = 0; uj < uiNChannels; uj++)
+    {
+        piIn[uj]                    = psPPFIRCtrl[uj]->piIn;
+        piOut[uj]                    = psPPFIRCtrl[uj]->piOut;
+        piDelayI[uj]                = psPPFIRCtrl[uj]->piDelayI;
+    }
+
+    for(ui = 0; ui < psPPFIRCtrl[0]->uiNInSamples; ui++)
+    {
+        // Get new data sample of each channel to its delay line with step
+        for(uj = 0; uj < uiNChannels; uj++)
+        {
+            FIR_DELAY_WRITE(piDelayI[uj], uiDelayO, 0, *piIn[uj]);
+            piIn[uj]                += uiInStep;
+            FIR_DELAY_STEP(psPPFIRCtrl[uj]->piDelayB, piDelayI[uj], psPPFIRCtrl[uj]->piDelayW, uiDelayO, 1);
+            piData[uj]                = FIR_DELAY_DATA(piDelayI[uj], uiDelayO);
+        }
+
+        // Do while the current phase coefficient pointer points to phase coefficients (same phase for all channels)
+        while(uiCoefsPhase < uiNCoefs)
+        {
+            SRC_MRHF_FIR_MC_INNER_LOOP(piData, piCoefsB + uiCoefsPhase, iData, uiNLoops, uiNChannels);
+
+            // Write output with step
+            for(uj = 0; uj < uiNChannels; uj++)
+            {
+                *piOut[uj]            = iData[uj];
+                piOut[uj]            += uiOutStep;
+            }
+
+            // Step phase coefficient offset for next output phase
+            uiCoefsPhase            += uiCoefsPhaseStep;
+
+            // Increase output sample counter
+            uiNOutSamples++;
+        }
+
+        // Reduce phase for next input sample (one input sample corresponds to all coefficients in the PP filter)
+        uiCoefsPhase                -= uiNCoefs;
+    }
+
+    for(uj = 0; uj < uiNChannels; uj++)
+    {
+        // Write delay line index, coefs phase and number of samples back for next round
+        psPPFIRCtrl[uj]->piDelayI        = piDelayI[uj];
+        psPPFIRCtrl[uj]->uiCoefsPhase    = uiCoefsPhase;
+        psPPFIRCtrl[uj]->uiNOutSamples    = uiNOutSamples;
+    }
+
+    return FIR_NO_ERROR;
+}
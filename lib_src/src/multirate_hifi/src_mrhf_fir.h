@@ -18,11 +18,99 @@
 
     // General defines
     // ---------------
-
+    #define        FIR_MC_MAX_CHANNELS                16            // Maximum number of channels processed together by FIR_proc_mc / PPFIR_proc_mc
 
     // Parameter values
     // ----------------
-
+    // Delay line layout. By default a delay line holding N samples is a circular buffer simulated
+    // by writing each sample twice into 2 x N words. With SRC_LINEAR_DELAY_LINES set to 1 it is
+    // instead a linear history of N + SRC_LINEAR_DELAY_BLOCK words: each sample is written once and
+    // the last N samples are moved back to the base once every SRC_LINEAR_DELAY_BLOCK samples.
+    #ifndef SRC_LINEAR_DELAY_LINES
+    #define        SRC_LINEAR_DELAY_LINES            0
+    #endif
+    #ifndef SRC_LINEAR_DELAY_BLOCK
+    #define        SRC_LINEAR_DELAY_BLOCK            16            // Must be even (keeps data alignment sequence, see FIR_proc_sync) and at least 4
+    #endif
+    #if (SRC_LINEAR_DELAY_BLOCK < 4) || (SRC_LINEAR_DELAY_BLOCK & 1)
+    #error "SRC_LINEAR_DELAY_BLOCK must be even and at least 4"
+    #endif
+
+    // Fast convolution (FFT overlap-save) FIR processing for large blocks, see src_mrhf_fir_fast_conv.h.
+    // Uses double precision floating point so host builds only.
+    #ifndef FIR_FAST_CONV
+    #if defined(__xcore__)
+    #define        FIR_FAST_CONV                    0
+    #else
+    #define        FIR_FAST_CONV                    1
+    #endif
+    #endif
+
+    // Single precision floating point FIR, PPFIR and ADFIR processing (see src_mrhf_fir_float.h), used
+    // by the float SSRC and ASRC (ssrc_float_process, asrc_float_process). Host builds only.
+    #ifndef FIR_FLOAT
+    #if defined(__xcore__)
+    #define        FIR_FLOAT                        0
+    #else
+    #define        FIR_FLOAT                        1
+    #endif
+    #endif
+
+    // Folded processing of the symmetric (linear phase) over-sample by 2 FIRs with the portable C inner
+    // loops: the odd phase is the even phase reversed, so the inner loop reads each coefficient of the
+    // first half of the table once for both phases (FIRDescriptor_t piCoefsHalf). Host builds only, the
+    // xCORE assembler and SIMD inner loops use the full tables.
+    #ifndef FIR_FOLD_SYMMETRIC
+    #if defined(__xcore__)
+    #define        FIR_FOLD_SYMMETRIC                0
+    #else
+    #define        FIR_FOLD_SYMMETRIC                1
+    #endif
+    #endif
+
+    // Delay line macros (uiStep is the number of samples written between two FIR_DELAY_STEP calls)
+    // Used for both int and float (FIR_FLOAT) delay lines
+    // ---------------------------------------------------------------------------------------------
+    #if SRC_LINEAR_DELAY_LINES
+    // Delay line buffer length (in words) for a delay line holding uiLen samples
+    #define        FIR_DELAY_LEN(uiLen)                                    ((uiLen) + SRC_LINEAR_DELAY_BLOCK)
+    // Wrap around address, i.e. position from which there is no room for uiStep more samples
+    #define        FIR_DELAY_WRAP(piDelayB, uiLen, uiStep)                    ((piDelayB) + FIR_DELAY_LEN(uiLen) - ((uiStep) - 1))
+    // Position of first write after sync (the older samples are the cleared history)
+    #define        FIR_DELAY_START(piDelayB, uiLen)                        ((piDelayB) + (uiLen))
+    // Pointer to oldest of the uiLen samples in delay line
+    #define        FIR_DELAY_DATA(piDelayI, uiLen)                            ((piDelayI) - (uiLen))
+    // Write sample at offset from current position
+    #define        FIR_DELAY_WRITE(piDelayI, uiLen, uiOffset, iSample)        (*((piDelayI) + (uiOffset)) = (iSample))
+    // Step current position, moving the last uiLen samples back to base when the wrap address is reached
+    #define        FIR_DELAY_STEP(piDelayB, piDelayI, piDelayW, uiLen, uiStep) \
+        do { \
+            (piDelayI) += (uiStep); \
+            if((piDelayI) >= (piDelayW)) \
+            { \
+                memmove((piDelayB), (piDelayI) - (uiLen), (uiLen) * sizeof(*(piDelayB))); \
+                (piDelayI) = (piDelayB) + (uiLen); \
+            } \
+        } while(0)
+    #else
+    #define        FIR_DELAY_LEN(uiLen)                                    ((uiLen)<<1)        // Double length for circular buffer simulation
+    #define        FIR_DELAY_WRAP(piDelayB, uiLen, uiStep)                    ((piDelayB) + (uiLen))
+    #define        FIR_DELAY_START(piDelayB, uiLen)                        (piDelayB)
+    #define        FIR_DELAY_DATA(piDelayI, uiLen)                            (piDelayI)
+    // Double write to simulate circular buffer
+    #define        FIR_DELAY_WRITE(piDelayI, uiLen, uiOffset, iSample) \
+        do { \
+            *((piDelayI) + (uiOffset))                = (iSample); \
+            *((piDelayI) + (uiLen) + (uiOffset))    = (iSample); \
+        } while(0)
+    // Step delay (with circular simulation)
+    #define        FIR_DELAY_STEP(piDelayB, piDelayI, piDelayW, uiLen, uiStep) \
+        do { \
+            (piDelayI) += (uiStep); \
+            if((piDelayI) >= (piDelayW)) \
+                (piDelayI) = (piDelayB); \
+        } while(0)
+    #endif
 
 
 
@@ -66,8 +154,15 @@
             FIR_TYPE_OS2                            = 0,            // Over-sampler by two FIR
             FIR_TYPE_SYNC                            = 1,            // Asynchronous (low-pass) FIR
             FIR_TYPE_DS2                            = 2,            // Down-sampler by two FIR
+            FIR_TYPE_DS4                            = 3,            // Down-sampler by four FIR
+            FIR_TYPE_DS8                            = 4,            // Down-sampler by eight FIR
+            FIR_TYPE_DS16                            = 5,            // Down-sampler by sixteen FIR
         } FIRTypeCodes_t;
 
+        // Decimation factor of the FIR_TYPE_DS4, FIR_TYPE_DS8 and FIR_TYPE_DS16 types
+        #define        FIR_DSN_DECIM(eType)                    (4u << ((eType) - FIR_TYPE_DS4))
+
+
 #ifdef __XC__
         // FIR Descriptor
         // --------------
@@ -97,8 +192,8 @@
             int* unsafe                                piDelayB;        // Pointer to delay line base
             unsigned int                            uiDelayL;        // Total length of delay line
             int* unsafe                                piDelayI;        // Pointer to current position in delay line
-            int* unsafe                                piDelayW;        // Delay buffer wrap around address (for circular buffer simulation)
-            unsigned int                            uiDelayO;        // Delay line offset for second write (for circular buffer simulation)
+            int* unsafe                                piDelayW;        // Delay buffer wrap around address
+            unsigned int                            uiDelayO;        // Delay line length in samples (offset for second write with circular buffer simulation)
 
             unsigned int                            uiNLoops;        // Number of inner loop iterations
             unsigned int                            uiNCoefs;        // Number of coefficients
@@ -119,16 +214,16 @@
         // ----------
         typedef struct _ADFIRCtrl
         {
-            int                                        iIn;                // Input sample
-            int* unsafe                                piOut;                // Pointer to output sample
-
-            int* unsafe                                piDelayB;            // Pointer to delay line base
-            unsigned int                            uiDelayL;            // Total length of delay line
+            // Used per sample by the ASRC F3 loops first (see asrc_ctrl_t)
             int* unsafe                                piDelayI;            // Pointer to current position in delay line
-            int* unsafe                                piDelayW;            // Delay buffer wrap around address (for circular buffer simulation)
-            unsigned int                            uiDelayO;            // Delay line offset for second write (for circular buffer simulation)
-
+            unsigned int                            uiDelayO;            // Delay line length in samples (offset for second write with circular buffer simulation)
             unsigned int                            uiNLoops;            // Number of inner loop iterations
+            int* unsafe                                piDelayB;            // Pointer to delay line base
+            int* unsafe                                piDelayW;            // Delay buffer wrap around address
+
+            int                                        iIn;                // Input sample
+            unsigned int                            uiDelayL;            // Total length of delay line
+            int* unsafe                                piOut;                // Pointer to output sample
             int* unsafe                                piADCoefs;            // Pointer to adaptive coefficients
         } ADFIRCtrl_t;
 
@@ -158,8 +253,8 @@
             int* unsafe                                piDelayB;            // Pointer to delay line base
             unsigned int                            uiDelayL;            // Total length of delay line
             int* unsafe                                piDelayI;            // Pointer to current position in delay line
-            int* unsafe                                piDelayW;            // Delay buffer wrap around address (for circular buffer simulation)
-            unsigned int                            uiDelayO;            // Delay line offset for second write (for circular buffer simulation)
+            int* unsafe                                piDelayW;            // Delay buffer wrap around address
+            unsigned int                            uiDelayO;            // Delay line length in samples (offset for second write with circular buffer simulation)
 
             unsigned int                            uiNLoops;            // Number of inner loop iterations
             unsigned int                            uiNCoefs;            // Number of coefficients
@@ -178,6 +273,9 @@
             FIRTypeCodes_t                            eType;            // Type of filter
             unsigned int                            uiNCoefs;        // Number of coefficients
             int*                                    piCoefs;        // Pointer to coefficients
+#if FIR_FOLD_SYMMETRIC
+            int*                                    piCoefsHalf;    // Pointer to first half of symmetric OS2 coefficients (folded processing), 0 if none
+#endif
         } FIRDescriptor_t;
 
 
@@ -194,18 +292,27 @@
             unsigned int                            uiNOutSamples;    // Number of output samples produced
             unsigned int                            uiOutStep;        // Step between output data samples
 
+#if defined(__xcore__)
 __attribute__((fptrgroup("G1")))
+#endif
             FIRReturnCodes_t                         (*pvProc)(int *);// Processing function address
 
             int*                                    piDelayB;        // Pointer to delay line base
             unsigned int                            uiDelayL;        // Total length of delay line
             int*                                    piDelayI;        // Pointer to current position in delay line
-            int*                                    piDelayW;        // Delay buffer wrap around address (for circular buffer simulation)
-            unsigned int                            uiDelayO;        // Delay line offset for second write (for circular buffer simulation)
+            int*                                    piDelayW;        // Delay buffer wrap around address
+            unsigned int                            uiDelayO;        // Delay line length in samples (offset for second write with circular buffer simulation)
 
             unsigned int                            uiNLoops;        // Number of inner loop iterations
+#if !defined(__xcore__)
+            void                                    (*pvInnerLoop)(int *, int *, int [], int);    // Inner loop kernel for uiNLoops (see src_kernels_fixed.h)
+            int*                                    piLoopCoefs;    // Coefficients read by pvInnerLoop (piCoefs, or its first half when folded)
+#endif
             unsigned int                            uiNCoefs;        // Number of coefficients
             int*                                    piCoefs;        // Pointer to coefficients
+#if FIR_FAST_CONV
+            struct _FIRFastConvState*                psFastConv;        // Fast convolution state (see FIR_fast_conv_init)
+#endif
         } FIRCtrl_t;
 
         // ADFIR Descriptor
@@ -221,16 +328,19 @@ __attribute__((fptrgroup("G1")))
         // ----------
         typedef struct _ADFIRCtrl
         {
-            int                                        iIn;                // Input sample
-            int*                                    piOut;                // Pointer to output sample
-
-            int*                                    piDelayB;            // Pointer to delay line base
-            unsigned int                            uiDelayL;            // Total length of delay line
+            // Used per sample by the ASRC F3 loops first (see asrc_ctrl_t)
             int*                                    piDelayI;            // Pointer to current position in delay line
-            int*                                    piDelayW;            // Delay buffer wrap around address (for circular buffer simulation)
-            unsigned int                            uiDelayO;            // Delay line offset for second write (for circular buffer simulation)
-
+            unsigned int                            uiDelayO;            // Delay line length in samples (offset for second write with circular buffer simulation)
             unsigned int                            uiNLoops;            // Number of inner loop iterations
+            int*                                    piDelayB;            // Pointer to delay line base
+            int*                                    piDelayW;            // Delay buffer wrap around address
+#if !defined(__xcore__)
+            void                                    (*pvInnerLoop)(int *, int *, int [], int);    // Inner loop kernel for uiNLoops (see src_kernels_fixed.h)
+#endif
+
+            int                                        iIn;                // Input sample
+            unsigned int                            uiDelayL;            // Total length of delay line
+            int*                                    piOut;                // Pointer to output sample
             int*                                    piADCoefs;            // Pointer to adaptive coefficients
         } ADFIRCtrl_t;
 
@@ -260,8 +370,8 @@ __attribute__((fptrgroup("G1")))
             int*                                    piDelayB;            // Pointer to delay line base
             unsigned int                            uiDelayL;            // Total length of delay line
             int*                                    piDelayI;            // Pointer to current position in delay line
-            int*                                    piDelayW;            // Delay buffer wrap around address (for circular buffer simulation)
-            unsigned int                            uiDelayO;            // Delay line offset for second write (for circular buffer simulation)
+            int*                                    piDelayW;            // Delay buffer wrap around address
+            unsigned int                            uiDelayO;            // Delay line length in samples (offset for second write with circular buffer simulation)
 
             unsigned int                            uiNLoops;            // Number of inner loop iterations
             unsigned int                            uiNCoefs;            // Number of coefficients
@@ -290,6 +400,30 @@ __attribute__((fptrgroup("G1")))
         // ==================================================================== //
         FIRReturnCodes_t                FIR_init_from_desc(FIRCtrl_t* psFIRCtrl, FIRDescriptor_t* psFIRDescriptor);
 
+        // ==================================================================== //
+        // Function:        FIR_set_desc                                        //
+        // Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+        //                    FIRDescriptor_t *psFIRDescriptor: Desc. strct.        //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Sets up the FIR from the Descriptor, leaving its    //
+        //                    delay line untouched until it is synced                //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_set_desc(FIRCtrl_t* psFIRCtrl, FIRDescriptor_t* psFIRDescriptor);
+
+        // ==================================================================== //
+        // Function:        FIR_get_n_out_samples                                //
+        // Arguments:        FIRDescriptor_t *psFIRDescriptor: Desc. strct.        //
+        //                    unsigned int uiNInSamples: Number of input samples    //
+        //                    unsigned int *puiNOutSamples: Number of output        //
+        //                    samples (0 if the FIR is disabled)                    //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Gets the number of output samples of a FIR from the    //
+        //                    Descriptor, as FIR_init_from_desc                    //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_get_n_out_samples(FIRDescriptor_t* psFIRDescriptor, unsigned int uiNInSamples, unsigned int* puiNOutSamples);
+
         // ==================================================================== //
         // Function:        FIR_sync                                            //
         // Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
@@ -299,6 +433,43 @@ __attribute__((fptrgroup("G1")))
         // ==================================================================== //
         FIRReturnCodes_t                FIR_sync(FIRCtrl_t* psFIRCtrl);
 
+        // ==================================================================== //
+        // Function:        FIR_get_history                                        //
+        // Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+        //                    const int **ppiHistory: History (oldest first)        //
+        //                    unsigned int *puiHistoryL: Number of samples        //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Gets the delay line samples, oldest first, in place    //
+        //                    (valid until the delay line is next written)        //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_get_history(FIRCtrl_t* psFIRCtrl, const int** ppiHistory, unsigned int* puiHistoryL);
+
+        // ==================================================================== //
+        // Function:        FIR_sync_history                                    //
+        // Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+        //                    const int *piHistory: History (oldest first)        //
+        //                    unsigned int uiHistoryL: Number of history samples    //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Syncs the FIR with the newest history samples (from    //
+        //                    FIR_get_history) in its delay line, the older ones    //
+        //                    cleared. The history may lie in the delay line        //
+        //                    buffer itself                                        //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_sync_history(FIRCtrl_t* psFIRCtrl, const int* piHistory, unsigned int uiHistoryL);
+
+        // ==================================================================== //
+        // Function:        FIR_get_delay                                        //
+        // Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+        //                    long long *pi64Delay: Group delay (Q32 format)        //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Gets the group delay at DC of the FIR in input        //
+        //                    samples (0 when disabled)                            //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_get_delay(FIRCtrl_t* psFIRCtrl, long long* pi64Delay);
+
         // ==================================================================== //
         // Function:        FIR_proc_os2                                        //
         // Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
@@ -326,6 +497,15 @@ __attribute__((fptrgroup("G1")))
         // ==================================================================== //
         FIRReturnCodes_t                FIR_proc_ds2(FIRCtrl_t* psFIRCtrl);
 
+        // ==================================================================== //
+        // Function:        FIR_proc_dsn                                        //
+        // Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Processes the FIR in down-sample by 4, 8 or 16 mode    //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_proc_dsn(FIRCtrl_t* psFIRCtrl);
+
         // ==================================================================== //
         // Function:        ADFIR_init_from_desc                                //
         // Arguments:        ADFIRCtrl_t     *psADFIRCtrl: Ctrl strct.            //
@@ -382,6 +562,17 @@ __attribute__((fptrgroup("G1")))
         // ==================================================================== //
         FIRReturnCodes_t                PPFIR_sync(PPFIRCtrl_t* psPPFIRCtrl);
 
+        // ==================================================================== //
+        // Function:        PPFIR_get_delay                                        //
+        // Arguments:        PPFIRCtrl_t     *psPPFIRCtrl: Ctrl strct.            //
+        //                    long long *pi64Delay: Group delay (Q32 format)        //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Gets the group delay at DC of the PPFIR in input    //
+        //                    samples (0 when disabled)                            //
+        // ==================================================================== //
+        FIRReturnCodes_t                PPFIR_get_delay(PPFIRCtrl_t* psPPFIRCtrl, long long* pi64Delay);
+
         // ==================================================================== //
         // Function:        PPFIR_proc                                            //
         // Arguments:        PPFIRCtrl_t     *psPPFIRCtrl: Ctrl strct.            //
@@ -390,6 +581,36 @@ __attribute__((fptrgroup("G1")))
         // Description:        Processes the PPFIR polyphase filter                 //
         // ==================================================================== //
         FIRReturnCodes_t                PPFIR_proc(PPFIRCtrl_t* psPPFIRCtrl);
+
+#ifndef __XC__
+        // Multichannel processing. The Ctrl strct. of all channels must be initialised from the same
+        // descriptor with the same number of samples and steps, and synced and processed together,
+        // so all delay lines are at the same position. Each coefficient load is then shared by the
+        // channels, and the output is identical to processing each channel on its own. Down-sample
+        // by 4 FIRs are processed one channel at a time.
+
+        // ==================================================================== //
+        // Function:        FIR_proc_mc                                            //
+        // Arguments:        FIRCtrl_t     *psFIRCtrl[]: Ctrl strct. per channel    //
+        //                    unsigned int uiNChannels: number of channels        //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Processes uiNChannels FIRs (up to                    //
+        //                    FIR_MC_MAX_CHANNELS) in their pvProc mode            //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_proc_mc(FIRCtrl_t* psFIRCtrl[], unsigned int uiNChannels);
+
+        // ==================================================================== //
+        // Function:        PPFIR_proc_mc                                        //
+        // Arguments:        PPFIRCtrl_t     *psPPFIRCtrl[]: Ctrl strct. per chan.    //
+        //                    unsigned int uiNChannels: number of channels        //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Processes uiNChannels PPFIR polyphase filters        //
+        //                    (up to FIR_MC_MAX_CHANNELS)                            //
+        // ==================================================================== //
+        FIRReturnCodes_t                PPFIR_proc_mc(PPFIRCtrl_t* psPPFIRCtrl[], unsigned int uiNChannels);
+#endif
     #endif // nINCLUDE_FROM_ASM
 
 #endif // _SRC_MRHF_FIR_H
@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+# Copyright (c) 2016, XMOS Ltd, All rights reserved
+#
+# Generates the FIR filters used by the ASRC for the sample rates beyond the
+# six FS codes (SRC_ARBITRARY_FS, see src_mrhf_asrc.h): FilterData/<name>.dat.
+#
+# Each filter is a Kaiser windowed sinc with a multiple of 16 taps (whole blocks
+# for the SIMD inner loops, see src_kernels_fixed.h), cut off half way between
+# the design pass and stop edges below. The edges are a fraction of the rate
+# the coefficients run at: the input rate for the SYNC and DS types, twice the
+# input rate for the OS2 type.
+# The coefficients are in 1.31 format scaled for a DC gain of GAIN (2 for OS2,
+# which doubles the number of samples).
+#
+# The ASRC stage planner (ASRC_plan in asrc/src_mrhf_asrc.c) checks a filter
+# fits a pair of rates against the measured pass band (-0.01dB) and stop band
+# (-100dB) edges of the generated coefficients, sASRCFirBands in
+# asrc/src_mrhf_asrc.c: update them when changing a filter here.
+import math
+import os.path
+
+ATTENUATION_DB = 105.0
+
+#          Name      Taps  Pass    Stop    Gain  Used for (Fsync is the rate of the coefficients)
+FILTERS = [
+    ("DS4",      64,  0.0625, 0.1700, 1),   # DS4 ahead of a SYNC filter (e.g. 384 -> 96kHz)
+    ("BL5016",  160,  0.1315, 0.1745, 1),   # SYNC, Fsout = 0.31 to 0.338 x Fsync (e.g. 50 -> 16kHz)
+    ("BL4816",  160,  0.1420, 0.1860, 1),   # SYNC, Fsout = 0.332 to 0.365 x Fsync (e.g. 48 -> 16kHz)
+    ("BL4416",  144,  0.1550, 0.2020, 1),   # SYNC, Fsout = 0.361 to 0.396 x Fsync (e.g. 44.1 -> 16kHz)
+    ("BL3716",  144,  0.1712, 0.2162, 1),   # SYNC, Fsout = 0.392 to 0.434 x Fsync (e.g. 37.8 -> 16kHz)
+    ("UP5032",  160,  0.1315, 0.1745, 2),   # OS2, as BL5016 (e.g. 50 -> 32kHz)
+    ("UP4832",  160,  0.1420, 0.1860, 2),   # OS2, as BL4816 (e.g. 48 -> 32kHz)
+    ("UP4432",  144,  0.1550, 0.2020, 2),   # OS2, as BL4416 (e.g. 44.1 -> 32kHz)
+    ("UP3732",  144,  0.1712, 0.2162, 2),   # OS2, as BL3716 (e.g. 37.8 -> 32kHz)
+    ("DS8",     128,  0.0290, 0.0900, 1),   # DS8 ahead of a SYNC filter (e.g. 384 -> 32kHz)
+    ("DS16",    176,  0.0095, 0.0500, 1),   # DS16 ahead of a SYNC filter (e.g. 384 -> 8kHz)
+]
+
+HEADER = """\
+/* This file is generated using src_mrhf_fir_coefs_generator.py
+ *
+ * Do not modify it directly, changes may be overwritten!
+ */
+"""
+
+
+def bessel_i0(x):
+    # Power series of the zeroth order modified Bessel function of the first kind
+    total = term = 1.0
+    k = 1
+    while term > 1e-12 * total:
+        term *= (x / (2.0 * k)) ** 2
+        total += term
+        k += 1
+    return total
+
+
+def kaiser_beta(attenuation_db):
+    if attenuation_db > 50.0:
+        return 0.1102 * (attenuation_db - 8.7)
+    if attenuation_db >= 21.0:
+        return 0.5842 * (attenuation_db - 21.0) ** 0.4 + 0.07886 * (attenuation_db - 21.0)
+    return 0.0
+
+
+def design(n_taps, pass_edge, stop_edge, gain):
+    assert n_taps % 16 == 0
+    cutoff = (pass_edge + stop_edge) / 2.0
+    beta = kaiser_beta(ATTENUATION_DB)
+    centre = (n_taps - 1) / 2.0
+    taps = []
+    for n in range(n_taps):
+        t = n - centre
+        window = bessel_i0(beta * math.sqrt(1.0 - (t / centre) ** 2)) / bessel_i0(beta)
+        taps.append(2.0 * cutoff * math.sin(2.0 * math.pi * cutoff * t) / (2.0 * math.pi * cutoff * t) * window)
+    scale = gain * 2.0 ** 31 / sum(taps)
+    return [int(round(c * scale)) for c in taps]
+
+
+def write_coefs(path, coefs):
+    with open(path, "w") as f:
+        f.write(HEADER)
+        for c in coefs:
+            f.write("   %d,\n" % c)
+
+
+if __name__ == "__main__":
+    filter_data = os.path.join(os.path.dirname(os.path.realpath(__file__)), "FilterData")
+    for name, n_taps, pass_edge, stop_edge, gain in FILTERS:
+        write_coefs(os.path.join(filter_data, name + ".dat"), design(n_taps, pass_edge, stop_edge, gain))
@@ -0,0 +1,479 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Fast convolution (FFT overlap-save) FIR implementation file for the SRC
+//
+// ===========================================================================
+// ===========================================================================
+
+
+// ===========================================================================
+//
+// Includes
+//
+// ===========================================================================
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// Inner loop kernels selection
+#include "src_kernels.h"
+
+// FIR includes
+#include "src_mrhf_fir.h"
+#include "src_mrhf_fir_fast_conv.h"
+
+#if FIR_FAST_CONV
+
+// ===========================================================================
+//
+// Defines
+//
+// ===========================================================================
+
+// Output scaling (outputs are bits [62-31] of the accumulation, see EXT30)
+#define        FIR_FAST_CONV_OUT_SCALE                2147483648.0
+
+#define        FIR_FAST_CONV_PI                    3.14159265358979323846
+
+// Last two stages of the forward FFT over 4 points (half lengths 2 and 1, twiddle factors 1 and -j)
+#define FIR_FAST_CONV_DIF4(pdRe, pdIm) \
+    do { \
+        double    dARe, dAIm, dBRe, dBIm, dCRe, dCIm, dDRe, dDIm; \
+        dARe        = (pdRe)[0] + (pdRe)[2]; \
+        dAIm        = (pdIm)[0] + (pdIm)[2]; \
+        dBRe        = (pdRe)[1] + (pdRe)[3]; \
+        dBIm        = (pdIm)[1] + (pdIm)[3]; \
+        dCRe        = (pdRe)[0] - (pdRe)[2]; \
+        dCIm        = (pdIm)[0] - (pdIm)[2]; \
+        dDRe        = (pdIm)[1] - (pdIm)[3]; \
+        dDIm        = (pdRe)[3] - (pdRe)[1]; \
+        (pdRe)[0]    = dARe + dBRe; \
+        (pdIm)[0]    = dAIm + dBIm; \
+        (pdRe)[1]    = dARe - dBRe; \
+        (pdIm)[1]    = dAIm - dBIm; \
+        (pdRe)[2]    = dCRe + dDRe; \
+        (pdIm)[2]    = dCIm + dDIm; \
+        (pdRe)[3]    = dCRe - dDRe; \
+        (pdIm)[3]    = dCIm - dDIm; \
+    } while(0)
+
+// First two stages of the inverse FFT over 4 points (half lengths 1 and 2, twiddle factors 1 and +j)
+#define FIR_FAST_CONV_DIT4(pdRe, pdIm) \
+    do { \
+        double    dARe, dAIm, dBRe, dBIm, dCRe, dCIm, dDRe, dDIm; \
+        dARe        = (pdRe)[0] + (pdRe)[1]; \
+        dAIm        = (pdIm)[0] + (pdIm)[1]; \
+        dBRe        = (pdRe)[0] - (pdRe)[1]; \
+        dBIm        = (pdIm)[0] - (pdIm)[1]; \
+        dCRe        = (pdRe)[2] + (pdRe)[3]; \
+        dCIm        = (pdIm)[2] + (pdIm)[3]; \
+        dDRe        = (pdIm)[3] - (pdIm)[2]; \
+        dDIm        = (pdRe)[2] - (pdRe)[3]; \
+        (pdRe)[0]    = dARe + dCRe; \
+        (pdIm)[0]    = dAIm + dCIm; \
+        (pdRe)[2]    = dARe - dCRe; \
+        (pdIm)[2]    = dAIm - dCIm; \
+        (pdRe)[1]    = dBRe + dDRe; \
+        (pdIm)[1]    = dBIm + dDIm; \
+        (pdRe)[3]    = dBRe - dDRe; \
+        (pdIm)[3]    = dBIm - dDIm; \
+    } while(0)
+
+
+// ===========================================================================
+//
+// Local Functions prototypes
+//
+// ===========================================================================
+
+static void                     FIR_fast_conv_fft(double* pdRe, double* pdIm, FIRFastConvState_t* psState);
+static void                     FIR_fast_conv_ifft(double* pdRe, double* pdIm, FIRFastConvState_t* psState);
+static void                     FIR_fast_conv_filter(FIRFastConvState_t* psState);
+static int                      FIR_fast_conv_out(double dData);
+
+
+// ===========================================================================
+//
+// Functions implementations
+//
+// ===========================================================================
+
+// ==================================================================== //
+// Function:        FIR_fast_conv_init                                    //
+// Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+//                    FIRFastConvState_t *psState: Fast conv. state        //
+// Return values:    FIR_NO_ERROR if fast convolution is used            //
+//                    FIR_ERROR if not (FIR left unchanged)                //
+// Description:        Switches an initialised FIR to fast convolution    //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_fast_conv_init(FIRCtrl_t* psFIRCtrl, FIRFastConvState_t* psState)
+{
+    FIRReturnCodes_t    (*pvProc)(int *);
+    FIRTypeCodes_t        eType;
+    unsigned int        uiNTaps;
+    unsigned int        ui, uiH;
+    int*                piCoefs;
+
+    if((psState == 0) || (psFIRCtrl->eEnable != FIR_ON))
+        return FIR_ERROR;
+
+    // Only where it is faster than the inner loops
+    if(!SRC_KERNELS_FAST_CONV())
+        return FIR_ERROR;
+
+    // Get type and branch length from processing function
+    pvProc                = psFIRCtrl->pvProc;
+    if(pvProc == (FIRReturnCodes_t (*)(int *)) FIR_proc_os2)
+    {
+        eType            = FIR_TYPE_OS2;
+        uiNTaps            = psFIRCtrl->uiNCoefs>>1;
+    }
+    else if(pvProc == (FIRReturnCodes_t (*)(int *)) FIR_proc_sync)
+    {
+        eType            = FIR_TYPE_SYNC;
+        uiNTaps            = psFIRCtrl->uiNCoefs;
+    }
+    else if(pvProc == (FIRReturnCodes_t (*)(int *)) FIR_proc_ds2)
+    {
+        eType            = FIR_TYPE_DS2;
+        uiNTaps            = psFIRCtrl->uiNCoefs>>1;
+    }
+    else
+        return FIR_ERROR;
+
+    // Check branches and block are long enough for fast convolution to be worthwhile
+    if((uiNTaps < FIR_FAST_CONV_MIN_BRANCH_TAPS) || (uiNTaps > FIR_FAST_CONV_MAX_BRANCH_TAPS))
+        return FIR_ERROR;
+    if(psFIRCtrl->uiNInSamples < FIR_FAST_CONV_MIN_IN_SAMPLES)
+        return FIR_ERROR;
+
+    psState->eType        = eType;
+    psState->uiNTaps    = uiNTaps;
+
+    // Twiddle factors: exp(-j * pi * k / uiH) for k < uiH, at offset N - 2 * uiH for each stage half length uiH
+    for(uiH = 1; uiH < FIR_FAST_CONV_N; uiH <<= 1)
+    {
+        for(ui = 0; ui < uiH; ui++)
+        {
+            psState->dTwiddleRe[FIR_FAST_CONV_N - 2 * uiH + ui]    = cos(FIR_FAST_CONV_PI * ui / uiH);
+            psState->dTwiddleIm[FIR_FAST_CONV_N - 2 * uiH + ui]    = -sin(FIR_FAST_CONV_PI * ui / uiH);
+        }
+    }
+
+    // Pack branches (impulse responses, i.e. coefficients reversed as delay lines are oldest sample first)
+    piCoefs                = psFIRCtrl->piCoefs;
+    memset(psState->dFilterRe, 0, sizeof(psState->dFilterRe));
+    memset(psState->dFilterIm, 0, sizeof(psState->dFilterIm));
+    for(ui = 0; ui < uiNTaps; ui++)
+    {
+        switch(eType)
+        {
+            // Even and odd coefficients give the two output phases: real and imaginary parts
+            case FIR_TYPE_OS2:
+                psState->dFilterRe[ui]    = piCoefs[2 * (uiNTaps - 1 - ui)];
+                psState->dFilterIm[ui]    = piCoefs[2 * (uiNTaps - 1 - ui) + 1];
+            break;
+
+            case FIR_TYPE_SYNC:
+                psState->dFilterRe[ui]    = piCoefs[uiNTaps - 1 - ui];
+            break;
+
+            // Frames hold odd input samples as real part and even ones as imaginary part, so
+            // the output is the real part with the branches packed as (even - j * odd) taps
+            default:
+                psState->dFilterRe[ui]    = piCoefs[2 * uiNTaps - 1 - 2 * ui];
+                psState->dFilterIm[ui]    = -piCoefs[2 * uiNTaps - 2 - 2 * ui];
+            break;
+        }
+    }
+    FIR_fast_conv_fft(psState->dFilterRe, psState->dFilterIm, psState);
+
+    // Scale for inverse FFT and output extraction
+    for(ui = 0; ui < FIR_FAST_CONV_N; ui++)
+    {
+        psState->dFilterRe[ui]    /= (FIR_FAST_CONV_N * FIR_FAST_CONV_OUT_SCALE);
+        psState->dFilterIm[ui]    /= (FIR_FAST_CONV_N * FIR_FAST_CONV_OUT_SCALE);
+    }
+
+    psFIRCtrl->psFastConv        = psState;
+    psFIRCtrl->pvProc            = (FIRReturnCodes_t (*)(int *)) FIR_proc_fast_conv;
+
+    return FIR_NO_ERROR;
+}
+
+
+// Reads input sample iIndex relative to the first sample of the frame: from the delay line
+// (piDelay, newest sample last) for the history, from the input buffer otherwise and zero past the
+// end of the block
+#define FIR_FAST_CONV_GET_SPL(iIndex) \
+    (((iIndex) < 0) ? piDelay[(int)uiDelayO + (iIndex)] : (((iIndex) < iNRemain) ? piIn[(iIndex) * (int)uiInStep] : 0))
+
+
+// ==================================================================== //
+// Function:        FIR_proc_fast_conv                                    //
+// Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the FIR by fast convolution                //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_proc_fast_conv(FIRCtrl_t* psFIRCtrl)
+{
+    FIRFastConvState_t*    psState        = psFIRCtrl->psFastConv;
+    int*            piIn        = psFIRCtrl->piIn;
+    unsigned int    uiInStep    = psFIRCtrl->uiInStep;
+    int*            piOut        = psFIRCtrl->piOut;
+    unsigned int    uiOutStep    = psFIRCtrl->uiOutStep;
+    int*            piDelayB    = psFIRCtrl->piDelayB;
+    int*            piDelayI    = psFIRCtrl->piDelayI;
+    int*            piDelayW    = psFIRCtrl->piDelayW;
+    unsigned int    uiDelayO    = psFIRCtrl->uiDelayO;
+    double*            pdRe        = psState->dFrameRe;
+    double*            pdIm        = psState->dFrameIm;
+    int                iH            = (int)psState->uiNTaps - 1;                // Number of history samples per branch
+    int                iB            = FIR_FAST_CONV_N - iH;                        // Number of outputs per branch and frame
+    int*            piDelay;
+    int                iNRemain, iNSpl, iNPush;
+    int                i;
+
+    // Number of input samples to process
+    iNRemain            = (int)psFIRCtrl->uiNInSamples;
+
+    while(iNRemain > 0)
+    {
+        // Fill frame from delay line and input
+        // ------------------------------------
+        piDelay            = FIR_DELAY_DATA(piDelayI, uiDelayO);
+        switch(psState->eType)
+        {
+            // Over-sampler: real frame, branches outputs as real and imaginary parts
+            case FIR_TYPE_OS2:
+                iNSpl        = (iNRemain < iB) ? iNRemain : iB;
+                for(i = 0; i < FIR_FAST_CONV_N; i++)
+                {
+                    pdRe[i]    = FIR_FAST_CONV_GET_SPL(i - iH);
+                    pdIm[i]    = 0;
+                }
+            break;
+
+            // Synchronous: two consecutive segments of the input as real and imaginary parts
+            case FIR_TYPE_SYNC:
+                iNSpl        = (iNRemain < 2 * iB) ? iNRemain : 2 * iB;
+                for(i = 0; i < FIR_FAST_CONV_N; i++)
+                {
+                    pdRe[i]    = FIR_FAST_CONV_GET_SPL(i - iH);
+                    pdIm[i]    = FIR_FAST_CONV_GET_SPL(iB + i - iH);
+                }
+            break;
+
+            // Down-sampler: odd input samples as real part, even ones as imaginary part
+            default:
+                iNSpl        = (iNRemain < 2 * iB) ? iNRemain : 2 * iB;
+                for(i = 0; i < FIR_FAST_CONV_N; i++)
+                {
+                    pdRe[i]    = FIR_FAST_CONV_GET_SPL(2 * (i - iH) + 1);
+                    pdIm[i]    = FIR_FAST_CONV_GET_SPL(2 * (i - iH));
+                }
+            break;
+        }
+
+        // Filter frame
+        // ------------
+        FIR_fast_conv_filter(psState);
+
+        // Get the input samples of the frame to delay line (before writing output as it may be the input buffer)
+        // ------------------------------------------------------------------------------------------------------
+        iNPush            = (iNSpl < (int)uiDelayO) ? iNSpl : (int)uiDelayO;
+        if(psState->eType == FIR_TYPE_DS2)
+        {
+            for(i = iNSpl - iNPush; i < iNSpl; i += 2)
+            {
+                FIR_DELAY_WRITE(piDelayI, uiDelayO, 0, piIn[i * uiInStep]);
+                FIR_DELAY_WRITE(piDelayI, uiDelayO, 1, piIn[(i + 1) * uiInStep]);
+                FIR_DELAY_STEP(piDelayB, piDelayI, piDelayW, uiDelayO, 2);
+            }
+        }
+        else
+        {
+            for(i = iNSpl - iNPush; i < iNSpl; i++)
+            {
+                FIR_DELAY_WRITE(piDelayI, uiDelayO, 0, piIn[i * uiInStep]);
+                FIR_DELAY_STEP(piDelayB, piDelayI, piDelayW, uiDelayO, 1);
+            }
+        }
+
+        // Write output with step
+        // ----------------------
+        switch(psState->eType)
+        {
+            // NOTE OUTPUT WRITE ORDER: First odd coefficients phase, then even coefficients phase
+            case FIR_TYPE_OS2:
+                for(i = 0; i < iNSpl; i++)
+                {
+                    *piOut                = FIR_fast_conv_out(pdIm[iH + i]);
+                    piOut                += uiOutStep;
+                    *piOut                = FIR_fast_conv_out(pdRe[iH + i]);
+                    piOut                += uiOutStep;
+                }
+            break;
+
+            case FIR_TYPE_SYNC:
+                for(i = 0; i < iNSpl; i++)
+                {
+                    *piOut                = FIR_fast_conv_out((i < iB) ? pdRe[iH + i] : pdIm[iH + i - iB]);
+                    piOut                += uiOutStep;
+                }
+            break;
+
+            default:
+                for(i = 0; i < (iNSpl>>1); i++)
+                {
+                    *piOut                = FIR_fast_conv_out(pdRe[iH + i]);
+                    piOut                += uiOutStep;
+                }
+            break;
+        }
+
+        piIn            += iNSpl * uiInStep;
+        iNRemain        -= iNSpl;
+    }
+
+    // Write delay line index back for next round
+    psFIRCtrl->piDelayI        = piDelayI;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_fast_conv_filter                                //
+// Arguments:        FIRFastConvState_t *psState: Fast conv. state        //
+// Return values:    None                                                //
+// Description:        Circular convolution of the frame with the packed    //
+//                    branches                                            //
+// ==================================================================== //
+static void                     FIR_fast_conv_filter(FIRFastConvState_t* psState)
+{
+    double*            pdRe        = psState->dFrameRe;
+    double*            pdIm        = psState->dFrameIm;
+    double            dRe;
+    unsigned int    ui;
+
+    FIR_fast_conv_fft(pdRe, pdIm, psState);
+
+    // Both spectra are in the same (bit reversed) order
+    for(ui = 0; ui < FIR_FAST_CONV_N; ui++)
+    {
+        dRe            = pdRe[ui] * psState->dFilterRe[ui] - pdIm[ui] * psState->dFilterIm[ui];
+        pdIm[ui]    = pdRe[ui] * psState->dFilterIm[ui] + pdIm[ui] * psState->dFilterRe[ui];
+        pdRe[ui]    = dRe;
+    }
+
+    FIR_fast_conv_ifft(pdRe, pdIm, psState);
+}
+
+
+// ==================================================================== //
+// Function:        FIR_fast_conv_fft                                    //
+// Arguments:        double *pdRe, *pdIm: data (natural order)            //
+//                    FIRFastConvState_t *psState: Fast conv. state        //
+// Return values:    None                                                //
+// Description:        Radix 2 decimation in frequency FFT, leaving the    //
+//                    spectrum in bit reversed order                        //
+// ==================================================================== //
+static void                     FIR_fast_conv_fft(double* pdRe, double* pdIm, FIRFastConvState_t* psState)
+{
+    const double*    pdWRe;
+    const double*    pdWIm;
+    double            dURe, dUIm, dVRe, dVIm;
+    unsigned int    uiH, ui, uj;
+
+    for(uiH = FIR_FAST_CONV_N>>1; uiH >= 4; uiH >>= 1)
+    {
+        pdWRe        = psState->dTwiddleRe + FIR_FAST_CONV_N - 2 * uiH;
+        pdWIm        = psState->dTwiddleIm + FIR_FAST_CONV_N - 2 * uiH;
+        for(ui = 0; ui < FIR_FAST_CONV_N; ui += 2 * uiH)
+        {
+            for(uj = ui; uj < ui + uiH; uj++)
+            {
+                dURe                = pdRe[uj];
+                dUIm                = pdIm[uj];
+                dVRe                = pdRe[uj + uiH];
+                dVIm                = pdIm[uj + uiH];
+                pdRe[uj]            = dURe + dVRe;
+                pdIm[uj]            = dUIm + dVIm;
+                dURe                -= dVRe;
+                dUIm                -= dVIm;
+                pdRe[uj + uiH]        = dURe * pdWRe[uj - ui] - dUIm * pdWIm[uj - ui];
+                pdIm[uj + uiH]        = dURe * pdWIm[uj - ui] + dUIm * pdWRe[uj - ui];
+            }
+        }
+    }
+
+    // Last two stages
+    for(ui = 0; ui < FIR_FAST_CONV_N; ui += 4)
+        FIR_FAST_CONV_DIF4(pdRe + ui, pdIm + ui);
+}
+
+
+// ==================================================================== //
+// Function:        FIR_fast_conv_ifft                                    //
+// Arguments:        double *pdRe, *pdIm: data (bit reversed order)        //
+//                    FIRFastConvState_t *psState: Fast conv. state        //
+// Return values:    None                                                //
+// Description:        Radix 2 decimation in time inverse FFT (unscaled),    //
+//                    from bit reversed to natural order                    //
+// ==================================================================== //
+static void                     FIR_fast_conv_ifft(double* pdRe, double* pdIm, FIRFastConvState_t* psState)
+{
+    const double*    pdWRe;
+    const double*    pdWIm;
+    double            dURe, dUIm, dVRe, dVIm;
+    unsigned int    uiH, ui, uj;
+
+    // First two stages
+    for(ui = 0; ui < FIR_FAST_CONV_N; ui += 4)
+        FIR_FAST_CONV_DIT4(pdRe + ui, pdIm + ui);
+
+    for(uiH = 4; uiH < FIR_FAST_CONV_N; uiH <<= 1)
+    {
+        pdWRe        = psState->dTwiddleRe + FIR_FAST_CONV_N - 2 * uiH;
+        pdWIm        = psState->dTwiddleIm + FIR_FAST_CONV_N - 2 * uiH;
+        for(ui = 0; ui < FIR_FAST_CONV_N; ui += 2 * uiH)
+        {
+            for(uj = ui; uj < ui + uiH; uj++)
+            {
+                // Conjugate twiddle factors
+                dVRe                = pdRe[uj + uiH] * pdWRe[uj - ui] + pdIm[uj + uiH] * pdWIm[uj - ui];
+                dVIm                = pdIm[uj + uiH] * pdWRe[uj - ui] - pdRe[uj + uiH] * pdWIm[uj - ui];
+                dURe                = pdRe[uj];
+                dUIm                = pdIm[uj];
+                pdRe[uj]            = dURe + dVRe;
+                pdIm[uj]            = dUIm + dVIm;
+                pdRe[uj + uiH]        = dURe - dVRe;
+                pdIm[uj + uiH]        = dUIm - dVIm;
+            }
+        }
+    }
+}
+
+
+// ==================================================================== //
+// Function:        FIR_fast_conv_out                                    //
+// Arguments:        double dData: scaled convolution result            //
+// Return values:    Output sample                                        //
+// Description:        Rounds down and saturates as per lsats/lextract    //
+// ==================================================================== //
+static int                      FIR_fast_conv_out(double dData)
+{
+    dData        = floor(dData);
+    if(dData > 2147483647.0)
+        return 0x7FFFFFFF;
+    if(dData < -2147483648.0)
+        return (int)0x80000000;
+    return (int)dData;
+}
+
+#endif // FIR_FAST_CONV
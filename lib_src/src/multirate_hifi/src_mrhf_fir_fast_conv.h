@@ -0,0 +1,111 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Fast convolution (FFT overlap-save) FIR definition file for the SRC
+//
+// For large blocks the F1/F2 FIRs can be processed by fast convolution in
+// place of direct form: each polyphase branch (one for FIR_TYPE_SYNC, two
+// for FIR_TYPE_OS2 and FIR_TYPE_DS2) is convolved with frames of
+// FIR_FAST_CONV_N input samples by FFT (self-contained radix 2, double
+// precision). Branches are packed as real and imaginary parts so each frame
+// costs one forward and one inverse FFT.
+//
+// The result is computed in double precision rather than with 64 bits
+// integer accumulation, so an output sample may differ by 1 LSB (of the 32
+// bits output) from the fixed point FIR where the exact result is within
+// rounding error of an LSB boundary. After the following filters of the SSRC
+// the difference stays within FIR_FAST_CONV_TOLERANCE LSBs.
+//
+// The delay line is kept up to date, so the ctrl strct. stays usable with
+// the direct form processing functions. Host builds only (FIR_FAST_CONV).
+//
+// ===========================================================================
+// ===========================================================================
+
+#ifndef _SRC_MRHF_FIR_FAST_CONV_H_
+#define _SRC_MRHF_FIR_FAST_CONV_H_
+
+    // ===========================================================================
+    //
+    // Includes
+    //
+    // ===========================================================================
+    #include "src_mrhf_fir.h"
+
+#if FIR_FAST_CONV
+
+    // ===========================================================================
+    //
+    // Defines
+    //
+    // ===========================================================================
+
+    // General defines
+    // ---------------
+    #define        FIR_FAST_CONV_LOG2_N                9                            // Log2 of FFT length
+    #define        FIR_FAST_CONV_N                        (1 << FIR_FAST_CONV_LOG2_N)    // FFT length (frame length in branch input samples)
+    #define        FIR_FAST_CONV_MIN_BRANCH_TAPS        64                            // Shortest branch for which fast convolution is faster than direct form
+    #define        FIR_FAST_CONV_MAX_BRANCH_TAPS        (FIR_FAST_CONV_N >> 1)        // Longest branch (at least half of each frame gives outputs)
+    #define        FIR_FAST_CONV_MIN_IN_SAMPLES        FIR_FAST_CONV_N                // Smallest block (number of FIR input samples) processed by fast convolution
+    #define        FIR_FAST_CONV_TOLERANCE                4                            // Maximum difference (in LSBs of the 32 bits output) from the fixed point SSRC
+
+
+    // ===========================================================================
+    //
+    // TypeDefs
+    //
+    // ===========================================================================
+
+    // To avoid C type definitions when including this file from assembler
+    #ifndef INCLUDE_FROM_ASM
+
+        // Fast convolution FIR state
+        // --------------------------
+        typedef struct _FIRFastConvState
+        {
+            FIRTypeCodes_t                            eType;                                // FIR type
+            unsigned int                            uiNTaps;                            // Number of taps per branch
+            double                                    dTwiddleRe[FIR_FAST_CONV_N];        // Twiddle factors of each FFT stage (real part)
+            double                                    dTwiddleIm[FIR_FAST_CONV_N];        // Twiddle factors of each FFT stage (imaginary part)
+            double                                    dFilterRe[FIR_FAST_CONV_N];            // Packed branches spectrum, scaled for output (real part)
+            double                                    dFilterIm[FIR_FAST_CONV_N];            // Packed branches spectrum, scaled for output (imaginary part)
+            double                                    dFrameRe[FIR_FAST_CONV_N];            // Frame being processed (real part)
+            double                                    dFrameIm[FIR_FAST_CONV_N];            // Frame being processed (imaginary part)
+        } FIRFastConvState_t;
+
+
+        // ===========================================================================
+        //
+        // Function prototypes
+        //
+        // ===========================================================================
+
+        // ==================================================================== //
+        // Function:        FIR_fast_conv_init                                    //
+        // Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+        //                    FIRFastConvState_t *psState: Fast conv. state        //
+        // Return values:    FIR_NO_ERROR if fast convolution is used            //
+        //                    FIR_ERROR if not (FIR left unchanged)                //
+        // Description:        Switches an initialised FIR to fast convolution if    //
+        //                    it is enabled, its branches and block are long        //
+        //                    enough and it is faster than the selected inner    //
+        //                    loops (SRC_KERNELS_FAST_CONV). FIR_init_from_desc    //
+        //                    switches back to direct form                        //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_fast_conv_init(FIRCtrl_t* psFIRCtrl, FIRFastConvState_t* psState);
+
+        // ==================================================================== //
+        // Function:        FIR_proc_fast_conv                                    //
+        // Arguments:        FIRCtrl_t     *psFIRCtrl: Ctrl strct.                    //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Processes the FIR by fast convolution                //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_proc_fast_conv(FIRCtrl_t* psFIRCtrl);
+
+    #endif // nINCLUDE_FROM_ASM
+
+#endif // FIR_FAST_CONV
+
+#endif // _SRC_MRHF_FIR_FAST_CONV_H_
@@ -0,0 +1,764 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Single precision floating point FIR functions implementation file for the
+// float SSRC and ASRC (host builds only, see src_mrhf_fir_float.h)
+//
+//
+// ===========================================================================
+// ===========================================================================
+
+
+// ===========================================================================
+//
+// Includes
+//
+// ===========================================================================
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// Inner loop kernels
+#include "src_kernels.h"
+
+// Float FIR includes
+#include "src_mrhf_fir_float.h"
+
+#if FIR_FLOAT
+
+// ===========================================================================
+//
+// Defines
+//
+// ===========================================================================
+
+
+// State init value
+#define        FIR_FLOAT_STATE_INIT                0.0f
+
+
+
+// ===========================================================================
+//
+// Variables
+//
+// ===========================================================================
+
+// Converted coefficients cache (see FIR_float_coefs)
+typedef struct _FIRFloatCoefsTable
+{
+    int*                                    piCoefs;        // Fixed point coefficients converted
+    unsigned int                            uiOS2;            // Phases stored contiguously (over-sampler by 2)
+    float*                                    pfCoefs;        // Converted coefficients
+} FIRFloatCoefsTable_t;
+
+static float                        fFIRFloatCoefs[FIR_FLOAT_COEFS_LEN];
+static unsigned int                    uiFIRFloatCoefsUsed        = 0;
+static FIRFloatCoefsTable_t            sFIRFloatCoefsTables[FIR_FLOAT_MAX_TABLES];
+static unsigned int                    uiFIRFloatNTables        = 0;
+
+
+
+// ===========================================================================
+//
+// Functions implementations
+//
+// ===========================================================================
+
+// ==================================================================== //
+// Function:        FIR_float_coefs                                        //
+// Arguments:        int *piCoefs: fixed point coefficients                //
+//                    unsigned int uiNCoefs: number of coefficients        //
+//                    FIRTypeCodes_t eType: FIR type (FIR_TYPE_OS2        //
+//                    stores the two phases contiguously)                    //
+// Return values:    Pointer to float coefficients, 0 on failure            //
+// Description:        Converts coefficients to float on first call for    //
+//                    a table, returns the same copy on later calls        //
+// ==================================================================== //
+float*                            FIR_float_coefs(int* piCoefs, unsigned int uiNCoefs, FIRTypeCodes_t eType)
+{
+    unsigned int        uiOS2    = (eType == FIR_TYPE_OS2);
+    float*                pfCoefs;
+    unsigned int        ui;
+
+    // Look for table already converted
+    for(ui = 0; ui < uiFIRFloatNTables; ui++)
+    {
+        if((sFIRFloatCoefsTables[ui].piCoefs == piCoefs) && (sFIRFloatCoefsTables[ui].uiOS2 == uiOS2))
+            return sFIRFloatCoefsTables[ui].pfCoefs;
+    }
+
+    // Check there is room left for a new table
+    if(uiFIRFloatNTables == FIR_FLOAT_MAX_TABLES)
+        return 0;
+    if(uiFIRFloatCoefsUsed + uiNCoefs > FIR_FLOAT_COEFS_LEN)
+        return 0;
+
+    pfCoefs                        = fFIRFloatCoefs + uiFIRFloatCoefsUsed;
+    if(uiOS2)
+    {
+        // Interleaved phases: even coefficients to first half, odd ones to second half
+        for(ui = 0; ui < (uiNCoefs>>1); ui++)
+        {
+            pfCoefs[ui]                    = (float)piCoefs[2 * ui] * FIR_FLOAT_SCALE;
+            pfCoefs[(uiNCoefs>>1) + ui]    = (float)piCoefs[2 * ui + 1] * FIR_FLOAT_SCALE;
+        }
+    }
+    else
+    {
+        for(ui = 0; ui < uiNCoefs; ui++)
+            pfCoefs[ui]                    = (float)piCoefs[ui] * FIR_FLOAT_SCALE;
+    }
+
+    // Register table
+    sFIRFloatCoefsTables[uiFIRFloatNTables].piCoefs        = piCoefs;
+    sFIRFloatCoefsTables[uiFIRFloatNTables].uiOS2        = uiOS2;
+    sFIRFloatCoefsTables[uiFIRFloatNTables].pfCoefs        = pfCoefs;
+    uiFIRFloatNTables++;
+    uiFIRFloatCoefsUsed            += uiNCoefs;
+
+    return pfCoefs;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_float_init_from_desc                            //
+// Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+//                    FIRDescriptor_t *psFIRDescriptor: Desc. strct.        //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Inits the float FIR from the Descriptor                //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_float_init_from_desc(FIRFloatCtrl_t* psFIRCtrl, FIRDescriptor_t* psFIRDescriptor)
+{
+    unsigned int        uiDecim;
+
+    // Check if FIR is disabled (this is given by the number of coefficients being zero)
+    if( psFIRDescriptor->uiNCoefs == 0)
+    {
+        // Number of coefficients is zero, so disable FIR
+        psFIRCtrl->eEnable            = FIR_OFF;
+        psFIRCtrl->uiNOutSamples    = 0;
+        psFIRCtrl->pvProc            = 0;
+        psFIRCtrl->uiDelayL            = 0;
+        psFIRCtrl->pfDelayW            = 0;
+        psFIRCtrl->uiDelayO            = 0;
+        psFIRCtrl->uiNTaps            = 0;
+        psFIRCtrl->pfCoefs            = 0;
+
+        return FIR_NO_ERROR;
+    }
+
+    // FIR is not disabled
+    // Check that delay line base has been set
+    if(psFIRCtrl->pfDelayB == 0)
+        return FIR_ERROR;
+
+    // Check that number of samples has been set and is a multiple of 2
+    if(psFIRCtrl->uiNInSamples == 0)
+        return FIR_ERROR;
+    if((psFIRCtrl->uiNInSamples & 0x1) != 0x0)
+        return FIR_ERROR;
+
+    // Check the input and output samples steps have been set
+    if(psFIRCtrl->uiInStep == 0)
+        return FIR_ERROR;
+    if(psFIRCtrl->uiOutStep == 0)
+        return FIR_ERROR;
+
+    // Setup depending on FIR descriptor
+    switch(psFIRDescriptor->eType)
+    {
+        // Over-sampler by 2 type
+        case FIR_TYPE_OS2:
+            psFIRCtrl->eEnable            = FIR_ON;
+            psFIRCtrl->uiNOutSamples    = (psFIRCtrl->uiNInSamples)<<1;                        // Os2 FIR doubles the number of samples
+            psFIRCtrl->pvProc            = FIR_float_proc_os2;
+            psFIRCtrl->uiDelayL            = FIR_DELAY_LEN(psFIRDescriptor->uiNCoefs>>1);        // Only half length due to OS2
+            psFIRCtrl->pfDelayW            = FIR_DELAY_WRAP(psFIRCtrl->pfDelayB, psFIRDescriptor->uiNCoefs>>1, 1);
+            psFIRCtrl->uiDelayO            = psFIRDescriptor->uiNCoefs>>1;
+            psFIRCtrl->uiNTaps            = psFIRDescriptor->uiNCoefs>>1;                        // Taps per phase
+        break;
+
+        // Asynchronous type
+        case FIR_TYPE_SYNC:
+            psFIRCtrl->eEnable            = FIR_ON;
+            psFIRCtrl->uiNOutSamples    = psFIRCtrl->uiNInSamples;                            // Sync FIR does not change number of samples
+            psFIRCtrl->pvProc            = FIR_float_proc_sync;
+            psFIRCtrl->uiDelayL            = FIR_DELAY_LEN(psFIRDescriptor->uiNCoefs);
+            psFIRCtrl->pfDelayW            = FIR_DELAY_WRAP(psFIRCtrl->pfDelayB, psFIRDescriptor->uiNCoefs, 1);
+            psFIRCtrl->uiDelayO            = psFIRDescriptor->uiNCoefs;
+            psFIRCtrl->uiNTaps            = psFIRDescriptor->uiNCoefs;
+        break;
+
+        // Down-sample by 2 type
+        case FIR_TYPE_DS2:
+            psFIRCtrl->eEnable            = FIR_ON;
+            psFIRCtrl->uiNOutSamples    = psFIRCtrl->uiNInSamples>>1;                        // Ds2 FIR divides the number of samples by two
+            psFIRCtrl->pvProc            = FIR_float_proc_ds2;
+            psFIRCtrl->uiDelayL            = FIR_DELAY_LEN(psFIRDescriptor->uiNCoefs);
+            psFIRCtrl->pfDelayW            = FIR_DELAY_WRAP(psFIRCtrl->pfDelayB, psFIRDescriptor->uiNCoefs, 2);
+            psFIRCtrl->uiDelayO            = psFIRDescriptor->uiNCoefs;
+            psFIRCtrl->uiNTaps            = psFIRDescriptor->uiNCoefs;
+        break;
+
+        // Down-sample by 4, 8 or 16 type
+        case FIR_TYPE_DS4:
+        case FIR_TYPE_DS8:
+        case FIR_TYPE_DS16:
+            uiDecim                        = FIR_DSN_DECIM(psFIRDescriptor->eType);
+            if( (psFIRCtrl->uiNInSamples & (uiDecim - 1)) != 0x0)                            // Check that number of samples is a multiple of the decimation
+                return FIR_ERROR;
+#if SRC_LINEAR_DELAY_LINES
+            if( uiDecim > SRC_LINEAR_DELAY_BLOCK )                                            // Linear delay lines take up to SRC_LINEAR_DELAY_BLOCK samples per step
+                return FIR_ERROR;
+#endif
+            psFIRCtrl->eEnable            = FIR_ON;
+            psFIRCtrl->uiNOutSamples    = psFIRCtrl->uiNInSamples / uiDecim;                // DsN FIR divides the number of samples by the decimation
+            psFIRCtrl->pvProc            = FIR_float_proc_dsn;
+            psFIRCtrl->uiDelayL            = FIR_DELAY_LEN(psFIRDescriptor->uiNCoefs);
+            psFIRCtrl->pfDelayW            = FIR_DELAY_WRAP(psFIRCtrl->pfDelayB, psFIRDescriptor->uiNCoefs, uiDecim);
+            psFIRCtrl->uiDelayO            = psFIRDescriptor->uiNCoefs;
+            psFIRCtrl->uiNTaps            = psFIRDescriptor->uiNCoefs;
+        break;
+
+        // Unrecognized type
+        default:
+            return FIR_ERROR;
+    }
+
+    // Check that the inner loop number of taps is supported
+    if((psFIRCtrl->uiNTaps % FIR_FLOAT_N_TAPS_MULT) != 0)
+        return FIR_ERROR;
+
+    // Get converted coefficients
+    psFIRCtrl->pfCoefs            = FIR_float_coefs(psFIRDescriptor->piCoefs, psFIRDescriptor->uiNCoefs, psFIRDescriptor->eType);
+    if(psFIRCtrl->pfCoefs == 0)
+        return FIR_ERROR;
+
+    // Sync the FIR
+    if(FIR_float_sync(psFIRCtrl) != FIR_NO_ERROR)
+        return FIR_ERROR;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_float_sync                                        //
+// Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Syncs the float FIR                                    //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_float_sync(FIRFloatCtrl_t* psFIRCtrl)
+{
+    unsigned int        ui;
+
+    if(psFIRCtrl->eEnable == FIR_ON)
+    {
+        // Set delay line index back to base
+        psFIRCtrl->pfDelayI    = FIR_DELAY_START(psFIRCtrl->pfDelayB, psFIRCtrl->uiDelayO);
+
+        // Clear delay line
+        for(ui = 0; ui < psFIRCtrl->uiDelayL; ui++)
+            psFIRCtrl->pfDelayB[ui]    = FIR_FLOAT_STATE_INIT;
+    }
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_float_proc_os2                                    //
+// Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the float FIR in over-sample by 2 mode    //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_float_proc_os2(FIRFloatCtrl_t* psFIRCtrl)
+{
+    float*            pfIn        = psFIRCtrl->pfIn;
+    unsigned int    uiInStep    = psFIRCtrl->uiInStep;
+    float*            pfOut        = psFIRCtrl->pfOut;
+    unsigned int    uiOutStep    = psFIRCtrl->uiOutStep;
+    float*            pfDelayB    = psFIRCtrl->pfDelayB;
+    float*            pfDelayI    = psFIRCtrl->pfDelayI;
+    float*            pfDelayW    = psFIRCtrl->pfDelayW;
+    unsigned int    uiDelayO    = psFIRCtrl->uiDelayO;
+    float*            pfCoefsB    = psFIRCtrl->pfCoefs;
+    unsigned int    uiNTaps        = psFIRCtrl->uiNTaps;
+    float            fData[2];
+    unsigned        ui;
+
+    for(ui = 0; ui < psFIRCtrl->uiNInSamples; ui++)
+    {
+        // Get new data sample to delay line with step
+        fData[0]                = *pfIn;
+        pfIn                    += uiInStep;
+        FIR_DELAY_WRITE(pfDelayI, uiDelayO, 0, fData[0]);
+        FIR_DELAY_STEP(pfDelayB, pfDelayI, pfDelayW, uiDelayO, 1);
+
+        SRC_MRHF_FIR_OS_FLOAT_INNER_LOOP(FIR_DELAY_DATA(pfDelayI, uiDelayO), pfCoefsB, fData, uiNTaps);
+
+        // Write output with step. NOTE OUTPUT WRITE ORDER: First fData[1], then fData[0] (as fixed point FIR)
+        *pfOut                    = fData[1];
+        pfOut                    += uiOutStep;
+        *pfOut                    = fData[0];
+        pfOut                    += uiOutStep;
+    }
+
+    // Write delay line index back for next round
+    psFIRCtrl->pfDelayI        = pfDelayI;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_float_proc_sync                                    //
+// Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the float FIR in asynchronous mode        //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_float_proc_sync(FIRFloatCtrl_t* psFIRCtrl)
+{
+    float*            pfIn        = psFIRCtrl->pfIn;
+    unsigned int    uiInStep    = psFIRCtrl->uiInStep;
+    float*            pfOut        = psFIRCtrl->pfOut;
+    unsigned int    uiOutStep    = psFIRCtrl->uiOutStep;
+    float*            pfDelayB    = psFIRCtrl->pfDelayB;
+    float*            pfDelayI    = psFIRCtrl->pfDelayI;
+    float*            pfDelayW    = psFIRCtrl->pfDelayW;
+    unsigned int    uiDelayO    = psFIRCtrl->uiDelayO;
+    float*            pfCoefsB    = psFIRCtrl->pfCoefs;
+    unsigned int    uiNTaps        = psFIRCtrl->uiNTaps;
+    float            fData0;
+    unsigned        ui;
+
+    for(ui = 0; ui < psFIRCtrl->uiNInSamples; ui++)
+    {
+        // Get new data sample to delay line with step
+        fData0                    = *pfIn;
+        pfIn                    += uiInStep;
+        FIR_DELAY_WRITE(pfDelayI, uiDelayO, 0, fData0);
+        FIR_DELAY_STEP(pfDelayB, pfDelayI, pfDelayW, uiDelayO, 1);
+
+        SRC_MRHF_FIR_FLOAT_INNER_LOOP(FIR_DELAY_DATA(pfDelayI, uiDelayO), pfCoefsB, &fData0, uiNTaps);
+
+        // Write output with step
+        *pfOut                    = fData0;
+        pfOut                    += uiOutStep;
+    }
+
+    // Write delay line index back for next round
+    psFIRCtrl->pfDelayI        = pfDelayI;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_float_proc_ds2                                    //
+// Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the float FIR in down-sample by 2 mode    //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_float_proc_ds2(FIRFloatCtrl_t* psFIRCtrl)
+{
+    float*            pfIn        = psFIRCtrl->pfIn;
+    unsigned int    uiInStep    = psFIRCtrl->uiInStep;
+    float*            pfOut        = psFIRCtrl->pfOut;
+    unsigned int    uiOutStep    = psFIRCtrl->uiOutStep;
+    float*            pfDelayB    = psFIRCtrl->pfDelayB;
+    float*            pfDelayI    = psFIRCtrl->pfDelayI;
+    float*            pfDelayW    = psFIRCtrl->pfDelayW;
+    unsigned int    uiDelayO    = psFIRCtrl->uiDelayO;
+    float*            pfCoefsB    = psFIRCtrl->pfCoefs;
+    unsigned int    uiNTaps        = psFIRCtrl->uiNTaps;
+    float            fData0, fData1;
+    unsigned        ui;
+
+    for(ui = 0; ui < psFIRCtrl->uiNInSamples>>1; ui++)
+    {
+        // Get two new data samples to delay line with step
+        fData0                    = *pfIn;
+        pfIn                    += uiInStep;
+        fData1                    = *pfIn;
+        pfIn                    += uiInStep;
+        FIR_DELAY_WRITE(pfDelayI, uiDelayO, 0, fData0);
+        FIR_DELAY_WRITE(pfDelayI, uiDelayO, 1, fData1);
+        FIR_DELAY_STEP(pfDelayB, pfDelayI, pfDelayW, uiDelayO, 2);
+
+        SRC_MRHF_FIR_FLOAT_INNER_LOOP(FIR_DELAY_DATA(pfDelayI, uiDelayO), pfCoefsB, &fData0, uiNTaps);
+
+        // Write output with step
+        *pfOut                    = fData0;
+        pfOut                    += uiOutStep;
+    }
+
+    // Write delay line index back for next round
+    psFIRCtrl->pfDelayI        = pfDelayI;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        FIR_float_proc_dsn                                    //
+// Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the float FIR in down-sample by 4, 8 or 16//
+//                    mode                                                //
+// ==================================================================== //
+FIRReturnCodes_t                FIR_float_proc_dsn(FIRFloatCtrl_t* psFIRCtrl)
+{
+    float*            pfIn        = psFIRCtrl->pfIn;
+    unsigned int    uiInStep    = psFIRCtrl->uiInStep;
+    float*            pfOut        = psFIRCtrl->pfOut;
+    unsigned int    uiOutStep    = psFIRCtrl->uiOutStep;
+    float*            pfDelayB    = psFIRCtrl->pfDelayB;
+    float*            pfDelayI    = psFIRCtrl->pfDelayI;
+    float*            pfDelayW    = psFIRCtrl->pfDelayW;
+    unsigned int    uiDelayO    = psFIRCtrl->uiDelayO;
+    float*            pfCoefsB    = psFIRCtrl->pfCoefs;
+    unsigned int    uiNTaps        = psFIRCtrl->uiNTaps;
+    unsigned int    uiDecim        = psFIRCtrl->uiNInSamples / psFIRCtrl->uiNOutSamples;
+    float            fData0;
+    unsigned        ui, uk;
+
+    for(ui = 0; ui < psFIRCtrl->uiNOutSamples; ui++)
+    {
+        // Get uiDecim new data samples to delay line with step
+        for(uk = 0; uk < uiDecim; uk++)
+        {
+            FIR_DELAY_WRITE(pfDelayI, uiDelayO, uk, *pfIn);
+            pfIn                += uiInStep;
+        }
+        FIR_DELAY_STEP(pfDelayB, pfDelayI, pfDelayW, uiDelayO, uiDecim);
+
+        SRC_MRHF_FIR_FLOAT_INNER_LOOP(FIR_DELAY_DATA(pfDelayI, uiDelayO), pfCoefsB, &fData0, uiNTaps);
+
+        // Write output with step
+        *pfOut                    = fData0;
+        pfOut                    += uiOutStep;
+    }
+
+    // Write delay line index back for next round
+    psFIRCtrl->pfDelayI        = pfDelayI;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ADFIR_float_init_from_desc                            //
+// Arguments:        ADFIRFloatCtrl_t *psADFIRCtrl: Ctrl strct.            //
+//                    ADFIRDescriptor_t *psADFIRDescriptor: Desc. strct.    //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Inits the float ADFIR from the Descriptor, converting//
+//                    the fixed point phases to float once                //
+// ==================================================================== //
+FIRReturnCodes_t                ADFIR_float_init_from_desc(ADFIRFloatCtrl_t* psADFIRCtrl, ADFIRDescriptor_t* psADFIRDescriptor)
+{
+    unsigned int        uiPhaseLength;
+
+    // Check that delay line base has been set
+    if(psADFIRCtrl->pfDelayB == 0)
+        return FIR_ERROR;
+
+    // Check that adaptive coefs buffer has been set
+    if(psADFIRCtrl->pfADCoefs == 0)
+        return FIR_ERROR;
+
+    // Check that number of phases and number of coefficients per phase are set and supported
+    if(psADFIRDescriptor->uiNPhases == 0)
+        return FIR_ERROR;
+    if(psADFIRDescriptor->uiNCoefsPerPhase == 0)
+        return FIR_ERROR;
+    if((psADFIRDescriptor->uiNCoefsPerPhase % FIR_FLOAT_N_TAPS_MULT) != 0)
+        return FIR_ERROR;
+
+    uiPhaseLength                    = psADFIRDescriptor->uiNCoefsPerPhase;
+    // Setup ADFIR
+    psADFIRCtrl->uiDelayL            = FIR_DELAY_LEN(uiPhaseLength);
+    psADFIRCtrl->pfDelayW            = FIR_DELAY_WRAP(psADFIRCtrl->pfDelayB, uiPhaseLength, 1);
+    psADFIRCtrl->uiDelayO            = uiPhaseLength;
+    psADFIRCtrl->uiNTaps            = uiPhaseLength;
+    psADFIRCtrl->pfCoefs            = FIR_float_coefs(psADFIRDescriptor->piCoefs, uiPhaseLength * psADFIRDescriptor->uiNPhases, FIR_TYPE_SYNC);
+    if(psADFIRCtrl->pfCoefs == 0)
+        return FIR_ERROR;
+
+    // Sync the ADFIR
+    if(ADFIR_float_sync(psADFIRCtrl) != FIR_NO_ERROR)
+        return FIR_ERROR;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ADFIR_float_sync                                    //
+// Arguments:        ADFIRFloatCtrl_t *psADFIRCtrl: Ctrl strct.            //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Syncs the float ADFIR                                //
+// ==================================================================== //
+FIRReturnCodes_t                ADFIR_float_sync(ADFIRFloatCtrl_t* psADFIRCtrl)
+{
+    unsigned int        ui;
+
+    // Set delay line index back to base
+    psADFIRCtrl->pfDelayI    = FIR_DELAY_START(psADFIRCtrl->pfDelayB, psADFIRCtrl->uiDelayO);
+
+    // Clear delay line
+    for(ui = 0; ui < psADFIRCtrl->uiDelayL; ui++)
+        psADFIRCtrl->pfDelayB[ui]    = FIR_FLOAT_STATE_INIT;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ADFIR_float_proc_in_spl                                //
+// Arguments:        ADFIRFloatCtrl_t *psADFIRCtrl: Ctrl strct.            //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Gets new input sample to delay line                    //
+// ==================================================================== //
+FIRReturnCodes_t                ADFIR_float_proc_in_spl(ADFIRFloatCtrl_t* psADFIRCtrl)
+{
+    FIR_DELAY_WRITE(psADFIRCtrl->pfDelayI, psADFIRCtrl->uiDelayO, 0, psADFIRCtrl->fIn);
+    FIR_DELAY_STEP(psADFIRCtrl->pfDelayB, psADFIRCtrl->pfDelayI, psADFIRCtrl->pfDelayW, psADFIRCtrl->uiDelayO, 1);
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ADFIR_float_proc_spline                                //
+// Arguments:        ADFIRFloatCtrl_t *psADFIRCtrl: Ctrl strct.            //
+//                    int iPhase: first of the three phases                //
+//                    float fAlpha: fractional time (0.0 to 1.0)            //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Computes the adaptive coefficients by spline        //
+//                    interpolation of three consecutive phases            //
+// ==================================================================== //
+FIRReturnCodes_t                ADFIR_float_proc_spline(ADFIRFloatCtrl_t* psADFIRCtrl, int iPhase, float fAlpha)
+{
+    unsigned int    uiNTaps        = psADFIRCtrl->uiNTaps;
+    float*            pfPhase0    = psADFIRCtrl->pfCoefs + iPhase * uiNTaps;
+    float*            pfPhase1    = pfPhase0 + uiNTaps;
+    float*            pfPhase2    = pfPhase1 + uiNTaps;
+    float*            pfADCoefs    = psADFIRCtrl->pfADCoefs;
+    float            fH0, fH1, fH2;
+    unsigned int    ui;
+
+    // Spline factors (same as fixed point ASRC_proc_F3_time)
+    fH0                = 0.5f * fAlpha * fAlpha;                // H0 = 0.5 * alpha * alpha
+    fH1                = 0.5f + fAlpha - 2.0f * fH0;            // H1 = 0.5 + alpha - alpha * alpha
+    fH2                = 0.5f - fAlpha + fH0;                    // H2 = 0.5 - alpha + 0.5 * alpha * alpha
+
+    for(ui = 0; ui < uiNTaps; ui++)
+        pfADCoefs[ui]    = fH2 * pfPhase0[ui] + fH1 * pfPhase1[ui] + fH0 * pfPhase2[ui];
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        ADFIR_float_proc_macc                                //
+// Arguments:        ADFIRFloatCtrl_t *psADFIRCtrl: Ctrl strct.            //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the macc loop for the float ADFIR            //
+// ==================================================================== //
+FIRReturnCodes_t                ADFIR_float_proc_macc(ADFIRFloatCtrl_t* psADFIRCtrl)
+{
+    SRC_MRHF_FIR_FLOAT_INNER_LOOP(FIR_DELAY_DATA(psADFIRCtrl->pfDelayI, psADFIRCtrl->uiDelayO), psADFIRCtrl->pfADCoefs,
+        psADFIRCtrl->pfOut, psADFIRCtrl->uiNTaps);
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        PPFIR_float_init_from_desc                            //
+// Arguments:        PPFIRFloatCtrl_t *psPPFIRCtrl: Ctrl strct.            //
+//                    PPFIRDescriptor_t *psPPFIRDescriptor: Desc. strct.    //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Inits the float PPFIR from the Descriptor            //
+// ==================================================================== //
+FIRReturnCodes_t                PPFIR_float_init_from_desc(PPFIRFloatCtrl_t* psPPFIRCtrl, PPFIRDescriptor_t* psPPFIRDescriptor)
+{
+    unsigned int        uiPhaseLength;
+
+    // Check if PPFIR is disabled (this is given by the number of coefficients being zero)
+    if( psPPFIRDescriptor->uiNCoefs == 0)
+    {
+        // Number of coefficients is zero, so disable PPFIR
+        psPPFIRCtrl->eEnable            = FIR_OFF;
+        psPPFIRCtrl->uiNOutSamples        = 0;
+        psPPFIRCtrl->uiDelayL            = 0;
+        psPPFIRCtrl->pfDelayW            = 0;
+        psPPFIRCtrl->uiDelayO            = 0;
+        psPPFIRCtrl->uiNTaps            = 0;
+        psPPFIRCtrl->uiNCoefs            = 0;
+        psPPFIRCtrl->pfCoefs            = 0;
+        psPPFIRCtrl->uiPhaseStep        = 0;
+        psPPFIRCtrl->uiCoefsPhaseStep    = 0;
+        psPPFIRCtrl->uiCoefsPhase        = 0;
+        return FIR_NO_ERROR;
+    }
+
+    // Check that delay line base has been set
+    if(psPPFIRCtrl->pfDelayB == 0)
+        return FIR_ERROR;
+
+    // Check that number of samples has been set
+    if(psPPFIRCtrl->uiNInSamples == 0)
+        return FIR_ERROR;
+
+    // Check the input and output samples steps have been set
+    if(psPPFIRCtrl->uiInStep == 0)
+        return FIR_ERROR;
+    if(psPPFIRCtrl->uiOutStep == 0)
+        return FIR_ERROR;
+
+    // Check that phase step has been set properly
+    if(psPPFIRCtrl->uiPhaseStep == 0)
+        return FIR_ERROR;
+
+    // Check that number of phases and number of coefficients are compatible
+    uiPhaseLength                    = (psPPFIRDescriptor->uiNCoefs / psPPFIRDescriptor->uiNPhases);
+    if(uiPhaseLength == 0)
+        return FIR_ERROR;
+    if((uiPhaseLength * psPPFIRDescriptor->uiNPhases) != psPPFIRDescriptor->uiNCoefs)
+        return FIR_ERROR;
+    if((uiPhaseLength % FIR_FLOAT_N_TAPS_MULT) != 0)
+        return FIR_ERROR;
+
+    // Setup PPFIR
+    psPPFIRCtrl->eEnable            = FIR_ON;
+    psPPFIRCtrl->uiDelayL            = FIR_DELAY_LEN(uiPhaseLength);
+    psPPFIRCtrl->pfDelayW            = FIR_DELAY_WRAP(psPPFIRCtrl->pfDelayB, uiPhaseLength, 1);
+    psPPFIRCtrl->uiDelayO            = uiPhaseLength;
+    psPPFIRCtrl->uiNTaps            = uiPhaseLength;
+    psPPFIRCtrl->uiNCoefs            = psPPFIRDescriptor->uiNCoefs;
+    psPPFIRCtrl->pfCoefs            = FIR_float_coefs(psPPFIRDescriptor->piCoefs, psPPFIRDescriptor->uiNCoefs, FIR_TYPE_SYNC);
+    psPPFIRCtrl->uiCoefsPhaseStep    = psPPFIRCtrl->uiPhaseStep * uiPhaseLength;            // Length (number of coefs) of a phase step
+    if(psPPFIRCtrl->pfCoefs == 0)
+        return FIR_ERROR;
+
+    // Sync the PPFIR
+    if(PPFIR_float_sync(psPPFIRCtrl) != FIR_NO_ERROR)
+        return FIR_ERROR;
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        PPFIR_float_sync                                    //
+// Arguments:        PPFIRFloatCtrl_t *psPPFIRCtrl: Ctrl strct.            //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Syncs the float PPFIR polyphase filter                //
+// ==================================================================== //
+FIRReturnCodes_t                PPFIR_float_sync(PPFIRFloatCtrl_t* psPPFIRCtrl)
+{
+    unsigned int        ui;
+
+    if(psPPFIRCtrl->eEnable == FIR_ON)
+    {
+        // Set delay line index back to base
+        psPPFIRCtrl->pfDelayI    = FIR_DELAY_START(psPPFIRCtrl->pfDelayB, psPPFIRCtrl->uiDelayO);
+
+        // Clear delay line
+        for(ui = 0; ui < psPPFIRCtrl->uiDelayL; ui++)
+            psPPFIRCtrl->pfDelayB[ui]    = FIR_FLOAT_STATE_INIT;
+
+        // Set coefficients phase to zero
+        psPPFIRCtrl->uiCoefsPhase        = 0;
+
+        // Clear number of output sampes
+        psPPFIRCtrl->uiNOutSamples        = 0;
+    }
+
+    return FIR_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        PPFIR_float_proc                                    //
+// Arguments:        PPFIRFloatCtrl_t *psPPFIRCtrl: Ctrl strct.            //
+// Return values:    FIR_NO_ERROR on success                                //
+//                    FIR_ERROR on failure                                //
+// Description:        Processes the float PPFIR polyphase filter            //
+// ==================================================================== //
+FIRReturnCodes_t                PPFIR_float_proc(PPFIRFloatCtrl_t* psPPFIRCtrl)
+{
+    float*            pfIn                = psPPFIRCtrl->pfIn;
+    unsigned int    uiInStep            = psPPFIRCtrl->uiInStep;
+    float*            pfOut                = psPPFIRCtrl->pfOut;
+    unsigned int    uiOutStep            = psPPFIRCtrl->uiOutStep;
+    float*            pfDelayB            = psPPFIRCtrl->pfDelayB;
+    float*            pfDelayI            = psPPFIRCtrl->pfDelayI;
+    float*            pfDelayW            = psPPFIRCtrl->pfDelayW;
+    unsigned int    uiDelayO            = psPPFIRCtrl->uiDelayO;
+    float*            pfCoefsB            = psPPFIRCtrl->pfCoefs;
+    unsigned int    uiNTaps                = psPPFIRCtrl->uiNTaps;
+    unsigned int    uiNCoefs            = psPPFIRCtrl->uiNCoefs;
+    unsigned int    uiCoefsPhase        = psPPFIRCtrl->uiCoefsPhase;
+    unsigned int    uiCoefsPhaseStep    = psPPFIRCtrl->uiCoefsPhaseStep;
+    float            fData;
+    unsigned int    uiNOutSamples        = 0;
+    unsigned        ui;
+
+    for(ui = 0; ui < psPPFIRCtrl->uiNInSamples; ui++)
+    {
+        // Get new data sample to delay line with step
+        fData                    = *pfIn;
+        pfIn                    += uiInStep;
+        FIR_DELAY_WRITE(pfDelayI, uiDelayO, 0, fData);
+        FIR_DELAY_STEP(pfDelayB, pfDelayI, pfDelayW, uiDelayO, 1);
+
+        // Do while the current phase coefficient pointer points to phase coefficients
+        // This is equivalent to know if the output sample is between the current and next input sample
+        while(uiCoefsPhase < uiNCoefs)
+        {
+            SRC_MRHF_FIR_FLOAT_INNER_LOOP(FIR_DELAY_DATA(pfDelayI, uiDelayO), pfCoefsB + uiCoefsPhase, &fData, uiNTaps);
+
+            // Write output with step
+            *pfOut                = fData;
+            pfOut                += uiOutStep;
+
+            // Step phase coefficient offset for next output phase
+            uiCoefsPhase        += uiCoefsPhaseStep;
+
+            // Increase output sample counter
+            uiNOutSamples++;
+        }
+
+        // Reduce phase for next input sample (one input sample corresponds to all coefficients in the PP filter)
+        uiCoefsPhase            -= uiNCoefs;
+    }
+
+    // Write delay line index back for next round
+    psPPFIRCtrl->pfDelayI        = pfDelayI;
+    // Write coefs phase back for next round
+    psPPFIRCtrl->uiCoefsPhase    = uiCoefsPhase;
+    // Write number of samples
+    psPPFIRCtrl->uiNOutSamples    = uiNOutSamples;
+
+    return FIR_NO_ERROR;
+}
+
+#endif // FIR_FLOAT
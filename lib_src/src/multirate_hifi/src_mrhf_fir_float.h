@@ -0,0 +1,300 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Single precision floating point FIR definition file for the SRC
+//
+// Float versions of the FIR (F1, F2), PPFIR (SSRC F3) and ADFIR (ASRC F3)
+// filters, used by the float SSRC and ASRC. They are initialised from the
+// same descriptors as the fixed point filters: the coefficients are
+// converted to float (scaled by 2^-31 so full scale is +/-1.0) once, on first
+// use, and shared by all instances (see FIR_float_coefs). Over-sampler by 2
+// coefficients are stored as two contiguous phases rather than interleaved,
+// so all inner loops are plain dot products (SRC_MRHF_FIR_FLOAT_INNER_LOOP).
+//
+// There is no saturation: samples beyond full scale pass through the
+// filters unchanged in scale. Host builds only (FIR_FLOAT).
+//
+// ===========================================================================
+// ===========================================================================
+
+#ifndef _SRC_MRHF_FIR_FLOAT_H_
+#define _SRC_MRHF_FIR_FLOAT_H_
+
+    // ===========================================================================
+    //
+    // Includes
+    //
+    // ===========================================================================
+    #include "src_mrhf_fir.h"
+    #include "src_mrhf_filter_defs.h"
+
+#if FIR_FLOAT
+
+    // ===========================================================================
+    //
+    // Defines
+    //
+    // ===========================================================================
+
+    // General defines
+    // ---------------
+    #define        FIR_FLOAT_SCALE                        (1.0f / 2147483648.0f)        // Fixed point (1.31) to float scale
+    #define        FIR_FLOAT_N_TAPS_MULT                8                            // Inner loop number of taps must be a multiple of this
+    // Converted coefficients storage length: all FIR tables (twice, as a table can be used both as
+    // over-sampler by 2 and as another type), PPFIR tables and ADFIR phases
+#if SRC_ARBITRARY_FS
+    #define        FIR_FLOAT_MAX_TABLES                48                            // Maximum number of converted coefficient tables
+    #define        FIR_FLOAT_ARBITRARY_FS_N_TAPS        (FILTER_DEFS_FIR_DS4_N_TAPS + FILTER_DEFS_FIR_BL5016_N_TAPS + FILTER_DEFS_FIR_BL4816_N_TAPS + \
+                                                        FILTER_DEFS_FIR_BL4416_N_TAPS + FILTER_DEFS_FIR_BL3716_N_TAPS + FILTER_DEFS_FIR_UP5032_N_TAPS + \
+                                                        FILTER_DEFS_FIR_UP4832_N_TAPS + FILTER_DEFS_FIR_UP4432_N_TAPS + FILTER_DEFS_FIR_UP3732_N_TAPS + \
+                                                        FILTER_DEFS_FIR_DS8_N_TAPS + FILTER_DEFS_FIR_DS16_N_TAPS)
+#else
+    #define        FIR_FLOAT_MAX_TABLES                32                            // Maximum number of converted coefficient tables
+    #define        FIR_FLOAT_ARBITRARY_FS_N_TAPS        0
+#endif
+    #define        FIR_FLOAT_COEFS_LEN                    (2 * (FILTER_DEFS_FIR_BL_N_TAPS + FILTER_DEFS_FIR_BL9644_N_TAPS + FILTER_DEFS_FIR_BL8848_N_TAPS + \
+                                                        FILTER_DEFS_FIR_BLF_N_TAPS + FILTER_DEFS_FIR_BL19288_N_TAPS + FILTER_DEFS_FIR_BL17696_N_TAPS + \
+                                                        FILTER_DEFS_FIR_UP_N_TAPS + FILTER_DEFS_FIR_UP4844_N_TAPS + FILTER_DEFS_FIR_UPF_N_TAPS + \
+                                                        FILTER_DEFS_FIR_UP192176_N_TAPS + FILTER_DEFS_FIR_DS_N_TAPS + FILTER_DEFS_FIR_OS_N_TAPS + \
+                                                        FIR_FLOAT_ARBITRARY_FS_N_TAPS) + \
+                                                        FILTER_DEFS_PPFIR_HS294_N_TAPS + FILTER_DEFS_PPFIR_HS320_N_TAPS + FILTER_DEFS_ADFIR_N_TAPS)
+
+
+    // ===========================================================================
+    //
+    // TypeDefs
+    //
+    // ===========================================================================
+
+    // To avoid C type definitions when including this file from assembler
+    #ifndef INCLUDE_FROM_ASM
+
+        // Float FIR Ctrl
+        // --------------
+        typedef struct _FIRFloatCtrl
+        {
+            FIROnOffCodes_t                            eEnable;        // FIR on/off
+
+            float*                                    pfIn;            // Pointer to input data
+            unsigned int                            uiNInSamples;    // Number of input samples to process
+            unsigned int                            uiInStep;        // Step between input data samples
+            float*                                    pfOut;            // Pointer to output data
+            unsigned int                            uiNOutSamples;    // Number of output samples produced
+            unsigned int                            uiOutStep;        // Step between output data samples
+
+            FIRReturnCodes_t                        (*pvProc)(struct _FIRFloatCtrl*);    // Processing function address
+
+            float*                                    pfDelayB;        // Pointer to delay line base
+            unsigned int                            uiDelayL;        // Total length of delay line
+            float*                                    pfDelayI;        // Pointer to current position in delay line
+            float*                                    pfDelayW;        // Delay buffer wrap around address
+            unsigned int                            uiDelayO;        // Delay line length in samples (offset for second write with circular buffer simulation)
+
+            unsigned int                            uiNTaps;        // Number of taps per inner loop call (per phase for over-sampler by 2)
+            float*                                    pfCoefs;        // Pointer to coefficients (converted, see FIR_float_coefs)
+        } FIRFloatCtrl_t;
+
+        // Float ADFIR Ctrl
+        // ----------------
+        typedef struct _ADFIRFloatCtrl
+        {
+            float                                    fIn;                // Input sample
+            float*                                    pfOut;                // Pointer to output sample
+
+            float*                                    pfDelayB;            // Pointer to delay line base
+            unsigned int                            uiDelayL;            // Total length of delay line
+            float*                                    pfDelayI;            // Pointer to current position in delay line
+            float*                                    pfDelayW;            // Delay buffer wrap around address
+            unsigned int                            uiDelayO;            // Delay line length in samples (offset for second write with circular buffer simulation)
+
+            unsigned int                            uiNTaps;            // Number of taps
+            float*                                    pfCoefs;            // Pointer to phases coefficients (converted, see FIR_float_coefs)
+            float*                                    pfADCoefs;            // Pointer to adaptive coefficients
+        } ADFIRFloatCtrl_t;
+
+        // Float PPFIR Ctrl
+        // ----------------
+        typedef struct _PPFIRFloatCtrl
+        {
+            FIROnOffCodes_t                            eEnable;        // PPFIR on/off
+
+            float*                                    pfIn;                // Pointer to input data
+            unsigned int                            uiNInSamples;        // Number of input samples to process
+            unsigned int                            uiInStep;            // Step between input data samples
+            float*                                    pfOut;                // Pointer to output data
+            unsigned int                            uiNOutSamples;        // Number of output samples produced
+            unsigned int                            uiOutStep;            // Step between output data samples
+
+            float*                                    pfDelayB;            // Pointer to delay line base
+            unsigned int                            uiDelayL;            // Total length of delay line
+            float*                                    pfDelayI;            // Pointer to current position in delay line
+            float*                                    pfDelayW;            // Delay buffer wrap around address
+            unsigned int                            uiDelayO;            // Delay line length in samples (offset for second write with circular buffer simulation)
+
+            unsigned int                            uiNTaps;            // Number of taps per phase
+            unsigned int                            uiNCoefs;            // Number of coefficients
+            float*                                    pfCoefs;            // Pointer to coefficients (converted, see FIR_float_coefs)
+            unsigned int                            uiPhaseStep;        // Phase step
+            unsigned int                            uiCoefsPhaseStep;    // Number of coefficients for a phase step
+            unsigned int                            uiCoefsPhase;        // Current phase coefficient offset from base
+        } PPFIRFloatCtrl_t;
+
+
+        // ===========================================================================
+        //
+        // Function prototypes
+        //
+        // ===========================================================================
+
+        // ==================================================================== //
+        // Function:        FIR_float_coefs                                        //
+        // Arguments:        int *piCoefs: fixed point coefficients                //
+        //                    unsigned int uiNCoefs: number of coefficients        //
+        //                    FIRTypeCodes_t eType: FIR type (FIR_TYPE_OS2        //
+        //                    stores the two phases contiguously)                    //
+        // Return values:    Pointer to float coefficients, 0 on failure            //
+        // Description:        Converts coefficients to float on first call for    //
+        //                    a table, returns the same copy on later calls        //
+        // ==================================================================== //
+        float*                            FIR_float_coefs(int* piCoefs, unsigned int uiNCoefs, FIRTypeCodes_t eType);
+
+        // ==================================================================== //
+        // Function:        FIR_float_init_from_desc                            //
+        // Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+        //                    FIRDescriptor_t *psFIRDescriptor: Desc. strct.        //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Inits the float FIR from the Descriptor                //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_float_init_from_desc(FIRFloatCtrl_t* psFIRCtrl, FIRDescriptor_t* psFIRDescriptor);
+
+        // ==================================================================== //
+        // Function:        FIR_float_sync                                        //
+        // Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Syncs the float FIR                                    //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_float_sync(FIRFloatCtrl_t* psFIRCtrl);
+
+        // ==================================================================== //
+        // Function:        FIR_float_proc_os2                                    //
+        // Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Processes the float FIR in over-sample by 2 mode    //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_float_proc_os2(FIRFloatCtrl_t* psFIRCtrl);
+
+        // ==================================================================== //
+        // Function:        FIR_float_proc_sync                                    //
+        // Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Processes the float FIR in asynchronous mode        //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_float_proc_sync(FIRFloatCtrl_t* psFIRCtrl);
+
+        // ==================================================================== //
+        // Function:        FIR_float_proc_ds2                                    //
+        // Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Processes the float FIR in down-sample by 2 mode    //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_float_proc_ds2(FIRFloatCtrl_t* psFIRCtrl);
+
+        // ==================================================================== //
+        // Function:        FIR_float_proc_dsn                                    //
+        // Arguments:        FIRFloatCtrl_t *psFIRCtrl: Ctrl strct.                //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Processes the float FIR in down-sample by 4, 8 or 16//
+        //                    mode                                                //
+        // ==================================================================== //
+        FIRReturnCodes_t                FIR_float_proc_dsn(FIRFloatCtrl_t* psFIRCtrl);
+
+        // ==================================================================== //
+        // Function:        ADFIR_float_init_from_desc                            //
+        // Arguments:        ADFIRFloatCtrl_t *psADFIRCtrl: Ctrl strct.            //
+        //                    ADFIRDescriptor_t *psADFIRDescriptor: Desc. strct.    //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Inits the float ADFIR from the Descriptor, converting//
+        //                    the fixed point phases to float once                //
+        // ==================================================================== //
+        FIRReturnCodes_t                ADFIR_float_init_from_desc(ADFIRFloatCtrl_t* psADFIRCtrl, ADFIRDescriptor_t* psADFIRDescriptor);
+
+        // ==================================================================== //
+        // Function:        ADFIR_float_sync                                    //
+        // Arguments:        ADFIRFloatCtrl_t *psADFIRCtrl: Ctrl strct.            //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Syncs the float ADFIR                                //
+        // ==================================================================== //
+        FIRReturnCodes_t                ADFIR_float_sync(ADFIRFloatCtrl_t* psADFIRCtrl);
+
+        // ==================================================================== //
+        // Function:        ADFIR_float_proc_in_spl                                //
+        // Arguments:        ADFIRFloatCtrl_t *psADFIRCtrl: Ctrl strct.            //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Gets new input sample to delay line                    //
+        // ==================================================================== //
+        FIRReturnCodes_t                ADFIR_float_proc_in_spl(ADFIRFloatCtrl_t* psADFIRCtrl);
+
+        // ==================================================================== //
+        // Function:        ADFIR_float_proc_spline                                //
+        // Arguments:        ADFIRFloatCtrl_t *psADFIRCtrl: Ctrl strct.            //
+        //                    int iPhase: first of the three phases                //
+        //                    float fAlpha: fractional time (0.0 to 1.0)            //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Computes the adaptive coefficients by spline        //
+        //                    interpolation of three consecutive phases            //
+        // ==================================================================== //
+        FIRReturnCodes_t                ADFIR_float_proc_spline(ADFIRFloatCtrl_t* psADFIRCtrl, int iPhase, float fAlpha);
+
+        // ==================================================================== //
+        // Function:        ADFIR_float_proc_macc                                //
+        // Arguments:        ADFIRFloatCtrl_t *psADFIRCtrl: Ctrl strct.            //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Processes the macc loop for the float ADFIR            //
+        // ==================================================================== //
+        FIRReturnCodes_t                ADFIR_float_proc_macc(ADFIRFloatCtrl_t* psADFIRCtrl);
+
+        // ==================================================================== //
+        // Function:        PPFIR_float_init_from_desc                            //
+        // Arguments:        PPFIRFloatCtrl_t *psPPFIRCtrl: Ctrl strct.            //
+        //                    PPFIRDescriptor_t *psPPFIRDescriptor: Desc. strct.    //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Inits the float PPFIR from the Descriptor            //
+        // ==================================================================== //
+        FIRReturnCodes_t                PPFIR_float_init_from_desc(PPFIRFloatCtrl_t* psPPFIRCtrl, PPFIRDescriptor_t* psPPFIRDescriptor);
+
+        // ==================================================================== //
+        // Function:        PPFIR_float_sync                                    //
+        // Arguments:        PPFIRFloatCtrl_t *psPPFIRCtrl: Ctrl strct.            //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Syncs the float PPFIR polyphase filter                //
+        // ==================================================================== //
+        FIRReturnCodes_t                PPFIR_float_sync(PPFIRFloatCtrl_t* psPPFIRCtrl);
+
+        // ==================================================================== //
+        // Function:        PPFIR_float_proc                                    //
+        // Arguments:        PPFIRFloatCtrl_t *psPPFIRCtrl: Ctrl strct.            //
+        // Return values:    FIR_NO_ERROR on success                                //
+        //                    FIR_ERROR on failure                                //
+        // Description:        Processes the float PPFIR polyphase filter            //
+        // ==================================================================== //
+        FIRReturnCodes_t                PPFIR_float_proc(PPFIRFloatCtrl_t* psPPFIRCtrl);
+
+    #endif // nINCLUDE_FROM_ASM
+
+#endif // FIR_FLOAT
+
+#endif // _SRC_MRHF_FIR_FLOAT_H_
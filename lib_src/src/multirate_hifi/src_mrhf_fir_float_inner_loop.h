@@ -0,0 +1,20 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+#ifndef _SRC_MRHF_FIR_FLOAT_INNER_LOOP_H_
+#define _SRC_MRHF_FIR_FLOAT_INNER_LOOP_H_
+
+// Single precision dot product shared by the float inner loops (src_mrhf_fir_float_inner_loops.c
+// and src_kernels_x86.c). Eight partial sums, one per lane, so the compiler can vectorise the
+// loop (and use FMA where enabled) without reassociating the additions. n_taps is a multiple of 8.
+static inline float src_mrhf_fir_float_dot(const float *pfData, const float *pfCoefs, int n_taps)
+{
+    float   fAcc[8] = {0};
+    int     i, k;
+
+    for (i = 0; i < n_taps; i += 8)
+        for (k = 0; k < 8; k++)
+            fAcc[k] += pfData[i + k] * pfCoefs[i + k];
+
+    return ((fAcc[0] + fAcc[4]) + (fAcc[1] + fAcc[5])) + ((fAcc[2] + fAcc[6]) + (fAcc[3] + fAcc[7]));
+}
+
+#endif // _SRC_MRHF_FIR_FLOAT_INNER_LOOP_H_
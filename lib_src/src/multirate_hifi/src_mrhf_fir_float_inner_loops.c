@@ -0,0 +1,66 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Portable C single precision inner loops for the float SRC (FIR_FLOAT)
+//
+// Same loops as the x86 versions in src_kernels_x86.c, which are this code
+// compiled for SSE4.1 and AVX2 + FMA. Host builds only.
+//
+// ===========================================================================
+// ===========================================================================
+
+#if !defined(__xcore__)
+
+// ===========================================================================
+//
+// Includes
+//
+// ===========================================================================
+#include <stdlib.h>
+#include <stdio.h>
+
+// Inner loop kernel prototypes
+#include "src_kernels.h"
+#include "src_mrhf_fir_float_inner_loop.h"
+
+// ===========================================================================
+//
+// Functions implementations
+//
+// ===========================================================================
+
+// ==================================================================== //
+// Function:        src_mrhf_fir_float_inner_loop_c                        //
+// Arguments:        const float *pfData: pointer to oldest delay line    //
+//                    sample                                            //
+//                    const float *pfCoefs: pointer to coefficients        //
+//                    float fData[]: output (1 sample)                    //
+//                    int n_taps: number of taps (multiple of 8)            //
+// Return values:    None                                                //
+// Description:        Single precision FIR dot product                    //
+// ==================================================================== //
+void src_mrhf_fir_float_inner_loop_c(const float *pfData, const float *pfCoefs, float fData[], int n_taps)
+{
+    fData[0]    = src_mrhf_fir_float_dot(pfData, pfCoefs, n_taps);
+}
+
+// ==================================================================== //
+// Function:        src_mrhf_fir_os_float_inner_loop_c                    //
+// Arguments:        const float *pfData: pointer to oldest delay line    //
+//                    sample                                            //
+//                    const float *pfCoefs: pointer to coefficients of    //
+//                    phase 0 followed by phase 1 (n_taps each)            //
+//                    float fData[]: output (2 samples)                    //
+//                    int n_taps: number of taps per phase (multiple of 8)//
+// Return values:    None                                                //
+// Description:        Two phase FIR for the x2 over-sampler. Phase 0 gives //
+//                    fData[0], phase 1 gives fData[1]                    //
+// ==================================================================== //
+void src_mrhf_fir_os_float_inner_loop_c(const float *pfData, const float *pfCoefs, float fData[], int n_taps)
+{
+    fData[0]    = src_mrhf_fir_float_dot(pfData, pfCoefs, n_taps);
+    fData[1]    = src_mrhf_fir_float_dot(pfData, pfCoefs + n_taps, n_taps);
+}
+
+#endif // !__xcore__
@@ -0,0 +1,44 @@
+#!/usr/bin/env python
+# Copyright (c) 2016, XMOS Ltd, All rights reserved
+#
+# Generates FilterData/<name>Half.dat, the first half of the coefficients of
+# the over-sample by 2 FIR filters, read by the folded OS2 inner loop of host
+# builds (FIR_FOLD_SYMMETRIC, see src_mrhf_fir.h) in place of the full tables.
+#
+# The prototypes are symmetric (linear phase), so in the interleaved table of
+# an OS2 filter the odd phase is the even phase reversed: the first half of the
+# table holds both phases. The full tables stay in use by the xCORE assembler,
+# the SIMD and multichannel inner loops, the float converters and the fast
+# convolution.
+import os.path
+import re
+
+FILTERS = ["UP", "UP4844", "UPF", "UP192176", "OS", "UP5032", "UP4832", "UP4432", "UP3732"]
+
+HEADER = """\
+/* This file is generated using src_mrhf_fir_half_coefs_generator.py
+ *
+ * Do not modify it directly, changes may be overwritten!
+ */
+"""
+
+
+def read_coefs(path):
+    with open(path) as f:
+        text = re.sub(r"/\*.*?\*/", "", f.read(), flags=re.S)
+    return [int(v) for v in text.replace(",", " ").split()]
+
+
+def write_coefs(path, coefs):
+    with open(path, "w") as f:
+        f.write(HEADER)
+        for c in coefs:
+            f.write("   %d,\n" % c)
+
+
+if __name__ == "__main__":
+    filter_data = os.path.join(os.path.dirname(os.path.realpath(__file__)), "FilterData")
+    for name in FILTERS:
+        coefs = read_coefs(os.path.join(filter_data, name + ".dat"))
+        assert len(coefs) % 4 == 0 and coefs == coefs[::-1], name + " is not a symmetric OS2 filter"
+        write_coefs(os.path.join(filter_data, name + "Half.dat"), coefs[:len(coefs) // 2])
@@ -0,0 +1,140 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Portable C multichannel inner loops for the multi-rate hifi FIR filters
+//
+// Filter several channels' delay lines with the same coefficients. Each
+// coefficient is loaded once for a group of channels rather than once per
+// channel, and the results are bit-exact with the single channel inner
+// loops (maccs accumulate, then lsats/lextract). Built for all targets,
+// including xCORE where there is no assembler version.
+//
+// ===========================================================================
+// ===========================================================================
+
+// ===========================================================================
+//
+// Includes
+//
+// ===========================================================================
+#include <stdlib.h>
+#include <stdio.h>
+
+// Integer arithmetic include
+#include "src_mrhf_int_arithmetic.h"
+
+// Inner loop kernel prototypes
+#include "src_kernels.h"
+
+// ===========================================================================
+//
+// Defines
+//
+// ===========================================================================
+
+// Number of channels sharing each coefficient load
+#define        FIR_MC_GROUP                4
+
+// ===========================================================================
+//
+// Functions implementations
+//
+// ===========================================================================
+
+// ==================================================================== //
+// Function:        src_mrhf_fir_mc_inner_loop_c                        //
+// Arguments:        int *ppiData[]: per channel newest delay line sample //
+//                    int *piCoefs: pointer to coefficients            //
+//                    int iData[]: output (1 sample per channel)        //
+//                    int count: number of taps / 2 (multiple of 8)    //
+//                    int n_channels: number of channels                //
+// Return values:    None                                                //
+// Description:        src_mrhf_fir_inner_loop for n_channels channels    //
+// ==================================================================== //
+void src_mrhf_fir_mc_inner_loop_c(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels)
+{
+    __int64         i64Acc[FIR_MC_GROUP];
+    int*            piData[FIR_MC_GROUP];
+    int             iCoef;
+    unsigned int    ui, uiNTaps;
+    int             iCh, iG, iNG;
+
+    // Assembler processes 16 taps per loop iteration
+    uiNTaps     = ((unsigned int)count >> 3) << 4;
+
+    for(iCh = 0; iCh < n_channels; iCh += iNG)
+    {
+        iNG     = (n_channels - iCh < FIR_MC_GROUP) ? n_channels - iCh : FIR_MC_GROUP;
+        for(iG = 0; iG < iNG; iG++)
+        {
+            piData[iG]  = ppiData[iCh + iG];
+            i64Acc[iG]  = 0;
+        }
+
+        for(ui = 0; ui < uiNTaps; ui++)
+        {
+            iCoef   = piCoefs[ui];
+            for(iG = 0; iG < iNG; iG++)
+                i64Acc[iG] += (__int64)piData[iG][ui] * (__int64)iCoef;
+        }
+
+        for(iG = 0; iG < iNG; iG++)
+        {
+            LSAT30(&i64Acc[iG]);
+            EXT30(&iData[iCh + iG], i64Acc[iG]);
+        }
+    }
+}
+
+// ==================================================================== //
+// Function:        src_mrhf_fir_os_mc_inner_loop_c                        //
+// Arguments:        int *ppiData[]: per channel newest delay line sample //
+//                    int *piCoefs: pointer to interleaved coefficients    //
+//                    int iData[]: output (2 samples per channel)        //
+//                    int count: number of coefficients / 4            //
+//                    int n_channels: number of channels                //
+// Return values:    None                                                //
+// Description:        src_mrhf_fir_os_inner_loop for n_channels channels    //
+// ==================================================================== //
+void src_mrhf_fir_os_mc_inner_loop_c(int *ppiData[], int *piCoefs, int iData[], int count, int n_channels)
+{
+    __int64         i64Acc0[FIR_MC_GROUP], i64Acc1[FIR_MC_GROUP];
+    int*            piData[FIR_MC_GROUP];
+    int             iCoef0, iCoef1;
+    unsigned int    ui, uiNData;
+    int             iCh, iG, iNG;
+
+    // Assembler processes 8 data samples (16 coefficients) per loop iteration
+    uiNData     = ((unsigned int)count >> 2) << 3;
+
+    for(iCh = 0; iCh < n_channels; iCh += iNG)
+    {
+        iNG     = (n_channels - iCh < FIR_MC_GROUP) ? n_channels - iCh : FIR_MC_GROUP;
+        for(iG = 0; iG < iNG; iG++)
+        {
+            piData[iG]  = ppiData[iCh + iG];
+            i64Acc0[iG] = 0;
+            i64Acc1[iG] = 0;
+        }
+
+        for(ui = 0; ui < uiNData; ui++)
+        {
+            iCoef0  = piCoefs[2 * ui];
+            iCoef1  = piCoefs[2 * ui + 1];
+            for(iG = 0; iG < iNG; iG++)
+            {
+                i64Acc0[iG] += (__int64)piData[iG][ui] * (__int64)iCoef0;
+                i64Acc1[iG] += (__int64)piData[iG][ui] * (__int64)iCoef1;
+            }
+        }
+
+        for(iG = 0; iG < iNG; iG++)
+        {
+            LSAT30(&i64Acc0[iG]);
+            LSAT30(&i64Acc1[iG]);
+            EXT30(&iData[2 * (iCh + iG)], i64Acc0[iG]);
+            EXT30(&iData[2 * (iCh + iG) + 1], i64Acc1[iG]);
+        }
+    }
+}
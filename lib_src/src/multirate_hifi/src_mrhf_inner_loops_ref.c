@@ -0,0 +1,261 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// ===========================================================================
+// ===========================================================================
+//
+// Portable C reference implementations of the multi-rate hifi inner loops
+//
+// These are bit-exact equivalents of the xCORE assembler inner loops
+// (maccs accumulate, then lsats/lextract), used when building for a
+// target other than xCORE (e.g. a Linux or Windows host). Alignment of
+// the data is not significant so no _odd variants are needed.
+//
+// ===========================================================================
+// ===========================================================================
+
+#if !defined(__xcore__)
+
+// ===========================================================================
+//
+// Includes
+//
+// ===========================================================================
+#include <stdlib.h>
+#include <stdio.h>
+
+// Integer arithmetic include
+#include "src_mrhf_int_arithmetic.h"
+
+// Inner loop kernel prototypes
+#include "src_kernels.h"
+#include "src_kernels_fixed.h"
+
+// ===========================================================================
+//
+// Functions implementations
+//
+// ===========================================================================
+
+// ==================================================================== //
+// Function:        src_mrhf_fir_inner_loop_c                            //
+// Arguments:        int *piData: pointer to newest delay line sample    //
+//                    int *piCoefs: pointer to coefficients            //
+//                    int iData[]: output (1 sample)                    //
+//                    int count: number of taps / 2 (multiple of 8)    //
+// Return values:    None                                                //
+// Description:        FIR dot product, saturated and extracted from    //
+//                    bit 31 as per lsats/lextract                        //
+// ==================================================================== //
+void src_mrhf_fir_inner_loop_c(int *piData, int *piCoefs, int iData[], int count)
+{
+    __int64         i64Acc;
+    unsigned int    ui, uiNTaps;
+
+    // Assembler processes 16 taps per loop iteration
+    uiNTaps     = ((unsigned int)count >> 3) << 4;
+
+    i64Acc      = 0;
+    for(ui = 0; ui < uiNTaps; ui++)
+        i64Acc += (__int64)piData[ui] * (__int64)piCoefs[ui];
+
+    LSAT30(&i64Acc);
+    EXT30(&iData[0], i64Acc);
+}
+
+// ==================================================================== //
+// Function:        src_mrhf_fir_os_inner_loop_c                        //
+// Arguments:        int *piData: pointer to newest delay line sample    //
+//                    int *piCoefs: pointer to interleaved coefficients    //
+//                    int iData[]: output (2 samples)                    //
+//                    int count: number of coefficients / 4            //
+// Return values:    None                                                //
+// Description:        Two phase FIR for the x2 over-sampler. Even        //
+//                    coefficients give iData[0], odd give iData[1]    //
+// ==================================================================== //
+void src_mrhf_fir_os_inner_loop_c(int *piData, int *piCoefs, int iData[], int count)
+{
+    __int64         i64Acc0, i64Acc1;
+    unsigned int    ui, uiNData;
+
+    // Assembler processes 8 data samples (16 coefficients) per loop iteration
+    uiNData     = ((unsigned int)count >> 2) << 3;
+
+    i64Acc0     = 0;
+    i64Acc1     = 0;
+    for(ui = 0; ui < uiNData; ui++)
+    {
+        i64Acc0 += (__int64)piData[ui] * (__int64)piCoefs[2 * ui];
+        i64Acc1 += (__int64)piData[ui] * (__int64)piCoefs[2 * ui + 1];
+    }
+
+    LSAT30(&i64Acc0);
+    LSAT30(&i64Acc1);
+    EXT30(&iData[0], i64Acc0);
+    EXT30(&iData[1], i64Acc1);
+}
+
+// ==================================================================== //
+// Function:        src_mrhf_fir_os_sym_inner_loop_c                    //
+// Arguments:        int *piData: pointer to newest delay line sample    //
+//                    int *piCoefs: pointer to first half of interleaved    //
+//                                  coefficients                        //
+//                    int iData[]: output (2 samples)                    //
+//                    int count: number of coefficients / 4            //
+// Return values:    None                                                //
+// Description:        src_mrhf_fir_os_inner_loop_c for a symmetric        //
+//                    prototype, where the odd phase is the even phase    //
+//                    reversed. Each coefficient is read once for both    //
+//                    phases                                            //
+// ==================================================================== //
+void src_mrhf_fir_os_sym_inner_loop_c(int *piData, int *piCoefs, int iData[], int count)
+{
+    __int64         i64Acc0, i64Acc1;
+    __int64         i64Data0, i64Data1, i64Coef0, i64Coef1;
+    unsigned int    ui, uiNData;
+
+    // Assembler processes 8 data samples (16 coefficients) per loop iteration
+    uiNData     = ((unsigned int)count >> 2) << 3;
+
+    i64Acc0     = 0;
+    i64Acc1     = 0;
+    for(ui = 0; ui < uiNData >> 1; ui++)
+    {
+        // Even phase coefficient ui is odd phase coefficient uiNData - 1 - ui and vice versa
+        i64Data0    = piData[ui];
+        i64Data1    = piData[uiNData - 1 - ui];
+        i64Coef0    = piCoefs[2 * ui];
+        i64Coef1    = piCoefs[2 * ui + 1];
+        i64Acc0     += i64Data0 * i64Coef0 + i64Data1 * i64Coef1;
+        i64Acc1     += i64Data0 * i64Coef1 + i64Data1 * i64Coef0;
+    }
+
+    LSAT30(&i64Acc0);
+    LSAT30(&i64Acc1);
+    EXT30(&iData[0], i64Acc0);
+    EXT30(&iData[1], i64Acc1);
+}
+
+// ==================================================================== //
+// Function:        src_mrhf_adfir_inner_loop_c                          //
+// Arguments:        int *piData: pointer to newest delay line sample    //
+//                    int *piCoefs: pointer to adaptive coefficients    //
+//                    int iData[]: output (1 sample)                    //
+//                    int count: number of taps / 2 (multiple of 8)    //
+// Return values:    None                                                //
+// Description:        ADFIR dot product, saturated and extracted from    //
+//                    bit 30 as per lsats/lextract                        //
+// ==================================================================== //
+void src_mrhf_adfir_inner_loop_c(int *piData, int *piCoefs, int iData[], int count)
+{
+    __int64         i64Acc;
+    unsigned int    ui, uiNTaps;
+
+    // Assembler processes 16 taps per loop iteration
+    uiNTaps     = ((unsigned int)count >> 3) << 4;
+
+    i64Acc      = 0;
+    for(ui = 0; ui < uiNTaps; ui++)
+        i64Acc += (__int64)piData[ui] * (__int64)piCoefs[ui];
+
+    LSAT29(&i64Acc);
+    EXT29(&iData[0], i64Acc);
+}
+
+// ==================================================================== //
+// Function:        src_mrhf_spline_coeff_gen_inner_loop_c              //
+// Arguments:        const int *piPhase0: pointer to first of three phases//
+//                    int *iH: spline factors H0, H1, H2                //
+//                    int *piADCoefs: output adaptive coefficients        //
+//                    int n_taps: number of taps per phase            //
+// Return values:    None                                                //
+// Description:        Applies spline factors to three consecutive        //
+//                    phases. Upper 32 bits kept, no saturation        //
+// ==================================================================== //
+void src_mrhf_spline_coeff_gen_inner_loop_c(const int *piPhase0, int *iH, int* piADCoefs, const int n_taps)
+{
+    const int*      piPhase1;
+    const int*      piPhase2;
+    __int64         i64Acc;
+    int             ui;
+
+    piPhase1    = piPhase0 + n_taps;
+    piPhase2    = piPhase1 + n_taps;
+
+    for(ui = 0; ui < n_taps; ui++)
+    {
+        i64Acc  = (__int64)iH[2] * (__int64)piPhase0[ui];
+        i64Acc += (__int64)iH[1] * (__int64)piPhase1[ui];
+        i64Acc += (__int64)iH[0] * (__int64)piPhase2[ui];
+
+        piADCoefs[ui] = (int)(i64Acc >> 32);
+    }
+}
+
+// ===========================================================================
+//
+// Fully unrolled kernels for the filter tap counts (see src_kernels_fixed.h)
+//
+// ===========================================================================
+
+// Four taps of the FIR / ADFIR dot product from tap ui
+#define FIXED_MACC_4(ui) \
+    i64Acc += (__int64)piData[(ui)] * (__int64)piCoefs[(ui)]; \
+    i64Acc += (__int64)piData[(ui) + 1] * (__int64)piCoefs[(ui) + 1]; \
+    i64Acc += (__int64)piData[(ui) + 2] * (__int64)piCoefs[(ui) + 2]; \
+    i64Acc += (__int64)piData[(ui) + 3] * (__int64)piCoefs[(ui) + 3];
+
+// Block b of 16 taps
+#define FIXED_MACC_16(b) \
+    FIXED_MACC_4(16 * (b)) FIXED_MACC_4(16 * (b) + 4) FIXED_MACC_4(16 * (b) + 8) FIXED_MACC_4(16 * (b) + 12)
+
+// Two data samples of the OS2 FIR from data sample ui (even coefficients phase 0, odd phase 1)
+#define FIXED_OS_MACC_2(ui) \
+    i64Acc0 += (__int64)piData[(ui)] * (__int64)piCoefs[2 * (ui)]; \
+    i64Acc1 += (__int64)piData[(ui)] * (__int64)piCoefs[2 * (ui) + 1]; \
+    i64Acc0 += (__int64)piData[(ui) + 1] * (__int64)piCoefs[2 * (ui) + 2]; \
+    i64Acc1 += (__int64)piData[(ui) + 1] * (__int64)piCoefs[2 * (ui) + 3];
+
+// Block b of 16 coefficients (8 data samples)
+#define FIXED_OS_MACC_16(b) \
+    FIXED_OS_MACC_2(8 * (b)) FIXED_OS_MACC_2(8 * (b) + 2) FIXED_OS_MACC_2(8 * (b) + 4) FIXED_OS_MACC_2(8 * (b) + 6)
+
+#define FIXED_FIR_KERNEL(kernel, isa, N, B) \
+    static void SRC_KERNELS_FIXED_NAME(kernel, isa, N)(int *piData, int *piCoefs, int iData[], int count) \
+    { \
+        (void)count; /* N taps */ \
+        __int64 i64Acc = 0; \
+        SRC_KERNELS_REPEAT(B, FIXED_MACC_16) \
+        LSAT30(&i64Acc); \
+        EXT30(&iData[0], i64Acc); \
+    }
+
+#define FIXED_ADFIR_KERNEL(kernel, isa, N, B) \
+    static void SRC_KERNELS_FIXED_NAME(kernel, isa, N)(int *piData, int *piCoefs, int iData[], int count) \
+    { \
+        (void)count; /* N taps */ \
+        __int64 i64Acc = 0; \
+        SRC_KERNELS_REPEAT(B, FIXED_MACC_16) \
+        LSAT29(&i64Acc); \
+        EXT29(&iData[0], i64Acc); \
+    }
+
+#define FIXED_FIR_OS_KERNEL(kernel, isa, N, B) \
+    static void SRC_KERNELS_FIXED_NAME(kernel, isa, N)(int *piData, int *piCoefs, int iData[], int count) \
+    { \
+        (void)count; /* N taps */ \
+        __int64 i64Acc0 = 0, i64Acc1 = 0; \
+        SRC_KERNELS_REPEAT(B, FIXED_OS_MACC_16) \
+        LSAT30(&i64Acc0); \
+        LSAT30(&i64Acc1); \
+        EXT30(&iData[0], i64Acc0); \
+        EXT30(&iData[1], i64Acc1); \
+    }
+
+SRC_KERNELS_FIXED_FIR_COUNTS(FIXED_FIR_KERNEL, mrhf_fir, c)
+SRC_KERNELS_FIXED_FIR_OS_COUNTS(FIXED_FIR_OS_KERNEL, mrhf_fir_os, c)
+SRC_KERNELS_FIXED_ADFIR_COUNTS(FIXED_ADFIR_KERNEL, mrhf_adfir, c)
+
+SRC_KERNELS_FIXED_TABLE(mrhf_fir, c, SRC_KERNELS_FIXED_FIR_COUNTS);
+SRC_KERNELS_FIXED_TABLE(mrhf_fir_os, c, SRC_KERNELS_FIXED_FIR_OS_COUNTS);
+SRC_KERNELS_FIXED_TABLE(mrhf_adfir, c, SRC_KERNELS_FIXED_ADFIR_COUNTS);
+
+#endif // !__xcore__
@@ -28,21 +28,66 @@
 
         // ===========================================================================
         //
-        // Function prototypes
+        // Inline functions
         //
         // ===========================================================================
+        // Simulation of the XMOS 64 bits accumulator instructions on hosts. On xCORE, MACC,
+        // LSAT30/29 and EXT30/29 map to the maccs, lsats and lextract instructions
 
         // ==================================================================== //
         // Function:        MACC                                                //
         // Description:        32i x 32i -> 64i Multiply-Accumulate                //
         // ==================================================================== //
-        void    MACC(__int64* plAcc, int ix, int iy);
+        static inline void    MACC(__int64* plAcc, int ix, int iy)
+        {
+#if defined(__xcore__)
+            int             iAccH    = (int)(*plAcc >> 32);
+            unsigned int    uiAccL    = (unsigned int)*plAcc;
+
+            asm("maccs %0, %1, %2, %3" : "=r"(iAccH), "=r"(uiAccL) : "r"(ix), "r"(iy), "0"(iAccH), "1"(uiAccL));
+            *plAcc    = (__int64)(((unsigned __int64)iAccH << 32) | uiAccL);
+#else
+            *plAcc += (__int64)ix * (__int64)iy;
+#endif
+        }
 
         // ==================================================================== //
         // Function:        LMUL                                                //
         // Description:        32i x 32i +32i + 32i -> 64i Multiply (and add)        //
         // ==================================================================== //
-        void    LMUL(__int64* plAcc, int ix, int iy, int ic, int id);
+        static inline void    LMUL(__int64* plAcc, int ix, int iy, int ic, int id)
+        {
+            *plAcc = (__int64)ix * (__int64)iy;
+            *plAcc += (__int64)ic;
+            *plAcc += (__int64)id;
+        }
+
+#if defined(__xcore__)
+        // ==================================================================== //
+        // Function:        LSATS                                               //
+        // Description:        Saturate 64i to 2^(iBit+31)-1, -2^(iBit+31) (lsats) //
+        // ==================================================================== //
+        static inline void    LSATS(__int64 *plx, int iBit)
+        {
+            int             iAccH    = (int)(*plx >> 32);
+            unsigned int    uiAccL    = (unsigned int)*plx;
+
+            asm("lsats %0, %1, %2" : "=r"(iAccH), "=r"(uiAccL) : "r"(iBit), "0"(iAccH), "1"(uiAccL));
+            *plx    = (__int64)(((unsigned __int64)iAccH << 32) | uiAccL);
+        }
+
+        // ==================================================================== //
+        // Function:        LEXTRACT                                            //
+        // Description:        Extracts bits [iBit+31-iBit] into 32i (lextract)    //
+        // ==================================================================== //
+        static inline void    LEXTRACT(int *pr, __int64 lx, int iBit)
+        {
+            int             iAccH    = (int)(lx >> 32);
+            unsigned int    uiAccL    = (unsigned int)lx;
+
+            asm("lextract %0, %1, %2, %3, 32" : "=r"(*pr) : "r"(iAccH), "r"(uiAccL), "r"(iBit));
+        }
+#endif
 
         // ==================================================================== //
         // Function:        LATS30                                                //
@@ -50,13 +95,30 @@
         // ==================================================================== //
         #define        MAX_VAL64_30    (__int64)0x3FFFFFFFFFFFFFFF
         #define        MIN_VAL64_30    (__int64)0xC000000000000000
-        void    LSAT30(__int64 *plx);
+        static inline void    LSAT30(__int64 *plx)
+        {
+#if defined(__xcore__)
+            LSATS(plx, 31);
+#else
+            if(*plx > MAX_VAL64_30)
+                *plx = MAX_VAL64_30;
+            if(*plx < MIN_VAL64_30)
+                *plx = MIN_VAL64_30;
+#endif
+        }
 
         // ==================================================================== //
         // Function:        EXT30                                                //
         // Description:        Extracts bits [62-31] into 32i                        //
         // ==================================================================== //
-        void    EXT30(int *pr, __int64 lx);
+        static inline void    EXT30(int *pr, __int64 lx)
+        {
+#if defined(__xcore__)
+            LEXTRACT(pr, lx, 31);
+#else
+            *pr        = (int)(lx>>31);
+#endif
+        }
 
         // ==================================================================== //
         // Function:        LATS29                                                //
@@ -64,13 +126,30 @@
         // ==================================================================== //
         #define        MAX_VAL64_29    (__int64)0x1FFFFFFFFFFFFFFF
         #define        MIN_VAL64_29    (__int64)0xE000000000000000
-        void    LSAT29(__int64 *plx);
+        static inline void    LSAT29(__int64 *plx)
+        {
+#if defined(__xcore__)
+            LSATS(plx, 30);
+#else
+            if(*plx > MAX_VAL64_29)
+                *plx = MAX_VAL64_29;
+            if(*plx < MIN_VAL64_29)
+                *plx = MIN_VAL64_29;
+#endif
+        }
 
         // ==================================================================== //
         // Function:        EXT29                                                //
         // Description:        Extracts bits [61-30] into 32i                        //
         // ==================================================================== //
-        void    EXT29(int *pr, __int64 lx);
+        static inline void    EXT29(int *pr, __int64 lx)
+        {
+#if defined(__xcore__)
+            LEXTRACT(pr, lx, 30);
+#else
+            *pr        = (int)(lx>>30);
+#endif
+        }
 
     #endif // nINCLUDE_FROM_ASM
 
@@ -2,6 +2,6 @@
 #ifndef SRC_MRHF_SPLINE_COEFF_GEN_INNER_LOOP_ASM_H_
 #define SRC_MRHF_SPLINE_COEFF_GEN_INNER_LOOP_ASM_H_
 
-void src_mrhf_spline_coeff_gen_inner_loop_asm(int *piPhase0, int *iH, int* piADCoefs, const int n_taps);
+void src_mrhf_spline_coeff_gen_inner_loop_asm(const int *piPhase0, int *iH, int* piADCoefs, const int n_taps);
 
 #endif // SRC_MRHF_SPLINE_COEFF_GEN_INNER_LOOP_ASM_H_
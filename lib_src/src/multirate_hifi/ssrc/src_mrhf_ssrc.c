@@ -23,9 +23,13 @@
 // Integer arithmetic include
 #include "src_mrhf_int_arithmetic.h"
 // XMOS built in functions
+#if defined(__xcore__)
 #include <xs1.h>
+#endif
 // SSRC include
 #include "src.h"
+// Inner loop kernels
+#include "src_kernels.h"
 
 // ===========================================================================
 //
@@ -56,6 +60,11 @@
 #define        SSRC_FIR_PP_TAP_CYCLE_COUNT            (2.125)
 #define        SSRC_DITHER_SAMPLE_COUNT            (20.0)
 
+// Stage planner (SRC_ARBITRARY_FS)
+#define        SSRC_PLAN_BANDS_UNIT                10000                    // Band edges unit (SSRCFirBands_t)
+#define        SSRC_PLAN_MIN_PASS_BAND                4000                    // Minimum pass band, in SSRC_PLAN_BANDS_UNIT of the lowest of Fsin and Fsout
+#define        SSRC_PLAN_N_PRE                        5                        // Number of pre-stages (none, DS, DS4, DS8, DS16)
+
 
 
 // ===========================================================================
@@ -64,6 +73,11 @@
 //
 // ===========================================================================
 
+const unsigned int        uiSSRCFsHz[SSRC_N_FS] =                            // Sampling rates of the FS codes (Hz)
+{
+    44100,        48000,        88200,        96000,        176400,        192000
+};
+
 SSRCFiltersIDs_t        sFiltersIDs[SSRC_N_FS][SSRC_N_FS] =                // Filter configuration table [Fsin][Fsout]
 {
     {    // Fsin = 44.1kHz
@@ -123,6 +137,52 @@ SSRCFiltersIDs_t        sFiltersIDs[SSRC_N_FS][SSRC_N_FS] =                // Fi
     }
 };
 
+#if SRC_ARBITRARY_FS
+// Measured band edges of the SSRC FIR filters (ordered by ID), for the stage planner (see SSRC_plan)
+// Those of FILTER_DEFS_SSRC_FIR_DS4_ID and above come from src_mrhf_fir_coefs_generator.py
+static const SSRCFirBands_t    sSSRCFirBands[FILTER_DEFS_SSRC_N_FIR_ID] =
+{
+    // Pass    Stop
+    {2276,    2700},        // FILTER_DEFS_SSRC_FIR_BL_ID
+    {2086,    2477},        // FILTER_DEFS_SSRC_FIR_BL9644_ID
+    {2481,    2933},        // FILTER_DEFS_SSRC_FIR_BL8848_ID
+    {1833,    2461},        // FITLER_DEFS_SSRC_FIR_BL19288_ID
+    {2284,    2924},        // FILTER_DEFS_SSRC_FIR_BL17696_ID
+    {2276,    2700},        // FILTER_DEFS_SSRC_FIR_UP_ID
+    {2086,    2477},        // FILTER_DEFS_SSRC_FIR_UP4844_ID
+    {2058,    2686},        // FILTER_DEFS_SSRC_FIR_UPF_ID
+    {1833,    2461},        // FILTER_DEFS_SSRC_FIR_UP192176_ID
+    {1453,    3325},        // FILTER_DEFS_SSRC_FIR_DS_ID
+    {1453,    3325},        // FILTER_DEFS_SSRC_FIR_OS_ID
+    {0,        0},            // FILTER_DEFS_SSRC_FIR_NONE_ID
+    {714,    1697},        // FILTER_DEFS_SSRC_FIR_DS4_ID
+    {1352,    1742},        // FILTER_DEFS_SSRC_FIR_BL5016_ID
+    {1462,    1852},        // FILTER_DEFS_SSRC_FIR_BL4816_ID
+    {1587,    2021},        // FILTER_DEFS_SSRC_FIR_BL4416_ID
+    {1739,    2173},        // FILTER_DEFS_SSRC_FIR_BL3716_ID
+    {1352,    1742},        // FILTER_DEFS_SSRC_FIR_UP5032_ID
+    {1462,    1852},        // FILTER_DEFS_SSRC_FIR_UP4832_ID
+    {1587,    2021},        // FILTER_DEFS_SSRC_FIR_UP4432_ID
+    {1739,    2173},        // FILTER_DEFS_SSRC_FIR_UP3732_ID
+    {372,    860},        // FILTER_DEFS_SSRC_FIR_DS8_ID
+    {136,    490}        // FILTER_DEFS_SSRC_FIR_DS16_ID
+};
+
+// Measured band edges of the PPFIR filters (ordered by ID), per PPFIR input rate: they interpolate
+// between input samples band limited to below a third of that rate
+static const SSRCFirBands_t    sSSRCPPFirBands[FILTER_DEFS_N_PPFIR_ID] =
+{
+    // Pass    Stop
+    {2848,    6920},        // FILTER_DEFS_PPFIR_HS294_ID
+    {2753,    6754},        // FILTER_DEFS_PPFIR_HS320_ID
+    {0,        0}            // FILTER_DEFS_PPFIR_NONE_ID
+};
+
+// Pre-stages the planner can put ahead of a band limiting filter, and their decimation factors
+static const unsigned int    uiSSRCPlanPreFID[SSRC_PLAN_N_PRE]        = {FILTER_DEFS_SSRC_FIR_NONE_ID,    FILTER_DEFS_SSRC_FIR_DS_ID,        FILTER_DEFS_SSRC_FIR_DS4_ID,    FILTER_DEFS_SSRC_FIR_DS8_ID,    FILTER_DEFS_SSRC_FIR_DS16_ID};
+static const unsigned int    uiSSRCPlanPreDecim[SSRC_PLAN_N_PRE]        = {1,                                2,                                4,                                8,                                16};
+#endif
+
 
 
 // ===========================================================================
@@ -145,6 +205,216 @@ SSRCReturnCodes_t                SSRC_proc_dither(ssrc_ctrl_t* pssrc_ctrl);
 
 
 
+// ==================================================================== //
+// Function:        SSRC_fs_code                                        //
+// Arguments:        unsigned int uiFs: Sampling rate (Hz)                //
+// Return values:    Sampling rate code of uiFs, SSRC_FS_NONE if it has    //
+//                    no code                                                //
+// Description:        Finds the sampling rate code of a rate in Hz        //
+// ==================================================================== //
+static SSRCFs_t                    SSRC_fs_code(unsigned int uiFs)
+{
+    int                            iFs;
+
+    for(iFs = SSRC_FS_MIN; iFs <= SSRC_FS_MAX; iFs++)
+        if(uiSSRCFsHz[iFs] == uiFs)
+            return (SSRCFs_t)iFs;
+    return SSRC_FS_NONE;
+}
+
+
+// ==================================================================== //
+// Function:        SSRC_plan                                            //
+// Arguments:        unsigned int uiInFs: Fsin (Hz)                        //
+//                    unsigned int uiOutFs: Fsout (Hz)                    //
+//                    unsigned int uiNInSamples: Number of input samples    //
+//                    SSRCFiltersIDs_t *psFiltersID: F1, F2 and F3 IDs    //
+//                    and F3 phase step                                    //
+// Return values:    SSRC_NO_ERROR on success                            //
+//                    SSRC_ERROR if there is no plan for Fsin and Fsout    //
+// Description:        Chooses filters F1, F2 and F3 for Fsin and Fsout    //
+// ==================================================================== //
+static SSRCReturnCodes_t        SSRC_plan(unsigned int uiInFs, unsigned int uiOutFs, unsigned int uiNInSamples, SSRCFiltersIDs_t* psFiltersID)
+{
+    SSRCFs_t                        eInFs, eOutFs;
+#if SRC_ARBITRARY_FS
+    unsigned long long            u64B, u64S, u64Fs3, u64OutFs, u64BestB;
+    unsigned int                uiPre, uiFID, uiOS, uiNOS, uiPPFID, uiD, uiR, uiM, uiCost, uiBestD, uiBestCost;
+    int                            iBestPre, iBestFID, iBestOS, iBestPPFID;
+    unsigned int                uiBestPhaseStep;
+    const FIRDescriptor_t*        psFIRDescriptor;
+#endif
+
+    // Pairs of FS codes rates use the table
+    eInFs    = SSRC_fs_code(uiInFs);
+    eOutFs    = SSRC_fs_code(uiOutFs);
+    if((eInFs != SSRC_FS_NONE) && (eOutFs != SSRC_FS_NONE))
+    {
+        *psFiltersID        = sFiltersIDs[eInFs][eOutFs];
+        return SSRC_NO_ERROR;
+    }
+
+#if SRC_ARBITRARY_FS
+    if((uiInFs == 0) || (uiOutFs == 0))
+        return SSRC_ERROR;
+
+    // 1:1 rate, all filters disabled
+    if(uiInFs == uiOutFs)
+    {
+        psFiltersID->uiFID[SSRC_F1_INDEX]    = FILTER_DEFS_SSRC_FIR_NONE_ID;
+        psFiltersID->uiFID[SSRC_F2_INDEX]    = FILTER_DEFS_SSRC_FIR_NONE_ID;
+        psFiltersID->uiFID[SSRC_F3_INDEX]    = FILTER_DEFS_PPFIR_NONE_ID;
+        psFiltersID->uiPPFIRPhaseStep        = FILTER_DEFS_PPFIR_PHASE_STEP_0;
+        return SSRC_NO_ERROR;
+    }
+
+    // Search a band limiting filter X, at Fsin (SYNC, or DS2 decimating by 2) or 2 x Fsin (OS2, which F2 OS can
+    // over-sample by 2 again), or a pre-stage decimating by D (DS, DS4, DS8, DS16) followed by a SYNC or DS2 X at
+    // Fsin / D. The F3 polyphase filter then goes from the rate Fs3 of X to Fsout, with an integer phase step
+    // (uiNPhases x Fs3 / Fsout), or is not needed when Fs3 is Fsout. With B the pass band edge of X (and of the
+    // pre-stage) and S its stop band edge, in Hz:
+    //  - S <= Fsout - B, so what F3 or a DS2 X folds back from above Fsout / 2 stays out of the pass band
+    //  - a pre-stage aliases above Fsin / D - its stop band edge, which must be above S
+    //  - the images of the F2 OS and F3 inputs, from their input rate - S, must be in their stop bands
+    //  - B >= SSRC_PLAN_MIN_PASS_BAND of the lowest of Fsin and Fsout
+    // and keep the widest pass band, then the fewest taps per input sample. Below, all frequencies are in
+    // Hz x SSRC_PLAN_BANDS_UNIT x 2D (exact integers)
+    iBestPre        = -1;
+    iBestFID        = -1;
+    iBestOS            = 0;
+    iBestPPFID        = FILTER_DEFS_PPFIR_NONE_ID;
+    uiBestPhaseStep    = FILTER_DEFS_PPFIR_PHASE_STEP_0;
+    u64BestB        = 0;
+    uiBestD            = 1;
+    uiBestCost        = 0;
+    for(uiPre = 0; uiPre < SSRC_PLAN_N_PRE; uiPre++)
+    {
+        uiD            = uiSSRCPlanPreDecim[uiPre];
+        // X needs an even number of input samples
+        if((uiNInSamples % (uiD << 1)) != 0)
+            continue;
+        u64OutFs    = (unsigned long long)uiOutFs * (uiD << 1);
+        for(uiFID = 0; uiFID < FILTER_DEFS_SSRC_N_FIR_ID; uiFID++)
+        {
+            psFIRDescriptor        = &sSSRCFirDescriptor[uiFID];
+            if((uiFID == FILTER_DEFS_SSRC_FIR_NONE_ID) || (uiFID == FILTER_DEFS_SSRC_FIR_OS_ID))
+                continue;
+            // The pre-stage and DS would both use the short delay line
+            if((uiD != 1) && (uiFID == FILTER_DEFS_SSRC_FIR_DS_ID))
+                continue;
+            // Coefficients rate uiR and output rate uiM of X, in Fsin x 2D / D
+            uiNOS        = 1;
+            if(psFIRDescriptor->eType == FIR_TYPE_OS2)
+            {
+                if(uiD != 1)
+                    continue;
+                uiR        = 4;
+                uiM        = 4;
+                uiNOS    = 2;
+            }
+            else if(psFIRDescriptor->eType == FIR_TYPE_SYNC)
+            {
+                uiR        = 2;
+                uiM        = 2;
+            }
+            else if(psFIRDescriptor->eType == FIR_TYPE_DS2)
+            {
+                uiR        = 2;
+                uiM        = 1;
+            }
+            else
+                continue;
+
+            for(uiOS = 0; uiOS < uiNOS; uiOS++)
+            {
+                u64B        = (unsigned long long)sSSRCFirBands[uiFID].uiPass * uiInFs * uiR;
+                u64S        = (unsigned long long)sSSRCFirBands[uiFID].uiStop * uiInFs * uiR;
+                uiCost        = psFIRDescriptor->uiNCoefs;
+                u64Fs3        = (unsigned long long)uiInFs * uiM;
+                if(uiD != 1)
+                {
+                    if(u64B > (unsigned long long)sSSRCFirBands[uiSSRCPlanPreFID[uiPre]].uiPass * uiInFs * (uiD << 1))
+                        u64B    = (unsigned long long)sSSRCFirBands[uiSSRCPlanPreFID[uiPre]].uiPass * uiInFs * (uiD << 1);
+                    if((unsigned long long)SSRC_PLAN_BANDS_UNIT * uiInFs * 2 < (unsigned long long)sSSRCFirBands[uiSSRCPlanPreFID[uiPre]].uiStop * uiInFs * (uiD << 1) + u64S)
+                        continue;
+                    uiCost    += sSSRCFirDescriptor[uiSSRCPlanPreFID[uiPre]].uiNCoefs;
+                }
+                if(uiOS != 0)
+                {
+                    // F2 OS at 4 x Fsin, from 2 x Fsin
+                    if((unsigned long long)SSRC_PLAN_BANDS_UNIT * u64Fs3 < (unsigned long long)sSSRCFirBands[FILTER_DEFS_SSRC_FIR_OS_ID].uiStop * u64Fs3 * 2 + u64S)
+                        continue;
+                    uiCost    += sSSRCFirDescriptor[FILTER_DEFS_SSRC_FIR_OS_ID].uiNCoefs;
+                    u64Fs3    *= 2;
+                }
+                if((psFIRDescriptor->eType == FIR_TYPE_DS2) && (u64S + u64B > SSRC_PLAN_BANDS_UNIT * u64Fs3))
+                    continue;
+                if(u64S + u64B > SSRC_PLAN_BANDS_UNIT * u64OutFs)
+                    continue;
+                if(u64B < (unsigned long long)SSRC_PLAN_MIN_PASS_BAND * ((uiInFs < uiOutFs) ? uiInFs : uiOutFs) * (uiD << 1))
+                    continue;
+
+                // F3, the first PPFIR with an integer phase step
+                uiPPFID        = FILTER_DEFS_PPFIR_NONE_ID;
+                if(u64Fs3 != u64OutFs)
+                {
+                    for(uiPPFID = 0; uiPPFID < FILTER_DEFS_PPFIR_NONE_ID; uiPPFID++)
+                    {
+                        if(((unsigned long long)sPPFirDescriptor[uiPPFID].uiNPhases * u64Fs3) % u64OutFs != 0)
+                            continue;
+                        if(u64B > (unsigned long long)sSSRCPPFirBands[uiPPFID].uiPass * u64Fs3)
+                            continue;
+                        if(SSRC_PLAN_BANDS_UNIT * u64Fs3 < (unsigned long long)sSSRCPPFirBands[uiPPFID].uiStop * u64Fs3 + u64S)
+                            continue;
+                        break;
+                    }
+                    if(uiPPFID == FILTER_DEFS_PPFIR_NONE_ID)
+                        continue;
+                }
+
+                // Pass bands B / 2D and costs uiCost / D compared across D
+                if( (iBestFID < 0) ||
+                    (u64B * uiBestD > u64BestB * uiD) ||
+                    ((u64B * uiBestD == u64BestB * uiD) && (uiCost * uiBestD < uiBestCost * uiD)) )
+                {
+                    iBestPre        = (int)uiPre;
+                    iBestFID        = (int)uiFID;
+                    iBestOS            = (int)uiOS;
+                    iBestPPFID        = (int)uiPPFID;
+                    uiBestPhaseStep    = (uiPPFID == FILTER_DEFS_PPFIR_NONE_ID) ? FILTER_DEFS_PPFIR_PHASE_STEP_0 :
+                                        (unsigned int)(((unsigned long long)sPPFirDescriptor[uiPPFID].uiNPhases * u64Fs3) / u64OutFs);
+                    u64BestB        = u64B;
+                    uiBestD            = uiD;
+                    uiBestCost        = uiCost;
+                }
+            }
+        }
+    }
+    if(iBestFID < 0)
+        return SSRC_ERROR;
+
+    // F1 is the pre-stage if any, X otherwise (then F2 is OS or disabled)
+    if(iBestPre != 0)
+    {
+        psFiltersID->uiFID[SSRC_F1_INDEX]    = uiSSRCPlanPreFID[iBestPre];
+        psFiltersID->uiFID[SSRC_F2_INDEX]    = (unsigned int)iBestFID;
+    }
+    else
+    {
+        psFiltersID->uiFID[SSRC_F1_INDEX]    = (unsigned int)iBestFID;
+        psFiltersID->uiFID[SSRC_F2_INDEX]    = iBestOS ? FILTER_DEFS_SSRC_FIR_OS_ID : FILTER_DEFS_SSRC_FIR_NONE_ID;
+    }
+    psFiltersID->uiFID[SSRC_F3_INDEX]        = (unsigned int)iBestPPFID;
+    psFiltersID->uiPPFIRPhaseStep            = uiBestPhaseStep;
+
+    return SSRC_NO_ERROR;
+#else
+    (void)uiNInSamples;
+    return SSRC_ERROR;
+#endif
+}
+
+
 // ==================================================================== //
 // Function:        SSRC_init                                            //
 // Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
@@ -154,7 +424,8 @@ SSRCReturnCodes_t                SSRC_proc_dither(ssrc_ctrl_t* pssrc_ctrl);
 // ==================================================================== //
 SSRCReturnCodes_t                SSRC_init(ssrc_ctrl_t* pssrc_ctrl)
 {
-    SSRCFiltersIDs_t*            psFiltersID;
+    SSRCFiltersIDs_t            sFiltersID;
+    SSRCFiltersIDs_t*            psFiltersID        = &sFiltersID;
     FIRDescriptor_t*            psFIRDescriptor;
     PPFIRDescriptor_t*            psPPFIRDescriptor;
 
@@ -167,20 +438,23 @@ SSRCReturnCodes_t                SSRC_init(ssrc_ctrl_t* pssrc_ctrl)
     if(pssrc_ctrl->piStack == 0)
         return SSRC_ERROR;
 
-    // Check if valid Fsin and Fsout have been provided
-    if( (pssrc_ctrl->eInFs < SSRC_FS_MIN) || (pssrc_ctrl->eInFs > SSRC_FS_MAX))
-        return SSRC_ERROR;
-    if( (pssrc_ctrl->eOutFs < SSRC_FS_MIN) || (pssrc_ctrl->eOutFs > SSRC_FS_MAX))
-        return SSRC_ERROR;
-
     // Check that number of input samples is allocated and is a multiple of 4
     if(pssrc_ctrl->uiNInSamples == 0)
         return SSRC_ERROR;
     if((pssrc_ctrl->uiNInSamples & 0x3) != 0x0)
         return SSRC_ERROR;
 
-    // Load filters ID and number of samples
-    psFiltersID        = &sFiltersIDs[pssrc_ctrl->eInFs][pssrc_ctrl->eOutFs];
+    // Choose filters (fails if Fsin and Fsout are not supported)
+    if(SSRC_plan(pssrc_ctrl->uiInFs, pssrc_ctrl->uiOutFs, pssrc_ctrl->uiNInSamples, psFiltersID) != SSRC_NO_ERROR)
+        return SSRC_ERROR;
+    pssrc_ctrl->eInFs        = SSRC_fs_code(pssrc_ctrl->uiInFs);
+    pssrc_ctrl->eOutFs        = SSRC_fs_code(pssrc_ctrl->uiOutFs);
+
+    // Select inner loop kernels (first call only)
+    src_kernels_init();
+
+    // Input and output buffers are interleaved (see SSRC_set_step)
+    pssrc_ctrl->uiStep                        = pssrc_ctrl->uiNchannels;
 
     // Configure filters from filters ID and number of samples
 
@@ -189,10 +463,16 @@ SSRCReturnCodes_t                SSRC_init(ssrc_ctrl_t* pssrc_ctrl)
     psFIRDescriptor                                = &sSSRCFirDescriptor[psFiltersID->uiFID[SSRC_F1_INDEX]];
     // Set number of input samples and input samples step
     pssrc_ctrl->sFIRF1Ctrl.uiNInSamples        = pssrc_ctrl->uiNInSamples;
-    pssrc_ctrl->sFIRF1Ctrl.uiInStep            = pssrc_ctrl->uiNchannels;
+    pssrc_ctrl->sFIRF1Ctrl.uiInStep            = pssrc_ctrl->uiStep;
 
     // Set delay line base pointer
-    if( (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_DS_ID) || (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_OS_ID) )
+    if( (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_DS_ID) || (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_OS_ID)
+#if SRC_ARBITRARY_FS
+        || (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_DS4_ID)
+        || (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_DS8_ID)
+        || (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_DS16_ID)
+#endif
+        )
         pssrc_ctrl->sFIRF1Ctrl.piDelayB        = pssrc_ctrl->psState->iDelayFIRShort;
     else
         pssrc_ctrl->sFIRF1Ctrl.piDelayB        = pssrc_ctrl->psState->iDelayFIRLong;
@@ -200,9 +480,9 @@ SSRCReturnCodes_t                SSRC_init(ssrc_ctrl_t* pssrc_ctrl)
     // Set output buffer step
     if(psFiltersID->uiFID[SSRC_F2_INDEX] == FILTER_DEFS_SSRC_FIR_OS_ID)
         // F2 in use in over-sampling by 2 mode
-        pssrc_ctrl->sFIRF1Ctrl.uiOutStep    = 2 * pssrc_ctrl->uiNchannels;
+        pssrc_ctrl->sFIRF1Ctrl.uiOutStep    = 2 * pssrc_ctrl->uiStep;
     else
-        pssrc_ctrl->sFIRF1Ctrl.uiOutStep    = pssrc_ctrl->uiNchannels;
+        pssrc_ctrl->sFIRF1Ctrl.uiOutStep    = pssrc_ctrl->uiStep;
 
     // Call init for FIR F1
     if(FIR_init_from_desc(&pssrc_ctrl->sFIRF1Ctrl, psFIRDescriptor) != FIR_NO_ERROR)
@@ -224,7 +504,7 @@ SSRCReturnCodes_t                SSRC_init(ssrc_ctrl_t* pssrc_ctrl)
         pssrc_ctrl->sFIRF2Ctrl.piDelayB        = pssrc_ctrl->psState->iDelayFIRLong;
 
     // Set output buffer step
-    pssrc_ctrl->sFIRF2Ctrl.uiOutStep    = pssrc_ctrl->uiNchannels;
+    pssrc_ctrl->sFIRF2Ctrl.uiOutStep    = pssrc_ctrl->uiStep;
 
     // Call init for FIR F1
     if(FIR_init_from_desc(&pssrc_ctrl->sFIRF2Ctrl, psFIRDescriptor) != FIR_NO_ERROR)
@@ -246,7 +526,7 @@ SSRCReturnCodes_t                SSRC_init(ssrc_ctrl_t* pssrc_ctrl)
     pssrc_ctrl->sPPFIRF3Ctrl.piDelayB        = pssrc_ctrl->psState->iDelayPPFIR;
 
     // Set output buffer step
-    pssrc_ctrl->sPPFIRF3Ctrl.uiOutStep        = pssrc_ctrl->uiNchannels;
+    pssrc_ctrl->sPPFIRF3Ctrl.uiOutStep        = pssrc_ctrl->uiStep;
 
     // Set phase step
     pssrc_ctrl->sPPFIRF3Ctrl.uiPhaseStep    = psFiltersID->uiPPFIRPhaseStep;
@@ -332,6 +612,130 @@ SSRCReturnCodes_t                SSRC_sync(ssrc_ctrl_t* pssrc_ctrl)
 }
 
 
+// ==================================================================== //
+// Function:        SSRC_set_step                                        //
+// Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
+//                    unsigned int uiStep: Step between the samples of    //
+//                    the channel in the input and output buffers            //
+// Return values:    SSRC_NO_ERROR on success                            //
+//                    SSRC_ERROR on failure                                //
+// Description:        Sets the input and output buffers layout of an        //
+//                    initialised SSRC: interleaved (uiNchannels) or        //
+//                    planar (1). The stack uses the same step            //
+// ==================================================================== //
+SSRCReturnCodes_t                SSRC_set_step(ssrc_ctrl_t* pssrc_ctrl, unsigned int uiStep)
+{
+    if(uiStep == 0)
+        return SSRC_ERROR;
+
+    pssrc_ctrl->uiStep                        = uiStep;
+
+    // Same steps as SSRC_init, F1 output spaced out when F2 over-samples by 2
+    pssrc_ctrl->sFIRF1Ctrl.uiInStep            = uiStep;
+    if((pssrc_ctrl->sFIRF2Ctrl.eEnable == FIR_ON) && (pssrc_ctrl->sFIRF2Ctrl.uiNOutSamples > pssrc_ctrl->sFIRF2Ctrl.uiNInSamples))
+        pssrc_ctrl->sFIRF1Ctrl.uiOutStep    = 2 * uiStep;
+    else
+        pssrc_ctrl->sFIRF1Ctrl.uiOutStep    = uiStep;
+    pssrc_ctrl->sFIRF2Ctrl.uiInStep            = pssrc_ctrl->sFIRF1Ctrl.uiOutStep;
+    pssrc_ctrl->sFIRF2Ctrl.uiOutStep        = uiStep;
+    pssrc_ctrl->sPPFIRF3Ctrl.uiInStep        = pssrc_ctrl->sFIRF2Ctrl.uiOutStep;
+    pssrc_ctrl->sPPFIRF3Ctrl.uiOutStep        = uiStep;
+
+    return SSRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        SSRC_get_stack_length                                //
+// Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
+//                    unsigned int *puiStackLength: Stack length            //
+// Return values:    SSRC_NO_ERROR on success                            //
+//                    SSRC_ERROR on failure                                //
+// Description:        Gets the length of the stack used by an SSRC for    //
+//                    uiInFs, uiOutFs, uiNInSamples and uiNchannels,        //
+//                    before it is initialised (interleaved or planar        //
+//                    buffers)                                            //
+// ==================================================================== //
+SSRCReturnCodes_t                SSRC_get_stack_length(ssrc_ctrl_t* pssrc_ctrl, unsigned int* puiStackLength)
+{
+    SSRCFiltersIDs_t            sFiltersID;
+    SSRCFiltersIDs_t*            psFiltersID        = &sFiltersID;
+    unsigned int                uiNF1OutSamples, uiNF2OutSamples;
+    unsigned int                uiF1OutStep;
+
+
+    // Same filters as SSRC_init
+    if(SSRC_plan(pssrc_ctrl->uiInFs, pssrc_ctrl->uiOutFs, pssrc_ctrl->uiNInSamples, psFiltersID) != SSRC_NO_ERROR)
+        return SSRC_ERROR;
+
+    // F1 and F2 write to the stack (in place), F2 and F3 read from it
+    if(FIR_get_n_out_samples(&sSSRCFirDescriptor[psFiltersID->uiFID[SSRC_F1_INDEX]], pssrc_ctrl->uiNInSamples, &uiNF1OutSamples) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+    if(FIR_get_n_out_samples(&sSSRCFirDescriptor[psFiltersID->uiFID[SSRC_F2_INDEX]], uiNF1OutSamples, &uiNF2OutSamples) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+
+    // F1 disabled: 1:1 rate, input copied to output
+    *puiStackLength        = 0;
+    if(uiNF1OutSamples == 0)
+        return SSRC_NO_ERROR;
+
+    // Steps as set by SSRC_init (interleaved buffers, planar ones use less)
+    uiF1OutStep        = (psFiltersID->uiFID[SSRC_F2_INDEX] == FILTER_DEFS_SSRC_FIR_OS_ID) ? 2 * pssrc_ctrl->uiNchannels : pssrc_ctrl->uiNchannels;
+    *puiStackLength        = (uiNF1OutSamples - 1) * uiF1OutStep + 1;
+    if((uiNF2OutSamples != 0) && ((uiNF2OutSamples - 1) * pssrc_ctrl->uiNchannels + 1 > *puiStackLength))
+        *puiStackLength    = (uiNF2OutSamples - 1) * pssrc_ctrl->uiNchannels + 1;
+
+    return SSRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        SSRC_get_delay                                        //
+// Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
+//                    long long *pi64Delay: Group delay (Q32 format)        //
+//                    unsigned long long *pu64OutRatio: Fsout / Fsin    //
+//                    (Q32 format)                                        //
+// Return values:    SSRC_NO_ERROR on success                            //
+//                    SSRC_ERROR on failure                                //
+// Description:        Gets the group delay at DC of the filters F1, F2    //
+//                    and F3 in input samples                                //
+// ==================================================================== //
+SSRCReturnCodes_t                SSRC_get_delay(ssrc_ctrl_t* pssrc_ctrl, long long* pi64Delay, unsigned long long* pu64OutRatio)
+{
+    long long                    i64Delay;
+    unsigned int                uiNInSamples    = pssrc_ctrl->uiNInSamples;
+
+
+    // Each filter delay is in its own input samples: scale by the converter input samples per filter input sample
+    if(FIR_get_delay(&pssrc_ctrl->sFIRF1Ctrl, &i64Delay) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+    *pi64Delay        = i64Delay;
+    *pu64OutRatio    = 1ULL << 32;
+    if(pssrc_ctrl->sFIRF1Ctrl.eEnable == FIR_ON)
+        *pu64OutRatio    = ((unsigned long long)pssrc_ctrl->sFIRF1Ctrl.uiNOutSamples << 32) / uiNInSamples;
+
+    if(FIR_get_delay(&pssrc_ctrl->sFIRF2Ctrl, &i64Delay) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+    if(pssrc_ctrl->sFIRF2Ctrl.eEnable == FIR_ON)
+    {
+        *pi64Delay        += i64Delay * uiNInSamples / pssrc_ctrl->sFIRF2Ctrl.uiNInSamples;
+        *pu64OutRatio    = ((unsigned long long)pssrc_ctrl->sFIRF2Ctrl.uiNOutSamples << 32) / uiNInSamples;
+    }
+
+    // F3 outputs a varying number of samples per call, uiNPhases per uiPhaseStep input samples on average
+    if(PPFIR_get_delay(&pssrc_ctrl->sPPFIRF3Ctrl, &i64Delay) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+    if(pssrc_ctrl->sPPFIRF3Ctrl.eEnable == FIR_ON)
+    {
+        *pi64Delay        += i64Delay * uiNInSamples / pssrc_ctrl->sPPFIRF3Ctrl.uiNInSamples;
+        *pu64OutRatio    = ((unsigned long long)pssrc_ctrl->sPPFIRF3Ctrl.uiNInSamples * pssrc_ctrl->sPPFIRF3Ctrl.uiNPhases << 32) /
+                            ((unsigned long long)uiNInSamples * pssrc_ctrl->sPPFIRF3Ctrl.uiPhaseStep);
+    }
+
+    return SSRC_NO_ERROR;
+}
+
+
 // ==================================================================== //
 // Function:        SSRC_proc                                            //
 // Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
@@ -368,6 +772,101 @@ SSRCReturnCodes_t                SSRC_proc(ssrc_ctrl_t* pssrc_ctrl)
 }
 
 
+// ==================================================================== //
+// Function:        SSRC_proc_mc                                        //
+// Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct. array        //
+//                    unsigned int uiNChannels: number of channels        //
+// Return values:    SSRC_NO_ERROR on success                            //
+//                    SSRC_ERROR on failure                                //
+// Description:        Processes uiNChannels SSRC (up to                    //
+//                    FIR_MC_MAX_CHANNELS) with shared coefficient loads    //
+// ==================================================================== //
+SSRCReturnCodes_t                SSRC_proc_mc(ssrc_ctrl_t* pssrc_ctrl, unsigned int uiNChannels)
+{
+    FIRCtrl_t*        psFIRCtrl[FIR_MC_MAX_CHANNELS];
+    PPFIRCtrl_t*    psPPFIRCtrl[FIR_MC_MAX_CHANNELS];
+    unsigned int    ui;
+
+    if(uiNChannels > FIR_MC_MAX_CHANNELS)
+        return SSRC_ERROR;
+
+    // F1 disabled means 1:1 rate, which is only a copy
+    if(pssrc_ctrl[0].sFIRF1Ctrl.eEnable == FIR_OFF)
+    {
+        for(ui = 0; ui < uiNChannels; ui++)
+        {
+            if(SSRC_proc(&pssrc_ctrl[ui]) != SSRC_NO_ERROR)
+                return SSRC_ERROR;
+        }
+        return SSRC_NO_ERROR;
+    }
+
+    // Setup input / output buffers
+    // ----------------------------
+    for(ui = 0; ui < uiNChannels; ui++)
+    {
+        pssrc_ctrl[ui].sFIRF1Ctrl.piIn        = pssrc_ctrl[ui].piIn;
+        *(pssrc_ctrl[ui].ppiOut)            = pssrc_ctrl[ui].piOut;
+        psFIRCtrl[ui]                        = &pssrc_ctrl[ui].sFIRF1Ctrl;
+    }
+
+    // F1 and F2 process
+    // -----------------
+    if(FIR_proc_mc(psFIRCtrl, uiNChannels) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+
+    if(pssrc_ctrl[0].sFIRF2Ctrl.eEnable == FIR_ON)
+    {
+        for(ui = 0; ui < uiNChannels; ui++)
+            psFIRCtrl[ui]                    = &pssrc_ctrl[ui].sFIRF2Ctrl;
+        if(FIR_proc_mc(psFIRCtrl, uiNChannels) != FIR_NO_ERROR)
+            return SSRC_ERROR;
+    }
+
+    // F3 process
+    // ----------
+    if(pssrc_ctrl[0].sPPFIRF3Ctrl.eEnable == FIR_ON)
+    {
+        for(ui = 0; ui < uiNChannels; ui++)
+            psPPFIRCtrl[ui]                    = &pssrc_ctrl[ui].sPPFIRF3Ctrl;
+        if(PPFIR_proc_mc(psPPFIRCtrl, uiNChannels) != FIR_NO_ERROR)
+            return SSRC_ERROR;
+    }
+
+    // Dither process
+    // --------------
+    for(ui = 0; ui < uiNChannels; ui++)
+    {
+        if(SSRC_proc_dither(&pssrc_ctrl[ui]) != SSRC_NO_ERROR)
+            return SSRC_ERROR;
+    }
+
+    return SSRC_NO_ERROR;
+}
+
+#if FIR_FAST_CONV
+// ==================================================================== //
+// Function:        SSRC_fast_conv_init                                    //
+// Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
+//                    ssrc_fast_conv_state_t *psState: Fast conv. state    //
+// Return values:    Number of filters (F1, F2) using fast convolution    //
+// Description:        Switches the F1 and F2 filters of an initialised    //
+//                    SSRC to fast convolution where suited                //
+// ==================================================================== //
+unsigned int                    SSRC_fast_conv_init(ssrc_ctrl_t* pssrc_ctrl, ssrc_fast_conv_state_t* psState)
+{
+    unsigned int    uiNFastConv        = 0;
+
+    if(FIR_fast_conv_init(&pssrc_ctrl->sFIRF1Ctrl, &psState->sFIRF1FastConv) == FIR_NO_ERROR)
+        uiNFastConv++;
+    if(FIR_fast_conv_init(&pssrc_ctrl->sFIRF2Ctrl, &psState->sFIRF2FastConv) == FIR_NO_ERROR)
+        uiNFastConv++;
+
+    return uiNFastConv;
+}
+#endif
+
+
 // ==================================================================== //
 // Function:        SSRC_proc_F1_F2                                        //
 // Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
@@ -386,7 +885,7 @@ SSRCReturnCodes_t                SSRC_proc_F1_F2(ssrc_ctrl_t* pssrc_ctrl)
     if(pssrc_ctrl->sFIRF1Ctrl.eEnable == FIR_OFF)
     {
         // F1 is not enabled, which means that we are in 1:1 rate, so just copy input to output
-        for(ui = 0; ui < pssrc_ctrl->uiNInSamples * pssrc_ctrl->uiNchannels; ui+= pssrc_ctrl->uiNchannels)
+        for(ui = 0; ui < pssrc_ctrl->uiNInSamples * pssrc_ctrl->uiStep; ui+= pssrc_ctrl->uiStep)
             piOut[ui]        = piIn[ui];
 
         return SSRC_NO_ERROR;
@@ -443,8 +942,10 @@ SSRCReturnCodes_t                SSRC_proc_dither(ssrc_ctrl_t* pssrc_ctrl)
     int*            piData;
     unsigned int    uiR;
     int                iDither;
-    __int64_t            i64Acc;
+    __int64            i64Acc;
     unsigned int    ui;
+    unsigned int    uiStep;
+    unsigned int    uiEnd;
 
 
     // Apply dither if required
@@ -454,9 +955,12 @@ SSRCReturnCodes_t                SSRC_proc_dither(ssrc_ctrl_t* pssrc_ctrl)
         piData    = pssrc_ctrl->piOut;
         // Get random seed
         uiR        = pssrc_ctrl->psState->uiRndSeed;
+        // Get step and end of the samples (locals: the stores to piData could alias the ctrl fields)
+        uiStep    = pssrc_ctrl->uiStep;
+        uiEnd    = *(pssrc_ctrl->puiNOutSamples) * uiStep;
 
         // Loop through samples
-        for(ui = 0; ui < *(pssrc_ctrl->puiNOutSamples) * pssrc_ctrl->uiNchannels; ui += pssrc_ctrl->uiNchannels)
+        for(ui = 0; ui < uiEnd; ui += uiStep)
         {
             // Compute dither sample (TPDF)
             iDither        = SSRC_DITHER_BIAS;
@@ -469,15 +973,12 @@ SSRCReturnCodes_t                SSRC_proc_dither(ssrc_ctrl_t* pssrc_ctrl)
             uiR            = (unsigned int)(SSRC_R_CONS + uiR);
             iDither        += ((uiR>>SSRC_RPDF_BITS_SHIFT) & SSRC_RPDF_MASK);
 
-                        //TODO - optimise this and remove IntArithmetic
             // Use MACC instruction to saturate and dither + signal
-            i64Acc        = ((__int64_t)iDither <<32);    // On XMOS this is not necessary, just load dither in the top word of the ACC register
+            i64Acc        = ((__int64)iDither <<32);    // On XMOS this is not necessary, just load dither in the top word of the ACC register
             MACC(&i64Acc, piData[ui], 0x7FFFFFFF);
-
-                        // Saturate to 31 bits
-                        LSAT30(&i64Acc);
-
-                        // Extract 32bits result
+            // Saturate to 31 bits
+            LSAT30(&i64Acc);
+            // Extract 32bits result
             EXT30(&piData[ui], i64Acc);
 
             // Mask to 24bits
@@ -491,3 +992,200 @@ SSRCReturnCodes_t                SSRC_proc_dither(ssrc_ctrl_t* pssrc_ctrl)
 
     return SSRC_NO_ERROR;
 }
+
+
+#if FIR_FLOAT
+// ==================================================================== //
+// Function:        SSRC_float_init                                        //
+// Arguments:        ssrc_float_ctrl_t *pssrc_ctrl: Ctrl strct.            //
+// Return values:    SSRC_NO_ERROR on success                            //
+//                    SSRC_ERROR on failure                                //
+// Description:        Inits the float SSRC passed as argument                //
+//                    (same filters and wiring as SSRC_init)                //
+// ==================================================================== //
+SSRCReturnCodes_t                SSRC_float_init(ssrc_float_ctrl_t* pssrc_ctrl)
+{
+    SSRCFiltersIDs_t            sFiltersID;
+    SSRCFiltersIDs_t*            psFiltersID        = &sFiltersID;
+    FIRDescriptor_t*            psFIRDescriptor;
+    PPFIRDescriptor_t*            psPPFIRDescriptor;
+
+
+    // Check if state is allocated
+    if(pssrc_ctrl->psState == 0)
+        return SSRC_ERROR;
+
+    // Check if stack is allocated
+    if(pssrc_ctrl->pfStack == 0)
+        return SSRC_ERROR;
+
+    // Check that number of input samples is allocated and is a multiple of 4
+    if(pssrc_ctrl->uiNInSamples == 0)
+        return SSRC_ERROR;
+    if((pssrc_ctrl->uiNInSamples & 0x3) != 0x0)
+        return SSRC_ERROR;
+
+    // Choose filters (fails if Fsin and Fsout are not supported)
+    if(SSRC_plan(pssrc_ctrl->uiInFs, pssrc_ctrl->uiOutFs, pssrc_ctrl->uiNInSamples, psFiltersID) != SSRC_NO_ERROR)
+        return SSRC_ERROR;
+
+    // Select inner loop kernels (first call only)
+    src_kernels_init();
+
+    // Filter F1
+    // ---------
+    psFIRDescriptor                                = &sSSRCFirDescriptor[psFiltersID->uiFID[SSRC_F1_INDEX]];
+    pssrc_ctrl->sFIRF1Ctrl.uiNInSamples        = pssrc_ctrl->uiNInSamples;
+    pssrc_ctrl->sFIRF1Ctrl.uiInStep            = pssrc_ctrl->uiNchannels;
+    if( (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_DS_ID) || (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_OS_ID)
+#if SRC_ARBITRARY_FS
+        || (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_DS4_ID)
+        || (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_DS8_ID)
+        || (psFiltersID->uiFID[SSRC_F1_INDEX] == FILTER_DEFS_SSRC_FIR_DS16_ID)
+#endif
+        )
+        pssrc_ctrl->sFIRF1Ctrl.pfDelayB        = pssrc_ctrl->psState->fDelayFIRShort;
+    else
+        pssrc_ctrl->sFIRF1Ctrl.pfDelayB        = pssrc_ctrl->psState->fDelayFIRLong;
+    if(psFiltersID->uiFID[SSRC_F2_INDEX] == FILTER_DEFS_SSRC_FIR_OS_ID)
+        // F2 in use in over-sampling by 2 mode
+        pssrc_ctrl->sFIRF1Ctrl.uiOutStep    = 2 * pssrc_ctrl->uiNchannels;
+    else
+        pssrc_ctrl->sFIRF1Ctrl.uiOutStep    = pssrc_ctrl->uiNchannels;
+
+    if(FIR_float_init_from_desc(&pssrc_ctrl->sFIRF1Ctrl, psFIRDescriptor) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+
+    // Filter F2
+    // ---------
+    psFIRDescriptor                            = &sSSRCFirDescriptor[psFiltersID->uiFID[SSRC_F2_INDEX]];
+    pssrc_ctrl->sFIRF2Ctrl.uiNInSamples        = pssrc_ctrl->sFIRF1Ctrl.uiNOutSamples;
+    pssrc_ctrl->sFIRF2Ctrl.uiInStep            = pssrc_ctrl->sFIRF1Ctrl.uiOutStep;
+    if( (psFiltersID->uiFID[SSRC_F2_INDEX] == FILTER_DEFS_SSRC_FIR_DS_ID) || (psFiltersID->uiFID[SSRC_F2_INDEX] == FILTER_DEFS_SSRC_FIR_OS_ID) )
+        pssrc_ctrl->sFIRF2Ctrl.pfDelayB        = pssrc_ctrl->psState->fDelayFIRShort;
+    else
+        pssrc_ctrl->sFIRF2Ctrl.pfDelayB        = pssrc_ctrl->psState->fDelayFIRLong;
+    pssrc_ctrl->sFIRF2Ctrl.uiOutStep        = pssrc_ctrl->uiNchannels;
+
+    if(FIR_float_init_from_desc(&pssrc_ctrl->sFIRF2Ctrl, psFIRDescriptor) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+
+    // Filter F3
+    // ---------
+    psPPFIRDescriptor                                = &sPPFirDescriptor[psFiltersID->uiFID[SSRC_F3_INDEX]];
+    if(psFiltersID->uiFID[SSRC_F2_INDEX] == FILTER_DEFS_SSRC_FIR_NONE_ID)
+        pssrc_ctrl->sPPFIRF3Ctrl.uiNInSamples    = pssrc_ctrl->sFIRF1Ctrl.uiNOutSamples;
+    else
+        pssrc_ctrl->sPPFIRF3Ctrl.uiNInSamples    = pssrc_ctrl->sFIRF2Ctrl.uiNOutSamples;
+    pssrc_ctrl->sPPFIRF3Ctrl.uiInStep        = pssrc_ctrl->sFIRF2Ctrl.uiOutStep;
+    pssrc_ctrl->sPPFIRF3Ctrl.pfDelayB        = pssrc_ctrl->psState->fDelayPPFIR;
+    pssrc_ctrl->sPPFIRF3Ctrl.uiOutStep        = pssrc_ctrl->uiNchannels;
+    pssrc_ctrl->sPPFIRF3Ctrl.uiPhaseStep    = psFiltersID->uiPPFIRPhaseStep;
+
+    if(PPFIR_float_init_from_desc(&pssrc_ctrl->sPPFIRF3Ctrl, psPPFIRDescriptor) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+
+    // Setup input/output buffers (see SSRC_init)
+    // ------------------------------------------
+    pssrc_ctrl->sFIRF2Ctrl.pfIn                = pssrc_ctrl->pfStack;
+    pssrc_ctrl->sPPFIRF3Ctrl.pfIn            = pssrc_ctrl->pfStack;
+    pssrc_ctrl->sFIRF1Ctrl.pfOut            = pssrc_ctrl->pfStack;
+    pssrc_ctrl->sFIRF2Ctrl.pfOut            = pssrc_ctrl->pfStack;
+
+    if(psFiltersID->uiFID[SSRC_F3_INDEX] != FILTER_DEFS_PPFIR_NONE_ID)
+    {
+        pssrc_ctrl->ppfOut            = &pssrc_ctrl->sPPFIRF3Ctrl.pfOut;
+        pssrc_ctrl->puiNOutSamples    = &pssrc_ctrl->sPPFIRF3Ctrl.uiNOutSamples;
+    }
+    else if(psFiltersID->uiFID[SSRC_F2_INDEX] != FILTER_DEFS_SSRC_FIR_NONE_ID)
+    {
+        pssrc_ctrl->ppfOut            = &pssrc_ctrl->sFIRF2Ctrl.pfOut;
+        pssrc_ctrl->puiNOutSamples    = &pssrc_ctrl->sFIRF2Ctrl.uiNOutSamples;
+    }
+    else
+    {
+        pssrc_ctrl->ppfOut            = &pssrc_ctrl->sFIRF1Ctrl.pfOut;
+        if(psFiltersID->uiFID[SSRC_F1_INDEX] != FILTER_DEFS_SSRC_FIR_NONE_ID)
+            pssrc_ctrl->puiNOutSamples    = &pssrc_ctrl->sFIRF1Ctrl.uiNOutSamples;
+        else
+            pssrc_ctrl->puiNOutSamples    = &pssrc_ctrl->uiNInSamples;
+    }
+
+    // Call sync function
+    if(SSRC_float_sync(pssrc_ctrl) != SSRC_NO_ERROR)
+        return SSRC_ERROR;
+
+    return SSRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        SSRC_float_sync                                        //
+// Arguments:        ssrc_float_ctrl_t *pssrc_ctrl: Ctrl strct.            //
+// Return values:    SSRC_NO_ERROR on success                            //
+//                    SSRC_ERROR on failure                                //
+// Description:        Syncs the float SSRC passed as argument                //
+// ==================================================================== //
+SSRCReturnCodes_t                SSRC_float_sync(ssrc_float_ctrl_t* pssrc_ctrl)
+{
+    // Sync the FIR and PPFIR
+    if(FIR_float_sync(&pssrc_ctrl->sFIRF1Ctrl) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+    if(FIR_float_sync(&pssrc_ctrl->sFIRF2Ctrl) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+    if(PPFIR_float_sync(&pssrc_ctrl->sPPFIRF3Ctrl) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+
+    return SSRC_NO_ERROR;
+}
+
+
+// ==================================================================== //
+// Function:        SSRC_float_proc                                        //
+// Arguments:        ssrc_float_ctrl_t *pssrc_ctrl: Ctrl strct.            //
+// Return values:    SSRC_NO_ERROR on success                            //
+//                    SSRC_ERROR on failure                                //
+// Description:        Processes the float SSRC passed as argument            //
+//                    (F1, F2 and F3, no dither)                            //
+// ==================================================================== //
+SSRCReturnCodes_t                SSRC_float_proc(ssrc_float_ctrl_t* pssrc_ctrl)
+{
+    float*            pfIn        = pssrc_ctrl->pfIn;
+    float*            pfOut        = pssrc_ctrl->pfOut;
+    unsigned int    ui;
+
+    // Setup input / output buffers
+    // ----------------------------
+    pssrc_ctrl->sFIRF1Ctrl.pfIn            = pfIn;
+    *(pssrc_ctrl->ppfOut)                = pfOut;
+
+    // Check if F1 is disabled, in which case we just copy input to output as all filters are disabled
+    if(pssrc_ctrl->sFIRF1Ctrl.eEnable == FIR_OFF)
+    {
+        for(ui = 0; ui < pssrc_ctrl->uiNInSamples * pssrc_ctrl->uiNchannels; ui+= pssrc_ctrl->uiNchannels)
+            pfOut[ui]        = pfIn[ui];
+
+        return SSRC_NO_ERROR;
+    }
+
+    // F1 and F2 process
+    // -----------------
+    if(pssrc_ctrl->sFIRF1Ctrl.pvProc(&pssrc_ctrl->sFIRF1Ctrl) != FIR_NO_ERROR)
+        return SSRC_ERROR;
+    if(pssrc_ctrl->sFIRF2Ctrl.eEnable == FIR_ON)
+    {
+        if(pssrc_ctrl->sFIRF2Ctrl.pvProc(&pssrc_ctrl->sFIRF2Ctrl) != FIR_NO_ERROR)
+            return SSRC_ERROR;
+    }
+
+    // F3 process
+    // ----------
+    if(pssrc_ctrl->sPPFIRF3Ctrl.eEnable == FIR_ON)
+    {
+        if(PPFIR_float_proc(&pssrc_ctrl->sPPFIRF3Ctrl) != FIR_NO_ERROR)
+            return SSRC_ERROR;
+    }
+
+    return SSRC_NO_ERROR;
+}
+#endif // FIR_FLOAT
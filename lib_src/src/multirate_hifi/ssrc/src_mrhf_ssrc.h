@@ -19,6 +19,8 @@
     //
     // ===========================================================================
     #include "src_mrhf_fir.h"
+    #include "src_mrhf_fir_fast_conv.h"
+    #include "src_mrhf_fir_float.h"
     #include "src_mrhf_filter_defs.h"
     #include "src.h"
 
@@ -40,6 +42,18 @@
     #define        SSRC_DITHER_ON_OFF_MIN                SSRC_DITHER_OFF
     #define        SSRC_DITHER_ON_OFF_MAX                SSRC_DITHER_ON
 
+    // Channel batching. When set, ssrc_process() filters the channels of an instance together (up to
+    // FIR_MC_MAX_CHANNELS at a time, see FIR_proc_mc) so each coefficient load is shared by all of them.
+    // Output is unchanged. Each channel must have its own stack buffer. Off by default on xCORE where
+    // the single channel assembler inner loops are used.
+    #ifndef SSRC_CHANNEL_BATCHING
+    #if defined(__xcore__)
+    #define        SSRC_CHANNEL_BATCHING                0
+    #else
+    #define        SSRC_CHANNEL_BATCHING                1
+    #endif
+    #endif
+
 
 
 
@@ -78,11 +92,15 @@
             SSRC_FS_96                                = 3,                                // Fs = 96kHz code
             SSRC_FS_176                                = 4,                                // Fs = 176.4kHz code
             SSRC_FS_192                                = 5,                                // Fs = 192kHz code
+            SSRC_FS_NONE                                = 6,                                // Fs without a code (rates given in Hz)
         } SSRCFs_t;
         #define        SSRC_N_FS                        (SSRC_FS_192 + 1)
         #define        SSRC_FS_MIN                        SSRC_FS_44
         #define        SSRC_FS_MAX                        SSRC_FS_192
 
+        // Sampling rates of the codes above (Hz)
+        extern const unsigned int        uiSSRCFsHz[SSRC_N_FS];
+
 
         // SSRC Filters IDs structure
         // --------------------------
@@ -97,71 +115,133 @@
             unsigned int        uiPPFIRPhaseStep;
         } SSRCFiltersIDs_t;
 
+#if SRC_ARBITRARY_FS
+        // SSRC FIR and PPFIR band edges (for the stage planner)
+        // -----------------------------------------------------
+        typedef struct _SSRCFirBands
+        {
+            unsigned int        uiPass;                                                    // Pass band edge (-0.01dB), in 1/10000 of the coefficients rate (PPFIR: of the input rate)
+            unsigned int        uiStop;                                                    // Stop band edge (-100dB), in 1/10000 of the coefficients rate (PPFIR: of the input rate)
+        } SSRCFirBands_t;
+#endif
+
 
         // SSRC State structure
         // --------------------
         typedef struct _SSRCState
         {
             long long                               pad_to_64b_alignment;
-            int                                        iDelayFIRLong[2 * FILTER_DEFS_FIR_MAX_TAPS_LONG];        // Doubled length for circular buffer simulation
-            int                                        iDelayFIRShort[2 * FILTER_DEFS_FIR_MAX_TAPS_SHORT];        // Doubled length for circular buffer simulation
-            int                                        iDelayPPFIR[2 * FILTER_DEFS_PPFIR_PHASE_MAX_TAPS];        // Doubled length for circular buffer simulation
+            int                                        iDelayFIRLong[FIR_DELAY_LEN(FILTER_DEFS_FIR_MAX_TAPS_LONG)];        // Delay line (see FIR_DELAY_LEN)
+            int                                        iDelayFIRShort[FIR_DELAY_LEN(FILTER_DEFS_SSRC_FIR_MAX_TAPS_SHORT)];        // Delay line (see FIR_DELAY_LEN)
+            int                                        iDelayPPFIR[FIR_DELAY_LEN(FILTER_DEFS_PPFIR_PHASE_MAX_TAPS)];        // Delay line (see FIR_DELAY_LEN)
             unsigned int                            uiRndSeed;                                              // Dither random seeds current values
 
         } ssrc_state_t;
 
 
+#if FIR_FAST_CONV
+        // SSRC Fast convolution state structure
+        // -------------------------------------
+        typedef struct _SSRCFastConvState
+        {
+            FIRFastConvState_t                        sFIRF1FastConv;                                        // F1 fast convolution state
+            FIRFastConvState_t                        sFIRF2FastConv;                                        // F2 fast convolution state
+        } ssrc_fast_conv_state_t;
+#endif
+
+
         // SSRC Control structure
         // ----------------------
         typedef struct _SSRCCtrl
         {
 #ifdef __XC__
+            // Used per block: pointers and counts first, then the filter controllers
             long long                               pad_to_64b_alignment;               //Force compiler to 64b align
-            unsigned int                            uiNchannels;                        // Number of channels in this instance
             int* unsafe                                piIn;                                // Input buffer pointer (PCM, 32bits, 2 channels time domain interleaved data)
-            unsigned int                            uiNInSamples;                        // Number of input samples to process in one call to the processing function
-            SSRCFs_t                                eInFs;                                // Input sampling rate code
             int* unsafe                                piOut;                                // Output buffer poin ter (PCM, 32bits, 2 channels time domain interleaved data)
             unsigned int* unsafe                        puiNOutSamples;                        // Pointer to number of output samples produced during last call to the processing function
-            SSRCFs_t                                eOutFs;                                // Output sampling rate code
-
             int* unsafe * unsafe                            ppiOut;                                // Pointer to (PP)FIR output data pointer for last filter in the chain
+            int* unsafe                                piStack;                            // Pointer to stack buffer
+            ssrc_state_t* unsafe                        psState;                            // Pointer to state structure
+            unsigned int                            uiNchannels;                        // Number of channels in this instance
+            unsigned int                            uiStep;                                // Step between the samples of a channel in the input and output buffers (uiNchannels interleaved, 1 planar)
+            unsigned int                            uiNInSamples;                        // Number of input samples to process in one call to the processing function
+            unsigned int                            uiDitherOnOff;                        // Dither on/off flag
 
             FIRCtrl_t                                sFIRF1Ctrl;                            // F1 FIR controller
             FIRCtrl_t                                sFIRF2Ctrl;                            // F2 FIR controller
             PPFIRCtrl_t                                sPPFIRF3Ctrl;                        // F3 PPFIR controller
 
-            unsigned int                            uiDitherOnOff;                        // Dither on/off flag
+            // Configuration, used at initialisation
+            unsigned int                            uiInFs;                                // Input sampling rate (Hz)
+            unsigned int                            uiOutFs;                            // Output sampling rate (Hz)
+            SSRCFs_t                                eInFs;                                // Input sampling rate code (SSRC_FS_NONE for rates without a code)
+            SSRCFs_t                                eOutFs;                                // Output sampling rate code (SSRC_FS_NONE for rates without a code)
             unsigned int                            uiRndSeedInit;                        // Dither random seed initial value
-
-            ssrc_state_t* unsafe                        psState;                            // Pointer to state structure
-            int* unsafe                                piStack;                            // Pointer to stack buffer
 #else
+            // Used per block: pointers and counts first, then the filter controllers
             long long                               pad_to_64b_alignment;               //Force compiler to 64b align
-            unsigned int                            uiNchannels;                        // Number of channels in this instance
-
             int*                                      piIn;                                // Input buffer pointer (PCM, 32bits, 2 channels time domain interleaved data)
-            unsigned int                            uiNInSamples;                        // Number of input samples to process in one call to the processing function
-            SSRCFs_t                                eInFs;                                // Input sampling rate code
             int*                                      piOut;                                // Output buffer poin ter (PCM, 32bits, 2 channels time domain interleaved data)
             unsigned int*                             puiNOutSamples;                        // Pointer to number of output samples produced during last call to the processing function
-            SSRCFs_t                                eOutFs;                                // Output sampling rate code
-
             int* *                                    ppiOut;                                // Pointer to (PP)FIR output data pointer for last filter in the chain
+            int*                                    piStack;                            // Pointer to stack buffer
+            ssrc_state_t*                              psState;                            // Pointer to state structure
+            unsigned int                            uiNchannels;                        // Number of channels in this instance
+            unsigned int                            uiStep;                                // Step between the samples of a channel in the input and output buffers (uiNchannels interleaved, 1 planar)
+            unsigned int                            uiNInSamples;                        // Number of input samples to process in one call to the processing function
+            unsigned int                            uiDitherOnOff;                        // Dither on/off flag
 
             FIRCtrl_t                                sFIRF1Ctrl;                            // F1 FIR controller
             FIRCtrl_t                                sFIRF2Ctrl;                            // F2 FIR controller
             PPFIRCtrl_t                                sPPFIRF3Ctrl;                        // F3 PPFIR controller
 
-            unsigned int                            uiDitherOnOff;                        // Dither on/off flag
+            // Configuration, used at initialisation
+            unsigned int                            uiInFs;                                // Input sampling rate (Hz)
+            unsigned int                            uiOutFs;                            // Output sampling rate (Hz)
+            SSRCFs_t                                eInFs;                                // Input sampling rate code (SSRC_FS_NONE for rates without a code)
+            SSRCFs_t                                eOutFs;                                // Output sampling rate code (SSRC_FS_NONE for rates without a code)
             unsigned int                            uiRndSeedInit;                        // Dither random seed initial value
-
-            ssrc_state_t*                              psState;                            // Pointer to state structure
-            int*                                    piStack;                            // Pointer to stack buffer
 #endif
         } ssrc_ctrl_t;
 
 
+#if FIR_FLOAT
+        // SSRC float state structure
+        // --------------------------
+        typedef struct _SSRCFloatState
+        {
+            float                                    fDelayFIRLong[FIR_DELAY_LEN(FILTER_DEFS_FIR_MAX_TAPS_LONG)];        // Delay line (see FIR_DELAY_LEN)
+            float                                    fDelayFIRShort[FIR_DELAY_LEN(FILTER_DEFS_SSRC_FIR_MAX_TAPS_SHORT)];    // Delay line (see FIR_DELAY_LEN)
+            float                                    fDelayPPFIR[FIR_DELAY_LEN(FILTER_DEFS_PPFIR_PHASE_MAX_TAPS)];        // Delay line (see FIR_DELAY_LEN)
+        } ssrc_float_state_t;
+
+
+        // SSRC float Control structure
+        // ----------------------------
+        typedef struct _SSRCFloatCtrl
+        {
+            unsigned int                            uiNchannels;                        // Number of channels in this instance
+
+            float*                                    pfIn;                                // Input buffer pointer (full scale +/-1.0, channels time domain interleaved data)
+            unsigned int                            uiNInSamples;                        // Number of input samples to process in one call to the processing function
+            unsigned int                            uiInFs;                                // Input sampling rate (Hz)
+            float*                                    pfOut;                                // Output buffer pointer (full scale +/-1.0, channels time domain interleaved data)
+            unsigned int*                            puiNOutSamples;                        // Pointer to number of output samples produced during last call to the processing function
+            unsigned int                            uiOutFs;                            // Output sampling rate (Hz)
+
+            float**                                    ppfOut;                                // Pointer to (PP)FIR output data pointer for last filter in the chain
+
+            FIRFloatCtrl_t                            sFIRF1Ctrl;                            // F1 FIR controller
+            FIRFloatCtrl_t                            sFIRF2Ctrl;                            // F2 FIR controller
+            PPFIRFloatCtrl_t                        sPPFIRF3Ctrl;                        // F3 PPFIR controller
+
+            ssrc_float_state_t*                        psState;                            // Pointer to state structure
+            float*                                    pfStack;                            // Pointer to stack buffer
+        } ssrc_float_ctrl_t;
+#endif
+
+
         // ===========================================================================
         //
         // Function prototypes
@@ -186,6 +266,45 @@
         // ==================================================================== //
         SSRCReturnCodes_t                SSRC_sync(ssrc_ctrl_t* pssrc_ctrl);
 
+        // ==================================================================== //
+        // Function:        SSRC_set_step                                        //
+        // Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
+        //                    unsigned int uiStep: Step between the samples of    //
+        //                    the channel in the input and output buffers            //
+        // Return values:    SSRC_NO_ERROR on success                            //
+        //                    SSRC_ERROR on failure                                //
+        // Description:        Sets the input and output buffers layout of an        //
+        //                    initialised SSRC: interleaved (uiNchannels) or        //
+        //                    planar (1). The stack uses the same step            //
+        // ==================================================================== //
+        SSRCReturnCodes_t                SSRC_set_step(ssrc_ctrl_t* pssrc_ctrl, unsigned int uiStep);
+
+        // ==================================================================== //
+        // Function:        SSRC_get_stack_length                                //
+        // Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
+        //                    unsigned int *puiStackLength: Stack length            //
+        // Return values:    SSRC_NO_ERROR on success                            //
+        //                    SSRC_ERROR on failure                                //
+        // Description:        Gets the length of the stack used by an SSRC for    //
+        //                    uiInFs, uiOutFs, uiNInSamples and uiNchannels,        //
+        //                    before it is initialised (interleaved or planar        //
+        //                    buffers)                                            //
+        // ==================================================================== //
+        SSRCReturnCodes_t                SSRC_get_stack_length(ssrc_ctrl_t* pssrc_ctrl, unsigned int* puiStackLength);
+
+        // ==================================================================== //
+        // Function:        SSRC_get_delay                                        //
+        // Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
+        //                    long long *pi64Delay: Group delay (Q32 format)        //
+        //                    unsigned long long *pu64OutRatio: Fsout / Fsin    //
+        //                    (Q32 format)                                        //
+        // Return values:    SSRC_NO_ERROR on success                            //
+        //                    SSRC_ERROR on failure                                //
+        // Description:        Gets the group delay at DC of the filters F1, F2    //
+        //                    and F3 in input samples                                //
+        // ==================================================================== //
+        SSRCReturnCodes_t                SSRC_get_delay(ssrc_ctrl_t* pssrc_ctrl, long long* pi64Delay, unsigned long long* pu64OutRatio);
+
         // ==================================================================== //
         // Function:        SSRC_proc                                            //
         // Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
@@ -195,6 +314,59 @@
         // ==================================================================== //
         SSRCReturnCodes_t                SSRC_proc(ssrc_ctrl_t* pssrc_ctrl);
 
+        // ==================================================================== //
+        // Function:        SSRC_proc_mc                                        //
+        // Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct. array        //
+        //                    unsigned int uiNChannels: number of channels        //
+        // Return values:    SSRC_NO_ERROR on success                            //
+        //                    SSRC_ERROR on failure                                //
+        // Description:        Processes uiNChannels SSRC (up to                    //
+        //                    FIR_MC_MAX_CHANNELS) with shared coefficient loads    //
+        // ==================================================================== //
+        SSRCReturnCodes_t                SSRC_proc_mc(ssrc_ctrl_t* pssrc_ctrl, unsigned int uiNChannels);
+
+#if FIR_FAST_CONV
+        // ==================================================================== //
+        // Function:        SSRC_fast_conv_init                                    //
+        // Arguments:        ssrc_ctrl_t     *pssrc_ctrl: Ctrl strct.                //
+        //                    ssrc_fast_conv_state_t *psState: Fast conv. state    //
+        // Return values:    Number of filters (F1, F2) using fast convolution    //
+        // Description:        Switches the F1 and F2 filters of an initialised    //
+        //                    SSRC to fast convolution where suited (see            //
+        //                    FIR_fast_conv_init). SSRC_init switches them back    //
+        // ==================================================================== //
+        unsigned int                    SSRC_fast_conv_init(ssrc_ctrl_t* pssrc_ctrl, ssrc_fast_conv_state_t* psState);
+#endif
+
+#if FIR_FLOAT
+        // ==================================================================== //
+        // Function:        SSRC_float_init                                        //
+        // Arguments:        ssrc_float_ctrl_t *pssrc_ctrl: Ctrl strct.            //
+        // Return values:    SSRC_NO_ERROR on success                            //
+        //                    SSRC_ERROR on failure                                //
+        // Description:        Inits the float SSRC passed as argument                //
+        // ==================================================================== //
+        SSRCReturnCodes_t                SSRC_float_init(ssrc_float_ctrl_t* pssrc_ctrl);
+
+        // ==================================================================== //
+        // Function:        SSRC_float_sync                                        //
+        // Arguments:        ssrc_float_ctrl_t *pssrc_ctrl: Ctrl strct.            //
+        // Return values:    SSRC_NO_ERROR on success                            //
+        //                    SSRC_ERROR on failure                                //
+        // Description:        Syncs the float SSRC passed as argument                //
+        // ==================================================================== //
+        SSRCReturnCodes_t                SSRC_float_sync(ssrc_float_ctrl_t* pssrc_ctrl);
+
+        // ==================================================================== //
+        // Function:        SSRC_float_proc                                        //
+        // Arguments:        ssrc_float_ctrl_t *pssrc_ctrl: Ctrl strct.            //
+        // Return values:    SSRC_NO_ERROR on success                            //
+        //                    SSRC_ERROR on failure                                //
+        // Description:        Processes the float SSRC passed as argument            //
+        // ==================================================================== //
+        SSRCReturnCodes_t                SSRC_float_proc(ssrc_float_ctrl_t* pssrc_ctrl);
+#endif
+
     #endif // nINCLUDE_FROM_ASM
 
 #endif // _SRC_MRHF_SSRC_H_
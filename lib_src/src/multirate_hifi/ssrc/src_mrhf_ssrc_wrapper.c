@@ -4,8 +4,12 @@
 #include <stdio.h>
 #include <time.h>
 #include <math.h>
+#if defined(__xcore__)
 #include <timer.h>
 #include "debug_print.h"
+#else
+#define debug_printf            printf
+#endif
 
 // SSRC includes
 #include "src.h"
@@ -13,13 +17,43 @@
 static void ssrc_error(int code)
 {
     debug_printf("SSRC_proc Error code %d\n", code);
+#if defined(__xcore__)
     delay_milliseconds(1); //Allow xscope to display message before quit
+#endif
     _Exit(code);
 }
 
 
+// Sampling rate of FS code fs (0, which is not supported, for an invalid code)
+static unsigned ssrc_fs_hz(const fs_code_t fs)
+{
+    if (((int)fs < SSRC_FS_MIN) || ((int)fs > SSRC_FS_MAX)) return 0;
+    return uiSSRCFsHz[fs];
+}
+
 void ssrc_init(const fs_code_t sr_in, const fs_code_t sr_out, ssrc_ctrl_t *ssrc_ctrl,
         const unsigned n_channels_per_instance, const unsigned n_in_samples, const dither_flag_t dither_on_off)
+{
+    if (!ssrc_init_hz(ssrc_fs_hz(sr_in), ssrc_fs_hz(sr_out), ssrc_ctrl, n_channels_per_instance, n_in_samples, dither_on_off)) ssrc_error(SSRC_ERROR);
+}
+
+unsigned ssrc_rate_supported(const unsigned fs_in, const unsigned fs_out, const unsigned n_in_samples)
+{
+    ssrc_ctrl_t ssrc_ctrl;
+    unsigned stack_length;
+
+    // SSRC_init needs a multiple of 4 input samples, and its filters are planned as for the stack length
+    if ((n_in_samples == 0) || (n_in_samples & 0x3)) return 0;
+    ssrc_ctrl.uiInFs                        = fs_in;
+    ssrc_ctrl.uiOutFs                       = fs_out;
+    ssrc_ctrl.uiNchannels                   = 1;
+    ssrc_ctrl.uiNInSamples                  = n_in_samples;
+
+    return (SSRC_get_stack_length(&ssrc_ctrl, &stack_length) == SSRC_NO_ERROR);
+}
+
+unsigned ssrc_init_hz(const unsigned fs_in, const unsigned fs_out, ssrc_ctrl_t *ssrc_ctrl,
+        const unsigned n_channels_per_instance, const unsigned n_in_samples, const dither_flag_t dither_on_off)
 {
     SSRCReturnCodes_t ret_code;
     unsigned ui;
@@ -28,6 +62,9 @@ void ssrc_init(const fs_code_t sr_in, const fs_code_t sr_out, ssrc_ctrl_t *ssrc_
     if ((n_in_samples & 0x1) || (n_in_samples < 4)) ssrc_error(100);
     if (n_channels_per_instance < 1) ssrc_error(101);
 
+    //Pairs of rates without a plan are left to the caller
+    if (!ssrc_rate_supported(fs_in, fs_out, n_in_samples)) return 0;
+
     for(ui = 0; ui < n_channels_per_instance; ui++)
     {
         // Set number of channels per instance
@@ -40,30 +77,266 @@ void ssrc_init(const fs_code_t sr_in, const fs_code_t sr_out, ssrc_ctrl_t *ssrc_
         ssrc_ctrl[ui].uiDitherOnOff             = dither_on_off;
         ssrc_ctrl[ui].uiRndSeedInit             = 12345 * ui;   //Some randomish numbers. Value not critical
 
-        // Set the sample rate codes
-        ssrc_ctrl[ui].eInFs                     = (int)sr_in;
-        ssrc_ctrl[ui].eOutFs                    = (int)sr_out;
+        // Set input/output sampling rates
+        ssrc_ctrl[ui].uiInFs                    = fs_in;
+        ssrc_ctrl[ui].uiOutFs                   = fs_out;
 
         // Init SSRC instances
         ret_code = SSRC_init(&ssrc_ctrl[ui]) ;
         if(ret_code != SSRC_NO_ERROR) ssrc_error(ret_code);
     }
+
+    return 1;
 }
 
-unsigned ssrc_process(int in_buff[], int out_buff[], ssrc_ctrl_t *ssrc_ctrl){
+// Rounds an arena block size up to keep the next block SRC_ARENA_ALIGN bytes aligned
+static unsigned ssrc_arena_round(unsigned size)
+{
+    return (size + SRC_ARENA_ALIGN - 1) & ~(SRC_ARENA_ALIGN - 1);
+}
+
+// Stack length of each channel of an instance
+static unsigned ssrc_stack_length(const unsigned fs_in, const unsigned fs_out,
+        const unsigned n_channels_per_instance, const unsigned n_in_samples)
+{
+    ssrc_ctrl_t ssrc_ctrl;
+    unsigned stack_length;
+
+    ssrc_ctrl.uiInFs                        = fs_in;
+    ssrc_ctrl.uiOutFs                       = fs_out;
+    ssrc_ctrl.uiNchannels                   = n_channels_per_instance;
+    ssrc_ctrl.uiNInSamples                  = n_in_samples;
+    if(SSRC_get_stack_length(&ssrc_ctrl, &stack_length) != SSRC_NO_ERROR) ssrc_error(SSRC_ERROR);
+
+    return stack_length;
+}
+
+unsigned ssrc_get_memory_size(const fs_code_t sr_in, const fs_code_t sr_out,
+        const unsigned n_channels_per_instance, const unsigned n_in_samples)
+{
+    unsigned size = ssrc_get_memory_size_hz(ssrc_fs_hz(sr_in), ssrc_fs_hz(sr_out), n_channels_per_instance, n_in_samples);
+
+    if (size == 0) ssrc_error(SSRC_ERROR);
+    return size;
+}
+
+unsigned ssrc_get_memory_size_hz(const unsigned fs_in, const unsigned fs_out,
+        const unsigned n_channels_per_instance, const unsigned n_in_samples)
+{
+    unsigned stack_length;
+
+    //Check to see if n_channels_per_instance, n_in_samples are reasonable
+    if ((n_in_samples & 0x1) || (n_in_samples < 4)) ssrc_error(100);
+    if (n_channels_per_instance < 1) ssrc_error(101);
+
+    //Pairs of rates without a plan are left to the caller
+    if (!ssrc_rate_supported(fs_in, fs_out, n_in_samples)) return 0;
+
+    stack_length = ssrc_stack_length(fs_in, fs_out, n_channels_per_instance, n_in_samples);
+
+    return ssrc_arena_round(n_channels_per_instance * sizeof(ssrc_ctrl_t)) +
+           n_channels_per_instance * (ssrc_arena_round(sizeof(ssrc_state_t)) + ssrc_arena_round(stack_length * sizeof(int)));
+}
+
+void ssrc_init_arena(const fs_code_t sr_in, const fs_code_t sr_out, ssrc_ctrl_t *ssrc_ctrl,
+        const unsigned n_channels_per_instance, const unsigned n_in_samples, const dither_flag_t dither_on_off)
+{
+    if (!ssrc_init_arena_hz(ssrc_fs_hz(sr_in), ssrc_fs_hz(sr_out), ssrc_ctrl, n_channels_per_instance, n_in_samples, dither_on_off)) ssrc_error(SSRC_ERROR);
+}
+
+unsigned ssrc_init_arena_hz(const unsigned fs_in, const unsigned fs_out, ssrc_ctrl_t *ssrc_ctrl,
+        const unsigned n_channels_per_instance, const unsigned n_in_samples, const dither_flag_t dither_on_off)
+{
+    char *arena = (char *)ssrc_ctrl;
+    unsigned stack_length;
+    unsigned ui;
+
+    //Check to see if n_channels_per_instance, n_in_samples and the arena are reasonable
+    if ((n_in_samples & 0x1) || (n_in_samples < 4)) ssrc_error(100);
+    if (n_channels_per_instance < 1) ssrc_error(101);
+    if ((size_t)arena & (SRC_ARENA_ALIGN - 1)) ssrc_error(102);
+
+    //Pairs of rates without a plan are left to the caller
+    if (!ssrc_rate_supported(fs_in, fs_out, n_in_samples)) return 0;
+
+    stack_length = ssrc_stack_length(fs_in, fs_out, n_channels_per_instance, n_in_samples);
+
+    // Control structures first, then the state and stack of each channel
+    arena += ssrc_arena_round(n_channels_per_instance * sizeof(ssrc_ctrl_t));
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        ssrc_ctrl[ui].psState                   = (ssrc_state_t *)arena;
+        arena += ssrc_arena_round(sizeof(ssrc_state_t));
+        ssrc_ctrl[ui].piStack                   = (int *)arena;
+        arena += ssrc_arena_round(stack_length * sizeof(int));
+    }
+
+    return ssrc_init_hz(fs_in, fs_out, ssrc_ctrl, n_channels_per_instance, n_in_samples, dither_on_off);
+}
+
+#if FIR_FAST_CONV
+unsigned ssrc_fast_conv_init(ssrc_ctrl_t *ssrc_ctrl, const unsigned n_channels_per_instance,
+        ssrc_fast_conv_state_t *fast_conv_state)
+{
+    unsigned ui;
+    unsigned n_fast_conv = 0;
+
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        n_fast_conv = SSRC_fast_conv_init(&ssrc_ctrl[ui], &fast_conv_state[ui]);
+    }
+
+    // Same filters and block size for all channels
+    return (n_fast_conv > 0);
+}
+#endif
+
+// Sets the step between the samples of a channel in the input and output buffers of all channels
+static void ssrc_set_step(ssrc_ctrl_t *ssrc_ctrl, unsigned step)
+{
+    SSRCReturnCodes_t ret_code;
+    unsigned ui;
+
+    for(ui = 0; ui < ssrc_ctrl[0].uiNchannels; ui++)
+    {
+        if(ssrc_ctrl[ui].uiStep == step) continue;
+        ret_code = SSRC_set_step(&ssrc_ctrl[ui], step);
+        if(ret_code != SSRC_NO_ERROR) ssrc_error(ret_code);
+    }
+}
 
+// Processes all channels, from the input and output pointers already set
+static unsigned ssrc_process_channels(ssrc_ctrl_t *ssrc_ctrl)
+{
     unsigned ui;
     unsigned n_samps_out;
 
     // Get the number of channels per instance from first channel
     const unsigned n_channels_per_instance = ssrc_ctrl[0].uiNchannels;
 
+#if !SSRC_CHANNEL_BATCHING
     for(ui = 0; ui < n_channels_per_instance; ui++)
     {
-        ssrc_ctrl[ui].piIn = in_buff + ui;
-        ssrc_ctrl[ui].piOut = out_buff + ui;
         if(SSRC_proc(&ssrc_ctrl[ui]) != SSRC_NO_ERROR) ssrc_error(0);
-        n_samps_out = (*ssrc_ctrl[ui].puiNOutSamples);
     }
+#else
+    // Filter the channels together, up to FIR_MC_MAX_CHANNELS at a time
+    for(ui = 0; ui < n_channels_per_instance; ui += FIR_MC_MAX_CHANNELS)
+    {
+        unsigned n_batch = n_channels_per_instance - ui;
+        if (n_batch > FIR_MC_MAX_CHANNELS) n_batch = FIR_MC_MAX_CHANNELS;
+        if(SSRC_proc_mc(&ssrc_ctrl[ui], n_batch) != SSRC_NO_ERROR) ssrc_error(0);
+    }
+#endif
+
+    n_samps_out = (*ssrc_ctrl[n_channels_per_instance - 1].puiNOutSamples);
     return n_samps_out;
 }
+
+unsigned ssrc_process(int in_buff[], int out_buff[], ssrc_ctrl_t *ssrc_ctrl){
+
+    unsigned ui;
+
+    // Get the number of channels per instance from first channel
+    const unsigned n_channels_per_instance = ssrc_ctrl[0].uiNchannels;
+
+    // Interleaved channels
+    ssrc_set_step(ssrc_ctrl, n_channels_per_instance);
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        ssrc_ctrl[ui].piIn = in_buff + ui;
+        ssrc_ctrl[ui].piOut = out_buff + ui;
+    }
+
+    return ssrc_process_channels(ssrc_ctrl);
+}
+
+unsigned ssrc_process_planar(int *in_buff[], int *out_buff[], ssrc_ctrl_t *ssrc_ctrl){
+
+    unsigned ui;
+
+    // Get the number of channels per instance from first channel
+    const unsigned n_channels_per_instance = ssrc_ctrl[0].uiNchannels;
+
+    // One contiguous buffer per channel
+    ssrc_set_step(ssrc_ctrl, 1);
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        ssrc_ctrl[ui].piIn = in_buff[ui];
+        ssrc_ctrl[ui].piOut = out_buff[ui];
+    }
+
+    return ssrc_process_channels(ssrc_ctrl);
+}
+
+void ssrc_get_latency(ssrc_ctrl_t *ssrc_ctrl, src_latency_t *latency)
+{
+    SSRCReturnCodes_t ret_code;
+    long long delay;                // Q32 input samples
+    unsigned long long out_ratio;   // Q32 output samples per input sample
+    long long block = (long long)ssrc_ctrl[0].uiNInSamples << 32;
+
+    // All channels of the instance have the same filters
+    ret_code = SSRC_get_delay(&ssrc_ctrl[0], &delay, &out_ratio);
+    if(ret_code != SSRC_NO_ERROR) ssrc_error(ret_code);
+
+    // Rounded to Q16.16 (the Q32 products do not fit in 64 bits)
+    latency->filters_in     = (unsigned)((delay + (1 << 15)) >> 16);
+    latency->filters_out    = (unsigned)((double)delay * out_ratio / 281474976710656.0 + 0.5);
+    latency->total_in       = (unsigned)((delay + block + (1 << 15)) >> 16);
+    latency->total_out      = (unsigned)((double)(delay + block) * out_ratio / 281474976710656.0 + 0.5);
+}
+
+#if FIR_FLOAT
+void ssrc_float_init(const fs_code_t sr_in, const fs_code_t sr_out, ssrc_float_ctrl_t *ssrc_ctrl,
+        const unsigned n_channels_per_instance, const unsigned n_in_samples)
+{
+    if (!ssrc_float_init_hz(ssrc_fs_hz(sr_in), ssrc_fs_hz(sr_out), ssrc_ctrl, n_channels_per_instance, n_in_samples))
+        ssrc_error(SSRC_ERROR);
+}
+
+unsigned ssrc_float_init_hz(const unsigned fs_in, const unsigned fs_out, ssrc_float_ctrl_t *ssrc_ctrl,
+        const unsigned n_channels_per_instance, const unsigned n_in_samples)
+{
+    SSRCReturnCodes_t ret_code;
+    unsigned ui;
+
+    //Check to see if n_channels_per_instance, n_in_samples are reasonable
+    if ((n_in_samples & 0x1) || (n_in_samples < 4)) ssrc_error(100);
+    if (n_channels_per_instance < 1) ssrc_error(101);
+
+    //Pairs of rates without a plan are left to the caller (same filters as ssrc_init_hz)
+    if (!ssrc_rate_supported(fs_in, fs_out, n_in_samples)) return 0;
+
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        ssrc_ctrl[ui].uiNchannels               = n_channels_per_instance;
+        ssrc_ctrl[ui].uiNInSamples              = n_in_samples;
+        ssrc_ctrl[ui].uiInFs                    = fs_in;
+        ssrc_ctrl[ui].uiOutFs                   = fs_out;
+
+        // Init float SSRC instances
+        ret_code = SSRC_float_init(&ssrc_ctrl[ui]) ;
+        if(ret_code != SSRC_NO_ERROR) ssrc_error(ret_code);
+    }
+
+    return 1;
+}
+
+unsigned ssrc_float_process(float in_buff[], float out_buff[], ssrc_float_ctrl_t *ssrc_ctrl){
+
+    unsigned ui;
+
+    // Get the number of channels per instance from first channel
+    const unsigned n_channels_per_instance = ssrc_ctrl[0].uiNchannels;
+
+    for(ui = 0; ui < n_channels_per_instance; ui++)
+    {
+        ssrc_ctrl[ui].pfIn = in_buff + ui;
+        ssrc_ctrl[ui].pfOut = out_buff + ui;
+        if(SSRC_float_proc(&ssrc_ctrl[ui]) != SSRC_NO_ERROR) ssrc_error(0);
+    }
+
+    return (*ssrc_ctrl[n_channels_per_instance - 1].puiNOutSamples);
+}
+#endif
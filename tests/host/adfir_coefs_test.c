@@ -0,0 +1,54 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the ADFIR filter phases prepared at build time (iADFirCoefs, from
+// src_mrhf_adfir_coefs_generator.py) against the phases built from the ADFIR
+// prototype as the ASRC used to do at init.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+
+// SRC includes
+#include "src.h"
+
+static const int    prototype[FILTER_DEFS_ADFIR_PROTOTYPE_N_TAPS] = {
+    #include FILTER_DEFS_ADFIR_PROTOTYPE_FILE
+};
+
+static int          phases[FILTER_DEFS_ADFIR_N_PHASES + 2][FILTER_DEFS_ADFIR_PHASE_N_TAPS];
+
+int main(void)
+{
+    const int*  piPrototypeCoefs = prototype + FILTER_DEFS_ADFIR_PROTOTYPE_N_TAPS - FILTER_DEFS_ADFIR_N_PHASES;
+    int         failures = 0;
+
+    // Phases which start normally, zero last coefficient
+    for (int ui = 0; ui < FILTER_DEFS_ADFIR_N_PHASES; ui++) {
+        for (int uj = 0; uj < FILTER_DEFS_ADFIR_PHASE_N_TAPS - 1; uj++)
+            phases[ui][uj] = *(piPrototypeCoefs + ui - uj * FILTER_DEFS_ADFIR_N_PHASES);
+        phases[ui][FILTER_DEFS_ADFIR_PHASE_N_TAPS - 1] = 0;
+    }
+    // Two phases which start delayed, zero first coefficient
+    for (int ui = 0; ui < 2; ui++) {
+        phases[FILTER_DEFS_ADFIR_N_PHASES + ui][0] = 0;
+        for (int uj = 0; uj < FILTER_DEFS_ADFIR_PHASE_N_TAPS - 1; uj++)
+            phases[FILTER_DEFS_ADFIR_N_PHASES + ui][uj + 1] = *(piPrototypeCoefs + ui - uj * FILTER_DEFS_ADFIR_N_PHASES);
+    }
+
+    for (int ui = 0; ui < FILTER_DEFS_ADFIR_N_PHASES + 2; ui++) {
+        for (int uj = 0; uj < FILTER_DEFS_ADFIR_PHASE_N_TAPS; uj++) {
+            if (iADFirCoefs[ui][uj] != phases[ui][uj]) {
+                printf("ERROR: phase %d tap %d: %d != %d\n", ui, uj, iADFirCoefs[ui][uj], phases[ui][uj]);
+                failures++;
+            }
+        }
+    }
+
+    // The descriptor used by the ASRC must point at the prepared phases
+    if (sADFirDescriptor.piCoefs != (int *)iADFirCoefs) {
+        printf("ERROR: ADFIR descriptor does not use the prepared phases\n");
+        failures++;
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Reports the quality and throughput of the ASRC F3 coefficients generation
+// the library is built with: spline (default) or dense ADFIR phase table
+// (ASRC_ADFIR_DENSE_PHASES, nearest or linear, see src_mrhf_asrc.h).
+//
+// For a few sample rate pairs, at a deviated Fs ratio, a tone is converted
+// without dither and a sine at the expected output frequency is fitted to the
+// output: the SINAD (signal to residual ratio) must be at least MIN_SINAD_DB,
+// set for each library variant in CMakeLists.txt. The throughput (output
+// samples per second for two channels) is reported only.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#ifndef MIN_SINAD_DB
+#define     MIN_SINAD_DB            150.0
+#endif
+
+#define     N_CHANNELS              2
+#define     N_IN_SAMPLES            16
+#define     N_BLOCKS_SETTLE         32
+#define     N_BLOCKS_MEASURE        256
+#define     N_BLOCKS_THROUGHPUT     20000
+#define     N_OUT_IN_RATIO_MAX      5
+#define     N_OUT_MAX               (N_BLOCKS_MEASURE * N_IN_SAMPLES * N_OUT_IN_RATIO_MAX)
+#define     TONE_AMPLITUDE          0.5
+#define     FS_RATIO_DEVIATION      1.009999
+
+static asrc_state_t             asrc_state[N_CHANNELS];
+static int                      asrc_stack[N_CHANNELS][4 * N_CHANNELS * N_IN_SAMPLES];
+static asrc_ctrl_t              asrc_ctrl[N_CHANNELS];
+static asrc_adfir_coefs_t       asrc_adfir_coefs;
+
+static int                      in_buff[N_IN_SAMPLES * N_CHANNELS];
+static int                      out_buff[N_IN_SAMPLES * N_OUT_IN_RATIO_MAX * N_CHANNELS];
+static double                   out_samples[N_OUT_MAX];
+
+static const unsigned           sample_rates[] = {44100, 48000, 88200, 96000, 176400, 192000};
+
+typedef struct {
+    fs_code_t   fs_in;
+    fs_code_t   fs_out;
+    double      tone_hz;
+} quality_case_t;
+
+static const quality_case_t     cases[] = {
+    {FS_CODE_44, FS_CODE_48, 1000.0},
+    {FS_CODE_44, FS_CODE_48, 15000.0},
+    {FS_CODE_48, FS_CODE_44, 15000.0},
+    {FS_CODE_96, FS_CODE_48, 15000.0},
+    {FS_CODE_48, FS_CODE_192, 19000.0},
+};
+
+static unsigned init_asrc(fs_code_t fs_in, fs_code_t fs_out)
+{
+    setup_asrc(asrc_ctrl, asrc_state, asrc_stack[0], sizeof(asrc_stack[0]) / sizeof(int), &asrc_adfir_coefs, N_CHANNELS);
+    unsigned fs_ratio = asrc_init(fs_in, fs_out, asrc_ctrl, N_CHANNELS, N_IN_SAMPLES, OFF);
+    return (unsigned)(fs_ratio * FS_RATIO_DEVIATION);
+}
+
+int main(void)
+{
+    int     failures = 0;
+
+#if ASRC_ADFIR_DENSE_PHASES
+    printf("F3 coefficients: dense table, %d phases, %s\n", ASRC_ADFIR_DENSE_PHASES, ASRC_ADFIR_DENSE_LINEAR ? "linear" : "nearest");
+#else
+    printf("F3 coefficients: spline\n");
+#endif
+
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const quality_case_t *qc = &cases[c];
+        unsigned    fs_ratio = init_asrc(qc->fs_in, qc->fs_out);
+        double      w_in = 2.0 * M_PI * qc->tone_hz / sample_rates[qc->fs_in];
+        unsigned    n_out = 0;
+
+        for (unsigned b = 0; b < N_BLOCKS_SETTLE + N_BLOCKS_MEASURE; b++) {
+            fill_tone(in_buff, N_IN_SAMPLES, N_CHANNELS, TONE_AMPLITUDE, w_in, b * N_IN_SAMPLES);
+            unsigned n = asrc_process(in_buff, out_buff, fs_ratio, asrc_ctrl);
+            if (b < N_BLOCKS_SETTLE) continue;
+            for (unsigned i = 0; i < n; i++) out_samples[n_out++] = out_buff[i * N_CHANNELS] / 2147483648.0;
+        }
+
+        // Output sample step is fs_ratio input samples
+        double sinad = sinad_db(out_samples, n_out, w_in * fs_ratio / (double)(1 << 28));
+        printf("%u -> %u Hz, %.0f Hz tone: SINAD %.1f dB\n", sample_rates[qc->fs_in], sample_rates[qc->fs_out], qc->tone_hz, sinad);
+        if (sinad < MIN_SINAD_DB) {
+            printf("ERROR: SINAD below %.1f dB\n", MIN_SINAD_DB);
+            failures++;
+        }
+    }
+
+    // Throughput at 44.1 -> 192kHz (most output samples per input sample)
+    {
+        unsigned    fs_ratio = init_asrc(FS_CODE_44, FS_CODE_192);
+        double      n_out = 0.0;
+        clock_t     start;
+        double      seconds;
+
+        fill_tone(in_buff, N_IN_SAMPLES, N_CHANNELS, TONE_AMPLITUDE, 0.1, 0);
+        start = clock();
+        for (unsigned b = 0; b < N_BLOCKS_THROUGHPUT; b++) {
+            n_out += asrc_process(in_buff, out_buff, fs_ratio, asrc_ctrl);
+        }
+        seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+        printf("Throughput 44100 -> 192000 Hz, %d channels: %.2f M output samples/s\n", N_CHANNELS, n_out / seconds / 1e6);
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,218 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the ASRC for sample rates given in Hz (asrc_init_hz(), asrc_change_rate_hz()).
+// For every pair of a set of common rates:
+//  - a plan must exist, with the Fs ratio in Q8.24 format (asrc_get_fs_ratio_frac_bits()) when it
+//    does not fit in Q4.28
+//  - a tone in the pass band, converted at a deviated Fs ratio without dither, must come out with a
+//    SINAD of at least MIN_SINAD_DB
+//  - when downsampling, a tone above the output Nyquist frequency (at ALIAS_TONE x Fout) must come
+//    out below MAX_ALIAS_DB (relative to full scale)
+// The pairs of rates of the FS codes must be bit-exact with asrc_init(), and asrc_change_rate_hz()
+// bit-exact with asrc_init_hz() at the new rates once the filters have been refilled. Pairs of
+// rates without a plan must be reported by asrc_rate_supported() and make asrc_init_hz() and
+// asrc_change_rate_hz() return 0, the latter leaving the instance at its current rates. The rate
+// codes of the control structures (eInFs, eOutFs) must be those of the rates, ASRC_FS_NONE without.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#define     N_CHANNELS              2
+#define     N_IN_SAMPLES            32      // A multiple of 2 x 16 for the decimation by 16
+#define     N_BLOCKS_SETTLE         96      // F1 and F2 delay lines filled (up to 16 x 160 + 176 taps at the input rate)
+#define     N_OUT_MEASURE           2048
+#define     N_OUT_IN_RATIO_MAX      50
+#define     N_BLOCKS_BITEXACT       72
+#define     TONE_AMPLITUDE          0.5
+#define     PASS_TONE               0.3     // Of the lowest of Fsin and Fsout
+#define     ALIAS_TONE              0.6     // Of Fsout, when below ALIAS_TONE_MAX x Fsin
+#define     ALIAS_TONE_MAX          0.45
+#define     FS_RATIO_DEVIATION      1.005
+#define     MIN_SINAD_DB            110.0
+#define     MAX_ALIAS_DB            -95.0
+
+TEST_ASRC_INSTANCES(2, N_CHANNELS, N_IN_SAMPLES);
+
+static int                      in_buff[N_IN_SAMPLES * N_CHANNELS];
+static int                      out_buff[2][N_IN_SAMPLES * N_OUT_IN_RATIO_MAX * N_CHANNELS];
+static double                   out_samples[N_OUT_MEASURE];
+
+static const unsigned           sample_rates[] = {8000, 16000, 22050, 24000, 32000, 44100, 48000, 88200, 96000, 176400, 192000, 352800, 384000};
+#define     N_RATES                 (sizeof(sample_rates) / sizeof(sample_rates[0]))
+
+// Converts a tone of w_in (radians per input sample) at the deviated Fs ratio, returning the number
+// of output samples of channel 0 in out_samples after the filters have settled
+static unsigned convert_tone(unsigned fs_in, unsigned fs_out, double w_in, unsigned *fs_ratio)
+{
+    unsigned n_out = 0;
+
+    *fs_ratio = (unsigned)(asrc_init_hz(fs_in, fs_out, asrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, OFF) * FS_RATIO_DEVIATION);
+    for (unsigned b = 0; n_out < N_OUT_MEASURE; b++) {
+        fill_tone(in_buff, N_IN_SAMPLES, N_CHANNELS, TONE_AMPLITUDE, w_in, b * N_IN_SAMPLES);
+        unsigned n = asrc_process(in_buff, out_buff[0], *fs_ratio, asrc_ctrl[0]);
+        if (b < N_BLOCKS_SETTLE) continue;
+        for (unsigned i = 0; i < n && n_out < N_OUT_MEASURE; i++) out_samples[n_out++] = out_buff[0][i * N_CHANNELS] / 2147483648.0;
+    }
+    return n_out;
+}
+
+// Converts the same blocks with both instances and checks the outputs are bit-exact from block b_check
+static int bitexact(unsigned b_check, double w_in)
+{
+    unsigned fs_ratio = asrc_ctrl[0][0].uiFsRatio;
+    int mismatch = 0;
+
+    for (unsigned b = 0; b < N_BLOCKS_BITEXACT; b++) {
+        fill_tone(in_buff, N_IN_SAMPLES, N_CHANNELS, TONE_AMPLITUDE, w_in, b * N_IN_SAMPLES);
+        unsigned n = asrc_process(in_buff, out_buff[0], fs_ratio, asrc_ctrl[0]);
+        if (asrc_process(in_buff, out_buff[1], fs_ratio, asrc_ctrl[1]) != n) return 0;
+        if (b < b_check) continue;
+        for (unsigned i = 0; i < n * N_CHANNELS; i++) {
+            if (out_buff[0][i] != out_buff[1][i]) mismatch = 1;
+        }
+    }
+    return !mismatch;
+}
+
+int main(void)
+{
+    int     failures = 0;
+    double  worst_sinad = 1000.0, worst_alias = -1000.0;
+    unsigned n_planned = 0;
+
+    TEST_ASRC_SETUP(0);
+    TEST_ASRC_SETUP(1);
+
+    for (unsigned i = 0; i < N_RATES; i++) {
+        for (unsigned o = 0; o < N_RATES; o++) {
+            unsigned    fs_in = sample_rates[i], fs_out = sample_rates[o];
+            double      ratio = (double)fs_in / fs_out;
+            unsigned    fs_min = fs_in < fs_out ? fs_in : fs_out;
+            unsigned    fs_ratio, n_out, frac_bits = (ratio * 1.01 < 16.0) ? 28 : 24;
+
+            if (!asrc_rate_supported(fs_in, fs_out, N_IN_SAMPLES)) {
+                printf("ERROR: %u -> %u Hz: no plan\n", fs_in, fs_out);
+                failures++;
+                continue;
+            }
+            n_planned++;
+
+            // Pass band tone
+            double w_in = 2.0 * M_PI * PASS_TONE * fs_min / fs_in;
+            n_out = convert_tone(fs_in, fs_out, w_in, &fs_ratio);
+            if (asrc_get_fs_ratio_frac_bits(asrc_ctrl[0]) != frac_bits) {
+                printf("ERROR: %u -> %u Hz: Fs ratio with %u fractional bits, %u expected\n",
+                       fs_in, fs_out, asrc_get_fs_ratio_frac_bits(asrc_ctrl[0]), frac_bits);
+                failures++;
+            }
+            double sinad = sinad_db(out_samples, n_out, w_in * fs_ratio / (double)(1 << frac_bits));
+            if (sinad < worst_sinad) worst_sinad = sinad;
+            if (sinad < MIN_SINAD_DB) {
+                printf("ERROR: %u -> %u Hz: SINAD %.1f dB below %.1f dB\n", fs_in, fs_out, sinad, MIN_SINAD_DB);
+                failures++;
+            }
+
+            // Tone above the output Nyquist frequency
+            if (ALIAS_TONE * fs_out < ALIAS_TONE_MAX * fs_in) {
+                n_out = convert_tone(fs_in, fs_out, 2.0 * M_PI * ALIAS_TONE * fs_out / fs_in, &fs_ratio);
+                double alias = level_db(out_samples, n_out);
+                if (alias > worst_alias) worst_alias = alias;
+                if (alias > MAX_ALIAS_DB) {
+                    printf("ERROR: %u -> %u Hz: tone at %.0f Hz comes out at %.1f dB, above %.1f dB\n",
+                           fs_in, fs_out, ALIAS_TONE * fs_out, alias, MAX_ALIAS_DB);
+                    failures++;
+                }
+            }
+        }
+    }
+    printf("%u pairs planned, worst SINAD %.1f dB, worst alias %.1f dB\n", n_planned, worst_sinad, worst_alias);
+
+    // The decimations by four and sixteen need a multiple of 8 and 32 input samples
+    if (asrc_rate_supported(352800, 32000, 12)) {
+        printf("ERROR: 352800 -> 32000 Hz planned for 12 input samples\n");
+        failures++;
+    }
+    if (asrc_rate_supported(384000, 8000, 16)) {
+        printf("ERROR: 384000 -> 8000 Hz planned for 16 input samples\n");
+        failures++;
+    }
+
+    // Unsupported pairs of rates are returned to the caller
+    if (asrc_init_hz(768000, 8000, asrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, OFF) != 0) {
+        printf("ERROR: 768000 -> 8000 Hz initialised\n");
+        failures++;
+    }
+    {
+        unsigned fs_ratio = asrc_init_hz(48000, 16000, asrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, OFF);
+        if ((asrc_change_rate_hz(768000, 8000, asrc_ctrl[1], N_CHANNELS) != 0) ||
+            (asrc_ctrl[1][0].uiInFs != 48000) || (asrc_ctrl[1][N_CHANNELS - 1].uiFsRatio != fs_ratio)) {
+            printf("ERROR: 768000 -> 8000 Hz rate change not rejected\n");
+            failures++;
+        }
+    }
+
+    // Rates of the FS codes: same as asrc_init()
+    for (int fs_in = 0; fs_in < ASRC_N_FS; fs_in++) {
+        for (int fs_out = 0; fs_out < ASRC_N_FS; fs_out++) {
+            dither_flag_t dither = ((fs_in + fs_out) & 1) ? ON : OFF;
+            unsigned fs_ratio = asrc_init(fs_in, fs_out, asrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, dither);
+            if (asrc_init_hz(uiASRCFsHz[fs_in], uiASRCFsHz[fs_out], asrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, dither) != fs_ratio) {
+                printf("ERROR: %d -> %d: nominal Fs ratio differs from asrc_init\n", fs_in, fs_out);
+                failures++;
+            }
+            if ((asrc_ctrl[1][N_CHANNELS - 1].eInFs != fs_in) || (asrc_ctrl[1][N_CHANNELS - 1].eOutFs != fs_out)) {
+                printf("ERROR: %d -> %d: rate codes %d -> %d\n", fs_in, fs_out, asrc_ctrl[1][N_CHANNELS - 1].eInFs, asrc_ctrl[1][N_CHANNELS - 1].eOutFs);
+                failures++;
+            }
+            if (!bitexact(0, 0.1)) {
+                printf("ERROR: %d -> %d: output differs from asrc_init\n", fs_in, fs_out);
+                failures++;
+            }
+        }
+    }
+
+    // Rate changes through the different plans (DS4, DS8, DS16, DS, SYNC and OS2 band limiting filters),
+    // and between the Q4.28 and Q8.24 Fs ratio formats
+    {
+        static const unsigned rates[][2] = {{48000, 16000}, {384000, 32000}, {384000, 8000}, {8000, 44100}, {176400, 8000},
+                                            {352800, 48000}, {22050, 48000}, {96000, 11025}};
+        unsigned fs_ratio = asrc_init_hz(rates[0][0], rates[0][1], asrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, OFF);
+
+        if ((asrc_ctrl[0][0].eInFs != ASRC_FS_48) || (asrc_ctrl[0][0].eOutFs != ASRC_FS_NONE)) {
+            printf("ERROR: 48000 -> 16000 Hz: rate codes %d -> %d\n", asrc_ctrl[0][0].eInFs, asrc_ctrl[0][0].eOutFs);
+            failures++;
+        }
+        for (unsigned r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+            for (unsigned b = 0; b < N_BLOCKS_SETTLE; b++) {
+                fill_tone(in_buff, N_IN_SAMPLES, N_CHANNELS, TONE_AMPLITUDE, 0.05, b * N_IN_SAMPLES);
+                asrc_process(in_buff, out_buff[0], fs_ratio, asrc_ctrl[0]);
+            }
+            if (r + 1 == sizeof(rates) / sizeof(rates[0])) break;
+            fs_ratio = asrc_change_rate_hz(rates[r + 1][0], rates[r + 1][1], asrc_ctrl[0], N_CHANNELS);
+            if (asrc_init_hz(rates[r + 1][0], rates[r + 1][1], asrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, OFF) != fs_ratio) {
+                printf("ERROR: %u -> %u Hz: nominal Fs ratio differs from asrc_init_hz\n", rates[r + 1][0], rates[r + 1][1]);
+                failures++;
+            }
+            for (int ch = 0; ch < N_CHANNELS; ch++) {
+                if ((asrc_ctrl[0][ch].eInFs != asrc_ctrl[1][ch].eInFs) || (asrc_ctrl[0][ch].eOutFs != asrc_ctrl[1][ch].eOutFs)) {
+                    printf("ERROR: %u -> %u Hz: rate codes differ from asrc_init_hz after asrc_change_rate_hz\n", rates[r + 1][0], rates[r + 1][1]);
+                    failures++;
+                }
+                asrc_ctrl[1][ch].iTimeInt = asrc_ctrl[0][ch].iTimeInt;
+                asrc_ctrl[1][ch].uiTimeFract = asrc_ctrl[0][ch].uiTimeFract;
+            }
+            if (!bitexact(N_BLOCKS_SETTLE, 0.05)) {
+                printf("ERROR: %u -> %u Hz: output differs from asrc_init_hz after asrc_change_rate_hz\n", rates[r + 1][0], rates[r + 1][1]);
+                failures++;
+            }
+        }
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,325 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the single arena initialisation (ssrc_init_arena(), asrc_init_arena()) against
+// ssrc_init() and asrc_init() with separately declared structures and stacks of
+// SSRC_STACK_LENGTH_MULT / ASRC_STACK_LENGTH_MULT. For every pair of FS codes, a few channel
+// counts and block sizes:
+//  - the arena is allocated with exactly ssrc/asrc_get_memory_size() bytes, followed by guard
+//    words that must not be written
+//  - the outputs must be bit-exact, block by block, with the ASRC Fs ratio changing from block
+//    to block and dither on
+//  - the arena must not be larger than the separate declarations, but for the alignment padding
+//  - the sizes in Hz (ssrc/asrc_get_memory_size_hz()) must be those of the FS codes
+// The same is checked for ssrc_init_arena_hz() and asrc_init_arena_hz() against ssrc_init_hz()
+// and asrc_init_hz() for a few pairs of rates in Hz, which for unsupported pairs must return 0
+// with a memory size of 0.
+// The memory sizes of stereo instances are printed for information.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#define     N_CHANNELS_MAX          5
+#define     N_IN_SAMPLES_MAX        64
+#define     N_OUT_IN_RATIO_MAX      5
+#define     N_OUT_SAMPLES_MAX       (N_IN_SAMPLES_MAX * N_OUT_IN_RATIO_MAX)
+#define     N_BLOCKS                16
+#define     N_GUARD_WORDS           64
+#define     GUARD_WORD              0x5A5AA5A5
+#define     FS_RATIO_DEVIATION_PPM  5000
+
+// Largest alignment padding of an arena (each structure and stack aligned)
+#define     ARENA_PADDING(n_ch)     ((2 * (n_ch) + 2) * SRC_ARENA_ALIGN)
+
+// Reference instances, declared the usual way
+static ssrc_state_t             ssrc_state[N_CHANNELS_MAX];
+static int                      ssrc_stack[N_CHANNELS_MAX][4 * N_CHANNELS_MAX * N_IN_SAMPLES_MAX];
+static ssrc_ctrl_t              ssrc_ctrl[N_CHANNELS_MAX];
+
+static asrc_state_t             asrc_state[N_CHANNELS_MAX];
+static int                      asrc_stack[N_CHANNELS_MAX][4 * N_CHANNELS_MAX * N_IN_SAMPLES_MAX];
+static asrc_ctrl_t              asrc_ctrl[N_CHANNELS_MAX];
+static asrc_adfir_coefs_t       asrc_adfir_coefs;
+
+static int                      in_buff[N_IN_SAMPLES_MAX * N_CHANNELS_MAX];
+static int                      out_ref[N_OUT_SAMPLES_MAX * N_CHANNELS_MAX];
+static int                      out_arena[N_OUT_SAMPLES_MAX * N_CHANNELS_MAX];
+
+static const unsigned           n_channels[] = {1, 2, N_CHANNELS_MAX};
+static const unsigned           n_in_samples[] = {4, 16, N_IN_SAMPLES_MAX};
+
+// Pairs of rates in Hz for the _hz arena functions: FS code rates, other rates (without a plan
+// for n_in_samples or without SRC_ARBITRARY_FS, the functions must fail) and unsupported rates
+static const unsigned           fs_hz[][2] = {{44100, 48000}, {48000, 16000}, {32000, 48000}, {22050, 96000},
+                                              {96000, 8000}, {384000, 8000}, {48000, 1000}, {0, 48000}};
+
+// Arena of size bytes followed by guard words
+static void *arena_alloc(unsigned size)
+{
+    unsigned *guard;
+    void     *arena = aligned_alloc(SRC_ARENA_ALIGN, (size + N_GUARD_WORDS * sizeof(unsigned) + SRC_ARENA_ALIGN - 1) & ~(SRC_ARENA_ALIGN - 1));
+
+    memset(arena, 0xFF, size);
+    guard = (unsigned *)((char *)arena + size);
+    for (unsigned i = 0; i < N_GUARD_WORDS; i++) {
+        guard[i] = GUARD_WORD;
+    }
+    return arena;
+}
+
+static int guard_intact(void *arena, unsigned size)
+{
+    unsigned *guard = (unsigned *)((char *)arena + size);
+
+    for (unsigned i = 0; i < N_GUARD_WORDS; i++) {
+        if (guard[i] != GUARD_WORD) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void fill_input(unsigned b, unsigned n_ch, unsigned n_in)
+{
+    for (unsigned i = 0; i < n_in; i++) {
+        for (unsigned ch = 0; ch < n_ch; ch++) {
+            unsigned n = b * n_in + i;
+            in_buff[i * n_ch + ch] = (ch == n_ch - 1) ? (rand() - RAND_MAX / 2) * 2 :
+                                     (int)(0.5 * sin(0.03 * (ch + 1) * n) * 2147483647.0);
+        }
+    }
+}
+
+static int compare(const char *name, unsigned fs_in, unsigned fs_out, unsigned n_ch, unsigned n_in, unsigned b,
+                   unsigned n_ref, unsigned n_arena)
+{
+    if (n_ref != n_arena) {
+        printf("ERROR: %s %u -> %u, %u channels, %u samples, block %u: %u output samples, %u expected\n",
+               name, fs_in, fs_out, n_ch, n_in, b, n_arena, n_ref);
+        return 1;
+    }
+    if (memcmp(out_ref, out_arena, n_ref * n_ch * sizeof(int))) {
+        printf("ERROR: %s %u -> %u, %u channels, %u samples, block %u: output differs\n", name, fs_in, fs_out, n_ch, n_in, b);
+        return 1;
+    }
+    return 0;
+}
+
+static int run_ssrc(fs_code_t fs_in, fs_code_t fs_out, unsigned n_ch, unsigned n_in)
+{
+    unsigned     size = ssrc_get_memory_size(fs_in, fs_out, n_ch, n_in);
+    unsigned     size_separate = n_ch * (sizeof(ssrc_ctrl_t) + sizeof(ssrc_state_t) + 4 * n_ch * n_in * sizeof(int));
+    void        *arena = arena_alloc(size);
+    ssrc_ctrl_t *arena_ctrl = (ssrc_ctrl_t *)arena;
+    int          failures = 0;
+
+    if (size > size_separate + ARENA_PADDING(n_ch)) {
+        printf("ERROR: SSRC %d -> %d, %u channels, %u samples: arena of %u bytes, %u declared separately\n",
+               fs_in, fs_out, n_ch, n_in, size, size_separate);
+        failures++;
+    }
+    if (ssrc_get_memory_size_hz(uiSSRCFsHz[fs_in], uiSSRCFsHz[fs_out], n_ch, n_in) != size) {
+        printf("ERROR: SSRC %d -> %d, %u channels, %u samples: arena size in Hz differs\n", fs_in, fs_out, n_ch, n_in);
+        failures++;
+    }
+
+    ssrc_init(fs_in, fs_out, ssrc_ctrl, n_ch, n_in, ON);
+    ssrc_init_arena(fs_in, fs_out, arena_ctrl, n_ch, n_in, ON);
+
+    srand(1);
+    for (unsigned b = 0; b < N_BLOCKS && !failures; b++) {
+        unsigned n_ref, n_arena;
+
+        fill_input(b, n_ch, n_in);
+        n_ref = ssrc_process(in_buff, out_ref, ssrc_ctrl);
+        n_arena = ssrc_process(in_buff, out_arena, arena_ctrl);
+        failures += compare("SSRC", fs_in, fs_out, n_ch, n_in, b, n_ref, n_arena);
+    }
+    if (!guard_intact(arena, size)) {
+        printf("ERROR: SSRC %d -> %d, %u channels, %u samples: written past the arena\n", fs_in, fs_out, n_ch, n_in);
+        failures++;
+    }
+    if (n_ch == 2 && n_in == N_IN_SAMPLES_MAX) {
+        printf("SSRC %d -> %d: %u bytes (%u declared separately)\n", fs_in, fs_out, size, size_separate);
+    }
+    free(arena);
+    return failures;
+}
+
+static int run_asrc(fs_code_t fs_in, fs_code_t fs_out, unsigned n_ch, unsigned n_in)
+{
+    unsigned     size = asrc_get_memory_size(fs_in, fs_out, n_ch, n_in);
+    unsigned     size_separate = n_ch * (sizeof(asrc_ctrl_t) + sizeof(asrc_state_t) + 4 * n_ch * n_in * sizeof(int)) + sizeof(asrc_adfir_coefs_t);
+    void        *arena = arena_alloc(size);
+    asrc_ctrl_t *arena_ctrl = (asrc_ctrl_t *)arena;
+    unsigned     fs_ratio, fs_ratio_arena;
+    int          failures = 0;
+
+    if (size > size_separate + ARENA_PADDING(n_ch)) {
+        printf("ERROR: ASRC %d -> %d, %u channels, %u samples: arena of %u bytes, %u declared separately\n",
+               fs_in, fs_out, n_ch, n_in, size, size_separate);
+        failures++;
+    }
+    if (asrc_get_memory_size_hz(uiASRCFsHz[fs_in], uiASRCFsHz[fs_out], n_ch, n_in) != size) {
+        printf("ERROR: ASRC %d -> %d, %u channels, %u samples: arena size in Hz differs\n", fs_in, fs_out, n_ch, n_in);
+        failures++;
+    }
+
+    fs_ratio = asrc_init(fs_in, fs_out, asrc_ctrl, n_ch, n_in, ON);
+    fs_ratio_arena = asrc_init_arena(fs_in, fs_out, arena_ctrl, n_ch, n_in, ON);
+    if (fs_ratio_arena != fs_ratio) {
+        printf("ERROR: ASRC %d -> %d: Fs ratio 0x%08x, 0x%08x expected\n", fs_in, fs_out, fs_ratio_arena, fs_ratio);
+        failures++;
+    }
+
+    srand(1);
+    for (unsigned b = 0; b < N_BLOCKS && !failures; b++) {
+        unsigned block_ratio, n_ref, n_arena;
+
+        fill_input(b, n_ch, n_in);
+        block_ratio = (unsigned)(fs_ratio * (1.0 + ((rand() % (2 * FS_RATIO_DEVIATION_PPM + 1)) - FS_RATIO_DEVIATION_PPM) * 1e-6));
+        n_ref = asrc_process(in_buff, out_ref, block_ratio, asrc_ctrl);
+        n_arena = asrc_process(in_buff, out_arena, block_ratio, arena_ctrl);
+        failures += compare("ASRC", fs_in, fs_out, n_ch, n_in, b, n_ref, n_arena);
+    }
+    if (!guard_intact(arena, size)) {
+        printf("ERROR: ASRC %d -> %d, %u channels, %u samples: written past the arena\n", fs_in, fs_out, n_ch, n_in);
+        failures++;
+    }
+    if (n_ch == 2 && n_in == N_IN_SAMPLES_MAX) {
+        printf("ASRC %d -> %d: %u bytes (%u declared separately)\n", fs_in, fs_out, size, size_separate);
+    }
+    free(arena);
+    return failures;
+}
+
+static int run_ssrc_hz(unsigned fs_in, unsigned fs_out, unsigned n_ch, unsigned n_in)
+{
+    unsigned     size = ssrc_get_memory_size_hz(fs_in, fs_out, n_ch, n_in);
+    unsigned     size_separate = n_ch * (sizeof(ssrc_ctrl_t) + sizeof(ssrc_state_t) + 4 * n_ch * n_in * sizeof(int));
+    void        *arena = arena_alloc(size ? size : SRC_ARENA_ALIGN);
+    ssrc_ctrl_t *arena_ctrl = (ssrc_ctrl_t *)arena;
+    unsigned     supported = ssrc_rate_supported(fs_in, fs_out, n_in);
+    int          failures = 0;
+
+    if (!supported || !size) {
+        if (size || ssrc_init_arena_hz(fs_in, fs_out, arena_ctrl, n_ch, n_in, ON)) {
+            printf("ERROR: SSRC %u -> %u Hz, %u samples: arena of %u bytes for a pair of rates %s\n",
+                   fs_in, fs_out, n_in, size, supported ? "supported" : "not supported");
+            failures++;
+        }
+        free(arena);
+        return failures;
+    }
+    if (size > size_separate + ARENA_PADDING(n_ch)) {
+        printf("ERROR: SSRC %u -> %u Hz, %u channels, %u samples: arena of %u bytes, %u declared separately\n",
+               fs_in, fs_out, n_ch, n_in, size, size_separate);
+        failures++;
+    }
+
+    ssrc_init_hz(fs_in, fs_out, ssrc_ctrl, n_ch, n_in, ON);
+    if (!ssrc_init_arena_hz(fs_in, fs_out, arena_ctrl, n_ch, n_in, ON)) {
+        printf("ERROR: SSRC %u -> %u Hz: arena not initialised\n", fs_in, fs_out);
+        failures++;
+    }
+
+    srand(1);
+    for (unsigned b = 0; b < N_BLOCKS && !failures; b++) {
+        unsigned n_ref, n_arena;
+
+        fill_input(b, n_ch, n_in);
+        n_ref = ssrc_process(in_buff, out_ref, ssrc_ctrl);
+        n_arena = ssrc_process(in_buff, out_arena, arena_ctrl);
+        failures += compare("SSRC (Hz)", fs_in, fs_out, n_ch, n_in, b, n_ref, n_arena);
+    }
+    if (!guard_intact(arena, size)) {
+        printf("ERROR: SSRC %u -> %u Hz, %u channels, %u samples: written past the arena\n", fs_in, fs_out, n_ch, n_in);
+        failures++;
+    }
+    free(arena);
+    return failures;
+}
+
+static int run_asrc_hz(unsigned fs_in, unsigned fs_out, unsigned n_ch, unsigned n_in)
+{
+    unsigned     size = asrc_get_memory_size_hz(fs_in, fs_out, n_ch, n_in);
+    unsigned     size_separate = n_ch * (sizeof(asrc_ctrl_t) + sizeof(asrc_state_t) + 4 * n_ch * n_in * sizeof(int)) + sizeof(asrc_adfir_coefs_t);
+    void        *arena = arena_alloc(size ? size : SRC_ARENA_ALIGN);
+    asrc_ctrl_t *arena_ctrl = (asrc_ctrl_t *)arena;
+    unsigned     supported = asrc_rate_supported(fs_in, fs_out, n_in);
+    unsigned     fs_ratio, fs_ratio_arena;
+    int          failures = 0;
+
+    if (!supported || !size) {
+        if (size || asrc_init_arena_hz(fs_in, fs_out, arena_ctrl, n_ch, n_in, ON)) {
+            printf("ERROR: ASRC %u -> %u Hz, %u samples: arena of %u bytes for a pair of rates %s\n",
+                   fs_in, fs_out, n_in, size, supported ? "supported" : "not supported");
+            failures++;
+        }
+        free(arena);
+        return failures;
+    }
+    if (size > size_separate + ARENA_PADDING(n_ch)) {
+        printf("ERROR: ASRC %u -> %u Hz, %u channels, %u samples: arena of %u bytes, %u declared separately\n",
+               fs_in, fs_out, n_ch, n_in, size, size_separate);
+        failures++;
+    }
+
+    fs_ratio = asrc_init_hz(fs_in, fs_out, asrc_ctrl, n_ch, n_in, ON);
+    fs_ratio_arena = asrc_init_arena_hz(fs_in, fs_out, arena_ctrl, n_ch, n_in, ON);
+    if (fs_ratio_arena != fs_ratio) {
+        printf("ERROR: ASRC %u -> %u Hz: Fs ratio 0x%08x, 0x%08x expected\n", fs_in, fs_out, fs_ratio_arena, fs_ratio);
+        failures++;
+    }
+
+    srand(1);
+    for (unsigned b = 0; b < N_BLOCKS && !failures; b++) {
+        unsigned block_ratio, n_ref, n_arena;
+
+        fill_input(b, n_ch, n_in);
+        block_ratio = (unsigned)(fs_ratio * (1.0 + ((rand() % (2 * FS_RATIO_DEVIATION_PPM + 1)) - FS_RATIO_DEVIATION_PPM) * 1e-6));
+        n_ref = asrc_process(in_buff, out_ref, block_ratio, asrc_ctrl);
+        n_arena = asrc_process(in_buff, out_arena, block_ratio, arena_ctrl);
+        failures += compare("ASRC (Hz)", fs_in, fs_out, n_ch, n_in, b, n_ref, n_arena);
+    }
+    if (!guard_intact(arena, size)) {
+        printf("ERROR: ASRC %u -> %u Hz, %u channels, %u samples: written past the arena\n", fs_in, fs_out, n_ch, n_in);
+        failures++;
+    }
+    free(arena);
+    return failures;
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    setup_ssrc(ssrc_ctrl, ssrc_state, ssrc_stack[0], sizeof(ssrc_stack[0]) / sizeof(int), N_CHANNELS_MAX);
+    setup_asrc(asrc_ctrl, asrc_state, asrc_stack[0], sizeof(asrc_stack[0]) / sizeof(int), &asrc_adfir_coefs, N_CHANNELS_MAX);
+
+    for (fs_code_t fs_in = FS_CODE_44; fs_in <= FS_CODE_192; fs_in++) {
+        for (fs_code_t fs_out = FS_CODE_44; fs_out <= FS_CODE_192; fs_out++) {
+            for (unsigned c = 0; c < sizeof(n_channels) / sizeof(n_channels[0]); c++) {
+                for (unsigned s = 0; s < sizeof(n_in_samples) / sizeof(n_in_samples[0]); s++) {
+                    failures += run_ssrc(fs_in, fs_out, n_channels[c], n_in_samples[s]);
+                    failures += run_asrc(fs_in, fs_out, n_channels[c], n_in_samples[s]);
+                }
+            }
+        }
+    }
+
+    for (unsigned p = 0; p < sizeof(fs_hz) / sizeof(fs_hz[0]); p++) {
+        for (unsigned s = 0; s < sizeof(n_in_samples) / sizeof(n_in_samples[0]); s++) {
+            failures += run_ssrc_hz(fs_hz[p][0], fs_hz[p][1], 2, n_in_samples[s]);
+            failures += run_asrc_hz(fs_hz[p][0], fs_hz[p][1], 2, n_in_samples[s]);
+        }
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
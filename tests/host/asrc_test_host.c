@@ -0,0 +1,228 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Host (non xCORE) equivalent of asrc_test.xc. Takes the same arguments and
+// produces the same output files, so results can be checked against the
+// golden files in asrc_test/expected.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// ASRC includes
+#include "src.h"
+
+//General ASRC configuration defines
+#define     ASRC_N_CHANNELS                  2  //Total number of audio channels to be processed by SRC (minimum 1)
+
+#define     ASRC_N_INSTANCES                 1  //Number of instances (each usuall run a logical core) used to process audio (minimum 1)
+#define     ASRC_CHANNELS_PER_INSTANCE       (ASRC_N_CHANNELS/ASRC_N_INSTANCES)
+                                                //Calcualted number of audio channels processed by each core
+#define     ASRC_N_IN_SAMPLES                4  //Number of samples per channel in each block passed into SRC each call
+                                                //Must be a power of 2 and minimum value is 4 (due to two /2 decimation stages)
+#define     ASRC_N_OUT_IN_RATIO_MAX          5  //Max ratio between samples out:in per processing step (44.1->192 is worst case)
+#define     ASRC_DITHER_SETTING              OFF//Enables or disables quantisation of output with dithering to 24b
+
+#include "src_mrhf_asrc_checks.h"               //Do some checking on the defines above
+
+//Input and output files
+char *pzInFileName[ASRC_N_CHANNELS] = {NULL};
+char *pzOutFileName[ASRC_N_CHANNELS] = {NULL};
+
+//Number of samples to process
+int uiNTotalInSamples = -1;
+
+//Input and output frequency indicies. See src_mrhf_asrc.h ASRCFs_t for these codes. 0=44.1 - 5=192
+int uiInFs = -1;
+int uiOutFs = -1;
+
+//Global deviation ratio from nominal sample rate in/out ratio. Initialise to invalid.
+float fFsRatioDeviation = -1.0000;
+
+const int sample_rates[] = {44100, 48000, 88200, 96000, 176400, 192000};
+
+void ShowUsage()
+{
+    puts(
+        "Usage: asrc_test_host <args>\n\n"
+        "         -i     Q1.31 line separated format input file names (eg. -i in_l.dat in_r.dat)\n\n"
+        "         -o     Q1.31 line separated format output file names (eg. -o out_l.dat out_r.dat)\n\n"
+        "         -h     Show this usage message and abort\n\n"
+        "         -f     Input sample rate (44100 - 192000)\n\n"
+        "         -g     Output sample rate (44100 - 192000)\n\n"
+        "         -n     Number of input samples (all channels) to process\n\n"
+        "         -e     Fs ratio deviation from nominal (eg. 1.000000)\n\n"
+        );
+
+    exit(0);
+}
+
+//Helper function for converting SR to index value
+int samp_rate_to_code(int samp_rate){
+    int samp_code = -1;
+    for (int i = 0; i < sizeof(sample_rates) / sizeof(sample_rates[0]); i++) {
+        if (sample_rates[i] == samp_rate) samp_code = i;
+    }
+    return samp_code;
+}
+
+void ParseCmdLine(int argc, char *argv[])
+{
+    for (int ui = 1; ui < argc; ui++)
+    {
+        if (*(argv[ui]) != '-') continue;
+        if (ui + 1 >= argc) ShowUsage();
+
+        switch (argv[ui][1])
+        {
+        case 'i':
+        case 'I':
+            if (ui + ASRC_N_CHANNELS >= argc) {
+                printf("ERROR: expecting %d input file names\n", ASRC_N_CHANNELS);
+                exit(1);
+            }
+            for (int i=0; i<ASRC_N_CHANNELS; i++) pzInFileName[i] = argv[ui + 1 + i];
+            break;
+
+        case 'o':
+        case 'O':
+            if (ui + ASRC_N_CHANNELS >= argc) {
+                printf("ERROR: expecting %d output file names\n", ASRC_N_CHANNELS);
+                exit(1);
+            }
+            for (int i=0; i<ASRC_N_CHANNELS; i++) pzOutFileName[i] = argv[ui + 1 + i];
+            break;
+
+        case 'f':
+        case 'F':
+            uiInFs = samp_rate_to_code(atoi(argv[ui + 1]));
+            if((uiInFs < ASRC_FS_MIN) || (uiInFs > ASRC_FS_MAX))
+            {
+                printf("ERROR: invalid frequency index %d\n", uiInFs);
+                exit(1);
+            }
+            break;
+
+        case 'g':
+        case 'G':
+            uiOutFs = samp_rate_to_code(atoi(argv[ui + 1]));
+            if((uiOutFs < ASRC_FS_MIN) || (uiOutFs > ASRC_FS_MAX))
+            {
+                printf("ERROR: invalid frequency index %d\n", uiOutFs);
+                exit(1);
+            }
+            break;
+
+        case 'e':
+        case 'E':
+            fFsRatioDeviation = (float)atof(argv[ui + 1]);
+            //Note no check. This is done at run-time.
+            break;
+
+        case 'n':
+        case 'N':
+            uiNTotalInSamples = atoi(argv[ui + 1]);
+            break;
+
+        default:
+            ShowUsage();
+            break;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    asrc_state_t     asrc_state[ASRC_CHANNELS_PER_INSTANCE];                  //ASRC state machine state
+    int              asrc_stack[ASRC_CHANNELS_PER_INSTANCE][ASRC_STACK_LENGTH_MULT * ASRC_N_IN_SAMPLES];  //Buffer between filter stages
+    asrc_ctrl_t      asrc_ctrl[ASRC_CHANNELS_PER_INSTANCE];                   //Control structure
+    asrc_adfir_coefs_t asrc_adfir_coefs;                                      //Adaptive filter coefficients
+
+    int              in_buff[ASRC_N_IN_SAMPLES * ASRC_CHANNELS_PER_INSTANCE];
+    int              out_buff[ASRC_N_IN_SAMPLES * ASRC_N_OUT_IN_RATIO_MAX * ASRC_CHANNELS_PER_INSTANCE];
+
+    FILE             *InFileDat[ASRC_N_CHANNELS];
+    FILE             *OutFileDat[ASRC_N_CHANNELS];
+
+    unsigned         count_in = 0, count_out = 0;
+    clock_t          t_dsp = 0, t1;
+
+    printf("Running ASRC test (host)\n");
+
+    if (argc == 1) ShowUsage();
+    ParseCmdLine(argc, argv);
+
+    //Test for valid arguments
+    if ((uiNTotalInSamples == -1) || (uiInFs == -1) || (uiOutFs == -1) || (fFsRatioDeviation < 0) ||
+        (pzInFileName[0] == NULL) || (pzOutFileName[0] == NULL))
+    {
+        printf("ERROR: input/output files, number of input samples, sample rates and deviation must be set\n");
+        exit(1);
+    }
+
+    for (int i=0; i<ASRC_N_CHANNELS; i++)
+    {
+        if ((InFileDat[i] = fopen(pzInFileName[i], "rt")) == NULL)
+        {
+            printf("Error while opening input file, %s\n", pzInFileName[i]);
+            exit(1);
+        }
+        if ((OutFileDat[i] = fopen(pzOutFileName[i], "wt")) == NULL)
+        {
+            printf("Error while opening output file, %s\n", pzOutFileName[i]);
+            exit(1);
+        }
+    }
+
+    // Set state, stack and coefs into ctrl structures
+    for(int ui = 0; ui < ASRC_CHANNELS_PER_INSTANCE; ui++)
+    {
+        asrc_ctrl[ui].psState                   = &asrc_state[ui];
+        asrc_ctrl[ui].piStack                   = asrc_stack[ui];
+        asrc_ctrl[ui].piADCoefs                 = asrc_adfir_coefs.iASRCADFIRCoefs;
+    }
+
+    unsigned nominal_FsRatio = asrc_init(uiInFs, uiOutFs, asrc_ctrl, ASRC_CHANNELS_PER_INSTANCE, ASRC_N_IN_SAMPLES, ASRC_DITHER_SETTING);
+    printf("DSP init Initial nominal_FsRatio=%d, SR in=%d, SR out=%d\n", nominal_FsRatio, uiInFs, uiOutFs);
+
+    unsigned FsRatio = (unsigned) (((unsigned long long)sample_rates[uiInFs] * (unsigned long long)(1<<28)) / (unsigned long long)sample_rates[uiOutFs]);
+    FsRatio =  (unsigned int)((float)FsRatio * fFsRatioDeviation); //Ensure is precisely the same as golden value complete with trucation due to 32b float
+
+    while(count_in + ASRC_N_IN_SAMPLES <= uiNTotalInSamples)
+    {
+        for(unsigned i = 0; i < ASRC_N_IN_SAMPLES * ASRC_CHANNELS_PER_INSTANCE; i++)
+        {
+            int samp;
+            if (fscanf(InFileDat[i % ASRC_N_CHANNELS], "%i\n", &samp) != 1)
+            {
+                printf("ERROR: input file too short\n");
+                exit(1);
+            }
+            in_buff[i] = samp;
+        }
+        count_in += ASRC_N_IN_SAMPLES;
+
+        t1 = clock();
+        unsigned n_samps = asrc_process(in_buff, out_buff, FsRatio, asrc_ctrl);
+        t_dsp += clock() - t1;
+
+        for(unsigned i = 0; i < n_samps * ASRC_CHANNELS_PER_INSTANCE; i++)
+        {
+            if(fprintf(OutFileDat[i % ASRC_N_CHANNELS], "%i\n", out_buff[i]) < 0)
+                printf("Error while writing to output file\n");
+        }
+        count_out += n_samps;
+    }
+
+    printf("DSP manager done - %d output samples produced, %.3f us processing per input sample per channel\n",
+        count_out, (1e6 * t_dsp / CLOCKS_PER_SEC) / ((double)count_in * ASRC_CHANNELS_PER_INSTANCE));
+
+    for (int i=0; i<ASRC_N_CHANNELS; i++)
+    {
+        fclose(InFileDat[i]);
+        fclose(OutFileDat[i]);
+    }
+
+    return 0;
+}
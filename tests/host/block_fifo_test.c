@@ -0,0 +1,199 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the lock-free block FIFO (src_block_fifo_*()):
+//  - blocks of varying sizes written through the write windows come out in order, over many
+//    wraps of the FIFO, with the fill level following the frames written and read
+//  - a block committed when the FIFO cannot hold a full write window is dropped and counted, as
+//    is a commit of more frames than the write window holds, and a read from an empty FIFO leaves
+//    the frame untouched and is counted, the FIFO carrying on from there
+//  - a producer and a consumer thread passing N_FRAMES_THREADED frames lose or reorder none
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+
+// SRC includes
+#include "src.h"
+
+#define     N_CHANNELS              2
+#define     N_FRAMES                100     // Not a power of 2
+#define     MAX_WRITE               24
+#define     N_FRAMES_WRAPS          100000
+#define     N_FRAMES_THREADED       2000000
+
+static int                  fifo_buff[SRC_BLOCK_FIFO_BUFF_LEN(N_FRAMES, MAX_WRITE, N_CHANNELS)];
+static src_block_fifo_t     fifo;
+
+// Frame number n, inverted on channel 1
+static void make_frame(int frame[], unsigned n)
+{
+    frame[0] = (int)n;
+    frame[1] = -(int)n;
+}
+
+static int check_frame(const int frame[], unsigned n)
+{
+    if (frame[0] != (int)n || frame[1] != -(int)n) {
+        printf("ERROR: frame %u read as {%d, %d}\n", n, frame[0], frame[1]);
+        return 1;
+    }
+    return 0;
+}
+
+// Block sizes of 1 to MAX_WRITE frames (linear congruential)
+static unsigned next_block_size(unsigned *seed)
+{
+    *seed = *seed * 1664525 + 1013904223;
+    return 1 + (*seed >> 16) % MAX_WRITE;
+}
+
+static int test_wraps(void)
+{
+    unsigned seed = 1, n_written = 0, n_read = 0;
+    int      frame[N_CHANNELS];
+    int      failures = 0;
+
+    src_block_fifo_init(&fifo, fifo_buff, N_FRAMES, N_CHANNELS, MAX_WRITE);
+    while (n_read < N_FRAMES_WRAPS && !failures) {
+        // Fill up to the last full window, then read a block back
+        while (src_block_fifo_fill_level(&fifo) <= N_FRAMES - MAX_WRITE) {
+            int     *window = src_block_fifo_write_window(&fifo);
+            unsigned n = next_block_size(&seed);
+
+            for (unsigned i = 0; i < n; i++) make_frame(&window[i * N_CHANNELS], n_written++);
+            src_block_fifo_write_commit(&fifo, n);
+        }
+        for (unsigned n = next_block_size(&seed) * 3; n > 0 && src_block_fifo_fill_level(&fifo) && !failures; n--) {
+            src_block_fifo_read(&fifo, frame);
+            failures += check_frame(frame, n_read++);
+        }
+        if (src_block_fifo_fill_level(&fifo) != n_written - n_read) {
+            printf("ERROR: fill level %u, expected %u\n", src_block_fifo_fill_level(&fifo), n_written - n_read);
+            failures++;
+        }
+    }
+    if (fifo.n_overflows || fifo.n_underflows) {
+        printf("ERROR: %u overflows and %u underflows without slipping\n", fifo.n_overflows, fifo.n_underflows);
+        failures++;
+    }
+    return failures;
+}
+
+static int test_slips(void)
+{
+    unsigned n_written = 0, n_read = 0;
+    int      frame[N_CHANNELS] = {12345, 678};
+    int      failures = 0;
+    int     *window;
+
+    // Underflow: the frame is left as it was
+    src_block_fifo_init(&fifo, fifo_buff, N_FRAMES, N_CHANNELS, MAX_WRITE);
+    if (src_block_fifo_read(&fifo, frame) || frame[0] != 12345 || frame[1] != 678 || fifo.n_underflows != 1) {
+        printf("ERROR: read from an empty FIFO\n");
+        failures++;
+    }
+
+    // Overflow: full windows until there is no room for one, then the next block is dropped
+    while (src_block_fifo_fill_level(&fifo) <= N_FRAMES - MAX_WRITE) {
+        window = src_block_fifo_write_window(&fifo);
+        for (unsigned i = 0; i < MAX_WRITE; i++) make_frame(&window[i * N_CHANNELS], n_written++);
+        src_block_fifo_write_commit(&fifo, MAX_WRITE);
+    }
+    window = src_block_fifo_write_window(&fifo);
+    for (unsigned i = 0; i < MAX_WRITE; i++) make_frame(&window[i * N_CHANNELS], 0xdead);
+    src_block_fifo_write_commit(&fifo, MAX_WRITE);
+    if (fifo.n_overflows != 1 || src_block_fifo_fill_level(&fifo) != n_written) {
+        printf("ERROR: block committed to a full FIFO not dropped\n");
+        failures++;
+    }
+
+    // The frames before the overflow are intact, then the FIFO carries on
+    while (src_block_fifo_read(&fifo, frame)) failures += check_frame(frame, n_read++);
+    window = src_block_fifo_write_window(&fifo);
+    for (unsigned i = 0; i < MAX_WRITE; i++) make_frame(&window[i * N_CHANNELS], n_written++);
+    src_block_fifo_write_commit(&fifo, MAX_WRITE);
+    while (src_block_fifo_read(&fifo, frame)) failures += check_frame(frame, n_read++);
+    if (n_read != n_written || fifo.n_overflows != 1 || fifo.n_underflows != 3) {
+        printf("ERROR: %u of %u frames read after the slips, %u overflows, %u underflows\n",
+               n_read, n_written, fifo.n_overflows, fifo.n_underflows);
+        failures++;
+    }
+
+    // Commit larger than the write window: dropped, then the FIFO carries on
+    window = src_block_fifo_write_window(&fifo);
+    for (unsigned i = 0; i < MAX_WRITE; i++) make_frame(&window[i * N_CHANNELS], 0xdead);
+    src_block_fifo_write_commit(&fifo, MAX_WRITE + 1);
+    if (fifo.n_overflows != 2 || src_block_fifo_fill_level(&fifo) != 0) {
+        printf("ERROR: commit of %u frames to a window of %u not dropped\n", MAX_WRITE + 1, MAX_WRITE);
+        failures++;
+    }
+    window = src_block_fifo_write_window(&fifo);
+    for (unsigned i = 0; i < MAX_WRITE; i++) make_frame(&window[i * N_CHANNELS], n_written++);
+    src_block_fifo_write_commit(&fifo, MAX_WRITE);
+    while (src_block_fifo_read(&fifo, frame)) failures += check_frame(frame, n_read++);
+    if (n_read != n_written) {
+        printf("ERROR: %u of %u frames read after the oversized commit\n", n_read, n_written);
+        failures++;
+    }
+    return failures;
+}
+
+static void *producer(void *arg)
+{
+    unsigned seed = 2, n_written = 0;
+
+    (void)arg;
+    while (n_written < N_FRAMES_THREADED) {
+        int     *window;
+        unsigned n = next_block_size(&seed);
+
+        if (n > N_FRAMES_THREADED - n_written) n = N_FRAMES_THREADED - n_written;
+        while (src_block_fifo_fill_level(&fifo) > N_FRAMES - MAX_WRITE) sched_yield();    // Wait for room, no dropped blocks
+        window = src_block_fifo_write_window(&fifo);
+        for (unsigned i = 0; i < n; i++) make_frame(&window[i * N_CHANNELS], n_written++);
+        src_block_fifo_write_commit(&fifo, n);
+    }
+    return NULL;
+}
+
+static int test_threads(void)
+{
+    pthread_t thread;
+    unsigned  n_read = 0;
+    int       frame[N_CHANNELS];
+    int       failures = 0;
+
+    src_block_fifo_init(&fifo, fifo_buff, N_FRAMES, N_CHANNELS, MAX_WRITE);
+    if (pthread_create(&thread, NULL, producer, NULL)) {
+        printf("ERROR: cannot create the producer thread\n");
+        return 1;
+    }
+    while (n_read < N_FRAMES_THREADED) {
+        if (!src_block_fifo_fill_level(&fifo)) {
+            sched_yield();  // Wait for frames, no underflows
+            continue;
+        }
+        src_block_fifo_read(&fifo, frame);
+        if (failures < 10) failures += check_frame(frame, n_read);    // Keep draining for the producer
+        n_read++;
+    }
+    pthread_join(thread, NULL);
+    if (fifo.n_overflows || fifo.n_underflows) {
+        printf("ERROR: %u overflows and %u underflows between threads\n", fifo.n_overflows, fifo.n_underflows);
+        failures++;
+    }
+    return failures;
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    failures += test_wraps();
+    failures += test_slips();
+    failures += test_threads();
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
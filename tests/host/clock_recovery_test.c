@@ -0,0 +1,192 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Clock drift simulator for the clock recovery loop (src_clock_recovery_*()).
+// An input and an output clock, each drifting from nominal (an offset, a ramp and a slow wander
+// in ppm), feed an ASRC modelled by its output sample count (one output every Fs ratio input
+// samples) writing blocks into a block FIFO read by the output clock. As in AN00231, the
+// input and output samples are counted over SR_CALC_PERIOD with timestamps of the last sample
+// counted (with TIMESTAMP_JITTER ticks of jitter) and the FIFO level is read at the same time.
+// For each scenario, after SETTLE_SECONDS:
+//  - the FIFO level must stay within MAX_LEVEL_ERROR frames of the target, with no overflow or
+//    underflow
+//  - the Fs ratio must follow the ratio of the drifting clocks within MAX_RATIO_ERROR_PPM (RMS)
+// The fixed gain and low pass filter of the AN00231 rate server (before the clock recovery
+// loop) are run on the same clocks for comparison. The Fs ratios are in Q4.28 format, or in
+// Q8.24 format for the ratio of 16 and above of the last scenario (asrc_get_fs_ratio_frac_bits()).
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+
+#define     TICKS_PER_SECOND        100000000   // xCORE reference clock
+#define     SR_CALC_PERIOD          2000000     // 20ms
+#define     TIMESTAMP_JITTER        100         // +/-1us
+#define     N_IN_SAMPLES            8           // As AN00231
+#define     MAX_BLOCK               (N_IN_SAMPLES * 3)
+#define     FIFO_FRAMES             (MAX_BLOCK * 4) // Half the FIFO of AN00231
+#define     TARGET_LEVEL            (FIFO_FRAMES / 2)
+#define     BANDWIDTH_MHZ           20
+#define     MAX_DEVIATION_PPM       10000
+#define     SIM_SECONDS             120.0
+#define     SETTLE_SECONDS          20.0
+#define     MAX_LEVEL_ERROR         16
+#define     MAX_RATIO_ERROR_PPM     20.0
+
+// AN00231 rate server loop, for comparison
+#define     BUFFER_LEVEL_TERM       20000
+#define     OLD_VAL_WEIGHTING       5
+
+typedef struct scenario_t {
+    unsigned fs_in, fs_out;
+    double   in_ppm, in_ppm_per_s;      // Input clock offset and ramp
+    double   out_ppm, out_ppm_per_s;    // Output clock offset and ramp
+    double   wander_ppm;                // Amplitude of a 30s period wander of the output clock
+    unsigned frac_bits;                 // Fractional bits of the Fs ratios
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+    {48000, 48000, 100.0, 0.0, -50.0, 0.0, 0.0, SRC_FS_RATIO_FRAC_BITS},
+    {44100, 48000, -80.0, 0.5, 30.0, 0.0, 20.0, SRC_FS_RATIO_FRAC_BITS},
+    {48000, 44100, 0.0, 0.0, 200.0, -2.0, 50.0, SRC_FS_RATIO_FRAC_BITS},
+    {96000, 48000, 50.0, 1.0, -50.0, 0.0, 10.0, SRC_FS_RATIO_FRAC_BITS},
+    {44100, 96000, -300.0, 0.0, 300.0, 0.0, 0.0, SRC_FS_RATIO_FRAC_BITS},
+    {384000, 16000, 60.0, 0.5, -40.0, 0.0, 20.0, SRC_FS_RATIO_FRAC_BITS_WIDE},
+};
+
+static int                  fifo_buff[SRC_BLOCK_FIFO_BUFF_LEN(FIFO_FRAMES, MAX_BLOCK, 1)];
+static src_block_fifo_t     fifo;
+
+typedef struct sim_result_t {
+    int      max_level_error;
+    double   rms_ratio_error_ppm;
+    unsigned n_slips;               // Overflows and underflows after settling
+} sim_result_t;
+
+static unsigned seed = 1;
+
+static int jitter(void)
+{
+    seed = seed * 1664525 + 1013904223;
+    return (int)((seed >> 8) % (2 * TIMESTAMP_JITTER + 1)) - TIMESTAMP_JITTER;
+}
+
+// Clock rate in Hz at time t
+static double in_rate(const scenario_t *s, double t)
+{
+    return s->fs_in * (1.0 + (s->in_ppm + s->in_ppm_per_s * t) * 1e-6);
+}
+
+static double out_rate(const scenario_t *s, double t)
+{
+    return s->fs_out * (1.0 + (s->out_ppm + s->out_ppm_per_s * t + s->wander_ppm * sin(2.0 * M_PI * t / 30.0)) * 1e-6);
+}
+
+// Runs a scenario with the clock recovery loop (legacy = 0) or the AN00231 rate server loop
+static sim_result_t simulate(const scenario_t *s, int legacy)
+{
+    src_clock_recovery_t clock_recovery;
+    sim_result_t result = {0, 0.0, 0};
+    unsigned nominal = (unsigned)(((unsigned long long)s->fs_in << s->frac_bits) / s->fs_out);
+    double   unit = (double)(1 << s->frac_bits);
+    unsigned fs_ratio = nominal;
+    double   t_in = 0.0, t_out = 0.0, t_calc = SR_CALC_PERIOD / (double)TICKS_PER_SECOND;
+    double   asrc_time = 0.0;      // Input samples until the next output sample
+    double   sum_sq = 0.0;
+    unsigned n_err = 0, n_in_block = 0, in_count = 0, out_count = 0;
+    unsigned ts_in = 0, ts_out = 0, ts_in_last = 0, ts_out_last = 0;   // Wrapping, as the xCORE timer
+    unsigned slips_at_settle = 0;
+    int      frame = 0;
+
+    src_block_fifo_init(&fifo, fifo_buff, FIFO_FRAMES, 1, MAX_BLOCK);
+    src_clock_recovery_init(&clock_recovery, nominal, s->frac_bits, TARGET_LEVEL, BANDWIDTH_MHZ, TICKS_PER_SECOND, MAX_DEVIATION_PPM);
+
+    while (t_calc < SIM_SECONDS) {
+        if (t_in <= t_out && t_in <= t_calc) {
+            // Input sample: timestamped, the ASRC runs on each full block
+            in_count++;
+            ts_in = (unsigned)((long long)(t_in * TICKS_PER_SECOND) + jitter());
+            if (++n_in_block == N_IN_SAMPLES) {
+                int     *window = src_block_fifo_write_window(&fifo);
+                unsigned n = 0;
+
+                for (asrc_time -= N_IN_SAMPLES; asrc_time < 0.0; asrc_time += fs_ratio / unit) window[n++] = 0;
+                src_block_fifo_write_commit(&fifo, n);
+                n_in_block = 0;
+            }
+            t_in += 1.0 / in_rate(s, t_in);
+        }
+        else if (t_out <= t_calc) {
+            // Output sample
+            out_count++;
+            ts_out = (unsigned)((long long)(t_out * TICKS_PER_SECOND) + jitter());
+            src_block_fifo_read(&fifo, &frame);
+            t_out += 1.0 / out_rate(s, t_out);
+        }
+        else {
+            // Rate calculation period
+            unsigned level = src_block_fifo_fill_level(&fifo);
+
+            if (legacy) {
+                unsigned fs_ratio_old = fs_ratio;
+                unsigned long long rate_in = ((unsigned long long)in_count << 32) / (ts_in - ts_in_last);
+                unsigned long long rate_out = ((unsigned long long)out_count << 32) / (ts_out - ts_out_last);
+
+                fs_ratio = (unsigned)((rate_in << s->frac_bits) / rate_out);
+                fs_ratio = (unsigned)(((BUFFER_LEVEL_TERM + (int)level - (int)TARGET_LEVEL) * (unsigned long long)fs_ratio) / BUFFER_LEVEL_TERM);
+                fs_ratio = (unsigned)(((unsigned long long)fs_ratio_old * OLD_VAL_WEIGHTING + fs_ratio) / (1 + OLD_VAL_WEIGHTING));
+            }
+            else {
+                fs_ratio = src_clock_recovery_update(&clock_recovery, in_count, ts_in - ts_in_last, out_count, ts_out - ts_out_last, level);
+            }
+            ts_in_last = ts_in;
+            ts_out_last = ts_out;
+            in_count = out_count = 0;
+
+            if (t_calc < SETTLE_SECONDS) {
+                slips_at_settle = fifo.n_overflows + fifo.n_underflows;
+            }
+            else {
+                double true_ratio = in_rate(s, t_calc) / out_rate(s, t_calc);
+                double err_ppm = (fs_ratio / unit / true_ratio - 1.0) * 1e6;
+                int    level_error = abs((int)level - TARGET_LEVEL);
+
+                sum_sq += err_ppm * err_ppm;
+                n_err++;
+                if (level_error > result.max_level_error) result.max_level_error = level_error;
+            }
+            t_calc += SR_CALC_PERIOD / (double)TICKS_PER_SECOND;
+        }
+    }
+    result.rms_ratio_error_ppm = sqrt(sum_sq / n_err);
+    result.n_slips = fifo.n_overflows + fifo.n_underflows - slips_at_settle;
+    return result;
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    for (unsigned i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        const scenario_t *s = &scenarios[i];
+        sim_result_t     dll = simulate(s, 0);
+        sim_result_t     legacy = simulate(s, 1);
+
+        printf("%u -> %u Hz: level error max %d frames, ratio error %.1f ppm RMS, %u slips (AN00231 loop: %d frames, %.1f ppm RMS, %u slips)\n",
+               s->fs_in, s->fs_out, dll.max_level_error, dll.rms_ratio_error_ppm, dll.n_slips,
+               legacy.max_level_error, legacy.rms_ratio_error_ppm, legacy.n_slips);
+        if (dll.max_level_error > MAX_LEVEL_ERROR || dll.n_slips) {
+            printf("ERROR: FIFO level not held within %d frames of the target\n", MAX_LEVEL_ERROR);
+            failures++;
+        }
+        if (dll.rms_ratio_error_ppm > MAX_RATIO_ERROR_PPM) {
+            printf("ERROR: Fs ratio error above %.1f ppm RMS\n", MAX_RATIO_ERROR_PPM);
+            failures++;
+        }
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the dither to 24 bits of ssrc_process() and asrc_process(), and the inline 64 bits
+// accumulator functions it uses (src_mrhf_int_arithmetic.h).
+//  - MACC, LSAT30 and EXT30 are checked against plain 64 bits arithmetic on random values and
+//    at the saturation limits
+//  - for every pair of FS codes, two instances convert the same blocks of a near full scale
+//    tone, one with dither and one without. The dithered output must be 24 bits, must stay
+//    within MAX_DITHER_ERROR of the output without dither (no wrap around at full scale), and
+//    must differ from its plain truncation to 24 bits for at least MIN_DITHERED_PERCENT of the
+//    samples
+// The ASRC Fs ratio changes from block to block.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+#include "src_mrhf_int_arithmetic.h"
+
+#define     N_CHANNELS              2
+#define     N_IN_SAMPLES            32
+#define     N_OUT_IN_RATIO_MAX      5
+#define     N_OUT_SAMPLES_MAX       (N_IN_SAMPLES * N_OUT_IN_RATIO_MAX)
+#define     N_BLOCKS                64
+#define     N_SETTLE_BLOCKS         8
+#define     N_RANDOM_VALUES         100000
+#define     FS_RATIO_DEVIATION_PPM  5000
+#define     TONE_AMPLITUDE          0.999
+#define     DATA24_MASK             0xFFFFFF00
+#define     MAX_DITHER_ERROR        1024
+#define     MIN_DITHERED_PERCENT    10
+
+TEST_SSRC_INSTANCES(2, N_CHANNELS, N_IN_SAMPLES);
+
+TEST_ASRC_INSTANCES(2, N_CHANNELS, N_IN_SAMPLES);
+
+static int                      in_buff[N_IN_SAMPLES * N_CHANNELS];
+static int                      out_dither[N_OUT_SAMPLES_MAX * N_CHANNELS];
+static int                      out_plain[N_OUT_SAMPLES_MAX * N_CHANNELS];
+
+// Reference of MACC, LSAT30 and EXT30 as used by the dither
+static int dither_ref(int iData, int iDither)
+{
+    long long acc = ((long long)iDither << 32) + (long long)iData * 0x7FFFFFFF;
+
+    if (acc > 0x3FFFFFFFFFFFFFFFLL) acc = 0x3FFFFFFFFFFFFFFFLL;
+    if (acc < -0x4000000000000000LL) acc = -0x4000000000000000LL;
+    return (int)(acc >> 31);
+}
+
+static int check_primitive(int iData, int iDither)
+{
+    __int64 i64Acc = (__int64)iDither << 32;
+    int     iOut;
+
+    MACC(&i64Acc, iData, 0x7FFFFFFF);
+    LSAT30(&i64Acc);
+    EXT30(&iOut, i64Acc);
+    if (iOut != dither_ref(iData, iDither)) {
+        printf("ERROR: MACC/LSAT30/EXT30 of 0x%08x with dither 0x%08x: 0x%08x, 0x%08x expected\n",
+               iData, iDither, iOut, dither_ref(iData, iDither));
+        return 1;
+    }
+    return 0;
+}
+
+static int check_primitives(void)
+{
+    static const int limits[] = {0x7FFFFFFF, 0x7FFFFF00, 0x40000000, 1, 0, -1, -0x40000000, -0x7FFFFF00, (int)0x80000000};
+    static const int dithers[] = {(int)0xFFFFFFC0, 0, 0xBE, 0x7FFFFFFF, (int)0x80000000};
+    int failures = 0;
+
+    for (unsigned i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+        for (unsigned j = 0; j < sizeof(dithers) / sizeof(dithers[0]); j++) {
+            failures += check_primitive(limits[i], dithers[j]);
+        }
+    }
+    srand(1);
+    for (unsigned i = 0; i < N_RANDOM_VALUES && !failures; i++) {
+        failures += check_primitive((rand() << 16) ^ rand(), ((rand() << 16) ^ rand()) >> (rand() % 32));
+    }
+    return failures;
+}
+
+static void setup_instances(void)
+{
+    for (int i = 0; i < 2; i++) {
+        TEST_SSRC_SETUP(i);
+        TEST_ASRC_SETUP(i);
+    }
+}
+
+// A near full scale tone per channel
+static void fill_input(unsigned b)
+{
+    for (unsigned i = 0; i < N_IN_SAMPLES; i++) {
+        for (unsigned ch = 0; ch < N_CHANNELS; ch++) {
+            unsigned n = b * N_IN_SAMPLES + i;
+            in_buff[i * N_CHANNELS + ch] = (int)(TONE_AMPLITUDE * sin(0.05 * (ch + 1) * n) * 2147483647.0);
+        }
+    }
+}
+
+// Checks a block, counting the samples which differ from their truncation to 24 bits
+static int compare(const char *name, fs_code_t fs_in, fs_code_t fs_out, unsigned b, unsigned n_dither, unsigned n_plain,
+                   unsigned *n_samples, unsigned *n_dithered)
+{
+    if (n_dither != n_plain) {
+        printf("ERROR: %s %d -> %d block %u: %u output samples with dither, %u without\n", name, fs_in, fs_out, b, n_dither, n_plain);
+        return 1;
+    }
+    for (unsigned i = 0; i < n_dither * N_CHANNELS; i++) {
+        if (out_dither[i] & ~DATA24_MASK) {
+            printf("ERROR: %s %d -> %d block %u: sample %u 0x%08x is not 24 bits\n", name, fs_in, fs_out, b, i, out_dither[i]);
+            return 1;
+        }
+        if (llabs((long long)out_dither[i] - out_plain[i]) > MAX_DITHER_ERROR) {
+            printf("ERROR: %s %d -> %d block %u: sample %u 0x%08x, 0x%08x without dither\n", name, fs_in, fs_out, b, i, out_dither[i], out_plain[i]);
+            return 1;
+        }
+        if (b >= N_SETTLE_BLOCKS) {
+            (*n_samples)++;
+            *n_dithered += (out_dither[i] != (int)(out_plain[i] & DATA24_MASK));
+        }
+    }
+    return 0;
+}
+
+static int check_dithered(const char *name, fs_code_t fs_in, fs_code_t fs_out, unsigned n_samples, unsigned n_dithered)
+{
+    if (n_dithered * 100 < n_samples * MIN_DITHERED_PERCENT) {
+        printf("ERROR: %s %d -> %d: %u of %u samples dithered\n", name, fs_in, fs_out, n_dithered, n_samples);
+        return 1;
+    }
+    return 0;
+}
+
+static int run_ssrc(fs_code_t fs_in, fs_code_t fs_out)
+{
+    unsigned n_samples = 0, n_dithered = 0;
+    int      failures = 0;
+
+    ssrc_init(fs_in, fs_out, ssrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, ON);
+    ssrc_init(fs_in, fs_out, ssrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, OFF);
+
+    for (unsigned b = 0; b < N_BLOCKS && !failures; b++) {
+        unsigned n_dither, n_plain;
+
+        fill_input(b);
+        n_dither = ssrc_process(in_buff, out_dither, ssrc_ctrl[0]);
+        n_plain = ssrc_process(in_buff, out_plain, ssrc_ctrl[1]);
+        failures += compare("SSRC", fs_in, fs_out, b, n_dither, n_plain, &n_samples, &n_dithered);
+    }
+    return failures ? failures : check_dithered("SSRC", fs_in, fs_out, n_samples, n_dithered);
+}
+
+static int run_asrc(fs_code_t fs_in, fs_code_t fs_out)
+{
+    unsigned fs_ratio;
+    unsigned n_samples = 0, n_dithered = 0;
+    int      failures = 0;
+
+    fs_ratio = asrc_init(fs_in, fs_out, asrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, ON);
+    asrc_init(fs_in, fs_out, asrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, OFF);
+
+    srand(1);
+    for (unsigned b = 0; b < N_BLOCKS && !failures; b++) {
+        unsigned block_ratio, n_dither, n_plain;
+
+        fill_input(b);
+        block_ratio = (unsigned)(fs_ratio * (1.0 + ((rand() % (2 * FS_RATIO_DEVIATION_PPM + 1)) - FS_RATIO_DEVIATION_PPM) * 1e-6));
+        n_dither = asrc_process(in_buff, out_dither, block_ratio, asrc_ctrl[0]);
+        n_plain = asrc_process(in_buff, out_plain, block_ratio, asrc_ctrl[1]);
+        failures += compare("ASRC", fs_in, fs_out, b, n_dither, n_plain, &n_samples, &n_dithered);
+    }
+    return failures ? failures : check_dithered("ASRC", fs_in, fs_out, n_samples, n_dithered);
+}
+
+int main(void)
+{
+    int failures = check_primitives();
+
+    setup_instances();
+
+    for (fs_code_t fs_in = FS_CODE_44; fs_in <= FS_CODE_192; fs_in++) {
+        for (fs_code_t fs_out = FS_CODE_44; fs_out <= FS_CODE_192; fs_out++) {
+            failures += run_ssrc(fs_in, fs_out);
+            failures += run_asrc(fs_in, fs_out);
+        }
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the SSRC with fast convolution F1/F2 filters (ssrc_fast_conv_init)
+// against the fixed point SSRC for every sample rate pair, with large blocks
+// of full scale and low level signals. Outputs must be within
+// FIR_FAST_CONV_TOLERANCE LSBs. Fast convolution is only used with the C and
+// SSE4.1 inner loops, so run with LIB_SRC_KERNELS=c.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// SSRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#define     N_CHANNELS              2
+#define     N_IN_SAMPLES            1024
+#define     N_BLOCKS                6
+#define     N_OUT_IN_RATIO_MAX      5
+
+TEST_SSRC_INSTANCES(2, N_CHANNELS, N_IN_SAMPLES);
+static ssrc_fast_conv_state_t   fast_conv_state[N_CHANNELS];
+
+static int                      in_buff[N_IN_SAMPLES * N_CHANNELS];
+static int                      out_buff[2][N_IN_SAMPLES * N_OUT_IN_RATIO_MAX * N_CHANNELS];
+
+// Full scale multi-tone with noise on channel 0 and low level tone on channel 1
+static int test_sample(unsigned n, unsigned ch)
+{
+    static unsigned rnd_seed = 12345;
+    double v;
+
+    rnd_seed = 1664525 * rnd_seed + 1013904223;
+    if (ch == 0) {
+        v = 0.6 * sin(0.0123 * n) + 0.3 * sin(0.731 * n) + 0.1 * ((int)rnd_seed / 2147483648.0);
+    } else {
+        v = 0.001 * sin(0.0456 * n);
+    }
+    return (int)(v * 2147483647.0);
+}
+
+int main(void)
+{
+    int     failures = 0;
+    int     n_fast_conv = 0;
+
+    for (int fs_in = FS_CODE_44; fs_in <= FS_CODE_192; fs_in++) {
+        for (int fs_out = FS_CODE_44; fs_out <= FS_CODE_192; fs_out++) {
+            int max_diff = 0;
+
+            for (int i = 0; i < 2; i++) {
+                TEST_SSRC_SETUP(i);
+                ssrc_init(fs_in, fs_out, ssrc_ctrl[i], N_CHANNELS, N_IN_SAMPLES, OFF);
+            }
+            unsigned fast_conv = ssrc_fast_conv_init(ssrc_ctrl[1], N_CHANNELS, fast_conv_state);
+            n_fast_conv += fast_conv;
+
+            for (unsigned b = 0; b < N_BLOCKS; b++) {
+                for (unsigned i = 0; i < N_IN_SAMPLES * N_CHANNELS; i++) {
+                    in_buff[i] = test_sample(b * N_IN_SAMPLES + i / N_CHANNELS, i % N_CHANNELS);
+                }
+
+                unsigned n_out = ssrc_process(in_buff, out_buff[0], ssrc_ctrl[0]);
+                if (ssrc_process(in_buff, out_buff[1], ssrc_ctrl[1]) != n_out) {
+                    printf("ERROR: %d -> %d block %u: number of output samples differs\n", fs_in, fs_out, b);
+                    failures++;
+                    break;
+                }
+                for (unsigned i = 0; i < n_out * N_CHANNELS; i++) {
+                    int diff = abs(out_buff[1][i] - out_buff[0][i]);
+                    if (diff > max_diff) max_diff = diff;
+                }
+            }
+
+            printf("%d -> %d: fast convolution %s, max difference %d\n", fs_in, fs_out, fast_conv ? "on" : "off", max_diff);
+            if (max_diff > FIR_FAST_CONV_TOLERANCE) {
+                printf("ERROR: %d -> %d: difference above tolerance (%d)\n", fs_in, fs_out, FIR_FAST_CONV_TOLERANCE);
+                failures++;
+            }
+        }
+    }
+
+    if (n_fast_conv == 0) {
+        printf("ERROR: fast convolution not used\n");
+        failures++;
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,220 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Host (non xCORE) equivalent of app_ds3.xc and app_os3.xc (see test_ds3.py /
+// test_os3.py). Reads the two input signal tables from the example source and
+// writes the same lines as the example prints, so results can be checked
+// against the golden files ds3_test.expect and os3_test.expect.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// SRC includes
+#include "src.h"
+
+#define     NUM_CHANNELS            2
+#define     NUM_INPUT_SAMPLES       1024    //Length of the input signal tables of the examples
+#define     DS3_NUM_OUTPUT_SAMPLES  128     //As app_ds3.xc
+#define     OS3_NUM_OUTPUT_SAMPLES  384     //As app_os3.xc
+
+//Input signals, one per channel
+static int  input_tables[NUM_CHANNELS][NUM_INPUT_SAMPLES];
+
+//Example source, converter and output file
+char *pzInFileName = NULL;
+char *pzOutFileName = NULL;
+char *pzConverter = NULL;
+
+void ShowUsage()
+{
+    puts(
+        "Usage: ff3_test_host <args>\n\n"
+        "         -c     Converter (ds3 or os3)\n\n"
+        "         -i     Example source holding the input signal tables (app_ds3.xc or app_os3.xc)\n\n"
+        "         -o     Output file name\n\n"
+        "         -h     Show this usage message and abort\n\n"
+        );
+
+    exit(0);
+}
+
+void ParseCmdLine(int argc, char *argv[])
+{
+    for (int ui = 1; ui < argc; ui++)
+    {
+        if (*(argv[ui]) != '-') continue;
+        if (ui + 1 >= argc) ShowUsage();
+
+        switch (argv[ui][1])
+        {
+        case 'c':
+        case 'C':
+            pzConverter = argv[ui + 1];
+            break;
+
+        case 'i':
+        case 'I':
+            pzInFileName = argv[ui + 1];
+            break;
+
+        case 'o':
+        case 'O':
+            pzOutFileName = argv[ui + 1];
+            break;
+
+        default:
+            ShowUsage();
+            break;
+        }
+    }
+}
+
+//Reads the "const int32_t name[1024] = {...};" tables of the example source in order. As in C,
+//samples missing from the initialiser are 0
+static void read_input_tables(FILE *InFile)
+{
+    static char line[32768];
+    unsigned    n_tables = 0;
+
+    while ((n_tables < NUM_CHANNELS) && fgets(line, sizeof(line), InFile))
+    {
+        char *p = line;
+        if (strncmp(line, "const int32_t", strlen("const int32_t")) || ((p = strchr(line, '{')) == NULL)) continue;
+
+        for (unsigned i = 0; (i < NUM_INPUT_SAMPLES) && (*p != '}'); i++)
+        {
+            char *end;
+            input_tables[n_tables][i] = (int)strtol(p + 1, &end, 10);
+            if ((end == p + 1) || ((*end != ',') && (*end != '}')))
+            {
+                printf("ERROR: cannot read sample %u of table %u of the example source\n", i, n_tables);
+                exit(1);
+            }
+            p = end;
+        }
+        n_tables++;
+    }
+    if (n_tables < NUM_CHANNELS)
+    {
+        printf("ERROR: the example source holds %u input tables, %d expected\n", n_tables, NUM_CHANNELS);
+        exit(1);
+    }
+}
+
+static int run_ds3(FILE *OutFile)
+{
+    src_ff3_return_code_t return_code = SRC_FF3_NO_ERROR;
+    int                   src_ds3_delay[NUM_CHANNELS][SRC_FF3_DS3_DELAY_LEN];
+    src_ds3_ctrl_t        src_ds3_ctrl[NUM_CHANNELS];
+    int                   output_data[NUM_CHANNELS];
+    const int             *input_data[NUM_CHANNELS] = {input_tables[0], input_tables[1]};
+
+    for (int i = 0; i < NUM_CHANNELS; i++)
+    {
+        fprintf(OutFile, "Init ds3 channel %d\n", i);
+        src_ds3_ctrl[i].delay_base = src_ds3_delay[i];
+        if ((src_ds3_init(&src_ds3_ctrl[i]) != SRC_FF3_NO_ERROR) || (src_ds3_sync(&src_ds3_ctrl[i]) != SRC_FF3_NO_ERROR))
+        {
+            printf("Error on init\n");
+            return_code = SRC_FF3_ERROR;
+        }
+    }
+
+    for (int s = 0; s < DS3_NUM_OUTPUT_SAMPLES; s++)
+    {
+        for (int i = 0; i < NUM_CHANNELS; i++)
+        {
+            src_ds3_ctrl[i].in_data  = (int *)input_data[i];
+            src_ds3_ctrl[i].out_data = &output_data[i];
+            if (src_ds3_proc(&src_ds3_ctrl[i]) != SRC_FF3_NO_ERROR)
+            {
+                printf("Error on ds3 process\n");
+                return_code = SRC_FF3_ERROR;
+            }
+            input_data[i] += 3;
+            fprintf(OutFile, "%d\n", output_data[i]);
+        }
+    }
+    return (int)return_code;
+}
+
+static int run_os3(FILE *OutFile)
+{
+    src_ff3_return_code_t return_code = SRC_FF3_NO_ERROR;
+    int                   src_os3_delay[NUM_CHANNELS][SRC_FF3_OS3_DELAY_LEN];
+    src_os3_ctrl_t        src_os3_ctrl[NUM_CHANNELS];
+    const int             *input_data[NUM_CHANNELS] = {input_tables[0], input_tables[1]};
+
+    for (int i = 0; i < NUM_CHANNELS; i++)
+    {
+        fprintf(OutFile, "Init os3 channel %d\n", i);
+        src_os3_ctrl[i].delay_base = src_os3_delay[i];
+        if ((src_os3_init(&src_os3_ctrl[i]) != SRC_FF3_NO_ERROR) || (src_os3_sync(&src_os3_ctrl[i]) != SRC_FF3_NO_ERROR))
+        {
+            printf("Error on init\n");
+            return_code = SRC_FF3_ERROR;
+        }
+    }
+
+    for (int s = 0; s < OS3_NUM_OUTPUT_SAMPLES; s++)
+    {
+        for (int i = 0; i < NUM_CHANNELS; i++)
+        {
+            //One input sample every 3 output samples
+            if (src_os3_ctrl[i].phase == 0)
+            {
+                src_os3_ctrl[i].in_data = *input_data[i]++;
+                if (src_os3_input(&src_os3_ctrl[i]) != SRC_FF3_NO_ERROR)
+                {
+                    printf("Error on os3 input\n");
+                    return_code = SRC_FF3_ERROR;
+                }
+            }
+            if (src_os3_proc(&src_os3_ctrl[i]) != SRC_FF3_NO_ERROR)
+            {
+                printf("Error on os3 process\n");
+                return_code = SRC_FF3_ERROR;
+            }
+            fprintf(OutFile, "%d\n", src_os3_ctrl[i].out_data);
+        }
+    }
+    return (int)return_code;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE    *InFile;
+    FILE    *OutFile;
+    int     result;
+
+    if (argc == 1) ShowUsage();
+    ParseCmdLine(argc, argv);
+
+    //Test for valid arguments
+    if ((pzConverter == NULL) || (pzInFileName == NULL) || (pzOutFileName == NULL) ||
+        (strcmp(pzConverter, "ds3") && strcmp(pzConverter, "os3")))
+    {
+        printf("ERROR: converter (ds3 or os3), example source and output file must be set\n");
+        exit(1);
+    }
+
+    printf("Running %s test (host)\n", pzConverter);
+
+    if ((InFile = fopen(pzInFileName, "rt")) == NULL)
+    {
+        printf("Error while opening input file, %s\n", pzInFileName);
+        exit(1);
+    }
+    read_input_tables(InFile);
+    fclose(InFile);
+
+    if ((OutFile = fopen(pzOutFileName, "wt")) == NULL)
+    {
+        printf("Error while opening output file, %s\n", pzOutFileName);
+        exit(1);
+    }
+    result = strcmp(pzConverter, "ds3") ? run_os3(OutFile) : run_ds3(OutFile);
+    fclose(OutFile);
+
+    return result;
+}
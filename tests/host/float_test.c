@@ -0,0 +1,239 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the single precision float SSRC and ASRC (ssrc_float_process,
+// asrc_float_process) against the fixed point versions, without dither, for
+// every sample rate pair and, for the ASRC, nominal and deviated Fs ratios.
+// The float outputs, scaled to 32 bits, must be within FLOAT_TOLERANCE_LSB24
+// LSBs at 24 bits of the fixed point outputs. The same is checked for pairs of
+// rates given in Hz (ssrc_float_init_hz, asrc_float_init_hz) planned with the
+// decimations by 4, 8 and 16 and the Q8.24 Fs ratio format, and pairs without
+// a plan must make them return 0. A long run checks all the channels of the
+// float ASRC stay at the time of the first channel.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#define     N_CHANNELS              2
+#define     N_IN_SAMPLES            32      // A multiple of 2 x 16 for the decimation by 16
+#define     N_BLOCKS                48
+#define     N_BLOCKS_LONG_RUN       20000
+#define     N_OUT_IN_RATIO_MAX      12
+#define     FLOAT_TOLERANCE_LSB24   2
+#define     FLOAT_TO_INT_SCALE      2147483648.0
+
+static ssrc_state_t             ssrc_state[N_CHANNELS];
+static int                      ssrc_stack[N_CHANNELS][4 * N_CHANNELS * N_IN_SAMPLES];
+static ssrc_ctrl_t              ssrc_ctrl[N_CHANNELS];
+static ssrc_float_state_t       ssrc_float_state[N_CHANNELS];
+static float                    ssrc_float_stack[N_CHANNELS][4 * N_CHANNELS * N_IN_SAMPLES];
+static ssrc_float_ctrl_t        ssrc_float_ctrl[N_CHANNELS];
+
+static asrc_state_t             asrc_state[N_CHANNELS];
+static int                      asrc_stack[N_CHANNELS][4 * N_CHANNELS * N_IN_SAMPLES];
+static asrc_ctrl_t              asrc_ctrl[N_CHANNELS];
+static asrc_adfir_coefs_t       asrc_adfir_coefs;
+static asrc_float_state_t       asrc_float_state[N_CHANNELS];
+static float                    asrc_float_stack[N_CHANNELS][4 * N_CHANNELS * N_IN_SAMPLES];
+static asrc_float_ctrl_t        asrc_float_ctrl[N_CHANNELS];
+
+static int                      in_buff[N_IN_SAMPLES * N_CHANNELS];
+static float                    in_buff_float[N_IN_SAMPLES * N_CHANNELS];
+static int                      out_buff[N_IN_SAMPLES * N_OUT_IN_RATIO_MAX * N_CHANNELS];
+static float                    out_buff_float[N_IN_SAMPLES * N_OUT_IN_RATIO_MAX * N_CHANNELS];
+
+static const unsigned           sample_rates[] = {44100, 48000, 88200, 96000, 176400, 192000};
+
+// Pairs of rates given in Hz: DS4, DS8 and DS16 pre-stages, band limiting filters of the planners,
+// an integer PPFIR step above x4 and the Q8.24 Fs ratio format
+static const unsigned           hz_rates[][2] = {{48000, 16000}, {384000, 32000}, {384000, 8000}, {8000, 44100},
+                                                 {352800, 48000}, {22050, 48000}, {16000, 96000}, {32000, 24000}};
+
+// Half scale multi-tone on channel 0 (no saturation in the fixed point path) and low level tone on channel 1
+static int test_sample(unsigned n, unsigned ch)
+{
+    double v;
+
+    if (ch == 0) {
+        v = 0.3 * sin(0.0123 * n) + 0.2 * sin(0.731 * n);
+    } else {
+        v = 0.001 * sin(0.0456 * n);
+    }
+    return (int)(v * 2147483647.0);
+}
+
+static void fill_input(unsigned b)
+{
+    for (unsigned i = 0; i < N_IN_SAMPLES * N_CHANNELS; i++) {
+        in_buff[i] = test_sample(b * N_IN_SAMPLES + i / N_CHANNELS, i % N_CHANNELS);
+        in_buff_float[i] = (float)(in_buff[i] / FLOAT_TO_INT_SCALE);
+    }
+}
+
+// Returns the largest difference in 24 bit LSBs between the float and fixed point outputs
+static double max_diff_lsb24(unsigned n_out)
+{
+    double max_diff = 0.0;
+
+    for (unsigned i = 0; i < n_out * N_CHANNELS; i++) {
+        double diff = fabs(out_buff_float[i] * FLOAT_TO_INT_SCALE - out_buff[i]) / 256.0;
+        if (diff > max_diff) max_diff = diff;
+    }
+    return max_diff;
+}
+
+static void setup_instances(void)
+{
+    setup_ssrc(ssrc_ctrl, ssrc_state, ssrc_stack[0], sizeof(ssrc_stack[0]) / sizeof(int), N_CHANNELS);
+    setup_asrc(asrc_ctrl, asrc_state, asrc_stack[0], sizeof(asrc_stack[0]) / sizeof(int), &asrc_adfir_coefs, N_CHANNELS);
+    for (int ch = 0; ch < N_CHANNELS; ch++) {
+        ssrc_float_ctrl[ch].psState = &ssrc_float_state[ch];
+        ssrc_float_ctrl[ch].pfStack = ssrc_float_stack[ch];
+        asrc_float_ctrl[ch].psState = &asrc_float_state[ch];
+        asrc_float_ctrl[ch].pfStack = asrc_float_stack[ch];
+    }
+}
+
+// Converts the same blocks with the initialised fixed point and float SSRCs (rates fs_in and fs_out
+// for the messages, FS codes or Hz)
+static int compare_ssrc(unsigned fs_in, unsigned fs_out)
+{
+    double max_diff = 0.0;
+
+    for (unsigned b = 0; b < N_BLOCKS; b++) {
+        fill_input(b);
+        unsigned n_out = ssrc_process(in_buff, out_buff, ssrc_ctrl);
+        if (ssrc_float_process(in_buff_float, out_buff_float, ssrc_float_ctrl) != n_out) {
+            printf("ERROR: SSRC %u -> %u block %u: number of output samples differs\n", fs_in, fs_out, b);
+            return 1;
+        }
+        double diff = max_diff_lsb24(n_out);
+        if (diff > max_diff) max_diff = diff;
+    }
+    printf("SSRC %u -> %u: max difference %.3f LSB24\n", fs_in, fs_out, max_diff);
+    if (max_diff > FLOAT_TOLERANCE_LSB24) {
+        printf("ERROR: SSRC %u -> %u: difference above tolerance\n", fs_in, fs_out);
+        return 1;
+    }
+    return 0;
+}
+
+// Converts the same blocks with the initialised fixed point and float ASRCs at fs_ratio
+static int compare_asrc(unsigned fs_in, unsigned fs_out, unsigned fs_ratio, double deviation)
+{
+    double max_diff = 0.0;
+
+    for (unsigned b = 0; b < N_BLOCKS; b++) {
+        fill_input(b);
+        unsigned n_out = asrc_process(in_buff, out_buff, fs_ratio, asrc_ctrl);
+        if (asrc_float_process(in_buff_float, out_buff_float, fs_ratio, asrc_float_ctrl) != n_out) {
+            printf("ERROR: ASRC %u -> %u block %u: number of output samples differs\n", fs_in, fs_out, b);
+            return 1;
+        }
+        double diff = max_diff_lsb24(n_out);
+        if (diff > max_diff) max_diff = diff;
+    }
+    printf("ASRC %u -> %u (%f): max difference %.3f LSB24\n", fs_in, fs_out, deviation, max_diff);
+    if (max_diff > FLOAT_TOLERANCE_LSB24) {
+        printf("ERROR: ASRC %u -> %u: difference above tolerance\n", fs_in, fs_out);
+        return 1;
+    }
+    return 0;
+}
+
+// Converts N_BLOCKS_LONG_RUN blocks with the float ASRC at fs_ratio, checking after every block that all
+// the channels are at the time of the first channel, and that this time stays within one step of the
+// next synchronous sample
+static int long_run_asrc(unsigned fs_in, unsigned fs_out, unsigned fs_ratio)
+{
+    for (unsigned b = 0; b < N_BLOCKS_LONG_RUN; b++) {
+        fill_input(b);
+        asrc_float_process(in_buff_float, out_buff_float, fs_ratio, asrc_float_ctrl);
+        if ((asrc_float_ctrl[0].iTimeInt < 0) || (asrc_float_ctrl[0].iTimeInt > FILTER_DEFS_ADFIR_N_PHASES + asrc_float_ctrl[0].iTimeStepInt)) {
+            printf("ERROR: ASRC %u -> %u block %u: time %d out of range\n", fs_in, fs_out, b, asrc_float_ctrl[0].iTimeInt);
+            return 1;
+        }
+        for (int ch = 1; ch < N_CHANNELS; ch++) {
+            if ((asrc_float_ctrl[ch].iTimeInt != asrc_float_ctrl[0].iTimeInt) ||
+                (asrc_float_ctrl[ch].uiTimeFract != asrc_float_ctrl[0].uiTimeFract)) {
+                printf("ERROR: ASRC %u -> %u block %u: channel %d time differs from channel 0\n", fs_in, fs_out, b, ch);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static const double deviations[] = {1.0, 0.990099, 1.009999};
+    int     failures = 0;
+
+    setup_instances();
+
+    for (int fs_in = FS_CODE_44; fs_in <= FS_CODE_192; fs_in++) {
+        for (int fs_out = FS_CODE_44; fs_out <= FS_CODE_192; fs_out++) {
+            // SSRC
+            ssrc_init(fs_in, fs_out, ssrc_ctrl, N_CHANNELS, N_IN_SAMPLES, OFF);
+            ssrc_float_init(fs_in, fs_out, ssrc_float_ctrl, N_CHANNELS, N_IN_SAMPLES);
+            failures += compare_ssrc(fs_in, fs_out);
+
+            // ASRC
+            for (unsigned d = 0; d < sizeof(deviations) / sizeof(deviations[0]); d++) {
+                asrc_init(fs_in, fs_out, asrc_ctrl, N_CHANNELS, N_IN_SAMPLES, OFF);
+                if (asrc_float_init(fs_in, fs_out, asrc_float_ctrl, N_CHANNELS, N_IN_SAMPLES) != asrc_ctrl[0].uiFsRatio) {
+                    printf("ERROR: ASRC %d -> %d: nominal Fs ratio differs\n", fs_in, fs_out);
+                    failures++;
+                }
+
+                unsigned fs_ratio = (unsigned)(((unsigned long long)sample_rates[fs_in] << 28) / sample_rates[fs_out]);
+                failures += compare_asrc(fs_in, fs_out, (unsigned)(fs_ratio * deviations[d]), deviations[d]);
+            }
+        }
+    }
+
+    // Rates given in Hz
+    for (unsigned r = 0; r < sizeof(hz_rates) / sizeof(hz_rates[0]); r++) {
+        unsigned fs_in = hz_rates[r][0], fs_out = hz_rates[r][1];
+
+        if (ssrc_init_hz(fs_in, fs_out, ssrc_ctrl, N_CHANNELS, N_IN_SAMPLES, OFF)) {
+            if (!ssrc_float_init_hz(fs_in, fs_out, ssrc_float_ctrl, N_CHANNELS, N_IN_SAMPLES)) {
+                printf("ERROR: SSRC %u -> %u Hz: float not initialised\n", fs_in, fs_out);
+                failures++;
+            } else {
+                failures += compare_ssrc(fs_in, fs_out);
+            }
+        } else if (ssrc_float_init_hz(fs_in, fs_out, ssrc_float_ctrl, N_CHANNELS, N_IN_SAMPLES)) {
+            printf("ERROR: SSRC %u -> %u Hz: float initialised without a plan\n", fs_in, fs_out);
+            failures++;
+        }
+
+        for (unsigned d = 0; d < sizeof(deviations) / sizeof(deviations[0]); d++) {
+            unsigned fs_ratio = asrc_init_hz(fs_in, fs_out, asrc_ctrl, N_CHANNELS, N_IN_SAMPLES, OFF);
+            if (asrc_float_init_hz(fs_in, fs_out, asrc_float_ctrl, N_CHANNELS, N_IN_SAMPLES) != fs_ratio) {
+                printf("ERROR: ASRC %u -> %u Hz: nominal Fs ratio differs\n", fs_in, fs_out);
+                failures++;
+            }
+            if (fs_ratio == 0) break;
+            failures += compare_asrc(fs_in, fs_out, (unsigned)(fs_ratio * deviations[d]), deviations[d]);
+        }
+    }
+    // Long run, ratio deviated
+    {
+        unsigned fs_ratio = asrc_float_init(FS_CODE_44, FS_CODE_48, asrc_float_ctrl, N_CHANNELS, N_IN_SAMPLES);
+        failures += long_run_asrc(44100, 48000, (unsigned)(fs_ratio * deviations[2]));
+    }
+
+    if (ssrc_float_init_hz(768000, 8000, ssrc_float_ctrl, N_CHANNELS, N_IN_SAMPLES) ||
+        asrc_float_init_hz(768000, 8000, asrc_float_ctrl, N_CHANNELS, N_IN_SAMPLES)) {
+        printf("ERROR: 768000 -> 8000 Hz initialised\n");
+        failures++;
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
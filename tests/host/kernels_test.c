@@ -0,0 +1,254 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks every SIMD inner loop kernel table supported by the running CPU
+// against the portable C kernels, including full scale data that exercises
+// the output saturation. The multichannel kernels of every table (C
+// included) are checked against the single channel C kernels. The fully unrolled fixed count kernels of every table
+// are checked against the generic C kernels for their count. The folded OS2
+// kernel is checked against the C kernel for symmetric filters, and the half
+// coefficient tables of the FIR descriptors against their full tables.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// Kernel includes
+#include "src_kernels.h"
+
+// SRC includes
+#include "src.h"
+
+#define     N_TRIALS                1000
+#define     MAX_TAPS                160
+#define     SPLINE_N_TAPS           16
+#define     MC_MAX_CHANNELS         16
+
+// Tap counts of the FIR filters (BL9644, BL, BLF, DS, ADFIR)
+static const int fir_taps[] = {160, 144, 96, 32, 16};
+// Inner loop counts of the factor of 3 filters (DS3, OS3)
+static const int ff3_loops[] = {6, 2, 1};
+// Channel counts for the multichannel kernels (full and partial channel groups)
+static const int mc_channels[] = {1, 2, 3, 4, 5, 8, 11, 16};
+
+static unsigned rnd_seed = 12345;
+
+static int rnd(void)
+{
+    rnd_seed = 1664525 * rnd_seed + 1013904223;
+    return (int)rnd_seed;
+}
+
+// Mix of random, full scale and small values
+static int test_value(int trial)
+{
+    switch (trial % 4) {
+    case 0:  return rnd();
+    case 1:  return (rnd() & 1) ? 0x7FFFFFFF : (int)0x80000000;
+    case 2:  return rnd() >> 16;
+    default: return (rnd() & 1) ? rnd() : 0x7FFFFFFF;
+    }
+}
+
+static int check(const char* isa, const char* kernel, int n, int trial, const int* result, const int* expected, int n_out)
+{
+    if (memcmp(result, expected, n_out * sizeof(int)) != 0) {
+        printf("ERROR: %s %s n=%d trial=%d: %d != %d\n", isa, kernel, n, trial, result[0], expected[0]);
+        return 1;
+    }
+    return 0;
+}
+
+// Checks the multichannel kernels of a table against the single channel C kernels
+static int check_mc(const char* isa, const src_kernels_t* k, const src_kernels_t* ref, int trial)
+{
+    static int  data[MC_MAX_CHANNELS][MAX_TAPS + 1];
+    int         coefs[2 * MAX_TAPS];
+    int*        ppiData[MC_MAX_CHANNELS];
+    int         expected[2 * MC_MAX_CHANNELS], result[2 * MC_MAX_CHANNELS];
+    int         failures = 0;
+
+    for (int ch = 0; ch < MC_MAX_CHANNELS; ch++) {
+        for (int i = 0; i < MAX_TAPS + 1; i++) data[ch][i] = test_value(trial);
+        // Alternate 64-bit aligned and misaligned channels
+        ppiData[ch] = data[ch] + ((ch + trial) & 1);
+    }
+    for (int i = 0; i < 2 * MAX_TAPS; i++) coefs[i] = test_value(trial >> 2);
+
+    for (int c = 0; c < sizeof(mc_channels) / sizeof(mc_channels[0]); c++) {
+        int n_ch = mc_channels[c];
+
+        for (int t = 0; t < sizeof(fir_taps) / sizeof(fir_taps[0]); t++) {
+            for (int ch = 0; ch < n_ch; ch++) {
+                ref->mrhf_fir(ppiData[ch], coefs, &expected[ch], fir_taps[t] >> 1);
+            }
+            k->mrhf_fir_mc(ppiData, coefs, result, fir_taps[t] >> 1, n_ch);
+            failures += check(isa, "fir_mc", n_ch, trial, result, expected, n_ch);
+
+            for (int ch = 0; ch < n_ch; ch++) {
+                ref->mrhf_fir_os(ppiData[ch], coefs, &expected[2 * ch], fir_taps[t] >> 2);
+            }
+            k->mrhf_fir_os_mc(ppiData, coefs, result, fir_taps[t] >> 2, n_ch);
+            failures += check(isa, "fir_os_mc", n_ch, trial, result, expected, 2 * n_ch);
+        }
+    }
+    return failures;
+}
+
+// Checks a list of fixed count kernels against a generic C kernel
+static int check_fixed_list(const char* isa, const char* kernel, const src_kernel_fixed_t* fixed, src_kernel_fir_t generic,
+        int* data, int* coefs, int trial, int n_out)
+{
+    int         expected[2], result[2];
+    int         failures = 0;
+
+    for (; fixed->count; fixed++) {
+        generic(data, coefs, expected, fixed->count);
+        fixed->kernel(data, coefs, result, fixed->count);
+        failures += check(isa, kernel, fixed->count, trial, result, expected, n_out);
+    }
+    return failures;
+}
+
+// Checks the fixed count kernels of a table, and that every table has them
+static int check_fixed(const char* isa, const src_kernels_t* k, const src_kernels_t* ref, int trial)
+{
+    int         data[MAX_TAPS + 1];
+    int         coefs[2 * MAX_TAPS];
+    int         failures = 0;
+
+    if (!k->mrhf_fir_fixed[0].count || !k->mrhf_fir_os_fixed[0].count || !k->mrhf_adfir_fixed[0].count) {
+        printf("ERROR: %s has no fixed count kernels\n", isa);
+        return 1;
+    }
+
+    for (int i = 0; i < MAX_TAPS + 1; i++) data[i] = test_value(trial);
+    for (int i = 0; i < 2 * MAX_TAPS; i++) coefs[i] = test_value(trial >> 2);
+
+    failures += check_fixed_list(isa, "fir_fixed", k->mrhf_fir_fixed, ref->mrhf_fir, data + (trial & 1), coefs, trial, 1);
+    failures += check_fixed_list(isa, "fir_os_fixed", k->mrhf_fir_os_fixed, ref->mrhf_fir_os, data + (trial & 1), coefs, trial, 2);
+    failures += check_fixed_list(isa, "adfir_fixed", k->mrhf_adfir_fixed, ref->mrhf_adfir, data + (trial & 1), coefs, trial, 1);
+
+    return failures;
+}
+
+// Checks the folded OS2 kernel against the C kernel with a symmetric prototype
+static int check_sym(int trial)
+{
+    const src_kernels_t* ref = src_kernels_get(SRC_KERNELS_ISA_C);
+    int         data[MAX_TAPS + 1];
+    int         coefs[2 * MAX_TAPS];
+    int         expected[2], result[2];
+    int         failures = 0;
+
+    for (int i = 0; i < MAX_TAPS + 1; i++) data[i] = test_value(trial);
+
+    for (int t = 0; t < sizeof(fir_taps) / sizeof(fir_taps[0]); t++) {
+        int n = fir_taps[t];
+
+        // Interleaved symmetric prototype: the odd phase is the even phase reversed
+        for (int i = 0; i < n >> 1; i++) coefs[i] = coefs[n - 1 - i] = test_value(trial >> 2);
+        ref->mrhf_fir_os(data + (trial & 1), coefs, expected, n >> 2);
+        src_mrhf_fir_os_sym_inner_loop_c(data + (trial & 1), coefs, result, n >> 2);
+        failures += check("c", "fir_os_sym", n, trial, result, expected, 2);
+    }
+    return failures;
+}
+
+// Checks the half tables of a list of FIR descriptors are the first half of their symmetric full tables
+static int check_half_tables(const char* name, const FIRDescriptor_t* desc, int n_desc)
+{
+    int         failures = 0;
+
+    for (int d = 0; d < n_desc; d++) {
+        unsigned n = desc[d].uiNCoefs;
+
+        if (desc[d].piCoefsHalf == 0) {
+            if (desc[d].eType == FIR_TYPE_OS2) {
+                printf("ERROR: %s FIR %d: OS2 filter without half table\n", name, d);
+                failures++;
+            }
+            continue;
+        }
+        for (unsigned i = 0; i < n; i++) {
+            if ((desc[d].piCoefs[i] != desc[d].piCoefs[n - 1 - i]) || ((i < n / 2) && (desc[d].piCoefsHalf[i] != desc[d].piCoefs[i]))) {
+                printf("ERROR: %s FIR %d: coefficient %u not symmetric or not in the half table\n", name, d, i);
+                failures++;
+                break;
+            }
+        }
+    }
+    return failures;
+}
+
+int main(void)
+{
+    static const char* isa_names[] = {"c", "sse41", "avx2", "avx512"};
+    int     data[MAX_TAPS + 1];
+    int     coefs[2 * MAX_TAPS];
+    int     h[3];
+    int     expected[SPLINE_N_TAPS], result[SPLINE_N_TAPS];
+    int     failures = 0;
+
+    const src_kernels_t* ref = src_kernels_get(SRC_KERNELS_ISA_C);
+
+    for (int trial = 0; trial < N_TRIALS / 10; trial++) {
+        failures += check_mc(isa_names[SRC_KERNELS_ISA_C], ref, ref, trial);
+        failures += check_fixed(isa_names[SRC_KERNELS_ISA_C], ref, ref, trial);
+        failures += check_sym(trial);
+    }
+    failures += check_half_tables("SSRC", sSSRCFirDescriptor, FILTER_DEFS_SSRC_N_FIR_ID);
+    failures += check_half_tables("ASRC", sASRCFirDescriptor, FILTER_DEFS_ASRC_N_FIR_ID);
+
+    for (int isa = SRC_KERNELS_ISA_SSE41; isa <= SRC_KERNELS_ISA_AVX512; isa++) {
+        const src_kernels_t* k = src_kernels_get(isa);
+        if (!k || !src_kernels_isa_supported(isa)) {
+            printf("%s kernels not supported, skipping\n", isa_names[isa]);
+            continue;
+        }
+
+        for (int trial = 0; trial < N_TRIALS; trial++) {
+            for (int i = 0; i < MAX_TAPS + 1; i++) data[i] = test_value(trial);
+            for (int i = 0; i < 2 * MAX_TAPS; i++) coefs[i] = test_value(trial >> 2);
+            for (int i = 0; i < 3; i++) h[i] = test_value(trial);
+
+            // Check both 64-bit aligned and misaligned data
+            for (int offset = 0; offset < 2; offset++) {
+                int* d = data + offset;
+
+                for (int t = 0; t < sizeof(fir_taps) / sizeof(fir_taps[0]); t++) {
+                    ref->mrhf_fir(d, coefs, expected, fir_taps[t] >> 1);
+                    k->mrhf_fir(d, coefs, result, fir_taps[t] >> 1);
+                    failures += check(isa_names[isa], "fir", fir_taps[t], trial, result, expected, 1);
+
+                    ref->mrhf_adfir(d, coefs, expected, fir_taps[t] >> 1);
+                    k->mrhf_adfir(d, coefs, result, fir_taps[t] >> 1);
+                    failures += check(isa_names[isa], "adfir", fir_taps[t], trial, result, expected, 1);
+
+                    // OS filter: n coefficients, n/2 data samples
+                    ref->mrhf_fir_os(d, coefs, expected, fir_taps[t] >> 2);
+                    k->mrhf_fir_os(d, coefs, result, fir_taps[t] >> 2);
+                    failures += check(isa_names[isa], "fir_os", fir_taps[t], trial, result, expected, 2);
+                }
+
+                for (int t = 0; t < sizeof(ff3_loops) / sizeof(ff3_loops[0]); t++) {
+                    ref->ff3_fir(d, coefs, expected, ff3_loops[t]);
+                    k->ff3_fir(d, coefs, result, ff3_loops[t]);
+                    failures += check(isa_names[isa], "ff3_fir", ff3_loops[t], trial, result, expected, 1);
+                }
+
+                ref->mrhf_spline(d, h, expected, SPLINE_N_TAPS);
+                k->mrhf_spline(d, h, result, SPLINE_N_TAPS);
+                failures += check(isa_names[isa], "spline", SPLINE_N_TAPS, trial, result, expected, SPLINE_N_TAPS);
+            }
+
+            if (trial % 10 == 0) {
+                failures += check_mc(isa_names[isa], k, ref, trial);
+                failures += check_fixed(isa_names[isa], k, ref, trial);
+            }
+        }
+        printf("%s kernels checked\n", isa_names[isa]);
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
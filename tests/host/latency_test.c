@@ -0,0 +1,173 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the latency reported by ssrc_get_latency() and asrc_get_latency() against the delay
+// measured through the converters. For every pair of FS codes, for the SSRC and the ASRC (at
+// the nominal Fs ratio), and for a few pairs of rates in Hz for the ASRC (asrc_init_hz()):
+//  - a low frequency tone is converted and, once the filters have settled, the phase of the
+//    output against the input tone (least squares fit) gives the delay from an output sample
+//    to the input it represents. It must match filters_out within MAX_DELAY_ERROR output samples
+//  - filters_in and filters_out must be in the ratio of the rates, and the totals must add one
+//    block of input samples
+// Two block sizes are checked (the filter delays do not depend on it).
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+
+#define     N_IN_SAMPLES_MAX        64
+#define     N_OUT_IN_RATIO_MAX      16
+#define     N_SETTLE                4096        // Input samples before the measurement, filters settled
+#define     N_MEASURE               16384       // Input samples measured
+#define     TONE_HZ                 50.0        // Period above any delay
+#define     TONE_AMPLITUDE          0.5
+#define     MAX_DELAY_ERROR         0.001       // Output samples
+#define     MAX_Q16_ERROR           2           // Q16.16 rounding of the ratios of the fields
+
+static ssrc_state_t             ssrc_state;
+static int                      ssrc_stack[8 * N_IN_SAMPLES_MAX];
+static ssrc_ctrl_t              ssrc_ctrl;
+
+static asrc_state_t             asrc_state;
+static int                      asrc_stack[4 * N_IN_SAMPLES_MAX];
+static asrc_ctrl_t              asrc_ctrl;
+static asrc_adfir_coefs_t       asrc_adfir_coefs;
+
+static int                      in_buff[N_IN_SAMPLES_MAX];
+static int                      out_buff[N_IN_SAMPLES_MAX * N_OUT_IN_RATIO_MAX];
+
+static const unsigned           fs_hz[] = {44100, 48000, 88200, 96000, 176400, 192000};
+static const unsigned           hz_pairs[][2] = {{32000, 48000}, {48000, 16000}, {22050, 96000}, {96000, 24000}};
+static const unsigned           n_in_samples[] = {16, N_IN_SAMPLES_MAX};
+
+// Least squares fit of the output samples to a sin(w t) + b cos(w t), t the time of the output
+// samples in input samples, accumulated over the measurement
+typedef struct fit_t {
+    double sss, ssc, scc, sys, syc;
+} fit_t;
+
+static void fit_add(fit_t *f, double y, double wt)
+{
+    double s = sin(wt), c = cos(wt);
+
+    f->sss += s * s;
+    f->ssc += s * c;
+    f->scc += c * c;
+    f->sys += y * s;
+    f->syc += y * c;
+}
+
+// Delay in input samples of the fitted tone against sin(w t)
+static double fit_delay(const fit_t *f, double w)
+{
+    double det = f->sss * f->scc - f->ssc * f->ssc;
+    double a = (f->sys * f->scc - f->syc * f->ssc) / det;
+    double b = (f->syc * f->sss - f->sys * f->ssc) / det;
+
+    // a sin(w t) + b cos(w t) = A sin(w (t - delay))
+    return atan2(-b, a) / w;
+}
+
+// Converts a tone with the SSRC (ssrc != 0) or the ASRC, returns the measured delay in input samples
+static double measure(int ssrc, unsigned fs_in, unsigned n_in, double out_per_in, unsigned fs_ratio)
+{
+    double   w = 2.0 * M_PI * TONE_HZ / fs_in;
+    fit_t    f = {0.0, 0.0, 0.0, 0.0, 0.0};
+    unsigned n_out_total = 0;
+
+    for (unsigned n = 0; n < N_SETTLE + N_MEASURE; n += n_in) {
+        unsigned n_out;
+
+        for (unsigned i = 0; i < n_in; i++) {
+            in_buff[i] = (int)(TONE_AMPLITUDE * sin(w * (n + i)) * 2147483647.0);
+        }
+        n_out = ssrc ? ssrc_process(in_buff, out_buff, &ssrc_ctrl) : asrc_process(in_buff, out_buff, fs_ratio, &asrc_ctrl);
+        for (unsigned j = 0; j < n_out; j++, n_out_total++) {
+            if (n >= N_SETTLE) {
+                fit_add(&f, out_buff[j], w * (n_out_total / out_per_in));
+            }
+        }
+    }
+    return fit_delay(&f, w);
+}
+
+// Checks a latency against the measured delay (input samples) for n_in input samples per block
+static int check(const char *name, unsigned fs_in, unsigned fs_out, unsigned n_in, const src_latency_t *l, double delay_in, double out_per_in)
+{
+    double filters_in = l->filters_in / 65536.0, filters_out = l->filters_out / 65536.0;
+    double delay_out = delay_in * out_per_in;
+    int    failures = 0;
+
+    if (fabs(filters_out - delay_out) > MAX_DELAY_ERROR) {
+        printf("ERROR: %s %u -> %u Hz: latency %.4f output samples, measured %.4f\n", name, fs_in, fs_out, filters_out, delay_out);
+        failures++;
+    }
+    if (fabs(filters_in * out_per_in - filters_out) * 65536.0 > MAX_Q16_ERROR * (out_per_in > 1.0 ? out_per_in : 1.0)) {
+        printf("ERROR: %s %u -> %u Hz: %.4f input samples and %.4f output samples differ\n", name, fs_in, fs_out, filters_in, filters_out);
+        failures++;
+    }
+    if (abs((int)(l->total_in - l->filters_in - (n_in << 16))) > MAX_Q16_ERROR ||
+        fabs((l->total_out - l->filters_out) / 65536.0 - n_in * out_per_in) * 65536.0 > MAX_Q16_ERROR * (out_per_in > 1.0 ? out_per_in : 1.0)) {
+        printf("ERROR: %s %u -> %u Hz: totals without a block of %u input samples\n", name, fs_in, fs_out, n_in);
+        failures++;
+    }
+    return failures;
+}
+
+static int check_asrc(unsigned fs_in, unsigned fs_out, unsigned n_in, unsigned fs_ratio)
+{
+    src_latency_t latency;
+    double        out_per_in = (double)(1 << 28) / fs_ratio;
+    double        delay_in;
+
+    asrc_get_latency(&asrc_ctrl, &latency);
+    delay_in = measure(0, fs_in, n_in, out_per_in, fs_ratio);
+    if (n_in == N_IN_SAMPLES_MAX) {
+        printf("ASRC %6u -> %6u Hz: %8.4f input samples, %8.4f output samples (measured %8.4f)\n",
+               fs_in, fs_out, latency.filters_in / 65536.0, latency.filters_out / 65536.0, delay_in * out_per_in);
+    }
+    return check("ASRC", fs_in, fs_out, n_in, &latency, delay_in, out_per_in);
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    ssrc_ctrl.psState = &ssrc_state;
+    ssrc_ctrl.piStack = ssrc_stack;
+    asrc_ctrl.psState = &asrc_state;
+    asrc_ctrl.piStack = asrc_stack;
+    asrc_ctrl.piADCoefs = asrc_adfir_coefs.iASRCADFIRCoefs;
+
+    for (unsigned b = 0; b < sizeof(n_in_samples) / sizeof(n_in_samples[0]); b++) {
+        unsigned n_in = n_in_samples[b];
+
+        for (fs_code_t fs_in = FS_CODE_44; fs_in <= FS_CODE_192; fs_in++) {
+            for (fs_code_t fs_out = FS_CODE_44; fs_out <= FS_CODE_192; fs_out++) {
+                src_latency_t latency;
+                double        out_per_in = (double)fs_hz[fs_out] / fs_hz[fs_in];
+                double        delay_in;
+
+                ssrc_init(fs_in, fs_out, &ssrc_ctrl, 1, n_in, OFF);
+                ssrc_get_latency(&ssrc_ctrl, &latency);
+                delay_in = measure(1, fs_hz[fs_in], n_in, out_per_in, 0);
+                if (n_in == N_IN_SAMPLES_MAX) {
+                    printf("SSRC %6u -> %6u Hz: %8.4f input samples, %8.4f output samples (measured %8.4f)\n",
+                           fs_hz[fs_in], fs_hz[fs_out], latency.filters_in / 65536.0, latency.filters_out / 65536.0, delay_in * out_per_in);
+                }
+                failures += check("SSRC", fs_hz[fs_in], fs_hz[fs_out], n_in, &latency, delay_in, out_per_in);
+
+                failures += check_asrc(fs_hz[fs_in], fs_hz[fs_out], n_in, asrc_init(fs_in, fs_out, &asrc_ctrl, 1, n_in, OFF));
+            }
+        }
+
+        for (unsigned p = 0; p < sizeof(hz_pairs) / sizeof(hz_pairs[0]); p++) {
+            failures += check_asrc(hz_pairs[p][0], hz_pairs[p][1], n_in, asrc_init_hz(hz_pairs[p][0], hz_pairs[p][1], &asrc_ctrl, 1, n_in, OFF));
+        }
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the multithreaded ASRC (asrc_mt_process()) against asrc_process().
+// The same blocks of interleaved channels, with an Fs ratio changing from block to block, are
+// converted by asrc_process() and by asrc_mt_process() with channel groups of various sizes
+// (aligned to cache lines or not), blocks of up to one and of several rounds of output samples,
+// dither on and off and a sample rate change half way through. The output must be bit-exact,
+// block by block. The conversion times are printed for information (they depend on the cores
+// available).
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#define     N_CHANNELS_MAX          64
+#define     N_IN_SAMPLES_MAX        128
+#define     N_OUT_SAMPLES_MAX       (N_IN_SAMPLES_MAX * 5)
+#define     N_BLOCKS                64
+#define     FS_RATIO_DEVIATION_PPM  5000
+
+typedef struct mt_config_t {
+    fs_code_t       fs_in, fs_out;
+    fs_code_t       fs_in_change, fs_out_change;   // Rates after the change half way through
+    unsigned        n_channels;
+    unsigned        n_in_samples;
+    unsigned        n_threads;
+    dither_flag_t   dither;
+} mt_config_t;
+
+static const mt_config_t configs[] = {
+    {FS_CODE_44, FS_CODE_48, FS_CODE_48, FS_CODE_48, 64, 16, 4, OFF},
+    {FS_CODE_48, FS_CODE_44, FS_CODE_96, FS_CODE_44, 64, 16, 3, ON},
+    {FS_CODE_44, FS_CODE_192, FS_CODE_48, FS_CODE_176, 64, 128, 4, OFF},   // Several rounds per block
+    {FS_CODE_192, FS_CODE_44, FS_CODE_176, FS_CODE_48, 5, 64, 3, ON},
+    {FS_CODE_96, FS_CODE_48, FS_CODE_96, FS_CODE_48, 2, 32, 8, OFF},       // More threads than channels
+};
+
+static asrc_state_t             asrc_state[2][N_CHANNELS_MAX];
+static int                      asrc_stack[2][N_CHANNELS_MAX][4 * N_IN_SAMPLES_MAX];
+static asrc_ctrl_t              asrc_ctrl[2][N_CHANNELS_MAX];
+static asrc_adfir_coefs_t       asrc_adfir_coefs[2];
+
+static int                      in_buff[N_IN_SAMPLES_MAX * N_CHANNELS_MAX];
+static int                      out_ref[N_OUT_SAMPLES_MAX * N_CHANNELS_MAX];
+static int                      out_mt[N_OUT_SAMPLES_MAX * N_CHANNELS_MAX];
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int run_config(const mt_config_t *c)
+{
+    asrc_mt_t   asrc_mt;
+    unsigned    fs_ratio, n_threads;
+    double      t_ref = 0.0, t_mt = 0.0;
+    int         failures = 0;
+
+    fs_ratio = asrc_init(c->fs_in, c->fs_out, asrc_ctrl[0], c->n_channels, c->n_in_samples, c->dither);
+    asrc_init(c->fs_in, c->fs_out, asrc_ctrl[1], c->n_channels, c->n_in_samples, c->dither);
+    n_threads = asrc_mt_init(&asrc_mt, asrc_ctrl[1], c->n_channels, c->n_threads, 1);
+    if (n_threads != (c->n_threads < c->n_channels ? c->n_threads : c->n_channels)) {
+        printf("ERROR: %u threads started, %u requested for %u channels\n", n_threads, c->n_threads, c->n_channels);
+        failures++;
+    }
+
+    srand(1);
+    for (unsigned b = 0; b < N_BLOCKS && !failures; b++) {
+        unsigned block_ratio, n_ref, n_mt;
+        double   t;
+
+        if (b == N_BLOCKS / 2) {
+            fs_ratio = asrc_change_rate(c->fs_in_change, c->fs_out_change, asrc_ctrl[0], c->n_channels);
+            asrc_change_rate(c->fs_in_change, c->fs_out_change, asrc_ctrl[1], c->n_channels);
+        }
+
+        // A tone per channel, every third channel noise
+        for (unsigned i = 0; i < c->n_in_samples; i++) {
+            for (unsigned ch = 0; ch < c->n_channels; ch++) {
+                unsigned n = b * c->n_in_samples + i;
+                in_buff[i * c->n_channels + ch] = (ch % 3 == 2) ? (rand() - RAND_MAX / 2) * 2 :
+                                                  (int)(0.5 * sin(0.01 * (ch + 1) * n) * 2147483647.0);
+            }
+        }
+        block_ratio = (unsigned)(fs_ratio * (1.0 + ((rand() % (2 * FS_RATIO_DEVIATION_PPM + 1)) - FS_RATIO_DEVIATION_PPM) * 1e-6));
+
+        t = now();
+        n_ref = asrc_process(in_buff, out_ref, block_ratio, asrc_ctrl[0]);
+        t_ref += now() - t;
+        t = now();
+        n_mt = asrc_mt_process(in_buff, out_mt, block_ratio, &asrc_mt);
+        t_mt += now() - t;
+
+        if (n_mt != n_ref) {
+            printf("ERROR: block %u: %u output samples, %u from asrc_process\n", b, n_mt, n_ref);
+            failures++;
+        }
+        for (unsigned i = 0; i < n_ref * c->n_channels && !failures; i++) {
+            if (out_mt[i] != out_ref[i]) {
+                printf("ERROR: block %u: sample %u of channel %u differs from asrc_process\n", b, i / c->n_channels, i % c->n_channels);
+                failures++;
+            }
+        }
+    }
+    asrc_mt_release(&asrc_mt);
+
+    printf("%u channels, %u threads, %u input samples: asrc_process %.1f ms, asrc_mt_process %.1f ms\n",
+           c->n_channels, n_threads, c->n_in_samples, t_ref * 1e3, t_mt * 1e3);
+    return failures;
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    setup_asrc(asrc_ctrl[0], asrc_state[0], asrc_stack[0][0], 4 * N_IN_SAMPLES_MAX, &asrc_adfir_coefs[0], N_CHANNELS_MAX);
+    setup_asrc(asrc_ctrl[1], asrc_state[1], asrc_stack[1][0], 4 * N_IN_SAMPLES_MAX, &asrc_adfir_coefs[1], N_CHANNELS_MAX);
+
+    for (unsigned i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+        failures += run_config(&configs[i]);
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
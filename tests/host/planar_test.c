@@ -0,0 +1,141 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the planar (non-interleaved) buffer variants ssrc_process_planar() and
+// asrc_process_planar() against ssrc_process() and asrc_process().
+// For every pair of FS codes, two instances convert the same blocks, one from interleaved and one
+// from planar buffers, swapping layouts half way through (so each instance switches once). The
+// ASRC Fs ratio changes from block to block. The outputs must be bit-exact, block by block, with
+// dither on and off.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#define     N_CHANNELS              3
+#define     N_IN_SAMPLES            32
+#define     N_OUT_IN_RATIO_MAX      5
+#define     N_OUT_SAMPLES_MAX       (N_IN_SAMPLES * N_OUT_IN_RATIO_MAX)
+#define     N_BLOCKS                32
+#define     FS_RATIO_DEVIATION_PPM  5000
+
+TEST_SSRC_INSTANCES(2, N_CHANNELS, N_IN_SAMPLES);
+
+TEST_ASRC_INSTANCES(2, N_CHANNELS, N_IN_SAMPLES);
+
+static int                      in_interleaved[N_IN_SAMPLES * N_CHANNELS];
+static int                      in_planar[N_CHANNELS][N_IN_SAMPLES];
+static int                      out_interleaved[N_OUT_SAMPLES_MAX * N_CHANNELS];
+static int                      out_planar[N_CHANNELS][N_OUT_SAMPLES_MAX];
+
+static int                      *in_ptrs[N_CHANNELS];
+static int                      *out_ptrs[N_CHANNELS];
+
+static void setup_instances(void)
+{
+    for (int i = 0; i < 2; i++) {
+        TEST_SSRC_SETUP(i);
+        TEST_ASRC_SETUP(i);
+    }
+    for (int ch = 0; ch < N_CHANNELS; ch++) {
+        in_ptrs[ch] = in_planar[ch];
+        out_ptrs[ch] = out_planar[ch];
+    }
+}
+
+// A tone per channel, the last channel noise, in both layouts
+static void fill_input(unsigned b)
+{
+    for (unsigned i = 0; i < N_IN_SAMPLES; i++) {
+        for (unsigned ch = 0; ch < N_CHANNELS; ch++) {
+            unsigned n = b * N_IN_SAMPLES + i;
+            int      v = (ch == N_CHANNELS - 1) ? (rand() - RAND_MAX / 2) * 2 :
+                         (int)(0.5 * sin(0.02 * (ch + 1) * n) * 2147483647.0);
+
+            in_interleaved[i * N_CHANNELS + ch] = v;
+            in_planar[ch][i] = v;
+        }
+    }
+}
+
+static int compare(const char *name, fs_code_t fs_in, fs_code_t fs_out, unsigned b, unsigned n_interleaved, unsigned n_planar)
+{
+    if (n_interleaved != n_planar) {
+        printf("ERROR: %s %d -> %d block %u: %u planar output samples, %u interleaved\n", name, fs_in, fs_out, b, n_planar, n_interleaved);
+        return 1;
+    }
+    for (unsigned i = 0; i < n_interleaved; i++) {
+        for (unsigned ch = 0; ch < N_CHANNELS; ch++) {
+            if (out_planar[ch][i] != out_interleaved[i * N_CHANNELS + ch]) {
+                printf("ERROR: %s %d -> %d block %u: sample %u of channel %u differs\n", name, fs_in, fs_out, b, i, ch);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int run_ssrc(fs_code_t fs_in, fs_code_t fs_out, dither_flag_t dither)
+{
+    int failures = 0;
+
+    ssrc_init(fs_in, fs_out, ssrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, dither);
+    ssrc_init(fs_in, fs_out, ssrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, dither);
+
+    srand(1);
+    for (unsigned b = 0; b < N_BLOCKS && !failures; b++) {
+        // Instance 0 interleaved then planar, instance 1 the other way round
+        unsigned i_planar = (b < N_BLOCKS / 2) ? 1 : 0;
+        unsigned n_interleaved, n_planar;
+
+        fill_input(b);
+        n_interleaved = ssrc_process(in_interleaved, out_interleaved, ssrc_ctrl[1 - i_planar]);
+        n_planar = ssrc_process_planar(in_ptrs, out_ptrs, ssrc_ctrl[i_planar]);
+        failures += compare("SSRC", fs_in, fs_out, b, n_interleaved, n_planar);
+    }
+    return failures;
+}
+
+static int run_asrc(fs_code_t fs_in, fs_code_t fs_out, dither_flag_t dither)
+{
+    unsigned fs_ratio;
+    int      failures = 0;
+
+    fs_ratio = asrc_init(fs_in, fs_out, asrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, dither);
+    asrc_init(fs_in, fs_out, asrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, dither);
+
+    srand(1);
+    for (unsigned b = 0; b < N_BLOCKS && !failures; b++) {
+        unsigned i_planar = (b < N_BLOCKS / 2) ? 1 : 0;
+        unsigned block_ratio, n_interleaved, n_planar;
+
+        fill_input(b);
+        block_ratio = (unsigned)(fs_ratio * (1.0 + ((rand() % (2 * FS_RATIO_DEVIATION_PPM + 1)) - FS_RATIO_DEVIATION_PPM) * 1e-6));
+        n_interleaved = asrc_process(in_interleaved, out_interleaved, block_ratio, asrc_ctrl[1 - i_planar]);
+        n_planar = asrc_process_planar(in_ptrs, out_ptrs, block_ratio, asrc_ctrl[i_planar]);
+        failures += compare("ASRC", fs_in, fs_out, b, n_interleaved, n_planar);
+    }
+    return failures;
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    setup_instances();
+
+    for (fs_code_t fs_in = FS_CODE_44; fs_in <= FS_CODE_192; fs_in++) {
+        for (fs_code_t fs_out = FS_CODE_44; fs_out <= FS_CODE_192; fs_out++) {
+            failures += run_ssrc(fs_in, fs_out, OFF);
+            failures += run_ssrc(fs_in, fs_out, ON);
+            failures += run_asrc(fs_in, fs_out, OFF);
+            failures += run_asrc(fs_in, fs_out, ON);
+        }
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the pull mode ASRC (asrc_pull_process()) for every pair of sample rates.
+// The same input blocks are converted by asrc_process() and, through an input
+// ring, by asrc_pull_process() asked for varying numbers of output samples,
+// with the ring sometimes left short of input. The pulled output must be
+// bit-exact with the asrc_process() output and, once all the input has been
+// pulled, hold the same number of samples. Each pair runs with the ring indices
+// starting at 0 and one block short of their wrap around at 2 x n_frames, and
+// the ring size is not a power of 2.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#define     N_CHANNELS              2
+#define     N_IN_SAMPLES            16
+#define     N_BLOCKS                48
+#define     N_RING_BLOCKS           3
+#define     N_RING_FRAMES           (N_RING_BLOCKS * N_IN_SAMPLES)
+#define     N_STARTS                2
+#define     N_OUT_IN_RATIO_MAX      5
+#define     N_OUT_MAX               (N_BLOCKS * N_IN_SAMPLES * N_OUT_IN_RATIO_MAX)
+#define     N_PULL_MAX              37
+#define     FS_RATIO_DEVIATION      1.0001
+
+TEST_ASRC_INSTANCES(2, N_CHANNELS, N_IN_SAMPLES);
+
+static int                      in_buff[N_BLOCKS][N_IN_SAMPLES * N_CHANNELS];
+static int                      ring_buff[N_RING_FRAMES * N_CHANNELS];
+static int                      out_ref[N_OUT_MAX * N_CHANNELS];
+static int                      out_pull[N_OUT_MAX * N_CHANNELS];
+
+// Writes the next input block into the ring
+static void ring_write_block(asrc_in_ring_t *ring, unsigned b)
+{
+    int *dst = ring->buff + ASRC_IN_RING_POS(ring, ring->write_index) * N_CHANNELS;
+    for (unsigned i = 0; i < N_IN_SAMPLES * N_CHANNELS; i++) dst[i] = in_buff[b][i];
+    ring->write_index = ASRC_IN_RING_ADVANCE(ring, ring->write_index, N_IN_SAMPLES);
+}
+
+int main(void)
+{
+    int     failures = 0;
+
+    TEST_ASRC_SETUP(0);
+    TEST_ASRC_SETUP(1);
+
+    srand(1);
+    for (unsigned b = 0; b < N_BLOCKS; b++) {
+        for (unsigned i = 0; i < N_IN_SAMPLES; i++) {
+            int v = (int)(0.5 * sin(0.05 * (b * N_IN_SAMPLES + i)) * 2147483647.0);
+            in_buff[b][i * N_CHANNELS] = v;
+            in_buff[b][i * N_CHANNELS + 1] = (rand() - RAND_MAX / 2) * 2;
+        }
+    }
+
+    for (int fs_in = 0; fs_in < ASRC_N_FS; fs_in++) {
+        for (int fs_out = 0; fs_out < ASRC_N_FS; fs_out++) {
+            dither_flag_t   dither = ((fs_in + fs_out) & 1) ? ON : OFF;
+            unsigned        fs_ratio;
+            unsigned        n_ref = 0;
+
+            // Reference: block by block
+            fs_ratio = (unsigned)(asrc_init(fs_in, fs_out, asrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, dither) * FS_RATIO_DEVIATION);
+            for (unsigned b = 0; b < N_BLOCKS; b++) {
+                n_ref += asrc_process(in_buff[b], out_ref + n_ref * N_CHANNELS, fs_ratio, asrc_ctrl[0]);
+            }
+
+            for (unsigned start = 0; start < N_STARTS; start++) {
+                unsigned        n_pull = 0, b_in = 0;
+                int             mismatch = 0;
+                unsigned        index = start ? 2 * N_RING_FRAMES - N_IN_SAMPLES : 0;
+                asrc_in_ring_t  ring = {ring_buff, N_RING_FRAMES, index, index};
+
+                // Pull mode: varying requests, ring topped up on two out of three calls
+                asrc_init(fs_in, fs_out, asrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, dither);
+                for (unsigned call = 0; ; call++) {
+                    unsigned n_req = 1 + (call * 7) % N_PULL_MAX;
+                    unsigned n;
+
+                    if (call % 3) {
+                        while ((b_in < N_BLOCKS) && (ASRC_IN_RING_FILL(&ring) <= (N_RING_BLOCKS - 1) * N_IN_SAMPLES)) {
+                            ring_write_block(&ring, b_in++);
+                        }
+                    }
+                    if (n_pull + n_req > N_OUT_MAX) break;
+                    n = asrc_pull_process(&ring, out_pull + n_pull * N_CHANNELS, n_req, fs_ratio, asrc_ctrl[1]);
+                    if ((n < n_req) && (ASRC_IN_RING_FILL(&ring) >= N_IN_SAMPLES)) {
+                        printf("ERROR: %d -> %d start %u: %u of %u output samples with a full input block in the ring\n", fs_in, fs_out, index, n, n_req);
+                        failures++;
+                    }
+                    n_pull += n;
+                    if ((n < n_req) && (b_in == N_BLOCKS)) break;
+                }
+
+                if (n_pull != n_ref) {
+                    printf("ERROR: %d -> %d start %u: %u output samples pulled, %u from asrc_process\n", fs_in, fs_out, index, n_pull, n_ref);
+                    failures++;
+                }
+                for (unsigned i = 0; i < n_ref * N_CHANNELS && i < n_pull * N_CHANNELS; i++) {
+                    if (out_pull[i] != out_ref[i]) mismatch = 1;
+                }
+                if (mismatch) {
+                    printf("ERROR: %d -> %d start %u: pulled output differs from asrc_process\n", fs_in, fs_out, index);
+                    failures++;
+                }
+            }
+        }
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks asrc_change_rate() for every change of input and output sample rates.
+// The ASRC converts a 1kHz tone at the old rates, switches to the new rates
+// and carries on with the tone at the new input rate. The output must not drop
+// to silence after the switch and, once the filters have been refilled with
+// new samples, must be bit-exact with an ASRC initialised at the new rates
+// (and set to the same time) fed with the same input. Right after the switch,
+// the delay lines of filters F1 and F2 must hold the newest samples of their
+// old delay lines (as many as they take), the older ones cleared.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#define     N_CHANNELS              2
+#define     N_IN_SAMPLES            16
+#define     N_BLOCKS_BEFORE         16
+#define     N_BLOCKS_SETTLE         24      // F1 and F2 delay lines refilled (up to 160 taps at twice the input rate)
+#define     N_BLOCKS_CHECK          16
+#define     N_OUT_IN_RATIO_MAX      5
+#define     TONE_HZ                 1000.0
+#define     TONE_AMPLITUDE          0.5
+#define     MIN_PEAK_AFTER_SWITCH   0.1     // Of full scale, over the first two blocks after the switch
+
+TEST_ASRC_INSTANCES(2, N_CHANNELS, N_IN_SAMPLES);
+
+static int                      in_buff[N_IN_SAMPLES * N_CHANNELS];
+static int                      out_buff[2][N_IN_SAMPLES * N_OUT_IN_RATIO_MAX * N_CHANNELS];
+
+static const unsigned           sample_rates[] = {44100, 48000, 88200, 96000, 176400, 192000};
+
+// Tone (inverted on channel 1) continuing at the new input rate after the switch
+static void fill_input(double *phase, unsigned fs)
+{
+    for (unsigned i = 0; i < N_IN_SAMPLES; i++) {
+        int v = (int)(TONE_AMPLITUDE * sin(*phase) * 2147483647.0);
+        in_buff[i * N_CHANNELS] = v;
+        in_buff[i * N_CHANNELS + 1] = -v;
+        *phase += 2.0 * M_PI * TONE_HZ / fs;
+    }
+}
+
+// Copies the delay line data of a FIR, oldest first, returning its length (0 when disabled)
+static unsigned fir_window(FIRCtrl_t *fir, int window[FILTER_DEFS_FIR_MAX_TAPS_LONG])
+{
+    if (fir->eEnable != FIR_ON) return 0;
+    for (unsigned i = 0; i < fir->uiDelayO; i++) window[i] = FIR_DELAY_DATA(fir->piDelayI, fir->uiDelayO)[i];
+    return fir->uiDelayO;
+}
+
+// Checks a FIR delay line holds the newest of n_old samples, the older ones cleared
+static int check_history(FIRCtrl_t *fir, const int *old, unsigned n_old)
+{
+    int         window[FILTER_DEFS_FIR_MAX_TAPS_LONG];
+    unsigned    n = fir_window(fir, window);
+
+    for (unsigned i = 0; i < n; i++) {
+        int expected = (i + n_old >= n) ? old[i + n_old - n] : 0;
+        if (window[i] != expected) return 0;
+    }
+    return 1;
+}
+
+int main(void)
+{
+    int     failures = 0;
+
+    TEST_ASRC_SETUP(0);
+    TEST_ASRC_SETUP(1);
+
+    for (int old = 0; old < ASRC_N_FS * ASRC_N_FS; old++) {
+        for (int new = 0; new < ASRC_N_FS * ASRC_N_FS; new++) {
+            int         in_old = old / ASRC_N_FS, out_old = old % ASRC_N_FS;
+            int         in_new = new / ASRC_N_FS, out_new = new % ASRC_N_FS;
+            double      phase = 0.0;
+            double      peak = 0.0;
+            unsigned    fs_ratio;
+            int         mismatch = 0;
+            int         history_f1[N_CHANNELS][FILTER_DEFS_FIR_MAX_TAPS_LONG];
+            int         history_f2[N_CHANNELS][FILTER_DEFS_FIR_MAX_TAPS_LONG];
+            unsigned    n_history_f1[N_CHANNELS], n_history_f2[N_CHANNELS];
+
+            // Convert at the old rates
+            fs_ratio = asrc_init(in_old, out_old, asrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, OFF);
+            for (unsigned b = 0; b < N_BLOCKS_BEFORE; b++) {
+                fill_input(&phase, sample_rates[in_old]);
+                asrc_process(in_buff, out_buff[0], fs_ratio, asrc_ctrl[0]);
+            }
+
+            // Switch rates and initialise the reference at the new rates from the same time
+            for (int ch = 0; ch < N_CHANNELS; ch++) {
+                n_history_f1[ch] = fir_window(&asrc_ctrl[0][ch].sFIRF1Ctrl, history_f1[ch]);
+                n_history_f2[ch] = fir_window(&asrc_ctrl[0][ch].sFIRF2Ctrl, history_f2[ch]);
+            }
+            fs_ratio = asrc_change_rate(in_new, out_new, asrc_ctrl[0], N_CHANNELS);
+            for (int ch = 0; ch < N_CHANNELS; ch++) {
+                if (!check_history(&asrc_ctrl[0][ch].sFIRF1Ctrl, history_f1[ch], n_history_f1[ch]) ||
+                    !check_history(&asrc_ctrl[0][ch].sFIRF2Ctrl, history_f2[ch], n_history_f2[ch])) {
+                    printf("ERROR: %d/%d -> %d/%d: channel %d F1/F2 history not carried over\n", in_old, out_old, in_new, out_new, ch);
+                    failures++;
+                }
+            }
+            if (asrc_init(in_new, out_new, asrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, OFF) != fs_ratio) {
+                printf("ERROR: %d/%d -> %d/%d: nominal Fs ratio differs from asrc_init\n", in_old, out_old, in_new, out_new);
+                failures++;
+            }
+            for (int ch = 0; ch < N_CHANNELS; ch++) {
+                asrc_ctrl[1][ch].iTimeInt = asrc_ctrl[0][ch].iTimeInt;
+                asrc_ctrl[1][ch].uiTimeFract = asrc_ctrl[0][ch].uiTimeFract;
+            }
+
+            for (unsigned b = 0; b < N_BLOCKS_SETTLE + N_BLOCKS_CHECK; b++) {
+                fill_input(&phase, sample_rates[in_new]);
+                unsigned n_out = asrc_process(in_buff, out_buff[0], fs_ratio, asrc_ctrl[0]);
+                if (asrc_process(in_buff, out_buff[1], fs_ratio, asrc_ctrl[1]) != n_out) {
+                    mismatch = 1;
+                    break;
+                }
+                if (b < 2) {
+                    for (unsigned i = 0; i < n_out * N_CHANNELS; i++) {
+                        double v = fabs(out_buff[0][i] / 2147483648.0);
+                        if (v > peak) peak = v;
+                    }
+                }
+                if (b >= N_BLOCKS_SETTLE) {
+                    for (unsigned i = 0; i < n_out * N_CHANNELS; i++) {
+                        if (out_buff[0][i] != out_buff[1][i]) mismatch = 1;
+                    }
+                }
+            }
+
+            if (peak < MIN_PEAK_AFTER_SWITCH) {
+                printf("ERROR: %d/%d -> %d/%d: output silent after switch (peak %.3f)\n", in_old, out_old, in_new, out_new, peak);
+                failures++;
+            }
+            if (mismatch) {
+                printf("ERROR: %d/%d -> %d/%d: output differs from asrc_init at the new rates\n", in_old, out_old, in_new, out_new);
+                failures++;
+            }
+        }
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,27 @@
+# Runs TEST_APP with TEST_ARGS plus "-o TEST_OUTPUTS" and checks that each
+# output file matches the corresponding TEST_EXPECTED golden file line by line.
+
+execute_process(COMMAND ${TEST_APP} ${TEST_ARGS} -o ${TEST_OUTPUTS}
+                RESULT_VARIABLE app_result)
+if(NOT app_result EQUAL 0)
+    message(FATAL_ERROR "${TEST_APP} failed: ${app_result}")
+endif()
+
+set(failed FALSE)
+foreach(output expected IN ZIP_LISTS TEST_OUTPUTS TEST_EXPECTED)
+    file(STRINGS ${output} output_lines)
+    file(STRINGS ${expected} expected_lines)
+    list(LENGTH output_lines n_output)
+    list(LENGTH expected_lines n_expected)
+    if(NOT n_output EQUAL n_expected)
+        message(SEND_ERROR "${output}: ${n_output} samples, expected ${n_expected} (${expected})")
+        set(failed TRUE)
+    elseif(NOT "${output_lines}" STREQUAL "${expected_lines}")
+        message(SEND_ERROR "${output} does not match ${expected}")
+        set(failed TRUE)
+    endif()
+endforeach()
+
+if(failed)
+    message(FATAL_ERROR "Output does not match golden result")
+endif()
@@ -0,0 +1,193 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the SSRC for sample rates given in Hz (ssrc_init_hz(), ssrc_rate_supported()).
+// For every pair of a set of common rates:
+//  - a plan must exist, except for the upsampling pairs without an integer step of the polyphase
+//    filter (unsupported_pairs), for which ssrc_init_hz() must return 0
+//  - the number of output samples must follow the ratio of the rates, block after block
+//  - a tone in the pass band, converted without dither, must come out with a SINAD of at least
+//    MIN_SINAD_DB
+//  - when downsampling, a tone above the output Nyquist frequency (at ALIAS_TONE x Fout) must come
+//    out below MAX_ALIAS_DB (relative to full scale)
+// The pairs of rates of the FS codes must be bit-exact with ssrc_init(). The rate codes of the
+// control structures (eInFs, eOutFs) must be those of the rates, SSRC_FS_NONE without.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#define     N_CHANNELS              2
+#define     N_IN_SAMPLES            32      // A multiple of 2 x 16 for the decimation by 16
+#define     N_BLOCKS_SETTLE         96      // Delay lines filled (up to 16 x 160 + 294 taps at the input rate)
+#define     N_OUT_MEASURE           2048
+#define     N_OUT_IN_RATIO_MAX      50
+#define     N_BLOCKS_BITEXACT       72
+#define     TONE_AMPLITUDE          0.5
+#define     PASS_TONE               0.3     // Of the lowest of Fsin and Fsout
+#define     ALIAS_TONE              0.6     // Of Fsout, when below ALIAS_TONE_MAX x Fsin
+#define     ALIAS_TONE_MAX          0.45
+#define     MIN_SINAD_DB            110.0
+#define     MAX_ALIAS_DB            -95.0
+
+TEST_SSRC_INSTANCES(2, N_CHANNELS, N_IN_SAMPLES);
+
+static int                      in_buff[N_IN_SAMPLES * N_CHANNELS];
+static int                      out_buff[2][N_IN_SAMPLES * N_OUT_IN_RATIO_MAX * N_CHANNELS];
+static double                   out_samples[N_OUT_MEASURE];
+
+static const unsigned           sample_rates[] = {8000, 16000, 22050, 24000, 32000, 44100, 48000, 88200, 96000, 176400, 192000, 352800, 384000};
+#define     N_RATES                 (sizeof(sample_rates) / sizeof(sample_rates[0]))
+
+// Upsampling pairs needing a polyphase filter of 441 phases, or more than x4 without an integer step
+static const unsigned           unsupported_pairs[][2] = {
+    {8000, 22050}, {8000, 44100}, {8000, 88200}, {8000, 176400}, {8000, 192000}, {8000, 352800}, {8000, 384000},
+    {16000, 22050}, {16000, 44100}, {16000, 88200}, {16000, 176400}, {16000, 352800}, {16000, 384000},
+    {22050, 192000}, {22050, 384000},
+    {32000, 22050}, {32000, 44100}, {32000, 88200}, {32000, 176400}, {32000, 352800},
+    {44100, 384000}};
+#define     N_UNSUPPORTED_PAIRS     (sizeof(unsupported_pairs) / sizeof(unsupported_pairs[0]))
+
+static const unsigned           fs_codes_hz[] = {44100, 48000, 88200, 96000, 176400, 192000};
+
+static int is_unsupported(unsigned fs_in, unsigned fs_out)
+{
+    for (unsigned p = 0; p < N_UNSUPPORTED_PAIRS; p++) {
+        if ((unsupported_pairs[p][0] == fs_in) && (unsupported_pairs[p][1] == fs_out)) return 1;
+    }
+    return 0;
+}
+
+// Converts a tone of w_in (radians per input sample), returning the number of output samples of
+// channel 0 in out_samples after the filters have settled. Checks the number of output samples
+// stays within one sample of the ratio of the rates
+static unsigned convert_tone(unsigned fs_in, unsigned fs_out, double w_in, int *failures)
+{
+    unsigned long long n_in_total = 0, n_out_total = 0;
+    unsigned n_out = 0;
+
+    ssrc_init_hz(fs_in, fs_out, ssrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, OFF);
+    for (unsigned b = 0; n_out < N_OUT_MEASURE; b++) {
+        fill_tone(in_buff, N_IN_SAMPLES, N_CHANNELS, TONE_AMPLITUDE, w_in, b * N_IN_SAMPLES);
+        unsigned n = ssrc_process(in_buff, out_buff[0], ssrc_ctrl[0]);
+        n_in_total += N_IN_SAMPLES;
+        n_out_total += n;
+        if (llabs((long long)(n_out_total * fs_in) - (long long)(n_in_total * fs_out)) >= (long long)fs_in) {
+            printf("ERROR: %u -> %u Hz: %llu output samples for %llu input samples\n", fs_in, fs_out, n_out_total, n_in_total);
+            (*failures)++;
+            return 0;
+        }
+        if (b < N_BLOCKS_SETTLE) continue;
+        for (unsigned i = 0; i < n && n_out < N_OUT_MEASURE; i++) out_samples[n_out++] = out_buff[0][i * N_CHANNELS] / 2147483648.0;
+    }
+    return n_out;
+}
+
+// Converts the same blocks with both instances and checks the outputs are bit-exact
+static int bitexact(double w_in)
+{
+    int mismatch = 0;
+
+    for (unsigned b = 0; b < N_BLOCKS_BITEXACT; b++) {
+        fill_tone(in_buff, N_IN_SAMPLES, N_CHANNELS, TONE_AMPLITUDE, w_in, b * N_IN_SAMPLES);
+        unsigned n = ssrc_process(in_buff, out_buff[0], ssrc_ctrl[0]);
+        if (ssrc_process(in_buff, out_buff[1], ssrc_ctrl[1]) != n) return 0;
+        for (unsigned i = 0; i < n * N_CHANNELS; i++) {
+            if (out_buff[0][i] != out_buff[1][i]) mismatch = 1;
+        }
+    }
+    return !mismatch;
+}
+
+int main(void)
+{
+    int     failures = 0;
+    double  worst_sinad = 1000.0, worst_alias = -1000.0;
+    unsigned n_planned = 0;
+
+    TEST_SSRC_SETUP(0);
+    TEST_SSRC_SETUP(1);
+
+    for (unsigned i = 0; i < N_RATES; i++) {
+        for (unsigned o = 0; o < N_RATES; o++) {
+            unsigned    fs_in = sample_rates[i], fs_out = sample_rates[o];
+            unsigned    fs_min = fs_in < fs_out ? fs_in : fs_out;
+            unsigned    n_out;
+
+            if (is_unsupported(fs_in, fs_out)) {
+                if (ssrc_rate_supported(fs_in, fs_out, N_IN_SAMPLES) ||
+                    (ssrc_init_hz(fs_in, fs_out, ssrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, OFF) != 0)) {
+                    printf("ERROR: %u -> %u Hz: planned without an integer polyphase step\n", fs_in, fs_out);
+                    failures++;
+                }
+                continue;
+            }
+            if (!ssrc_rate_supported(fs_in, fs_out, N_IN_SAMPLES)) {
+                printf("ERROR: %u -> %u Hz: no plan\n", fs_in, fs_out);
+                failures++;
+                continue;
+            }
+            n_planned++;
+
+            // Pass band tone
+            double w_in = 2.0 * M_PI * PASS_TONE * fs_min / fs_in;
+            n_out = convert_tone(fs_in, fs_out, w_in, &failures);
+            if (n_out == 0) continue;
+            double sinad = sinad_db(out_samples, n_out, w_in * fs_in / fs_out);
+            if (sinad < worst_sinad) worst_sinad = sinad;
+            if (sinad < MIN_SINAD_DB) {
+                printf("ERROR: %u -> %u Hz: SINAD %.1f dB below %.1f dB\n", fs_in, fs_out, sinad, MIN_SINAD_DB);
+                failures++;
+            }
+
+            // Tone above the output Nyquist frequency
+            if (ALIAS_TONE * fs_out < ALIAS_TONE_MAX * fs_in) {
+                n_out = convert_tone(fs_in, fs_out, 2.0 * M_PI * ALIAS_TONE * fs_out / fs_in, &failures);
+                double alias = level_db(out_samples, n_out);
+                if (alias > worst_alias) worst_alias = alias;
+                if (alias > MAX_ALIAS_DB) {
+                    printf("ERROR: %u -> %u Hz: tone at %.0f Hz comes out at %.1f dB, above %.1f dB\n",
+                           fs_in, fs_out, ALIAS_TONE * fs_out, alias, MAX_ALIAS_DB);
+                    failures++;
+                }
+            }
+        }
+    }
+    printf("%u pairs planned, worst SINAD %.1f dB, worst alias %.1f dB\n", n_planned, worst_sinad, worst_alias);
+
+    // The decimation by sixteen needs a multiple of 32 input samples
+    if (ssrc_rate_supported(384000, 8000, 16)) {
+        printf("ERROR: 384000 -> 8000 Hz planned for 16 input samples\n");
+        failures++;
+    }
+
+    // Unsupported pairs of rates are returned to the caller
+    if (ssrc_init_hz(768000, 8000, ssrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, OFF) != 0) {
+        printf("ERROR: 768000 -> 8000 Hz initialised\n");
+        failures++;
+    }
+    ssrc_init_hz(48000, 16000, ssrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, OFF);
+    if ((ssrc_ctrl[1][N_CHANNELS - 1].eInFs != SSRC_FS_48) || (ssrc_ctrl[1][N_CHANNELS - 1].eOutFs != SSRC_FS_NONE)) {
+        printf("ERROR: 48000 -> 16000 Hz: rate codes %d -> %d\n", ssrc_ctrl[1][N_CHANNELS - 1].eInFs, ssrc_ctrl[1][N_CHANNELS - 1].eOutFs);
+        failures++;
+    }
+
+    // Rates of the FS codes: same as ssrc_init()
+    for (int fs_in = FS_CODE_44; fs_in <= FS_CODE_192; fs_in++) {
+        for (int fs_out = FS_CODE_44; fs_out <= FS_CODE_192; fs_out++) {
+            dither_flag_t dither = ((fs_in + fs_out) & 1) ? ON : OFF;
+            ssrc_init(fs_in, fs_out, ssrc_ctrl[0], N_CHANNELS, N_IN_SAMPLES, dither);
+            if ((ssrc_init_hz(fs_codes_hz[fs_in], fs_codes_hz[fs_out], ssrc_ctrl[1], N_CHANNELS, N_IN_SAMPLES, dither) != 1) ||
+                (ssrc_ctrl[1][0].eInFs != fs_in) || (ssrc_ctrl[1][0].eOutFs != fs_out) || !bitexact(0.1)) {
+                printf("ERROR: %d -> %d: output differs from ssrc_init\n", fs_in, fs_out);
+                failures++;
+            }
+        }
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
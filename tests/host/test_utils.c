@@ -0,0 +1,73 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Helpers shared by the host tests (see test_utils.h)
+
+// General includes
+#include <math.h>
+
+#include "test_utils.h"
+
+void setup_ssrc(ssrc_ctrl_t ssrc_ctrl[], ssrc_state_t ssrc_state[], int *ssrc_stack, unsigned stack_length,
+                unsigned n_channels)
+{
+    for (unsigned ch = 0; ch < n_channels; ch++) {
+        ssrc_ctrl[ch].psState = &ssrc_state[ch];
+        ssrc_ctrl[ch].piStack = ssrc_stack + ch * stack_length;
+    }
+}
+
+void setup_asrc(asrc_ctrl_t asrc_ctrl[], asrc_state_t asrc_state[], int *asrc_stack, unsigned stack_length,
+                asrc_adfir_coefs_t *asrc_adfir_coefs, unsigned n_channels)
+{
+    for (unsigned ch = 0; ch < n_channels; ch++) {
+        asrc_ctrl[ch].psState = &asrc_state[ch];
+        asrc_ctrl[ch].piStack = asrc_stack + ch * stack_length;
+        asrc_ctrl[ch].piADCoefs = asrc_adfir_coefs->iASRCADFIRCoefs;
+    }
+}
+
+void fill_tone(int buff[], unsigned n_samples, unsigned n_channels, double amplitude, double w, unsigned n)
+{
+    for (unsigned i = 0; i < n_samples; i++) {
+        int v = (int)(amplitude * sin(w * (n + i)) * 2147483647.0);
+        for (unsigned ch = 0; ch < n_channels; ch++) {
+            buff[i * n_channels + ch] = (ch & 1) ? -v : v;
+        }
+    }
+}
+
+double sinad_db(const double *x, unsigned n, double w)
+{
+    double m[3][4] = {{0}};
+    double a, b, c, err = 0.0;
+
+    for (unsigned i = 0; i < n; i++) {
+        double v[3] = {sin(w * i), cos(w * i), 1.0};
+        for (int r = 0; r < 3; r++) {
+            for (int k = 0; k < 3; k++) m[r][k] += v[r] * v[k];
+            m[r][3] += v[r] * x[i];
+        }
+    }
+    // Gaussian elimination (the matrix is well conditioned)
+    for (int p = 0; p < 3; p++) {
+        for (int r = p + 1; r < 3; r++) {
+            double f = m[r][p] / m[p][p];
+            for (int k = p; k < 4; k++) m[r][k] -= f * m[p][k];
+        }
+    }
+    c = m[2][3] / m[2][2];
+    b = (m[1][3] - m[1][2] * c) / m[1][1];
+    a = (m[0][3] - m[0][1] * b - m[0][2] * c) / m[0][0];
+
+    for (unsigned i = 0; i < n; i++) {
+        double e = x[i] - (a * sin(w * i) + b * cos(w * i) + c);
+        err += e * e;
+    }
+    return 10.0 * log10((0.5 * (a * a + b * b)) / (err / n));
+}
+
+double level_db(const double *x, unsigned n)
+{
+    double sum = 1e-30;
+    for (unsigned i = 0; i < n; i++) sum += x[i] * x[i];
+    return 10.0 * log10(sum / n);
+}
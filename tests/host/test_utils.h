@@ -0,0 +1,62 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Helpers shared by the host tests: SSRC/ASRC instances declared the usual way (static control
+// structures, states and stacks of 4 x channels x input samples per channel), tone inputs and
+// tone measurements.
+//
+// test_utils.c is built into each test executable (see CMakeLists.txt), so the structures match
+// the library variant the test is linked with.
+#ifndef _TEST_UTILS_H_
+#define _TEST_UTILS_H_
+
+// SRC includes
+#include "src.h"
+
+// Declares n_inst SSRC instances of n_ch channels converting blocks of n_in input samples:
+// ssrc_state, ssrc_stack and ssrc_ctrl, indexed by instance then channel
+#define     TEST_SSRC_INSTANCES(n_inst, n_ch, n_in) \
+    static ssrc_state_t             ssrc_state[n_inst][n_ch]; \
+    static int                      ssrc_stack[n_inst][n_ch][4 * (n_ch) * (n_in)]; \
+    static ssrc_ctrl_t              ssrc_ctrl[n_inst][n_ch]
+
+// Declares n_inst ASRC instances of n_ch channels converting blocks of n_in input samples:
+// asrc_state, asrc_stack and asrc_ctrl, indexed by instance then channel, and asrc_adfir_coefs
+#define     TEST_ASRC_INSTANCES(n_inst, n_ch, n_in) \
+    static asrc_state_t             asrc_state[n_inst][n_ch]; \
+    static int                      asrc_stack[n_inst][n_ch][4 * (n_ch) * (n_in)]; \
+    static asrc_ctrl_t              asrc_ctrl[n_inst][n_ch]; \
+    static asrc_adfir_coefs_t       asrc_adfir_coefs[n_inst]
+
+// Sets the state and stack of each channel of instance inst of TEST_SSRC_INSTANCES
+#define     TEST_SSRC_SETUP(inst) \
+    setup_ssrc(ssrc_ctrl[inst], ssrc_state[inst], ssrc_stack[inst][0], \
+               sizeof(ssrc_stack[inst][0]) / sizeof(int), sizeof(ssrc_ctrl[inst]) / sizeof(ssrc_ctrl_t))
+
+// Sets the state, stack and adaptive filter coefficients of each channel of instance inst of
+// TEST_ASRC_INSTANCES
+#define     TEST_ASRC_SETUP(inst) \
+    setup_asrc(asrc_ctrl[inst], asrc_state[inst], asrc_stack[inst][0], \
+               sizeof(asrc_stack[inst][0]) / sizeof(int), &asrc_adfir_coefs[inst], \
+               sizeof(asrc_ctrl[inst]) / sizeof(asrc_ctrl_t))
+
+// Sets ssrc_ctrl[ch] to ssrc_state[ch] and the stack_length samples at ssrc_stack + ch x stack_length
+void setup_ssrc(ssrc_ctrl_t ssrc_ctrl[], ssrc_state_t ssrc_state[], int *ssrc_stack, unsigned stack_length,
+                unsigned n_channels);
+
+// Sets asrc_ctrl[ch] to asrc_state[ch], the stack_length samples at asrc_stack + ch x stack_length and
+// the adaptive filter coefficients shared by the channels
+void setup_asrc(asrc_ctrl_t asrc_ctrl[], asrc_state_t asrc_state[], int *asrc_stack, unsigned stack_length,
+                asrc_adfir_coefs_t *asrc_adfir_coefs, unsigned n_channels);
+
+// Fills n_samples interleaved samples of n_channels with a tone of amplitude (of full scale) and
+// angular frequency w (radians per sample), from sample n of the tone. The tone is inverted on
+// the odd channels
+void fill_tone(int buff[], unsigned n_samples, unsigned n_channels, double amplitude, double w, unsigned n);
+
+// Least squares fit of a * sin(w n) + b * cos(w n) + c to the n samples of x, returns the signal
+// to residual ratio in dB
+double sinad_db(const double *x, unsigned n, double w);
+
+// RMS level of the n samples of x relative to full scale in dB
+double level_db(const double *x, unsigned n);
+
+#endif // _TEST_UTILS_H_
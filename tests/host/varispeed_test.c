@@ -0,0 +1,152 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+// Checks the ASRC Fs ratio range (asrc_set_fs_ratio_range()) at +/-RANGE_PPM.
+// For a few pairs of rates:
+//  - the Fs ratio is swept from the bottom to the top of the range: the number of output samples
+//    must follow the Fs ratio (within two input samples), where the default range replaces it with
+//    the nominal ratio
+//  - a tone, converted at either end of the range without dither, must come out with a SINAD of
+//    at least MIN_SINAD_DB
+//  - the range must be kept over asrc_change_rate_hz()
+// Ranges beyond ASRC_FS_RATIO_RANGE_MAX or the Q4.28 format of the Fs ratio must be rejected.
+
+// General includes
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+// SRC includes
+#include "src.h"
+#include "test_utils.h"
+
+#define     N_CHANNELS              2
+#define     N_IN_SAMPLES            16
+#define     N_BLOCKS_SETTLE         64
+#define     N_BLOCKS_SWEEP          512
+#define     N_OUT_MEASURE           2048
+#define     N_OUT_IN_RATIO_MAX      6       // 44.1 -> 192kHz at the bottom of the range
+#define     RANGE_PPM               100000  // +/-10%
+#define     TONE_AMPLITUDE          0.5
+#define     TONE                    0.2     // Of the lowest of Fsin and Fsout
+#define     MIN_SINAD_DB            150.0
+
+static asrc_state_t             asrc_state[N_CHANNELS];
+static int                      asrc_stack[N_CHANNELS][4 * N_CHANNELS * N_IN_SAMPLES];
+static asrc_ctrl_t              asrc_ctrl[N_CHANNELS];
+static asrc_adfir_coefs_t       asrc_adfir_coefs;
+
+static int                      in_buff[N_IN_SAMPLES * N_CHANNELS];
+static int                      out_buff[N_IN_SAMPLES * N_OUT_IN_RATIO_MAX * N_CHANNELS];
+static double                   out_samples[N_OUT_MEASURE];
+
+static const unsigned           rates[][2] = {{44100, 48000}, {48000, 44100}, {96000, 48000}, {44100, 192000}, {44100, 16000}};
+
+static unsigned init_asrc(unsigned fs_in, unsigned fs_out, unsigned range_ppm)
+{
+    unsigned fs_ratio;
+
+    setup_asrc(asrc_ctrl, asrc_state, asrc_stack[0], sizeof(asrc_stack[0]) / sizeof(int), &asrc_adfir_coefs, N_CHANNELS);
+    fs_ratio = asrc_init_hz(fs_in, fs_out, asrc_ctrl, N_CHANNELS, N_IN_SAMPLES, OFF);
+    if (range_ppm) asrc_set_fs_ratio_range(asrc_ctrl, N_CHANNELS, range_ppm);
+    return fs_ratio;
+}
+
+// Number of output samples over the sweep of the Fs ratio from (1 - RANGE_PPM) to (1 + RANGE_PPM)
+// times nominal, and the number expected from the Fs ratios
+static unsigned sweep(unsigned fs_in, unsigned fs_out, unsigned range_ppm, double *expected)
+{
+    unsigned nominal = init_asrc(fs_in, fs_out, range_ppm);
+    unsigned n_out = 0;
+
+    *expected = 0.0;
+    for (unsigned b = 0; b < N_BLOCKS_SWEEP; b++) {
+        double   deviation = (2.0 * b / (N_BLOCKS_SWEEP - 1) - 1.0) * RANGE_PPM / 1e6;
+        unsigned fs_ratio = (unsigned)(nominal * (1.0 + deviation));
+
+        fill_tone(in_buff, N_IN_SAMPLES, N_CHANNELS, TONE_AMPLITUDE, 0.1, b * N_IN_SAMPLES);
+        n_out += asrc_process(in_buff, out_buff, fs_ratio, asrc_ctrl);
+        *expected += N_IN_SAMPLES * (double)(1 << 28) / fs_ratio;
+    }
+    return n_out;
+}
+
+// SINAD of a tone converted at the Fs ratio nominal x (1 + deviation)
+static double tone_sinad(unsigned fs_in, unsigned fs_out, double deviation)
+{
+    unsigned fs_min = fs_in < fs_out ? fs_in : fs_out;
+    double   w_in = 2.0 * M_PI * TONE * fs_min / fs_in;
+    unsigned fs_ratio = (unsigned)(init_asrc(fs_in, fs_out, RANGE_PPM) * (1.0 + deviation));
+    unsigned n_out = 0;
+
+    for (unsigned b = 0; n_out < N_OUT_MEASURE; b++) {
+        fill_tone(in_buff, N_IN_SAMPLES, N_CHANNELS, TONE_AMPLITUDE, w_in, b * N_IN_SAMPLES);
+        unsigned n = asrc_process(in_buff, out_buff, fs_ratio, asrc_ctrl);
+        if (b < N_BLOCKS_SETTLE) continue;
+        for (unsigned i = 0; i < n && n_out < N_OUT_MEASURE; i++) out_samples[n_out++] = out_buff[i * N_CHANNELS] / 2147483648.0;
+    }
+    return sinad_db(out_samples, n_out, w_in * fs_ratio / (double)(1 << 28));
+}
+
+int main(void)
+{
+    int     failures = 0;
+
+    for (unsigned r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+        unsigned fs_in = rates[r][0], fs_out = rates[r][1];
+        unsigned n_out, n_out_default, n_nominal;
+        double   expected, expected_default;
+        double   tolerance = 2.0 * fs_out / fs_in + 1.0;    // Two input samples (start of F3 time)
+
+        // Output follows the swept Fs ratio, and only with the range set
+        n_out = sweep(fs_in, fs_out, RANGE_PPM, &expected);
+        n_out_default = sweep(fs_in, fs_out, 0, &expected_default);
+        n_nominal = (unsigned)(N_BLOCKS_SWEEP * N_IN_SAMPLES * (double)fs_out / fs_in);
+        if (fabs(n_out - expected) > tolerance) {
+            printf("ERROR: %u -> %u Hz: %u output samples over the sweep, expected %.1f\n", fs_in, fs_out, n_out, expected);
+            failures++;
+        }
+        if (fabs((double)n_out_default - n_nominal) > tolerance) {
+            printf("ERROR: %u -> %u Hz: %u output samples over the sweep with the default range, expected %u\n", fs_in, fs_out, n_out_default, n_nominal);
+            failures++;
+        }
+
+        // Quality at either end of the range
+        for (int end = -1; end <= 1; end += 2) {
+            double sinad = tone_sinad(fs_in, fs_out, end * 0.999 * RANGE_PPM / 1e6);
+            printf("%u -> %u Hz, Fs ratio %+d%%: SINAD %.1f dB\n", fs_in, fs_out, end * RANGE_PPM / 10000, sinad);
+            if (sinad < MIN_SINAD_DB) {
+                printf("ERROR: SINAD below %.1f dB\n", MIN_SINAD_DB);
+                failures++;
+            }
+        }
+    }
+
+    // Range kept over a rate change
+    {
+        unsigned nominal;
+
+        init_asrc(44100, 48000, RANGE_PPM);
+        nominal = asrc_change_rate_hz(48000, 32000, asrc_ctrl, N_CHANNELS);
+        if ((asrc_ctrl[1].sFsRatioConfig.uiMinFsRatio != nominal - (unsigned)((unsigned long long)nominal * RANGE_PPM / 1000000)) ||
+            (asrc_ctrl[1].sFsRatioConfig.uiMaxFsRatio != nominal + (unsigned)((unsigned long long)nominal * RANGE_PPM / 1000000))) {
+            printf("ERROR: Fs ratio range not kept over asrc_change_rate_hz()\n");
+            failures++;
+        }
+    }
+
+    // Ranges beyond the maximum or the Q4.28 format of the Fs ratio
+    init_asrc(44100, 48000, 0);
+    asrc_ctrl[0].uiFsRatioRange = ASRC_FS_RATIO_RANGE_MAX + 1;
+    if (ASRC_set_fs_ratio_range(&asrc_ctrl[0]) == ASRC_NO_ERROR) {
+        printf("ERROR: Fs ratio range above ASRC_FS_RATIO_RANGE_MAX accepted\n");
+        failures++;
+    }
+    init_asrc(384000, 32000, 0);
+    asrc_ctrl[0].uiFsRatioRange = 400000;
+    if (ASRC_set_fs_ratio_range(&asrc_ctrl[0]) == ASRC_NO_ERROR) {
+        printf("ERROR: Fs ratio range beyond the Q4.28 format accepted\n");
+        failures++;
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}